@@ -0,0 +1,114 @@
+/**
+ * @file latency_recorder.h
+ * @brief 基准测试用的延迟样本记录与分位数统计
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 延迟记录器（微秒，保存全部样本，分位数精确）
+ *
+ * 每个压测线程各持有一个，结束后 merge 到一起再统计，记录时不加锁。
+ * 闭环压测（发完一个再发下一个）时，服务变慢会让客户端少发请求，慢请求在样本中
+ * 的占比被低估（coordinated omission）。correctedForCoordinatedOmission 按
+ * HdrHistogram 的 recordValueWithExpectedInterval 补回这些"本应发出"的请求：
+ * 延迟 L 超过期望间隔 I 时，追加 L-I、L-2I、...，只追加不小于 I 的样本
+ * （如 L=2.5I 只追加 1.5I）。
+ */
+class LatencyRecorder {
+public:
+    void record(uint64_t micros) {
+        samples_.push_back(micros);
+        sorted_ = false;
+    }
+
+    void merge(const LatencyRecorder& other) {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+        sorted_ = false;
+    }
+
+    void reserve(size_t n) {
+        samples_.reserve(n);
+    }
+
+    size_t count() const {
+        return samples_.size();
+    }
+
+    /**
+     * @brief 分位数（最近秩法：秩 = ceil(q * n)，至少为1，取第 rank 小的样本）
+     * @param q 0~1，如 0.99
+     * @return 微秒，没有样本时返回0
+     */
+    uint64_t percentile(double q) {
+        if (samples_.empty()) {
+            return 0;
+        }
+        sort();
+        q = std::min(1.0, std::max(0.0, q));
+        size_t n = samples_.size();
+        size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(n)));
+        rank = std::min(std::max<size_t>(rank, 1), n);
+        return samples_[rank - 1];
+    }
+
+    uint64_t max() {
+        if (samples_.empty()) {
+            return 0;
+        }
+        sort();
+        return samples_.back();
+    }
+
+    double mean() const {
+        if (samples_.empty()) {
+            return 0.0;
+        }
+        long double sum = 0;
+        for (uint64_t v : samples_) {
+            sum += v;
+        }
+        return static_cast<double>(sum / samples_.size());
+    }
+
+    /**
+     * @brief 按期望的请求间隔补齐被遗漏的样本
+     * @param expectedIntervalMicros 期望间隔（0 表示不修正）
+     */
+    LatencyRecorder correctedForCoordinatedOmission(uint64_t expectedIntervalMicros) const {
+        LatencyRecorder corrected;
+        corrected.reserve(samples_.size());
+        for (uint64_t v : samples_) {
+            corrected.record(v);
+            if (expectedIntervalMicros == 0) {
+                continue;
+            }
+            if (v <= expectedIntervalMicros) {
+                continue;
+            }
+            for (uint64_t missing = v - expectedIntervalMicros; missing >= expectedIntervalMicros;
+                 missing -= expectedIntervalMicros) {
+                corrected.record(missing);
+            }
+        }
+        return corrected;
+    }
+
+private:
+    void sort() {
+        if (!sorted_) {
+            std::sort(samples_.begin(), samples_.end());
+            sorted_ = true;
+        }
+    }
+
+    std::vector<uint64_t> samples_;
+    bool sorted_ = true;
+};
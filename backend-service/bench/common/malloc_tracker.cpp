@@ -0,0 +1,117 @@
+/**
+ * @file malloc_tracker.cpp
+ * @brief 基准测试用的堆分配统计实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "common/malloc_tracker.h"
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+std::atomic<bool> tracking{false};
+std::atomic<int64_t> allocations{0};
+std::atomic<int64_t> allocatedBytes{0};
+std::atomic<int64_t> currentBytes{0};   // 相对 Start() 时的净增长，释放更早分配的内存时可能为负
+std::atomic<int64_t> peakBytes{0};
+
+void onAllocate(void* ptr) {
+    if (!ptr || !tracking.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto size = static_cast<int64_t>(malloc_usable_size(ptr));
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    int64_t current = currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    int64_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (current > peak && !peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void onFree(void* ptr) {
+    if (!ptr || !tracking.load(std::memory_order_relaxed)) {
+        return;
+    }
+    currentBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+}
+
+}  // namespace
+
+extern "C" {
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    onAllocate(ptr);
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    onAllocate(ptr);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    onFree(ptr);
+    void* result = __libc_realloc(ptr, size);
+    onAllocate(result);
+    return result;
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    onAllocate(ptr);
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    void* ptr = memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *out = ptr;
+    return 0;
+}
+
+void free(void* ptr) {
+    onFree(ptr);
+    __libc_free(ptr);
+}
+
+}  // extern "C"
+
+void MallocTracker::Start() {
+    allocations = 0;
+    allocatedBytes = 0;
+    currentBytes = 0;
+    peakBytes = 0;
+    tracking = true;
+}
+
+void MallocTracker::Stop(Result* result) {
+    Stop(*result);
+}
+
+void MallocTracker::Stop(Result& result) {
+    tracking = false;
+    result.num_allocs = allocations.load();
+    result.max_bytes_used = peakBytes.load();
+    result.total_allocated_bytes = allocatedBytes.load();
+    result.net_heap_growth = currentBytes.load();
+}
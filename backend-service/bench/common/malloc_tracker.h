@@ -0,0 +1,27 @@
+/**
+ * @file malloc_tracker.h
+ * @brief 基准测试用的堆分配统计（拦截 malloc/free，接入 Google Benchmark 的 MemoryManager）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+/**
+ * @brief 堆分配统计
+ *
+ * malloc_tracker.cpp 在可执行文件中替换 malloc/calloc/realloc/free 等（转调 glibc 的 __libc_*），
+ * 因此 operator new 和 stb_image 内部的 malloc 都会被统计。只在 start() 与 stop() 之间计数。
+ * 只适用于 glibc。
+ */
+class MallocTracker : public benchmark::MemoryManager {
+public:
+    void Start() override;
+
+    // benchmark 1.7 的纯虚接口；新版本只保留引用版本
+    void Stop(Result* result);
+    void Stop(Result& result) override;
+};
@@ -0,0 +1,60 @@
+/**
+ * @file report.h
+ * @brief 基准测试结果的 JSON 输出与基线对比（knot_load_gen / knot_repo_bench 共用）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "common/latency_recorder.h"
+#include <json/json.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+inline const std::vector<std::pair<std::string, double>> kPercentiles = {
+    {"p50", 0.50}, {"p90", 0.90}, {"p99", 0.99}, {"p99.9", 0.999}};
+
+/**
+ * @brief 延迟分位数（毫秒）
+ */
+inline Json::Value latencyJson(LatencyRecorder& recorder) {
+    Json::Value json;
+    for (const auto& [name, q] : kPercentiles) {
+        json[name] = recorder.percentile(q) / 1000.0;
+    }
+    json["max"] = recorder.max() / 1000.0;
+    json["mean"] = recorder.mean() / 1000.0;
+    return json;
+}
+
+/**
+ * @brief 相对基线的变化，格式 " (+3.2%)"；基线缺失时返回空串
+ */
+inline std::string delta(double current, const Json::Value& base) {
+    if (!base.isNumeric() || base.asDouble() == 0.0) {
+        return "";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), " (%+.1f%%)", (current / base.asDouble() - 1.0) * 100.0);
+    return buffer;
+}
+
+inline bool readJsonFile(const std::string& path, Json::Value& out) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    Json::CharReaderBuilder reader;
+    std::string errors;
+    return file && Json::parseFromStream(reader, content, &out, &errors);
+}
+
+inline bool writeJsonFile(const std::string& path, const Json::Value& json) {
+    std::ofstream file(path);
+    file << json.toStyledString();
+    return static_cast<bool>(file);
+}
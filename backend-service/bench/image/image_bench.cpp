@@ -0,0 +1,352 @@
+/**
+ * @file image_bench.cpp
+ * @brief 上传链路微基准：图片处理、缩略图、头像、编解码、Base64
+ * @author Knot Team
+ * @date 2026-10-18
+ *
+ * 基于 Google Benchmark。启动时在临时目录生成一组不同尺寸/格式的合成图片
+ * （--corpus=DIR 可追加真实图片，如 test/pictures），对每张图片注册：
+ *   ProcessImage/<图片>      ImageProcessor::processImage（解码 + 原图 JPEG + 缩略图）
+ *   GenerateThumbnail/<图片> ImageProcessor::generateThumbnail（缩放 + JPEG）
+ *   ProcessAvatar/<图片>     AvatarProcessor::processAvatar（裁剪 + 缩放 + JPEG）
+ *   Decode/<图片>            stbi_load
+ *   EncodeJpeg/<图片>        stbi_write_jpg（质量 80，与上传链路一致）
+ * 以及 Base64Decode/<字节数>。
+ *
+ * 每项输出 MP/s（按原图像素）、bytes/s 以及峰值堆内存（MallocTracker）。
+ *
+ * 回归门禁：
+ *   knot_image_bench --benchmark_out=base.json --benchmark_out_format=json
+ *   knot_image_bench --baseline=base.json --max_regression=10
+ * 后者任何一项比基线慢 10% 以上时退出码为 2。
+ */
+
+#include "common/malloc_tracker.h"
+#include "utils/avatar_processor.h"
+#include "utils/base64_decoder.h"
+#include "utils/image_processor.h"
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include <benchmark/benchmark.h>
+#include <json/json.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief 基准图片
+ */
+struct CorpusImage {
+    std::string name;       // 如 rgb_1920x1080.jpg
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    size_t fileBytes = 0;
+    std::shared_ptr<std::vector<unsigned char>> pixels;    // 预先解码，缩略图/编码基准的峰值内存不含解码
+};
+
+fs::path workDir;
+
+/**
+ * @brief 生成合成图片：渐变 + 少量噪声，压缩率接近照片而不是纯色（4032x3024 的 JPEG 仍低于 5MB 上传限制）
+ */
+std::vector<unsigned char> syntheticPixels(int width, int height, int channels) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * channels);
+    std::mt19937 rng(static_cast<unsigned>(width * 31 + height));
+    std::uniform_int_distribution<int> noise(-4, 4);
+    size_t i = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int base[4] = {x * 255 / width, y * 255 / height, (x + y) * 255 / (width + height), 255};
+            for (int c = 0; c < channels; ++c) {
+                int v = c == 3 ? 255 : base[c] + noise(rng);
+                pixels[i++] = static_cast<unsigned char>(std::min(255, std::max(0, v)));
+            }
+        }
+    }
+    return pixels;
+}
+
+bool describe(CorpusImage& image) {
+    image.fileBytes = static_cast<size_t>(fs::file_size(image.path));
+    unsigned char* data = stbi_load(image.path.c_str(), &image.width, &image.height, &image.channels, 0);
+    if (!data) {
+        return false;
+    }
+    image.pixels = std::make_shared<std::vector<unsigned char>>(
+        data, data + static_cast<size_t>(image.width) * image.height * image.channels);
+    stbi_image_free(data);
+    return true;
+}
+
+std::vector<CorpusImage> buildCorpus(const std::string& extraDir) {
+    struct Spec { int width; int height; int channels; const char* format; };
+    const Spec specs[] = {
+        {640, 480, 3, "jpg"},  {640, 480, 3, "png"},
+        {1280, 720, 4, "png"}, {1920, 1080, 3, "jpg"}, {1920, 1080, 3, "png"},
+        {4032, 3024, 3, "jpg"},
+    };
+
+    std::vector<CorpusImage> corpus;
+    for (const Spec& spec : specs) {
+        CorpusImage image;
+        image.name = std::string(spec.channels == 4 ? "rgba_" : "rgb_") + std::to_string(spec.width) + "x" +
+                     std::to_string(spec.height) + "." + spec.format;
+        image.path = (workDir / "corpus" / image.name).string();
+
+        std::vector<unsigned char> pixels = syntheticPixels(spec.width, spec.height, spec.channels);
+        int ok = std::strcmp(spec.format, "png") == 0
+            ? stbi_write_png(image.path.c_str(), spec.width, spec.height, spec.channels, pixels.data(),
+                             spec.width * spec.channels)
+            : stbi_write_jpg(image.path.c_str(), spec.width, spec.height, spec.channels, pixels.data(), 90);
+        if (ok && describe(image)) {
+            corpus.push_back(image);
+        }
+    }
+
+    if (!extraDir.empty()) {
+        for (const auto& entry : fs::directory_iterator(extraDir)) {
+            if (!entry.is_regular_file() || !ImageProcessor::validateFormat(entry.path().string())) {
+                continue;
+            }
+            CorpusImage image;
+            image.name = entry.path().filename().string();
+            image.path = entry.path().string();
+            if (describe(image)) {
+                corpus.push_back(image);
+            }
+        }
+    }
+    return corpus;
+}
+
+void setImageCounters(benchmark::State& state, const CorpusImage& image, size_t bytesPerIteration) {
+    double pixels = static_cast<double>(image.width) * image.height;
+    state.counters["MP/s"] = benchmark::Counter(pixels * state.iterations() / 1e6, benchmark::Counter::kIsRate);
+    state.SetBytesProcessed(static_cast<int64_t>(bytesPerIteration * state.iterations()));
+}
+
+void BM_ProcessImage(benchmark::State& state, const CorpusImage& image) {
+    std::string outputDir = (workDir / "images").string() + "/";
+    std::string thumbnailDir = (workDir / "thumbnails").string() + "/";
+    for (auto _ : state) {
+        ProcessResult result = ImageProcessor::processImage(image.path, outputDir, thumbnailDir, "bench");
+        if (!result.success) {
+            state.SkipWithError(result.message.c_str());
+            break;
+        }
+    }
+    setImageCounters(state, image, image.fileBytes);
+}
+
+void BM_GenerateThumbnail(benchmark::State& state, const CorpusImage& image) {
+    std::string outputPath = (workDir / "thumbnails" / "bench_thumb.jpg").string();
+    for (auto _ : state) {
+        if (!ImageProcessor::generateThumbnail(image.pixels->data(), image.width, image.height, image.channels,
+                                               outputPath)) {
+            state.SkipWithError("generateThumbnail failed");
+            break;
+        }
+    }
+    setImageCounters(state, image, image.pixels->size());
+}
+
+void BM_ProcessAvatar(benchmark::State& state, const CorpusImage& image) {
+    std::string outputDir = (workDir / "avatars").string() + "/";
+    for (auto _ : state) {
+        AvatarProcessResult result = AvatarProcessor::processAvatar(image.path, "USR_bench", outputDir);
+        if (!result.success) {
+            state.SkipWithError(result.message.c_str());
+            break;
+        }
+    }
+    setImageCounters(state, image, image.fileBytes);
+}
+
+void BM_Decode(benchmark::State& state, const CorpusImage& image) {
+    for (auto _ : state) {
+        int width, height, channels;
+        unsigned char* pixels = stbi_load(image.path.c_str(), &width, &height, &channels, 0);
+        benchmark::DoNotOptimize(pixels);
+        stbi_image_free(pixels);
+    }
+    setImageCounters(state, image, image.fileBytes);
+}
+
+void BM_EncodeJpeg(benchmark::State& state, const CorpusImage& image) {
+    std::string outputPath = (workDir / "images" / "bench_encode.jpg").string();
+    for (auto _ : state) {
+        if (!stbi_write_jpg(outputPath.c_str(), image.width, image.height, image.channels, image.pixels->data(),
+                            80)) {
+            state.SkipWithError("stbi_write_jpg failed");
+            break;
+        }
+    }
+    setImageCounters(state, image, image.pixels->size());
+}
+
+void BM_Base64Decode(benchmark::State& state) {
+    std::string raw(static_cast<size_t>(state.range(0)), '\0');
+    std::mt19937 rng(42);
+    for (char& c : raw) {
+        c = static_cast<char>(rng());
+    }
+    std::string encoded = Base64Decoder::encode(raw);
+    for (auto _ : state) {
+        std::string decoded = Base64Decoder::decode(encoded);
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(encoded.size() * state.iterations()));
+}
+
+BENCHMARK(BM_Base64Decode)->Arg(64 << 10)->Arg(1 << 20)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief 控制台报告：把 MemoryManager 的结果作为计数器显示，并记录每项的单次迭代耗时（纳秒）用于与基线比较
+ *
+ * 内存统计是在计时结束后单独再跑一轮得到的，不影响耗时。
+ */
+class GateReporter : public benchmark::ConsoleReporter {
+public:
+    void ReportRuns(const std::vector<Run>& runs) override {
+        std::vector<Run> withMemory = runs;
+        for (Run& run : withMemory) {
+            if (run.memory_result) {
+                run.counters["peak_MB"] = static_cast<double>(run.memory_result->max_bytes_used) / (1 << 20);
+                run.counters["allocs/iter"] = run.allocs_per_iter;
+            }
+        }
+        ConsoleReporter::ReportRuns(withMemory);
+        for (const Run& run : runs) {
+            if (!run.error_occurred && run.run_type == Run::RT_Iteration) {
+                realTimeNanos[run.benchmark_name()] =
+                    run.GetAdjustedRealTime() * toNanos(run.time_unit);
+            }
+        }
+    }
+
+    static double toNanos(benchmark::TimeUnit unit) {
+        switch (unit) {
+            case benchmark::kSecond: return 1e9;
+            case benchmark::kMillisecond: return 1e6;
+            case benchmark::kMicrosecond: return 1e3;
+            default: return 1.0;
+        }
+    }
+
+    std::map<std::string, double> realTimeNanos;
+};
+
+benchmark::TimeUnit parseUnit(const std::string& unit) {
+    if (unit == "s") return benchmark::kSecond;
+    if (unit == "ms") return benchmark::kMillisecond;
+    if (unit == "us") return benchmark::kMicrosecond;
+    return benchmark::kNanosecond;
+}
+
+/**
+ * @brief 与 --benchmark_out 写出的基线比较
+ * @return 没有超过阈值的回归返回true
+ */
+bool checkBaseline(const std::string& path, double maxRegressionPercent, const GateReporter& reporter) {
+    std::ifstream file(path);
+    Json::Value baseline;
+    Json::CharReaderBuilder reader;
+    std::string errors;
+    if (!file || !Json::parseFromStream(reader, file, &baseline, &errors)) {
+        std::cerr << "Cannot read baseline " << path << ": " << errors << std::endl;
+        return false;
+    }
+
+    bool passed = true;
+    std::printf("\nBaseline comparison (max regression %.1f%%):\n", maxRegressionPercent);
+    for (const auto& entry : baseline["benchmarks"]) {
+        if (entry.get("run_type", "iteration").asString() != "iteration" || entry["error_occurred"].asBool()) {
+            continue;
+        }
+        auto it = reporter.realTimeNanos.find(entry["name"].asString());
+        if (it == reporter.realTimeNanos.end()) {
+            continue;
+        }
+        double base = entry["real_time"].asDouble() *
+                      GateReporter::toNanos(parseUnit(entry.get("time_unit", "ns").asString()));
+        double change = base > 0 ? (it->second / base - 1.0) * 100.0 : 0.0;
+        bool regressed = change > maxRegressionPercent;
+        passed &= !regressed;
+        std::printf("  %-48s %+7.1f%%%s\n", it->first.c_str(), change, regressed ? "  REGRESSION" : "");
+    }
+    return passed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    std::string corpusDir;
+    std::string baselinePath;
+    double maxRegression = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--corpus=", 0) == 0) {
+            corpusDir = arg.substr(9);
+        } else if (arg.rfind("--baseline=", 0) == 0) {
+            baselinePath = arg.substr(11);
+        } else if (arg.rfind("--max_regression=", 0) == 0) {
+            maxRegression = std::stod(arg.substr(17));
+        } else {
+            std::cerr << "Unknown argument " << arg << "\n"
+                      << "Extra options: --corpus=DIR --baseline=FILE --max_regression=PERCENT" << std::endl;
+            return 1;
+        }
+    }
+
+    workDir = fs::temp_directory_path() / ("knot_image_bench_" + std::to_string(::getpid()));
+    for (const char* dir : {"corpus", "images", "thumbnails", "avatars"}) {
+        fs::create_directories(workDir / dir);
+    }
+
+    std::vector<CorpusImage> corpus = buildCorpus(corpusDir);
+    for (const CorpusImage& image : corpus) {
+        benchmark::RegisterBenchmark(("ProcessImage/" + image.name).c_str(), BM_ProcessImage, image)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("GenerateThumbnail/" + image.name).c_str(), BM_GenerateThumbnail, image)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("ProcessAvatar/" + image.name).c_str(), BM_ProcessAvatar, image)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("Decode/" + image.name).c_str(), BM_Decode, image)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("EncodeJpeg/" + image.name).c_str(), BM_EncodeJpeg, image)
+            ->Unit(benchmark::kMillisecond);
+    }
+
+    MallocTracker tracker;
+    benchmark::RegisterMemoryManager(&tracker);
+
+    GateReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::RegisterMemoryManager(nullptr);
+    benchmark::Shutdown();
+
+    std::error_code ec;
+    fs::remove_all(workDir, ec);
+
+    if (!baselinePath.empty() && !checkBaseline(baselinePath, maxRegression, reporter)) {
+        return 2;
+    }
+    return 0;
+}
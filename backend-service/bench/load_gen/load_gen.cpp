@@ -0,0 +1,480 @@
+/**
+ * @file load_gen.cpp
+ * @brief API 压测工具：多线程 HTTP 负载生成 + 场景脚本 + 延迟分位数（含 coordinated omission 修正）
+ * @author Knot Team
+ * @date 2026-10-18
+ *
+ * 用法：
+ *   knot_load_gen --url http://127.0.0.1:8080 --username bench --password bench123 \
+ *                 --scenario all --threads 8 --duration 30 --rate 400 --output result.json
+ *
+ * --rate > 0 为开环压测：每个线程按固定间隔计划发送时间，延迟从计划时间算起
+ * （服务变慢时请求排队的时间也计入，即 wrk2 的做法）；--rate 0 为闭环压测，
+ * 用 HdrHistogram 的方式按期望间隔补齐样本。两种模式都同时输出未修正的服务时间。
+ *
+ * --baseline 指定上一次 --output 的结果文件时，逐项打印变化百分比，用于性能改动前后对比。
+ */
+
+#include "httplib.h"
+#include "common/latency_recorder.h"
+#include "common/report.h"
+#include <json/json.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 命令行选项
+ */
+struct Options {
+    std::string url = "http://127.0.0.1:8080";
+    std::string scenario = "all";
+    int threads = 8;
+    int durationSeconds = 30;
+    int warmupSeconds = 5;
+    double rate = 0.0;                  // 总请求速率（req/s），0 为闭环
+    uint64_t expectedIntervalMicros = 0; // 闭环修正用的期望间隔，0 取服务时间中位数
+    std::string username;
+    std::string password;
+    std::string userId;                 // follow_list 查询的用户，默认为登录用户
+    std::vector<std::string> images = {"test/pictures/test_square_200x200.png",
+                                       "test/pictures/test_rect_400x300.png"};
+    std::string output;
+    std::string baseline;
+};
+
+/**
+ * @brief 所有场景共享的只读数据（压测开始前准备好）
+ */
+struct SharedData {
+    std::string token;
+    std::string userId;
+    std::vector<std::string> postIds;
+    httplib::UploadFormDataItems imageItems;
+};
+
+/**
+ * @brief 单个压测线程的状态
+ */
+struct WorkerState {
+    int threadIndex = 0;
+    int threads = 1;
+    uint64_t iteration = 0;
+};
+
+/**
+ * @brief 压测场景
+ */
+struct Scenario {
+    std::string name;
+    bool needsAuth;
+    std::function<httplib::Result(httplib::Client&, const SharedData&, WorkerState&)> request;
+};
+
+/**
+ * @brief 单个线程的压测结果
+ */
+struct WorkerResult {
+    LatencyRecorder corrected;      // 从计划发送时间算起（开环）
+    LatencyRecorder service;        // 从实际发送时间算起
+    uint64_t success = 0;           // 2xx
+    uint64_t httpErrors = 0;        // 非 2xx
+    uint64_t transportErrors = 0;   // 连接失败、超时等
+    uint64_t bytes = 0;
+};
+
+/**
+ * @brief 一个场景的汇总结果
+ */
+struct ScenarioReport {
+    std::string name;
+    double seconds = 0.0;
+    uint64_t requests = 0;
+    uint64_t httpErrors = 0;
+    uint64_t transportErrors = 0;
+    uint64_t bytes = 0;
+    LatencyRecorder corrected;
+    LatencyRecorder service;
+};
+
+httplib::Headers authHeaders(const SharedData& data) {
+    return {{"Authorization", "Bearer " + data.token}};
+}
+
+std::string feedPath(const WorkerState& state) {
+    return "/api/v1/posts?page=" + std::to_string(1 + state.iteration % 5) + "&page_size=20";
+}
+
+std::vector<Scenario> buildScenarios() {
+    return {
+        {"guest_feed", false,
+         [](httplib::Client& client, const SharedData&, WorkerState& state) {
+             return client.Get(feedPath(state));
+         }},
+        {"auth_feed", true,
+         [](httplib::Client& client, const SharedData& data, WorkerState& state) {
+             return client.Get(feedPath(state), authHeaders(data));
+         }},
+        // 每个帖子先点赞再取消，线程之间按下标错开帖子
+        {"like_toggle", true,
+         [](httplib::Client& client, const SharedData& data, WorkerState& state) {
+             size_t index = (static_cast<size_t>(state.threadIndex) +
+                             static_cast<size_t>(state.iteration / 2) * static_cast<size_t>(state.threads)) %
+                            data.postIds.size();
+             std::string path = "/api/v1/posts/" + data.postIds[index] + "/like";
+             return state.iteration % 2 == 0 ? client.Post(path, authHeaders(data))
+                                             : client.Delete(path, authHeaders(data));
+         }},
+        // 会真实创建帖子，只应在压测库上运行
+        {"post_create", true,
+         [](httplib::Client& client, const SharedData& data, WorkerState& state) {
+             httplib::UploadFormDataItems items = data.imageItems;
+             items.push_back({"title", "bench-" + std::to_string(state.threadIndex) + "-" +
+                                           std::to_string(state.iteration), "", ""});
+             items.push_back({"description", "load_gen post_create scenario", "", ""});
+             items.push_back({"tags", "[\"bench\"]", "", ""});
+             return client.Post("/api/v1/posts", authHeaders(data), items);
+         }},
+        {"follow_list", true,
+         [](httplib::Client& client, const SharedData& data, WorkerState& state) {
+             return client.Get("/api/v1/users/" + data.userId + "/following?page=" +
+                               std::to_string(1 + state.iteration % 3) + "&page_size=20",
+                               authHeaders(data));
+         }},
+    };
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: knot_load_gen [options]\n"
+        "  --url URL                 server base URL (default http://127.0.0.1:8080)\n"
+        "  --scenario NAME           guest_feed|auth_feed|like_toggle|post_create|follow_list|all (default all)\n"
+        "  --threads N               worker threads, one keep-alive connection each (default 8)\n"
+        "  --duration S              measured seconds per scenario (default 30)\n"
+        "  --warmup S                unmeasured warmup seconds per scenario (default 5)\n"
+        "  --rate R                  total requests/s, open loop; 0 = closed loop (default 0)\n"
+        "  --expected-interval-us U  closed-loop correction interval (default: median service time)\n"
+        "  --username U --password P account for authenticated scenarios\n"
+        "  --user-id ID              user whose following list is read (default: logged-in user)\n"
+        "  --image PATH              image for post_create, repeatable (default two files in test/pictures)\n"
+        "  --output FILE             write results as JSON\n"
+        "  --baseline FILE           compare with a previous --output file\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    bool imagesGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--url") options.url = value;
+            else if (arg == "--scenario") options.scenario = value;
+            else if (arg == "--threads") options.threads = std::max(1, std::stoi(value));
+            else if (arg == "--duration") options.durationSeconds = std::max(1, std::stoi(value));
+            else if (arg == "--warmup") options.warmupSeconds = std::max(0, std::stoi(value));
+            else if (arg == "--rate") options.rate = std::max(0.0, std::stod(value));
+            else if (arg == "--expected-interval-us") options.expectedIntervalMicros = std::stoull(value);
+            else if (arg == "--username") options.username = value;
+            else if (arg == "--password") options.password = value;
+            else if (arg == "--user-id") options.userId = value;
+            else if (arg == "--image") {
+                if (!imagesGiven) {
+                    options.images.clear();
+                    imagesGiven = true;
+                }
+                options.images.push_back(value);
+            }
+            else if (arg == "--output") options.output = value;
+            else if (arg == "--baseline") options.baseline = value;
+            else {
+                std::cerr << "Unknown option " << arg << std::endl;
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseJson(const std::string& text, Json::Value& out) {
+    Json::CharReaderBuilder reader;
+    std::istringstream stream(text);
+    std::string errors;
+    return Json::parseFromStream(reader, stream, &out, &errors);
+}
+
+std::unique_ptr<httplib::Client> makeClient(const Options& options) {
+    auto client = std::make_unique<httplib::Client>(options.url);
+    client->set_keep_alive(true);
+    client->set_tcp_nodelay(true);
+    client->set_connection_timeout(5);
+    client->set_read_timeout(30);
+    client->set_write_timeout(30);
+    return client;
+}
+
+/**
+ * @brief 登录并准备场景需要的数据（token、用户ID、帖子ID、图片）
+ */
+bool prepare(const Options& options, bool needsAuth, SharedData& data) {
+    auto client = makeClient(options);
+
+    if (needsAuth) {
+        if (options.username.empty()) {
+            std::cerr << "Authenticated scenarios need --username and --password" << std::endl;
+            return false;
+        }
+        Json::Value body;
+        body["username"] = options.username;
+        body["password"] = options.password;
+        auto res = client->Post("/api/v1/auth/login", Json::writeString(Json::StreamWriterBuilder(), body),
+                                "application/json");
+        Json::Value json;
+        if (!res || res->status != 200 || !parseJson(res->body, json) || !json["data"]["access_token"].isString()) {
+            std::cerr << "Login failed: " << (res ? std::to_string(res->status) + " " + res->body
+                                                   : httplib::to_string(res.error())) << std::endl;
+            return false;
+        }
+        data.token = json["data"]["access_token"].asString();
+        data.userId = options.userId.empty() ? json["data"]["user"]["user_id"].asString() : options.userId;
+    }
+
+    auto res = client->Get("/api/v1/posts?page=1&page_size=50");
+    Json::Value json;
+    if (res && res->status == 200 && parseJson(res->body, json)) {
+        for (const auto& post : json["data"]["posts"]) {
+            data.postIds.push_back(post["post_id"].asString());
+        }
+    }
+
+    for (const auto& path : options.images) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Cannot read image " << path << std::endl;
+            return false;
+        }
+        std::ostringstream content;
+        content << file.rdbuf();
+        std::string filename = path.substr(path.find_last_of('/') + 1);
+        std::string ext = filename.substr(filename.find_last_of('.') + 1);
+        std::string type = ext == "png" ? "image/png" : ext == "webp" ? "image/webp" : "image/jpeg";
+        data.imageItems.push_back({"imageFiles", content.str(), filename, type});
+    }
+    return true;
+}
+
+void runWorker(const Options& options, const Scenario& scenario, const SharedData& data, int threadIndex,
+               Clock::time_point start, Clock::time_point measureStart, Clock::time_point end,
+               WorkerResult& result) {
+    auto client = makeClient(options);
+    WorkerState state;
+    state.threadIndex = threadIndex;
+    state.threads = options.threads;
+
+    // 开环：每个线程按 threads/rate 的间隔计划发送时间，线程之间错开
+    Clock::duration interval{};
+    Clock::time_point next = start;
+    if (options.rate > 0) {
+        interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.threads / options.rate));
+        next += interval * threadIndex / options.threads;
+    }
+
+    while (true) {
+        Clock::time_point intended;
+        if (options.rate > 0) {
+            intended = next;
+            next += interval;
+            if (intended >= end) {
+                break;
+            }
+            std::this_thread::sleep_until(intended);
+        }
+        // 服务跟不上计划速率时，到点即停止，不再补发积压的请求
+        Clock::time_point sent = Clock::now();
+        if (sent >= end) {
+            break;
+        }
+        if (options.rate <= 0) {
+            intended = sent;
+        }
+
+        httplib::Result res = scenario.request(*client, data, state);
+        Clock::time_point done = Clock::now();
+        state.iteration++;
+
+        if (intended < measureStart) {
+            continue;
+        }
+        result.corrected.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(done - intended).count()));
+        result.service.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(done - sent).count()));
+        if (!res) {
+            result.transportErrors++;
+        } else if (res->status >= 200 && res->status < 300) {
+            result.success++;
+            result.bytes += res->body.size();
+        } else {
+            result.httpErrors++;
+        }
+    }
+}
+
+ScenarioReport runScenario(const Options& options, const Scenario& scenario, const SharedData& data) {
+    std::vector<WorkerResult> results(static_cast<size_t>(options.threads));
+    std::vector<std::thread> workers;
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point measureStart = start + std::chrono::seconds(options.warmupSeconds);
+    Clock::time_point end = measureStart + std::chrono::seconds(options.durationSeconds);
+    for (int i = 0; i < options.threads; ++i) {
+        workers.emplace_back(runWorker, std::cref(options), std::cref(scenario), std::cref(data), i,
+                             start, measureStart, end, std::ref(results[static_cast<size_t>(i)]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    ScenarioReport report;
+    report.name = scenario.name;
+    report.seconds = std::chrono::duration<double>(std::max(Clock::now(), end) - measureStart).count();
+    for (const auto& result : results) {
+        report.requests += result.success + result.httpErrors + result.transportErrors;
+        report.httpErrors += result.httpErrors;
+        report.transportErrors += result.transportErrors;
+        report.bytes += result.bytes;
+        report.corrected.merge(result.corrected);
+        report.service.merge(result.service);
+    }
+
+    // 闭环：按服务时间补齐因等待响应而没有发出的请求
+    if (options.rate <= 0) {
+        uint64_t expected = options.expectedIntervalMicros > 0 ? options.expectedIntervalMicros
+                                                               : report.service.percentile(0.5);
+        report.corrected = report.service.correctedForCoordinatedOmission(expected);
+    }
+    return report;
+}
+
+Json::Value reportJson(ScenarioReport& report) {
+    Json::Value json;
+    json["requests"] = static_cast<Json::UInt64>(report.requests);
+    json["http_errors"] = static_cast<Json::UInt64>(report.httpErrors);
+    json["transport_errors"] = static_cast<Json::UInt64>(report.transportErrors);
+    json["throughput_rps"] = report.requests / report.seconds;
+    json["bytes_per_second"] = report.bytes / report.seconds;
+    json["latency_ms"] = latencyJson(report.corrected);
+    json["service_time_ms"] = latencyJson(report.service);
+    return json;
+}
+
+void printReport(const Json::Value& json, const std::string& name, const Json::Value& baseline) {
+    const Json::Value& base = baseline["scenarios"][name];
+    std::printf("\n== %s ==\n", name.c_str());
+    std::printf("  requests %llu, errors %llu http / %llu transport, %.1f req/s%s\n",
+                static_cast<unsigned long long>(json["requests"].asUInt64()),
+                static_cast<unsigned long long>(json["http_errors"].asUInt64()),
+                static_cast<unsigned long long>(json["transport_errors"].asUInt64()),
+                json["throughput_rps"].asDouble(),
+                delta(json["throughput_rps"].asDouble(), base["throughput_rps"]).c_str());
+
+    for (const char* series : {"latency_ms", "service_time_ms"}) {
+        std::printf("  %-16s", series);
+        for (const char* key : {"p50", "p90", "p99", "p99.9", "max"}) {
+            double value = json[series][key].asDouble();
+            std::printf(" %s=%.2f%s", key, value, delta(value, base[series][key]).c_str());
+        }
+        std::printf("\n");
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<Scenario> scenarios;
+    for (auto& scenario : buildScenarios()) {
+        if (options.scenario == "all" || options.scenario == scenario.name) {
+            scenarios.push_back(std::move(scenario));
+        }
+    }
+    if (scenarios.empty()) {
+        std::cerr << "Unknown scenario " << options.scenario << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    bool needsAuth = false;
+    for (const auto& scenario : scenarios) {
+        needsAuth |= scenario.needsAuth;
+    }
+    SharedData data;
+    if (!prepare(options, needsAuth, data)) {
+        return 1;
+    }
+
+    Json::Value baseline;
+    if (!options.baseline.empty()) {
+        if (!readJsonFile(options.baseline, baseline)) {
+            std::cerr << "Cannot read baseline " << options.baseline << std::endl;
+            return 1;
+        }
+    }
+
+    char mode[64] = "closed loop";
+    if (options.rate > 0) {
+        std::snprintf(mode, sizeof(mode), "open loop at %g req/s", options.rate);
+    }
+    std::printf("knot_load_gen: %s, %d threads, %s, %ds warmup + %ds per scenario\n", options.url.c_str(),
+                options.threads, mode, options.warmupSeconds, options.durationSeconds);
+
+    Json::Value output;
+    output["url"] = options.url;
+    output["threads"] = options.threads;
+    output["rate"] = options.rate;
+    output["duration_seconds"] = options.durationSeconds;
+    for (const auto& scenario : scenarios) {
+        if (scenario.name == "like_toggle" && data.postIds.empty()) {
+            std::printf("\n== %s ==\n  skipped: no posts returned by GET /api/v1/posts\n", scenario.name.c_str());
+            continue;
+        }
+        ScenarioReport report = runScenario(options, scenario, data);
+        Json::Value json = reportJson(report);
+        printReport(json, scenario.name, baseline);
+        output["scenarios"][scenario.name] = json;
+    }
+
+    if (!options.output.empty()) {
+        if (!writeJsonFile(options.output, output)) {
+            std::cerr << "Cannot write " << options.output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
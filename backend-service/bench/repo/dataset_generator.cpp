@@ -0,0 +1,562 @@
+/**
+ * @file dataset_generator.cpp
+ * @brief 仓储层基准测试的合成数据集生成器实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "repo/dataset_generator.h"
+#include "security/password_hasher.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 各表的随机数种子盐值
+constexpr uint64_t kPostsSalt = 1;
+constexpr uint64_t kLikesSalt = 2;
+constexpr uint64_t kFollowsSalt = 3;
+constexpr uint64_t kSharesSalt = 4;
+constexpr uint64_t kTimeSalt = 5;
+
+constexpr std::time_t kDaySeconds = 86400;
+constexpr uint64_t kProgressRows = 1000000;
+
+std::string formatTime(std::time_t time) {
+    std::tm tm{};
+    gmtime_r(&time, &tm);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+    return buffer;
+}
+
+bool execute(MYSQL* conn, const std::string& sql, const std::string& what) {
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) {
+        std::cerr << what << ": " << mysql_error(conn) << std::endl;
+        return false;
+    }
+    MYSQL_RES* result = mysql_store_result(conn);
+    if (result) {
+        mysql_free_result(result);
+    }
+    return true;
+}
+
+bool queryCount(MYSQL* conn, const std::string& sql, uint64_t& count) {
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) {
+        std::cerr << sql << ": " << mysql_error(conn) << std::endl;
+        return false;
+    }
+    MYSQL_RES* result = mysql_store_result(conn);
+    if (!result) {
+        return false;
+    }
+    MYSQL_ROW row = mysql_fetch_row(result);
+    count = (row && row[0]) ? std::stoull(row[0]) : 0;
+    mysql_free_result(result);
+    return true;
+}
+
+/**
+ * @brief 批量装载一张表：多行 INSERT，或写 TSV 文件后 LOAD DATA LOCAL INFILE
+ */
+class TableLoader {
+public:
+    TableLoader(MYSQL* conn, const DatasetOptions& options, const std::string& table, const std::string& columns)
+        : conn_(conn),
+          infile_(options.loadDataInfile),
+          table_(table),
+          columns_(columns),
+          flushRows_(std::max<size_t>(1, options.loadDataInfile ? options.batchRows * 100 : options.batchRows)),
+          path_(options.tmpDir + "/knot_bench_" + table + ".tsv"),
+          started_(Clock::now()) {
+        resetBuffer();
+    }
+
+    TableLoader& str(const std::string& value) {
+        separator();
+        if (infile_) {
+            for (char c : value) {
+                switch (c) {
+                    case '\t': buffer_ += "\\t"; break;
+                    case '\n': buffer_ += "\\n"; break;
+                    case '\\': buffer_ += "\\\\"; break;
+                    default: buffer_ += c;
+                }
+            }
+        } else {
+            size_t offset = buffer_.size() + 1;
+            buffer_.resize(offset + value.size() * 2 + 1);
+            buffer_[offset - 1] = '\'';
+            unsigned long length = mysql_real_escape_string(conn_, &buffer_[offset], value.data(),
+                                                            static_cast<unsigned long>(value.size()));
+            buffer_.resize(offset + length);
+            buffer_ += '\'';
+        }
+        return *this;
+    }
+
+    TableLoader& num(int64_t value) {
+        separator();
+        buffer_ += std::to_string(value);
+        return *this;
+    }
+
+    TableLoader& null() {
+        separator();
+        buffer_ += infile_ ? "\\N" : "NULL";
+        return *this;
+    }
+
+    bool endRow() {
+        buffer_ += infile_ ? '\n' : ')';
+        fields_ = 0;
+        ++rows_;
+        if (rows_ % kProgressRows == 0) {
+            std::printf("\r  %-10s %12llu rows", table_.c_str(), static_cast<unsigned long long>(rows_));
+            std::fflush(stdout);
+        }
+        return ++pending_ >= flushRows_ ? flush() : true;
+    }
+
+    bool finish() {
+        if (!flush()) {
+            return false;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - started_).count();
+        std::printf("\r  %-10s %12llu rows %8.1fs %10.0f rows/s\n", table_.c_str(),
+                    static_cast<unsigned long long>(rows_), seconds, rows_ / std::max(seconds, 1e-6));
+        return true;
+    }
+
+private:
+    void resetBuffer() {
+        buffer_.clear();
+        if (!infile_) {
+            buffer_ = "INSERT INTO " + table_ + " (" + columns_ + ") VALUES ";
+        }
+        pending_ = 0;
+    }
+
+    void separator() {
+        if (fields_++ > 0) {
+            buffer_ += infile_ ? '\t' : ',';
+        } else if (!infile_) {
+            buffer_ += pending_ == 0 ? "(" : ",(";
+        }
+    }
+
+    bool flush() {
+        if (pending_ == 0) {
+            return true;
+        }
+        bool ok;
+        if (infile_) {
+            {
+                std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+                file.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                if (!file) {
+                    std::cerr << "Cannot write " << path_ << std::endl;
+                    return false;
+                }
+            }
+            ok = execute(conn_,
+                         "LOAD DATA LOCAL INFILE '" + path_ + "' INTO TABLE " + table_ +
+                             " CHARACTER SET utf8mb4 FIELDS TERMINATED BY '\\t' LINES TERMINATED BY '\\n' (" +
+                             columns_ + ")",
+                         table_);
+            std::remove(path_.c_str());
+        } else {
+            ok = execute(conn_, buffer_, table_);
+        }
+        resetBuffer();
+        return ok;
+    }
+
+    MYSQL* conn_;
+    bool infile_;
+    std::string table_;
+    std::string columns_;
+    size_t flushRows_;
+    std::string path_;
+    Clock::time_point started_;
+    std::string buffer_;
+    size_t pending_ = 0;
+    size_t fields_ = 0;
+    uint64_t rows_ = 0;
+};
+
+}  // namespace
+
+std::string syntheticPostId(uint64_t id) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "POST_BENCH_%09llu", static_cast<unsigned long long>(id));
+    return buffer;
+}
+
+DatasetGenerator::DatasetGenerator(const DatasetOptions& options)
+    : options_(options),
+      shape_(options.users, options.posts, options.skew),
+      now_(std::time(nullptr)),
+      start_(now_ - static_cast<std::time_t>(std::max(1, options.days)) * kDaySeconds) {}
+
+bool DatasetGenerator::run(MYSQL* conn) {
+    auto started = Clock::now();
+    for (const char* sql : {"SET time_zone = '+00:00'", "SET unique_checks = 0", "SET foreign_key_checks = 0"}) {
+        if (!execute(conn, sql, "session setup")) {
+            return false;
+        }
+    }
+    if (!prepareTables(conn)) {
+        return false;
+    }
+
+    std::printf("Planning %llu users, %llu posts, %llu likes, %llu follows, %llu shares (skew %.2f, seed %llu)\n",
+                static_cast<unsigned long long>(options_.users), static_cast<unsigned long long>(options_.posts),
+                static_cast<unsigned long long>(options_.likes), static_cast<unsigned long long>(options_.follows),
+                static_cast<unsigned long long>(options_.shares), options_.skew,
+                static_cast<unsigned long long>(options_.seed));
+    plan();
+    std::printf("Loading with %s\n", options_.loadDataInfile ? "LOAD DATA LOCAL INFILE" : "multi-row INSERT");
+
+    bool ok = loadUsers(conn) && loadPosts(conn) && loadImages(conn) && loadLikes(conn) && loadFollows(conn) &&
+              loadShares(conn) && loadUserStats(conn);
+
+    execute(conn, "SET unique_checks = 1", "session setup");
+    execute(conn, "SET foreign_key_checks = 1", "session setup");
+    if (!ok) {
+        return false;
+    }
+
+    // 刷新索引统计，否则优化器按装载前的空表估算
+    if (!execute(conn, "ANALYZE TABLE users, posts, images, likes, follows, shares, user_stats", "analyze")) {
+        return false;
+    }
+    std::printf("Dataset ready in %.1fs\n", std::chrono::duration<double>(Clock::now() - started).count());
+    return true;
+}
+
+bool DatasetGenerator::prepareTables(MYSQL* conn) {
+    for (const char* table : {"users", "posts", "images", "likes", "follows", "shares", "user_stats"}) {
+        if (!execute(conn, std::string("SELECT 1 FROM ") + table + " LIMIT 0", table)) {
+            std::cerr << "Apply config/database.sql and the config/migration_*.sql scripts first" << std::endl;
+            return false;
+        }
+    }
+
+    if (options_.truncate) {
+        // 包括引用 users/posts 的其他表，避免留下悬空外键
+        for (const char* table : {"feed_inbox", "shares", "follows", "favorites", "likes", "comments", "image_tags",
+                                  "images", "user_stats", "posts", "users"}) {
+            std::string sql = std::string("TRUNCATE TABLE ") + table;
+            if (mysql_real_query(conn, sql.data(), sql.size()) != 0 && mysql_errno(conn) != 1146) {
+                std::cerr << sql << ": " << mysql_error(conn) << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint64_t users = 0;
+    uint64_t posts = 0;
+    if (!queryCount(conn, "SELECT COUNT(*) FROM users", users) ||
+        !queryCount(conn, "SELECT COUNT(*) FROM posts", posts)) {
+        return false;
+    }
+    if (users > 0 || posts > 0) {
+        std::cerr << "users/posts are not empty; use a dedicated database and pass --truncate" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void DatasetGenerator::plan() {
+    const uint64_t users = options_.users;
+    const uint64_t posts = options_.posts;
+
+    postAuthor_.assign(posts + 1, 0);
+    imageCount_.assign(posts + 1, 0);
+    userPosts_.assign(users + 1, 0);
+    std::mt19937_64 rng(hash(kPostsSalt, 0, 0));
+    std::uniform_int_distribution<int> images(1, std::max(1, std::min(options_.maxImagesPerPost, 9)));
+    for (uint64_t post = 1; post <= posts; ++post) {
+        auto author = static_cast<uint32_t>(shape_.activeUser(rng));
+        postAuthor_[post] = author;
+        userPosts_[author]++;
+        imageCount_[post] = static_cast<uint8_t>(images(rng));
+    }
+
+    likeActivity_ = distributeActivity(options_.likes, options_.maxLikesPerUser, kLikesSalt);
+    followActivity_ = distributeActivity(options_.follows, options_.maxFollowsPerUser, kFollowsSalt);
+    shareActivity_ = distributeActivity(options_.shares, options_.maxSharesPerUser, kSharesSalt);
+
+    // 第一遍：只统计冗余计数
+    postLikes_.assign(posts + 1, 0);
+    uint64_t likes = 0;
+    forEachEdge(
+        likeActivity_, kLikesSalt, posts,
+        [this](std::mt19937_64& r, uint64_t actor, bool uniform) { return drawLikeTarget(r, actor, uniform); },
+        [this, &likes](uint64_t, uint64_t post) {
+            postLikes_[post]++;
+            likes++;
+            return true;
+        });
+
+    userFollowers_.assign(users + 1, 0);
+    userFollowing_.assign(users + 1, 0);
+    uint64_t follows = 0;
+    forEachEdge(
+        followActivity_, kFollowsSalt, users > 0 ? users - 1 : 0,
+        [this](std::mt19937_64& r, uint64_t actor, bool uniform) { return drawFollowTarget(r, actor, uniform); },
+        [this, &follows](uint64_t follower, uint64_t followee) {
+            userFollowing_[follower]++;
+            userFollowers_[followee]++;
+            follows++;
+            return true;
+        });
+
+    uint32_t hottestPost = *std::max_element(postLikes_.begin(), postLikes_.end());
+    uint32_t hottestUser = *std::max_element(userFollowers_.begin(), userFollowers_.end());
+    std::printf("  planned %llu likes (hottest post %u), %llu follows (most followed user %u)\n",
+                static_cast<unsigned long long>(likes), hottestPost, static_cast<unsigned long long>(follows),
+                hottestUser);
+}
+
+std::vector<uint32_t> DatasetGenerator::distributeActivity(uint64_t total, uint32_t cap, uint64_t salt) const {
+    std::vector<uint32_t> counts(options_.users + 1, 0);
+    uint64_t capacity = options_.users * cap;
+    if (total > capacity) {
+        std::printf("  warning: %llu rows exceed %llu users x %u per user, capped\n",
+                    static_cast<unsigned long long>(total), static_cast<unsigned long long>(options_.users), cap);
+        total = capacity;
+    }
+
+    std::mt19937_64 rng(hash(salt, 0, 0));
+    std::uniform_int_distribution<uint64_t> uniform(1, std::max<uint64_t>(1, options_.users));
+    for (uint64_t i = 0; i < total; ++i) {
+        // 头部用户达到上限后改为均匀抽取，避免在高偏斜时反复落到已满的用户上
+        for (int attempt = 0;; ++attempt) {
+            uint64_t user = attempt < 64 ? shape_.activeUser(rng) : uniform(rng);
+            if (counts[user] < cap) {
+                counts[user]++;
+                break;
+            }
+        }
+    }
+    return counts;
+}
+
+template <typename Draw, typename Visit>
+bool DatasetGenerator::forEachEdge(const std::vector<uint32_t>& activity, uint64_t salt, uint64_t targetSpace,
+                                   Draw draw, Visit visit) const {
+    for (uint64_t actor = 1; actor < activity.size(); ++actor) {
+        uint64_t want = std::min<uint64_t>(activity[actor], targetSpace);
+        if (want == 0) {
+            continue;
+        }
+        std::mt19937_64 rng(hash(salt, actor, 0));
+        std::unordered_set<uint64_t> seen;
+        seen.reserve(want);
+        const uint64_t skewedAttempts = want * 4 + 16;
+        const uint64_t maxAttempts = want * 64 + 256;
+        for (uint64_t attempt = 0; seen.size() < want && attempt < maxAttempts; ++attempt) {
+            uint64_t target = draw(rng, actor, attempt >= skewedAttempts);
+            if (target != 0 && seen.insert(target).second && !visit(actor, target)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint64_t DatasetGenerator::drawLikeTarget(std::mt19937_64& rng, uint64_t, bool uniform) const {
+    if (uniform) {
+        return std::uniform_int_distribution<uint64_t>(1, options_.posts)(rng);
+    }
+    return shape_.popularPost(rng);
+}
+
+uint64_t DatasetGenerator::drawFollowTarget(std::mt19937_64& rng, uint64_t actor, bool uniform) const {
+    uint64_t followee = uniform ? std::uniform_int_distribution<uint64_t>(1, options_.users)(rng)
+                                : shape_.popularUser(rng);
+    return followee == actor ? 0 : followee;
+}
+
+uint64_t DatasetGenerator::drawShareTarget(std::mt19937_64& rng, uint64_t actor, bool uniform) const {
+    uint64_t receiver = drawFollowTarget(rng, actor, uniform);
+    uint64_t post = drawLikeTarget(rng, actor, uniform);
+    return receiver == 0 ? 0 : receiver * (options_.posts + 1) + post;
+}
+
+bool DatasetGenerator::loadUsers(MYSQL* conn) {
+    std::string salt = PasswordHasher::generateSalt();
+    std::string password = PasswordHasher::hashPassword(options_.password, salt);
+    TableLoader table(conn, options_, "users",
+                      "id, user_id, username, password, salt, real_name, phone, email, bio, "
+                      "following_count, follower_count, create_time, update_time");
+    char userId[32], username[32], realName[32], phone[32], email[48];
+    for (uint64_t user = 1; user <= options_.users; ++user) {
+        auto id = static_cast<unsigned long long>(user);
+        std::snprintf(userId, sizeof(userId), "USR_BENCH_%08llu", id);
+        std::snprintf(username, sizeof(username), "bench_%07llu", id);
+        std::snprintf(realName, sizeof(realName), "Bench User %llu", id);
+        std::snprintf(phone, sizeof(phone), "199%08llu", id);
+        std::snprintf(email, sizeof(email), "bench_%llu@example.com", id);
+        std::string created = formatTime(start_ - 30 * kDaySeconds +
+                                         static_cast<std::time_t>(hash(kTimeSalt, user, 1) % (30 * kDaySeconds)));
+        table.num(static_cast<int64_t>(user)).str(userId).str(username).str(password).str(salt).str(realName)
+            .str(phone).str(email).str("synthetic user")
+            .num(userFollowing_[user]).num(userFollowers_[user]).str(created).str(created);
+        if (!table.endRow()) {
+            return false;
+        }
+    }
+    return table.finish();
+}
+
+bool DatasetGenerator::loadPosts(MYSQL* conn) {
+    TableLoader table(conn, options_, "posts",
+                      "id, post_id, user_id, title, description, image_count, like_count, favorite_count, "
+                      "comment_count, view_count, status, create_time, update_time");
+    char title[48], description[96];
+    for (uint64_t post = 1; post <= options_.posts; ++post) {
+        auto id = static_cast<unsigned long long>(post);
+        std::snprintf(title, sizeof(title), "Synthetic post %llu", id);
+        std::snprintf(description, sizeof(description), "Generated by knot_repo_bench for user %u, post %llu",
+                      postAuthor_[post], id);
+        std::string created = formatTime(postTime(post));
+        table.num(static_cast<int64_t>(post)).str(syntheticPostId(post)).num(postAuthor_[post]).str(title)
+            .str(description).num(imageCount_[post]).num(postLikes_[post]).num(0).num(0)
+            .num(static_cast<int64_t>(postLikes_[post]) * 8 + static_cast<int64_t>(hash(kTimeSalt, post, 2) % 200))
+            .str("APPROVED").str(created).str(created);
+        if (!table.endRow()) {
+            return false;
+        }
+    }
+    return table.finish();
+}
+
+bool DatasetGenerator::loadImages(MYSQL* conn) {
+    TableLoader table(conn, options_, "images",
+                      "image_id, user_id, post_id, display_order, file_url, thumbnail_url, file_size, "
+                      "width, height, mime_type, create_time, update_time");
+    char imageId[40], fileUrl[80], thumbnailUrl[80];
+    for (uint64_t post = 1; post <= options_.posts; ++post) {
+        std::string created = formatTime(postTime(post));
+        for (int order = 0; order < imageCount_[post]; ++order) {
+            auto id = static_cast<unsigned long long>(post);
+            std::snprintf(imageId, sizeof(imageId), "IMG_BENCH_%09llu_%d", id, order);
+            std::snprintf(fileUrl, sizeof(fileUrl), "/uploads/images/bench_%09llu_%d.jpg", id, order);
+            std::snprintf(thumbnailUrl, sizeof(thumbnailUrl), "/uploads/thumbnails/bench_%09llu_%d.jpg", id, order);
+            uint64_t h = hash(kTimeSalt, post, 3 + static_cast<uint64_t>(order));
+            table.str(imageId).num(postAuthor_[post]).num(static_cast<int64_t>(post)).num(order).str(fileUrl)
+                .str(thumbnailUrl).num(150000 + static_cast<int64_t>(h % 850000)).num(1080)
+                .num(h % 2 == 0 ? 1080 : 1350).str("image/jpeg").str(created).str(created);
+            if (!table.endRow()) {
+                return false;
+            }
+        }
+    }
+    return table.finish();
+}
+
+bool DatasetGenerator::loadLikes(MYSQL* conn) {
+    TableLoader table(conn, options_, "likes", "user_id, post_id, create_time");
+    bool ok = forEachEdge(
+        likeActivity_, kLikesSalt, options_.posts,
+        [this](std::mt19937_64& r, uint64_t actor, bool uniform) { return drawLikeTarget(r, actor, uniform); },
+        [this, &table](uint64_t user, uint64_t post) {
+            std::time_t created = postTime(post);
+            created += static_cast<std::time_t>(hash(kLikesSalt, user, post) %
+                                                static_cast<uint64_t>(now_ - created + 1));
+            table.num(static_cast<int64_t>(user)).num(static_cast<int64_t>(post)).str(formatTime(created));
+            return table.endRow();
+        });
+    return ok && table.finish();
+}
+
+bool DatasetGenerator::loadFollows(MYSQL* conn) {
+    TableLoader table(conn, options_, "follows", "follower_id, followee_id, create_time");
+    bool ok = forEachEdge(
+        followActivity_, kFollowsSalt, options_.users > 0 ? options_.users - 1 : 0,
+        [this](std::mt19937_64& r, uint64_t actor, bool uniform) { return drawFollowTarget(r, actor, uniform); },
+        [this, &table](uint64_t follower, uint64_t followee) {
+            std::time_t created = start_ + static_cast<std::time_t>(hash(kFollowsSalt, follower, followee) %
+                                                                    static_cast<uint64_t>(now_ - start_));
+            table.num(static_cast<int64_t>(follower)).num(static_cast<int64_t>(followee)).str(formatTime(created));
+            return table.endRow();
+        });
+    return ok && table.finish();
+}
+
+bool DatasetGenerator::loadShares(MYSQL* conn) {
+    TableLoader table(conn, options_, "shares",
+                      "share_id, post_id, sender_id, receiver_id, share_message, create_time");
+    uint64_t sequence = 0;
+    char shareId[32];
+    bool ok = forEachEdge(
+        shareActivity_, kSharesSalt, options_.users > 0 ? (options_.users - 1) * options_.posts : 0,
+        [this](std::mt19937_64& r, uint64_t actor, bool uniform) { return drawShareTarget(r, actor, uniform); },
+        [this, &table, &sequence, &shareId](uint64_t sender, uint64_t key) {
+            uint64_t receiver = key / (options_.posts + 1);
+            uint64_t post = key % (options_.posts + 1);
+            std::snprintf(shareId, sizeof(shareId), "SHR_BENCH_%010llu", static_cast<unsigned long long>(++sequence));
+            std::time_t created = postTime(post);
+            created += static_cast<std::time_t>(hash(kSharesSalt, sender, key) %
+                                                static_cast<uint64_t>(now_ - created + 1));
+            table.str(shareId).num(static_cast<int64_t>(post)).num(static_cast<int64_t>(sender))
+                .num(static_cast<int64_t>(receiver));
+            if (sequence % 4 == 0) {
+                table.null();
+            } else {
+                table.str("分享给你");
+            }
+            table.str(formatTime(created));
+            return table.endRow();
+        });
+    return ok && table.finish();
+}
+
+bool DatasetGenerator::loadUserStats(MYSQL* conn) {
+    std::vector<uint64_t> totalLikes(options_.users + 1, 0);
+    for (uint64_t post = 1; post <= options_.posts; ++post) {
+        totalLikes[postAuthor_[post]] += postLikes_[post];
+    }
+
+    TableLoader table(conn, options_, "user_stats",
+                      "user_id, post_count, total_likes, total_favorites, follower_count, following_count");
+    for (uint64_t user = 1; user <= options_.users; ++user) {
+        table.num(static_cast<int64_t>(user)).num(userPosts_[user]).num(static_cast<int64_t>(totalLikes[user]))
+            .num(0).num(userFollowers_[user]).num(userFollowing_[user]);
+        if (!table.endRow()) {
+            return false;
+        }
+    }
+    return table.finish();
+}
+
+std::time_t DatasetGenerator::postTime(uint64_t postId) const {
+    // 物理ID越大越新，与线上按自增ID插入的顺序一致
+    const uint64_t span = static_cast<uint64_t>(now_ - start_);
+    const uint64_t step = std::max<uint64_t>(1, span / std::max<uint64_t>(1, options_.posts));
+    uint64_t offset = (postId - 1) * span / std::max<uint64_t>(1, options_.posts) + hash(kTimeSalt, postId, 0) % step;
+    return start_ + static_cast<std::time_t>(std::min(offset, span));
+}
+
+uint64_t DatasetGenerator::hash(uint64_t salt, uint64_t a, uint64_t b) const {
+    // splitmix64 终混合
+    uint64_t x = options_.seed ^ (salt * 0x9E3779B97F4A7C15ULL) ^ (a * 0xBF58476D1CE4E5B9ULL) ^
+                 (b * 0x94D049BB133111EBULL);
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file dataset_generator.h
+ * @brief 仓储层基准测试的合成数据集生成器（按 config/database.sql 及迁移脚本的表结构）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "repo/synthetic_distribution.h"
+#include <mysql/mysql.h>
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 数据集规模与装载方式
+ */
+struct DatasetOptions {
+    uint64_t users = 10000;
+    uint64_t posts = 100000;
+    uint64_t likes = 500000;
+    uint64_t follows = 200000;
+    uint64_t shares = 50000;
+    int maxImagesPerPost = 3;           // 每帖图片数在 1..N 间均匀分布
+    uint32_t maxLikesPerUser = 5000;    // 单用户活跃度上限，避免 Zipf 头部用户点赞全站
+    uint32_t maxFollowsPerUser = 2000;
+    uint32_t maxSharesPerUser = 200;
+    double skew = 1.0;                  // Zipf 指数，0 为均匀
+    uint64_t seed = 42;
+    int days = 180;                     // 帖子时间跨度（截止到当前时间）
+    bool loadDataInfile = false;        // true 用 LOAD DATA LOCAL INFILE，否则多行 INSERT
+    size_t batchRows = 1000;            // 每条 INSERT 的行数；INFILE 模式下每个文件为其 100 倍
+    std::string tmpDir = "/tmp";
+    bool truncate = false;              // 生成前清空相关表
+    std::string password = "bench123";  // 所有合成用户的登录密码
+};
+
+/**
+ * @brief 合成数据集生成器
+ *
+ * 生成 users / posts / images / likes / follows / shares / user_stats，物理ID从1连续分配，
+ * 冗余计数（like_count、follower_count、user_stats 等）与明细表一致。
+ *
+ * 点赞、关注、分享先按 Zipf 分配每个用户的活跃度，再按 Zipf 热度为每个用户抽取不重复的目标，
+ * 每个用户的随机数种子由 (seed, 表, 用户) 决定：第一遍只统计计数（写 posts/users 时需要），
+ * 第二遍重放同样的抽样写明细表，不必在内存中保存上亿条边。
+ */
+class DatasetGenerator {
+public:
+    explicit DatasetGenerator(const DatasetOptions& options);
+
+    /**
+     * @brief 生成并装载数据集
+     * @param conn 独立连接（装载期间会关闭该会话的外键与唯一性检查）
+     * @return 成功返回true
+     */
+    bool run(MYSQL* conn);
+
+private:
+    bool prepareTables(MYSQL* conn);
+    void plan();
+    std::vector<uint32_t> distributeActivity(uint64_t total, uint32_t cap, uint64_t salt) const;
+
+    /**
+     * @brief 为每个发起方抽取不重复的目标并回调（同样的种子总是得到同样的边）
+     * @param draw (rng, actor, uniform) -> 目标，0 表示本次作废；uniform 为 true 时应均匀抽样，
+     *             用于头部目标抽完后补足数量
+     * @param visit (actor, target) -> bool，返回false时中止
+     */
+    template <typename Draw, typename Visit>
+    bool forEachEdge(const std::vector<uint32_t>& activity, uint64_t salt, uint64_t targetSpace,
+                     Draw draw, Visit visit) const;
+
+    uint64_t drawLikeTarget(std::mt19937_64& rng, uint64_t actor, bool uniform) const;
+    uint64_t drawFollowTarget(std::mt19937_64& rng, uint64_t actor, bool uniform) const;
+    uint64_t drawShareTarget(std::mt19937_64& rng, uint64_t actor, bool uniform) const;
+
+    bool loadUsers(MYSQL* conn);
+    bool loadPosts(MYSQL* conn);
+    bool loadImages(MYSQL* conn);
+    bool loadLikes(MYSQL* conn);
+    bool loadFollows(MYSQL* conn);
+    bool loadShares(MYSQL* conn);
+    bool loadUserStats(MYSQL* conn);
+
+    std::time_t postTime(uint64_t postId) const;
+    uint64_t hash(uint64_t salt, uint64_t a, uint64_t b) const;
+
+    DatasetOptions options_;
+    SyntheticShape shape_;
+    std::time_t now_;
+    std::time_t start_;
+
+    // 计划阶段的统计结果，下标为物理ID（0 不用）
+    std::vector<uint32_t> postAuthor_;
+    std::vector<uint8_t> imageCount_;
+    std::vector<uint32_t> postLikes_;
+    std::vector<uint32_t> userPosts_;
+    std::vector<uint32_t> userFollowers_;
+    std::vector<uint32_t> userFollowing_;
+    std::vector<uint32_t> likeActivity_;
+    std::vector<uint32_t> followActivity_;
+    std::vector<uint32_t> shareActivity_;
+};
+
+/// 合成帖子的业务ID（POST_BENCH_000000001），压测循环按物理ID反推
+std::string syntheticPostId(uint64_t id);
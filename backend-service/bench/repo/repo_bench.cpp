@@ -0,0 +1,527 @@
+/**
+ * @file repo_bench.cpp
+ * @brief 仓储层基准测试：生成合成数据集并压测 Post/Like/Follow/Share Repository 的方法
+ * @author Knot Team
+ * @date 2026-10-18
+ *
+ * 用法：
+ *   knot_repo_bench --config config/config.json --mode generate --preset large --truncate
+ *   knot_repo_bench --config config/config.json --mode run --threads 4 --duration 10 --output repo.json
+ *
+ * 连接参数取自配置文件的 database.*，应指向专用的压测库（--truncate 会清空相关表）。
+ * run 模式假定库中是本工具生成的数据（物理ID从1连续），按与生成时相同的 --skew 命中热点用户和帖子。
+ */
+
+#include "repo/dataset_generator.h"
+#include "common/latency_recorder.h"
+#include "common/report.h"
+#include "database/connection_guard.h"
+#include "database/connection_pool.h"
+#include "database/follow_repository.h"
+#include "database/like_repository.h"
+#include "database/post_repository.h"
+#include "database/share_repository.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <json/json.h>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 命令行选项
+ */
+struct Options {
+    std::string config = "config/config.json";
+    std::string mode = "run";           // generate | run | all
+    DatasetOptions dataset;
+    std::string benchmark = "all";      // 名称或前缀（如 follow.）
+    int threads = 4;
+    int durationSeconds = 5;
+    int warmupSeconds = 1;
+    int maxPage = 500;                  // 深分页基准的最大页码（每页20条）
+    std::string output;
+    std::string baseline;
+};
+
+/**
+ * @brief 单个压测线程的上下文
+ */
+struct BenchContext {
+    MYSQL* conn;
+    std::mt19937_64 rng;
+    const SyntheticShape& shape;
+    uint64_t users;
+    uint64_t posts;
+    int maxPage;
+    PostRepository& postRepo;
+    LikeRepository likeRepo;
+    FollowRepository followRepo;
+    ShareRepository shareRepo;
+
+    int activeUser() { return static_cast<int>(shape.activeUser(rng)); }
+    int popularUser() { return static_cast<int>(shape.popularUser(rng)); }
+    int popularPost() { return static_cast<int>(shape.popularPost(rng)); }
+    int anyUser() { return static_cast<int>(std::uniform_int_distribution<uint64_t>(1, users)(rng)); }
+    int anyPost() { return static_cast<int>(std::uniform_int_distribution<uint64_t>(1, posts)(rng)); }
+    int page() { return std::uniform_int_distribution<int>(1, maxPage)(rng); }
+
+    std::vector<int> popularPosts(size_t n) {
+        std::vector<int> ids;
+        for (size_t i = 0; i < n; ++i) {
+            ids.push_back(popularPost());
+        }
+        return ids;
+    }
+
+    std::vector<int64_t> popularUsers(size_t n) {
+        std::vector<int64_t> ids;
+        for (size_t i = 0; i < n; ++i) {
+            ids.push_back(popularUser());
+        }
+        return ids;
+    }
+};
+
+/**
+ * @brief 一个仓储方法的压测项，返回本次调用得到的行数
+ */
+struct RepoBenchmark {
+    std::string name;
+    std::function<uint64_t(BenchContext&)> run;
+};
+
+std::vector<RepoBenchmark> buildBenchmarks() {
+    return {
+        {"post.find_by_post_id", [](BenchContext& c) -> uint64_t {
+             return c.postRepo.findByPostIdWithImages(syntheticPostId(static_cast<uint64_t>(c.popularPost()))) ? 1 : 0;
+         }},
+        {"post.recent_first_page", [](BenchContext& c) -> uint64_t {
+             return c.postRepo.getRecentPostsWithImagesOptimized(1, 20).size();
+         }},
+        {"post.recent_deep_page", [](BenchContext& c) -> uint64_t {
+             return c.postRepo.getRecentPostsWithImagesOptimized(c.page(), 20).size();
+         }},
+        {"post.by_user", [](BenchContext& c) -> uint64_t {
+             return c.postRepo.findByUserIdWithImages(c.activeUser(), 1, 20).size();
+         }},
+        {"post.find_by_ids", [](BenchContext& c) -> uint64_t {
+             return c.postRepo.findByIdsWithImages(c.popularPosts(20)).size();
+         }},
+        {"post.user_post_count", [](BenchContext& c) -> uint64_t {
+             return c.postRepo.getUserPostCount(c.activeUser()) >= 0 ? 1 : 0;
+         }},
+        {"like.exists", [](BenchContext& c) -> uint64_t {
+             return c.likeRepo.exists(c.conn, c.activeUser(), c.popularPost()) ? 1 : 0;
+         }},
+        {"like.batch_exists", [](BenchContext& c) -> uint64_t {
+             return c.likeRepo.batchExistsForPosts(c.conn, c.activeUser(), c.popularPosts(20)).size();
+         }},
+        {"like.find_by_user", [](BenchContext& c) -> uint64_t {
+             return c.likeRepo.findByUserId(c.conn, c.activeUser(), 20, 0).size();
+         }},
+        {"like.count_by_post", [](BenchContext& c) -> uint64_t {
+             return static_cast<uint64_t>(std::max(0, c.likeRepo.countByPostId(c.conn, c.popularPost())));
+         }},
+        {"like.create_delete", [](BenchContext& c) -> uint64_t {
+             // 随机对大多不存在；已存在时 create 失败，不能删掉生成的数据
+             int user = c.anyUser();
+             int post = c.anyPost();
+             return c.likeRepo.create(c.conn, user, post) && c.likeRepo.deleteByUserAndPost(c.conn, user, post) ? 1 : 0;
+         }},
+        {"follow.exists", [](BenchContext& c) -> uint64_t {
+             return c.followRepo.exists(c.conn, c.activeUser(), c.popularUser()) ? 1 : 0;
+         }},
+        {"follow.following", [](BenchContext& c) -> uint64_t {
+             return c.followRepo.findFollowingByUserId(c.conn, c.activeUser(), 20, 0).value_or(std::vector<Follow>()).size();
+         }},
+        {"follow.followers", [](BenchContext& c) -> uint64_t {
+             return c.followRepo.findFollowersByUserId(c.conn, c.popularUser(), 20, 0).value_or(std::vector<Follow>()).size();
+         }},
+        {"follow.followers_deep", [](BenchContext& c) -> uint64_t {
+             return c.followRepo.findFollowersByUserId(c.conn, c.popularUser(), 20, (c.page() - 1) * 20).value_or(std::vector<Follow>()).size();
+         }},
+        {"follow.count_followers", [](BenchContext& c) -> uint64_t {
+             return static_cast<uint64_t>(std::max(0, c.followRepo.countFollowers(c.conn, c.popularUser())));
+         }},
+        {"follow.batch_check", [](BenchContext& c) -> uint64_t {
+             return c.followRepo.batchCheckExists(c.conn, c.activeUser(), c.popularUsers(20)).size();
+         }},
+        {"follow.mutual", [](BenchContext& c) -> uint64_t {
+             return c.followRepo.findMutualFollowIds(c.conn, c.activeUser(), 20, 0).size();
+         }},
+        {"follow.count_mutual", [](BenchContext& c) -> uint64_t {
+             return static_cast<uint64_t>(std::max(0, c.followRepo.countMutualFollows(c.conn, c.activeUser())));
+         }},
+        {"follow.create_delete", [](BenchContext& c) -> uint64_t {
+             int follower = c.anyUser();
+             int followee = c.anyUser();
+             if (follower == followee) {
+                 return 0;
+             }
+             return c.followRepo.create(c.conn, follower, followee) &&
+                            c.followRepo.deleteByFollowerAndFollowee(c.conn, follower, followee)
+                        ? 1
+                        : 0;
+         }},
+        {"share.received", [](BenchContext& c) -> uint64_t {
+             return c.shareRepo.findReceivedShares(c.conn, c.popularUser(), 20, 0).size();
+         }},
+        {"share.sent", [](BenchContext& c) -> uint64_t {
+             return c.shareRepo.findSentShares(c.conn, c.activeUser(), 20, 0).size();
+         }},
+        {"share.count_received", [](BenchContext& c) -> uint64_t {
+             return static_cast<uint64_t>(std::max(0, c.shareRepo.countReceivedShares(c.conn, c.popularUser())));
+         }},
+        {"share.count_post", [](BenchContext& c) -> uint64_t {
+             return static_cast<uint64_t>(std::max(0, c.shareRepo.countPostShares(c.conn, c.popularPost())));
+         }},
+        {"share.exists", [](BenchContext& c) -> uint64_t {
+             return c.shareRepo.exists(c.conn, c.activeUser(), c.popularUser(), c.popularPost()) ? 1 : 0;
+         }},
+    };
+}
+
+void printUsage() {
+    std::cout <<
+        "Usage: knot_repo_bench [options]\n"
+        "  --config FILE             server config with database.* (default config/config.json)\n"
+        "  --mode M                  generate|run|all (default run)\n"
+        "dataset (generate):\n"
+        "  --preset P                small|medium|large (default small; large = 1M users, 10M posts,\n"
+        "                            50M likes, 20M follows, 5M shares)\n"
+        "  --users N --posts N --likes N --follows N --shares N   override preset sizes\n"
+        "  --max-images N            images per post, uniform 1..N (default 3)\n"
+        "  --max-likes-per-user N --max-follows-per-user N --max-shares-per-user N\n"
+        "  --skew S                  Zipf exponent for activity and popularity, 0 = uniform (default 1.0)\n"
+        "  --seed N                  random seed (default 42)\n"
+        "  --days N                  post time span ending now (default 180)\n"
+        "  --load insert|infile      multi-row INSERT or LOAD DATA LOCAL INFILE (default insert)\n"
+        "  --batch N                 rows per INSERT (default 1000)\n"
+        "  --tmp-dir DIR             TSV files for --load infile (default /tmp)\n"
+        "  --truncate                empty the affected tables first\n"
+        "benchmark (run):\n"
+        "  --benchmark NAME          benchmark name or prefix such as follow. (default all)\n"
+        "  --threads N               worker threads, one pooled connection each (default 4)\n"
+        "  --duration S              measured seconds per benchmark (default 5)\n"
+        "  --warmup S                unmeasured warmup seconds per benchmark (default 1)\n"
+        "  --max-page N              highest page for *_deep benchmarks (default 500)\n"
+        "  --output FILE             write results as JSON\n"
+        "  --baseline FILE           compare with a previous --output file\n";
+}
+
+void applyPreset(const std::string& preset, DatasetOptions& dataset) {
+    if (preset == "medium") {
+        dataset.users = 100000;
+        dataset.posts = 1000000;
+        dataset.likes = 5000000;
+        dataset.follows = 2000000;
+        dataset.shares = 500000;
+    } else if (preset == "large") {
+        dataset.users = 1000000;
+        dataset.posts = 10000000;
+        dataset.likes = 50000000;
+        dataset.follows = 20000000;
+        dataset.shares = 5000000;
+    }
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    // 先应用 --preset，显式给出的数量总是覆盖预设，与参数顺序无关
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--preset") {
+            std::string preset = argv[i + 1];
+            if (preset != "small" && preset != "medium" && preset != "large") {
+                std::cerr << "Unknown preset " << preset << std::endl;
+                return false;
+            }
+            applyPreset(preset, options.dataset);
+        }
+    }
+
+    DatasetOptions& dataset = options.dataset;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (arg == "--truncate") {
+            dataset.truncate = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--config") options.config = value;
+            else if (arg == "--mode") options.mode = value;
+            else if (arg == "--preset") continue;
+            else if (arg == "--users") dataset.users = std::stoull(value);
+            else if (arg == "--posts") dataset.posts = std::stoull(value);
+            else if (arg == "--likes") dataset.likes = std::stoull(value);
+            else if (arg == "--follows") dataset.follows = std::stoull(value);
+            else if (arg == "--shares") dataset.shares = std::stoull(value);
+            else if (arg == "--max-images") dataset.maxImagesPerPost = std::stoi(value);
+            else if (arg == "--max-likes-per-user") dataset.maxLikesPerUser = static_cast<uint32_t>(std::stoul(value));
+            else if (arg == "--max-follows-per-user") dataset.maxFollowsPerUser = static_cast<uint32_t>(std::stoul(value));
+            else if (arg == "--max-shares-per-user") dataset.maxSharesPerUser = static_cast<uint32_t>(std::stoul(value));
+            else if (arg == "--skew") dataset.skew = std::max(0.0, std::stod(value));
+            else if (arg == "--seed") dataset.seed = std::stoull(value);
+            else if (arg == "--days") dataset.days = std::max(1, std::stoi(value));
+            else if (arg == "--load") dataset.loadDataInfile = (value == "infile");
+            else if (arg == "--batch") dataset.batchRows = std::max<size_t>(1, std::stoull(value));
+            else if (arg == "--tmp-dir") dataset.tmpDir = value;
+            else if (arg == "--benchmark") options.benchmark = value;
+            else if (arg == "--threads") options.threads = std::max(1, std::stoi(value));
+            else if (arg == "--duration") options.durationSeconds = std::max(1, std::stoi(value));
+            else if (arg == "--warmup") options.warmupSeconds = std::max(0, std::stoi(value));
+            else if (arg == "--max-page") options.maxPage = std::max(1, std::stoi(value));
+            else if (arg == "--output") options.output = value;
+            else if (arg == "--baseline") options.baseline = value;
+            else {
+                std::cerr << "Unknown option " << arg << std::endl;
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (options.mode != "generate" && options.mode != "run" && options.mode != "all") {
+        std::cerr << "Unknown mode " << options.mode << std::endl;
+        return false;
+    }
+    if (dataset.users < 2 || dataset.posts < 1) {
+        std::cerr << "Need at least 2 users and 1 post" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 按 database.* 建立生成器专用连接（需要在连接前打开 LOCAL INFILE）
+ */
+MYSQL* connectForLoad(bool localInfile) {
+    auto& config = ConfigManager::getInstance();
+    MYSQL* mysql = mysql_init(nullptr);
+    if (!mysql) {
+        return nullptr;
+    }
+    unsigned int localInfileFlag = localInfile ? 1 : 0;
+    mysql_options(mysql, MYSQL_OPT_LOCAL_INFILE, &localInfileFlag);
+    mysql_options(mysql, MYSQL_SET_CHARSET_NAME, "utf8mb4");
+    if (!mysql_real_connect(mysql, config.get<std::string>("database.host", "localhost").c_str(),
+                            config.get<std::string>("database.username", "root").c_str(),
+                            config.get<std::string>("database.password", "").c_str(),
+                            config.get<std::string>("database.database", "shared_parking").c_str(),
+                            static_cast<unsigned int>(config.get<int>("database.port", 3306)), nullptr, 0)) {
+        std::cerr << "Cannot connect to MySQL: " << mysql_error(mysql) << std::endl;
+        mysql_close(mysql);
+        return nullptr;
+    }
+    return mysql;
+}
+
+bool queryMaxId(MYSQL* conn, const char* table, uint64_t& out) {
+    std::string sql = std::string("SELECT COALESCE(MAX(id), 0) FROM ") + table;
+    if (mysql_real_query(conn, sql.data(), sql.size()) != 0) {
+        std::cerr << sql << ": " << mysql_error(conn) << std::endl;
+        return false;
+    }
+    MYSQL_RES* result = mysql_store_result(conn);
+    if (!result) {
+        return false;
+    }
+    MYSQL_ROW row = mysql_fetch_row(result);
+    out = (row && row[0]) ? std::stoull(row[0]) : 0;
+    mysql_free_result(result);
+    return true;
+}
+
+struct WorkerResult {
+    LatencyRecorder latency;
+    uint64_t rows = 0;
+};
+
+struct BenchReport {
+    double seconds = 0.0;
+    uint64_t ops = 0;
+    uint64_t rows = 0;
+    LatencyRecorder latency;
+};
+
+void runWorker(const Options& options, const RepoBenchmark& benchmark, const SyntheticShape& shape,
+               uint64_t users, uint64_t posts, int threadIndex, Clock::time_point measureStart,
+               Clock::time_point end, WorkerResult& result) {
+    PostRepository postRepo;
+    ConnectionGuard guard(DatabaseConnectionPool::getInstance());
+    if (!guard.isValid()) {
+        std::cerr << "No database connection for worker " << threadIndex << std::endl;
+        return;
+    }
+    BenchContext context{guard.get(), std::mt19937_64(options.dataset.seed * 1000 + static_cast<uint64_t>(threadIndex)),
+                         shape, users, posts, options.maxPage, postRepo, {}, {}, {}};
+
+    while (true) {
+        Clock::time_point begin = Clock::now();
+        if (begin >= end) {
+            break;
+        }
+        uint64_t rows = benchmark.run(context);
+        if (begin >= measureStart) {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin).count();
+            result.latency.record(static_cast<uint64_t>(micros));
+            result.rows += rows;
+        }
+    }
+}
+
+BenchReport runBenchmark(const Options& options, const RepoBenchmark& benchmark, const SyntheticShape& shape,
+                         uint64_t users, uint64_t posts) {
+    std::vector<WorkerResult> results(static_cast<size_t>(options.threads));
+    std::vector<std::thread> workers;
+    Clock::time_point measureStart = Clock::now() + std::chrono::seconds(options.warmupSeconds);
+    Clock::time_point end = measureStart + std::chrono::seconds(options.durationSeconds);
+    for (int i = 0; i < options.threads; ++i) {
+        workers.emplace_back(runWorker, std::cref(options), std::cref(benchmark), std::cref(shape), users, posts, i,
+                             measureStart, end, std::ref(results[static_cast<size_t>(i)]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    BenchReport report;
+    report.seconds = std::chrono::duration<double>(std::max(Clock::now(), end) - measureStart).count();
+    for (const auto& result : results) {
+        report.ops += result.latency.count();
+        report.rows += result.rows;
+        report.latency.merge(result.latency);
+    }
+    return report;
+}
+
+Json::Value reportJson(BenchReport& report) {
+    Json::Value json;
+    json["ops"] = static_cast<Json::UInt64>(report.ops);
+    json["ops_per_second"] = report.ops / report.seconds;
+    json["rows_per_op"] = report.ops > 0 ? static_cast<double>(report.rows) / report.ops : 0.0;
+    json["latency_ms"] = latencyJson(report.latency);
+    return json;
+}
+
+void printReport(const Json::Value& json, const std::string& name, const Json::Value& baseline) {
+    const Json::Value& base = baseline["benchmarks"][name];
+    std::printf("%-24s %9.0f ops/s%s  rows/op %.1f ", name.c_str(), json["ops_per_second"].asDouble(),
+                delta(json["ops_per_second"].asDouble(), base["ops_per_second"]).c_str(),
+                json["rows_per_op"].asDouble());
+    for (const char* key : {"p50", "p99", "max"}) {
+        double value = json["latency_ms"][key].asDouble();
+        std::printf(" %s=%.2fms%s", key, value, delta(value, base["latency_ms"][key]).c_str());
+    }
+    std::printf("\n");
+}
+
+bool matches(const std::string& filter, const std::string& name) {
+    return filter == "all" || name == filter || name.compare(0, filter.size(), filter) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    if (!ConfigManager::getInstance().loadConfig(options.config)) {
+        std::cerr << "Cannot load config " << options.config << std::endl;
+        return 1;
+    }
+    Logger::initialize("", LogLevel::WARNING, true);
+
+    if (options.mode != "run") {
+        MYSQL* conn = connectForLoad(options.dataset.loadDataInfile);
+        if (!conn) {
+            return 1;
+        }
+        bool ok = DatasetGenerator(options.dataset).run(conn);
+        mysql_close(conn);
+        if (!ok) {
+            return 1;
+        }
+        if (options.mode == "generate") {
+            return 0;
+        }
+    }
+
+    auto& pool = DatabaseConnectionPool::getInstance();
+    if (!pool.initialize()) {
+        std::cerr << "Cannot initialize database connection pool" << std::endl;
+        return 1;
+    }
+
+    uint64_t users = 0;
+    uint64_t posts = 0;
+    {
+        ConnectionGuard guard(pool);
+        if (!guard.isValid() || !queryMaxId(guard.get(), "users", users) || !queryMaxId(guard.get(), "posts", posts)) {
+            return 1;
+        }
+    }
+    if (users < 2 || posts < 1) {
+        std::cerr << "Database is empty; run with --mode generate first" << std::endl;
+        return 1;
+    }
+    SyntheticShape shape(users, posts, options.dataset.skew);
+
+    Json::Value baseline;
+    if (!options.baseline.empty() && !readJsonFile(options.baseline, baseline)) {
+        std::cerr << "Cannot read baseline " << options.baseline << std::endl;
+        return 1;
+    }
+
+    std::printf("knot_repo_bench: %llu users, %llu posts, skew %.2f, %d threads, %ds warmup + %ds per benchmark\n",
+                static_cast<unsigned long long>(users), static_cast<unsigned long long>(posts),
+                options.dataset.skew, options.threads, options.warmupSeconds, options.durationSeconds);
+
+    Json::Value output;
+    output["users"] = static_cast<Json::UInt64>(users);
+    output["posts"] = static_cast<Json::UInt64>(posts);
+    output["skew"] = options.dataset.skew;
+    output["threads"] = options.threads;
+    output["duration_seconds"] = options.durationSeconds;
+    bool any = false;
+    for (const auto& benchmark : buildBenchmarks()) {
+        if (!matches(options.benchmark, benchmark.name)) {
+            continue;
+        }
+        any = true;
+        BenchReport report = runBenchmark(options, benchmark, shape, users, posts);
+        Json::Value json = reportJson(report);
+        printReport(json, benchmark.name, baseline);
+        output["benchmarks"][benchmark.name] = json;
+    }
+    if (!any) {
+        std::cerr << "Unknown benchmark " << options.benchmark << std::endl;
+        return 1;
+    }
+
+    if (!options.output.empty() && !writeJsonFile(options.output, output)) {
+        std::cerr << "Cannot write " << options.output << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file synthetic_distribution.h
+ * @brief 合成数据集的偏斜分布：Zipf 采样与排名到物理ID的打散映射
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+/**
+ * @brief Zipf 分布采样器（rejection-inversion，Hörmann & Derflinger 1996）
+ *
+ * 返回 1..n 的排名，P(k) ∝ 1/k^s。s=0 为均匀分布，s 越大越集中在头部。
+ * 构造 O(1)、采样期望 O(1)，不需要为千万级的 n 预计算 CDF 表。
+ */
+class ZipfSampler {
+public:
+    ZipfSampler(uint64_t n, double exponent)
+        : n_(n == 0 ? 1 : n), exponent_(exponent < 0 ? 0 : exponent) {
+        hIntegralX1_ = hIntegral(1.5) - 1.0;
+        hIntegralN_ = hIntegral(static_cast<double>(n_) + 0.5);
+        s_ = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    template <typename Rng>
+    uint64_t operator()(Rng& rng) const {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        while (true) {
+            double u = hIntegralN_ + uniform(rng) * (hIntegralX1_ - hIntegralN_);
+            double x = hIntegralInverse(u);
+            double rounded = std::floor(x + 0.5);
+            uint64_t k = rounded < 1.0 ? 1 : (rounded > static_cast<double>(n_) ? n_ : static_cast<uint64_t>(rounded));
+            if (static_cast<double>(k) - x <= s_ || u >= hIntegral(static_cast<double>(k) + 0.5) - h(static_cast<double>(k))) {
+                return k;
+            }
+        }
+    }
+
+    uint64_t size() const {
+        return n_;
+    }
+
+private:
+    double h(double x) const {
+        return std::exp(-exponent_ * std::log(x));
+    }
+
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return helper2((1.0 - exponent_) * logX) * logX;
+    }
+
+    double hIntegralInverse(double x) const {
+        double t = x * (1.0 - exponent_);
+        if (t < -1.0) {
+            t = -1.0;  // 浮点误差保护
+        }
+        return std::exp(helper1(t) * x);
+    }
+
+    // log(1+x)/x，x 接近 0 时用泰勒展开
+    static double helper1(double x) {
+        if (std::abs(x) > 1e-8) {
+            return std::log1p(x) / x;
+        }
+        return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    // (exp(x)-1)/x，x 接近 0 时用泰勒展开
+    static double helper2(double x) {
+        if (std::abs(x) > 1e-8) {
+            return std::expm1(x) / x;
+        }
+        return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+    }
+
+    uint64_t n_;
+    double exponent_;
+    double hIntegralX1_;
+    double hIntegralN_;
+    double s_;
+};
+
+/**
+ * @brief 把排名 1..n 打散成物理ID 1..n 的双射：id = ((rank-1)*stride + offset) mod n + 1
+ *
+ * 直接用排名当 ID 会让热点全部落在最早插入的几页 B+ 树上；不同 salt 给出不同的打散方式，
+ * 使"最活跃的点赞者"和"最受欢迎的作者"不是同一批用户。
+ */
+class RankScatter {
+public:
+    RankScatter(uint64_t n, uint64_t salt) : n_(n == 0 ? 1 : n) {
+        // 取接近 n*0.618 的奇数再调到与 n 互素，保证是排列
+        stride_ = (static_cast<uint64_t>(static_cast<double>(n_) * 0.6180339887) + salt * 2654435761ULL) % n_;
+        stride_ |= 1;
+        while (std::gcd(stride_, n_) != 1) {
+            stride_ += 2;
+        }
+        stride_ %= n_;
+        if (stride_ == 0) {
+            stride_ = 1;
+        }
+        offset_ = (salt * 0x9E3779B97F4A7C15ULL) % n_;
+    }
+
+    uint64_t operator()(uint64_t rank) const {
+        unsigned __int128 scaled = static_cast<unsigned __int128>((rank - 1) % n_) * stride_ + offset_;
+        return static_cast<uint64_t>(scaled % n_) + 1;
+    }
+
+private:
+    uint64_t n_;
+    uint64_t stride_;
+    uint64_t offset_;
+};
+
+/**
+ * @brief 数据集各角色的热点分布（生成器与压测循环共用，保证压测命中生成时的热点）
+ */
+struct SyntheticShape {
+    SyntheticShape(uint64_t users, uint64_t posts, double skew)
+        : userZipf(users, skew),
+          postZipf(posts, skew),
+          activeUsers(users, 1),
+          popularUsers(users, 2),
+          popularPosts(posts, 3) {}
+
+    /// 按活跃度抽用户（点赞、关注、发帖、分享的发起方）
+    template <typename Rng>
+    uint64_t activeUser(Rng& rng) const {
+        return activeUsers(userZipf(rng));
+    }
+
+    /// 按受欢迎程度抽用户（被关注、被分享的一方）
+    template <typename Rng>
+    uint64_t popularUser(Rng& rng) const {
+        return popularUsers(userZipf(rng));
+    }
+
+    /// 按热度抽帖子
+    template <typename Rng>
+    uint64_t popularPost(Rng& rng) const {
+        return popularPosts(postZipf(rng));
+    }
+
+    ZipfSampler userZipf;
+    ZipfSampler postZipf;
+    RankScatter activeUsers;
+    RankScatter popularUsers;
+    RankScatter popularPosts;
+};
@@ -0,0 +1,179 @@
+/**
+ * @file router_bench.cpp
+ * @brief 路由分发微基准：前缀树路由器与 httplib 逐条匹配的对比
+ * @author Knot Team
+ * @date 2026-10-18
+ *
+ * 基于 Google Benchmark。两边注册同一张路由表（与 HttpServer::setupRoutes 的模块顺序一致）：
+ *   RouterDispatch/<路径>   Router::dispatchWithoutBody（匹配 + 写入 path_params + 空处理器）
+ *   LinearMatch/<路径>      按注册顺序逐个调用 httplib 的 matcher，直到命中
+ *                            （含 ':' 的模式用 PathParamsMatcher，其余用 RegexMatcher，与 httplib::Server 相同）
+ *
+ * 路径覆盖静态路由、靠前/靠后注册的参数路由和未命中的请求；
+ * 逐条匹配的耗时随命中位置增长，前缀树只与路径段数有关。
+ */
+
+#include "server/router.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// method, pattern
+const std::vector<std::pair<std::string, std::string>> kRoutes = {
+    // auth
+    {"POST", "/api/v1/auth/register"},
+    {"POST", "/api/v1/auth/login"},
+    {"POST", "/api/v1/auth/validate"},
+    {"POST", "/api/v1/auth/refresh"},
+    {"POST", "/api/v1/auth/logout"},
+    {"PUT", "/api/v1/auth/password"},
+    {"GET", "/api/v1/users/profile"},
+    {"PUT", "/api/v1/users/profile"},
+    {"GET", "/api/v1/users/check-username"},
+    {"POST", "/api/v1/users/avatar"},
+    {"GET", "/api/v1/users/:user_id"},
+    // image
+    {"POST", "/api/v1/images"},
+    {"GET", "/api/v1/images"},
+    {"GET", "/api/v1/images/:id"},
+    {"PUT", "/api/v1/images/:id<int>"},
+    {"DELETE", "/api/v1/images/:id<int>"},
+    {"GET", "/api/v1/users/:id/images"},
+    // like
+    {"POST", "/api/v1/posts/:post_id/like"},
+    {"DELETE", "/api/v1/posts/:post_id/like"},
+    {"GET", "/api/v1/posts/:post_id/like/status"},
+    // favorite
+    {"POST", "/api/v1/posts/:post_id/favorite"},
+    {"DELETE", "/api/v1/posts/:post_id/favorite"},
+    {"GET", "/api/v1/posts/:post_id/favorite/status"},
+    {"GET", "/api/v1/my/favorites"},
+    // follow
+    {"POST", "/api/v1/users/:user_id/follow"},
+    {"DELETE", "/api/v1/users/:user_id/follow"},
+    {"GET", "/api/v1/users/:user_id/follow/status"},
+    {"GET", "/api/v1/users/:user_id/following"},
+    {"GET", "/api/v1/users/:user_id/followers"},
+    {"GET", "/api/v1/users/:user_id/mutual-follows"},
+    {"GET", "/api/v1/users/:user_id/stats"},
+    {"POST", "/api/v1/users/follow/batch-status"},
+    // comment
+    {"POST", "/api/v1/posts/:post_id/comments"},
+    {"GET", "/api/v1/posts/:post_id/comments"},
+    {"DELETE", "/api/v1/posts/:post_id/comments/:comment_id"},
+    // share
+    {"POST", "/api/v1/shares/posts"},
+    {"GET", "/api/v1/shares/received"},
+    {"GET", "/api/v1/shares/sent"},
+    {"DELETE", "/api/v1/shares/:id"},
+    // post
+    {"POST", "/api/v1/posts"},
+    {"GET", "/api/v1/posts/:post_id"},
+    {"PUT", "/api/v1/posts/:post_id"},
+    {"DELETE", "/api/v1/posts/:post_id"},
+    {"GET", "/api/v1/posts"},
+    {"GET", "/api/v1/feed/following"},
+    {"GET", "/api/v1/users/:user_id/posts"},
+    {"POST", "/api/v1/posts/:post_id/images"},
+    {"DELETE", "/api/v1/posts/:post_id/images/:image_id"},
+    {"PUT", "/api/v1/posts/:post_id/images/order"},
+    // server
+    {"GET", "/health"},
+    {"GET", "/metrics"},
+    {"GET", "/debug/slow-queries"},
+    {"GET", "/debug/runtime"},
+    {"GET", "/api/v1/version"},
+};
+
+void noop(const httplib::Request&, httplib::Response&) {}
+
+Router& router() {
+    static Router* instance = [] {
+        auto* r = new Router();
+        for (const auto& [method, pattern] : kRoutes) {
+            if (method == "GET") {
+                r->Get(pattern, noop);
+            } else if (method == "POST") {
+                r->Post(pattern, noop);
+            } else if (method == "PUT") {
+                r->Put(pattern, noop);
+            } else {
+                r->Delete(pattern, noop);
+            }
+        }
+        return r;
+    }();
+    return *instance;
+}
+
+// httplib::Server 内部的 GET 路由表：同样的模式（:id<int> 去掉类型），按注册顺序
+const std::vector<std::unique_ptr<httplib::detail::MatcherBase>>& linearGetRoutes() {
+    static auto* matchers = [] {
+        auto* list = new std::vector<std::unique_ptr<httplib::detail::MatcherBase>>();
+        for (const auto& [method, route] : kRoutes) {
+            if (method != "GET") {
+                continue;
+            }
+            std::string pattern = route;
+            size_t typed = pattern.find("<int>");
+            if (typed != std::string::npos) {
+                pattern.erase(typed, 5);
+            }
+            if (pattern.find("/:") != std::string::npos) {
+                list->push_back(std::make_unique<httplib::detail::PathParamsMatcher>(pattern));
+            } else {
+                list->push_back(std::make_unique<httplib::detail::RegexMatcher>(pattern));
+            }
+        }
+        return list;
+    }();
+    return *matchers;
+}
+
+void BM_RouterDispatch(benchmark::State& state, const std::string& path) {
+    Router& r = router();
+    httplib::Request req;
+    req.method = "GET";
+    req.path = path;
+    httplib::Response res;
+    for (auto _ : state) {
+        bool handled = r.dispatchWithoutBody(req, res);
+        benchmark::DoNotOptimize(handled);
+    }
+}
+
+void BM_LinearMatch(benchmark::State& state, const std::string& path) {
+    const auto& matchers = linearGetRoutes();
+    httplib::Request req;
+    req.method = "GET";
+    req.path = path;
+    for (auto _ : state) {
+        const httplib::detail::MatcherBase* hit = nullptr;
+        for (const auto& matcher : matchers) {
+            if (matcher->match(req)) {
+                hit = matcher.get();
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(hit);
+    }
+}
+
+#define ROUTER_BENCH_PATH(name, path)                                           \
+    BENCHMARK_CAPTURE(BM_RouterDispatch, name, std::string(path));             \
+    BENCHMARK_CAPTURE(BM_LinearMatch, name, std::string(path))
+
+ROUTER_BENCH_PATH(static_posts, "/api/v1/posts");
+ROUTER_BENCH_PATH(user_profile, "/api/v1/users/USR_2025Q4_abc123");
+ROUTER_BENCH_PATH(post_comments, "/api/v1/posts/POST_2025Q4_abc123/comments");
+ROUTER_BENCH_PATH(user_posts, "/api/v1/users/USR_2025Q4_abc123/posts");
+ROUTER_BENCH_PATH(version, "/api/v1/version");
+ROUTER_BENCH_PATH(not_found, "/api/v1/unknown/resource");
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+-- ============================================================================
+-- 关注时间线（收件箱）数据库迁移脚本
+-- ============================================================================
+-- 文件: migration_feed_inbox.sql
+-- 创建时间: 2026-10-18
+-- 版本: v2.11.0
+-- 描述: 创建关注时间线收件箱表（feed_inbox），实现写扩散（fan-out-on-write）
+-- 修改说明: 发帖时把帖子ID推送到每个粉丝的收件箱，读取时直接按时间倒序分页；
+--           粉丝数超过阈值的作者不推送，读取时再合并其最新帖子（读扩散兜底）
+-- ============================================================================
+
+USE knot_image_sharing;
+
+-- ============================================================================
+-- 第1步：创建feed_inbox表（关注时间线收件箱）
+-- ============================================================================
+
+CREATE TABLE IF NOT EXISTS feed_inbox (
+    id BIGINT AUTO_INCREMENT PRIMARY KEY COMMENT '物理ID（自增主键）',
+    user_id BIGINT NOT NULL COMMENT '收件箱所属用户ID（粉丝，物理ID）',
+    post_id BIGINT NOT NULL COMMENT '帖子ID（物理ID，关联posts表）',
+    author_id BIGINT NOT NULL COMMENT '帖子作者ID（物理ID，取消关注时按作者清理）',
+    create_time TIMESTAMP NOT NULL COMMENT '帖子发布时间（冗余，用于排序）',
+
+    -- 外键约束（级联删除：删除帖子/用户时自动清理收件箱）
+    CONSTRAINT fk_feed_inbox_user FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
+    CONSTRAINT fk_feed_inbox_post FOREIGN KEY (post_id) REFERENCES posts(id) ON DELETE CASCADE,
+
+    -- 唯一约束（同一帖子在同一收件箱中只出现一次，配合 INSERT IGNORE 实现幂等推送）
+    UNIQUE KEY uk_user_post (user_id, post_id),
+
+    -- 索引优化
+    INDEX idx_user_time (user_id, create_time DESC, post_id DESC) COMMENT '按时间倒序读取收件箱，裁剪时定位边界',
+    INDEX idx_user_author (user_id, author_id) COMMENT '取消关注时清理该作者的帖子'
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci COMMENT='关注时间线收件箱表';
+
+-- ============================================================================
+-- 第2步：创建feed_pull_authors表（读扩散作者）
+-- ============================================================================
+-- 发帖时因粉丝数超过阈值跳过推送的作者记录在这里，读取时间线时按此表拉取；
+-- 不按作者当前粉丝数判断，粉丝数回落到阈值以下后之前未推送的帖子仍可见
+
+CREATE TABLE IF NOT EXISTS feed_pull_authors (
+    author_id BIGINT PRIMARY KEY COMMENT '作者ID（物理ID）',
+    create_time TIMESTAMP DEFAULT CURRENT_TIMESTAMP COMMENT '首次跳过推送的时间',
+    update_time TIMESTAMP DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP COMMENT '最近一次跳过推送的时间',
+
+    -- 外键约束（级联删除：删除用户时自动清理）
+    CONSTRAINT fk_feed_pull_author FOREIGN KEY (author_id) REFERENCES users(id) ON DELETE CASCADE
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci COMMENT='关注时间线读扩散作者表';
+
+-- ============================================================================
+-- 第3步：验证表结构
+-- ============================================================================
+
+-- 查看feed_inbox表结构
+SHOW CREATE TABLE feed_inbox\G
+
+-- 查看feed_inbox表字段详情
+DESCRIBE feed_inbox;
+
+-- 查看feed_pull_authors表字段详情
+DESCRIBE feed_pull_authors;
+
+-- ============================================================================
+-- 完成
+-- ============================================================================
+-- 迁移脚本执行完成！
+--
+-- 设计要点：
+-- 1. 写扩散 - 发帖时一条 INSERT ... SELECT FROM follows 推送到所有粉丝的收件箱
+-- 2. 有界收件箱 - 每个用户最多保留 feed.inbox_size 条，回填后同步裁剪、推送后由后台线程裁剪超出部分
+-- 3. 大V读扩散 - 粉丝数超过 feed.fanout_max_followers 的作者不推送并记入 feed_pull_authors，读取时合并
+-- 4. 关注/取关 - 关注时回填对方最近的帖子，取关时按 author_id 清理
+-- 5. 级联删除 - 删除帖子/用户时自动清理收件箱
+--
+-- 已有数据：历史帖子不会自动进入收件箱，用户重新关注或作者发新帖后逐步填充
+-- ============================================================================
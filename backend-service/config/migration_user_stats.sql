@@ -0,0 +1,80 @@
+-- ============================================================================
+-- 用户统计物化表数据库迁移脚本
+-- ============================================================================
+-- 文件: migration_user_stats.sql
+-- 创建时间: 2026-10-18
+-- 版本: v2.12.0
+-- 描述: 创建用户统计表（user_stats），由帖子/点赞/收藏/关注服务在事务内增量维护
+-- 修改说明: GET /api/v1/users/:user_id/stats 由多次 COUNT/SUM 聚合改为单行读取
+-- ============================================================================
+
+USE knot_image_sharing;
+
+-- ============================================================================
+-- 第1步：创建user_stats表（每个用户一行）
+-- ============================================================================
+
+CREATE TABLE IF NOT EXISTS user_stats (
+    user_id BIGINT NOT NULL PRIMARY KEY COMMENT '用户ID（物理ID，关联users表）',
+    post_count INT NOT NULL DEFAULT 0 COMMENT '发布的帖子数',
+    total_likes INT NOT NULL DEFAULT 0 COMMENT '帖子获得的点赞总数',
+    total_favorites INT NOT NULL DEFAULT 0 COMMENT '帖子获得的收藏总数',
+    follower_count INT NOT NULL DEFAULT 0 COMMENT '粉丝数（关注我的人数）',
+    following_count INT NOT NULL DEFAULT 0 COMMENT '关注数（我关注的人数）',
+    update_time TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP COMMENT '最后更新时间',
+
+    -- 外键约束（级联删除：删除用户时自动清理统计行）
+    CONSTRAINT fk_user_stats_user FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci COMMENT='用户统计物化表';
+
+-- ============================================================================
+-- 第2步：用现有数据初始化（可重复执行，会以实际数据覆盖）
+-- ============================================================================
+
+INSERT INTO user_stats (user_id, post_count, total_likes, total_favorites, follower_count, following_count)
+SELECT
+    u.id,
+    COALESCE(p.post_count, 0),
+    COALESCE(p.total_likes, 0),
+    COALESCE(p.total_favorites, 0),
+    (SELECT COUNT(*) FROM follows f WHERE f.followee_id = u.id),
+    (SELECT COUNT(*) FROM follows f WHERE f.follower_id = u.id)
+FROM users u
+LEFT JOIN (
+    SELECT user_id,
+           COUNT(*) AS post_count,
+           SUM(like_count) AS total_likes,
+           SUM(favorite_count) AS total_favorites
+    FROM posts
+    GROUP BY user_id
+) p ON p.user_id = u.id
+ON DUPLICATE KEY UPDATE
+    post_count = VALUES(post_count),
+    total_likes = VALUES(total_likes),
+    total_favorites = VALUES(total_favorites),
+    follower_count = VALUES(follower_count),
+    following_count = VALUES(following_count);
+
+-- ============================================================================
+-- 第3步：验证表结构
+-- ============================================================================
+
+-- 查看user_stats表结构
+SHOW CREATE TABLE user_stats\G
+
+-- 抽查统计数据
+SELECT * FROM user_stats ORDER BY follower_count DESC LIMIT 10;
+
+-- ============================================================================
+-- 完成
+-- ============================================================================
+-- 迁移脚本执行完成！
+--
+-- 设计要点：
+-- 1. 主键即用户物理ID - 统计查询是一次主键读取
+-- 2. 事务内增量维护 - 点赞/收藏/关注/删帖与统计更新在同一事务中提交或回滚
+-- 3. UPSERT - 统计行不存在时（例如新注册用户）由第一次更新自动创建
+-- 4. 计数不小于0 - 所有更新使用 GREATEST(..., 0) 防止并发下出现负数
+--
+-- 注意：如果统计出现偏差，可重新执行第2步校准
+-- ============================================================================
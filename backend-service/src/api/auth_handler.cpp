@@ -9,6 +9,7 @@
 #include "../core/auth_service.h"
 #include "../database/user_repository.h"
 #include "../security/jwt_manager.h"
+#include "../server/router.h"
 #include "../utils/logger.h"
 #include "../utils/url_helper.h"
 #include <sstream>
@@ -25,69 +26,63 @@ AuthHandler::~AuthHandler() {
 }
 
 // 注册路由
-void AuthHandler::registerRoutes(httplib::Server& server) {
+void AuthHandler::registerRoutes(Router& router) {
     // 用户注册
-    server.Post("/api/v1/auth/register", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/auth/register", [this](const httplib::Request& req, httplib::Response& res) {
         handleRegister(req, res);
     });
     
     // 用户登录
-    server.Post("/api/v1/auth/login", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/auth/login", [this](const httplib::Request& req, httplib::Response& res) {
         handleLogin(req, res);
     });
     
     // 令牌验证
-    server.Post("/api/v1/auth/validate", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/auth/validate", [this](const httplib::Request& req, httplib::Response& res) {
         handleValidate(req, res);
     });
     
     // 令牌刷新
-    server.Post("/api/v1/auth/refresh", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/auth/refresh", [this](const httplib::Request& req, httplib::Response& res) {
         handleRefresh(req, res);
     });
     
     // 用户登出
-    server.Post("/api/v1/auth/logout", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/auth/logout", [this](const httplib::Request& req, httplib::Response& res) {
         handleLogout(req, res);
     });
     
     // 修改密码（API文档路径：PUT /api/v1/auth/password）
-    server.Put("/api/v1/auth/password", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Put("/api/v1/auth/password", [this](const httplib::Request& req, httplib::Response& res) {
         handleChangePassword(req, res);
     });
 
     // 获取当前用户信息
-    server.Get("/api/v1/users/profile", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/profile", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetProfile(req, res);
     });
 
     // 更新用户信息
-    server.Put("/api/v1/users/profile", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Put("/api/v1/users/profile", [this](const httplib::Request& req, httplib::Response& res) {
         handleUpdateProfile(req, res);
     });
 
-    // 检查用户名可用性 (必须在正则匹配路由之前注册)
-    server.Get("/api/v1/users/check-username", [this](const httplib::Request& req, httplib::Response& res) {
+    // 检查用户名可用性
+    router.Get("/api/v1/users/check-username", [this](const httplib::Request& req, httplib::Response& res) {
         handleCheckUsername(req, res);
     });
 
     // 上传用户头像 (v2.6.0)
-    server.Post("/api/v1/users/avatar", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/users/avatar", [this](const httplib::Request& req, httplib::Response& res) {
         handleUploadAvatar(req, res);
     });
 
-    Logger::info("Auth routes registered");
-}
-
-// 注册通配符路由（必须最后注册）
-void AuthHandler::registerWildcardRoutes(httplib::Server& server) {
-    // 获取用户公开信息 (使用正则表达式，必须放在最后)
-    // 添加$结尾锚点，避免匹配 /api/v1/users/{id}/follow 等带子路径的URL
-    server.Get(R"(/api/v1/users/([^/]+)$)", [this](const httplib::Request& req, httplib::Response& res) {
+    // 获取用户公开信息（静态段 profile、check-username 由路由器优先匹配）
+    router.Get("/api/v1/users/:user_id", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetUserPublicInfo(req, res);
     });
 
-    Logger::info("Auth wildcard routes registered");
+    Logger::info("Auth routes registered");
 }
 
 // 处理用户注册
@@ -434,10 +429,7 @@ void AuthHandler::handleGetUserPublicInfo(const httplib::Request& req, httplib::
     Logger::info("处理获取用户公开信息请求");
 
     // 1. 提取用户ID（从路径参数）
-    std::string userId;
-    if (req.matches.size() > 1) {
-        userId = req.matches[1];
-    }
+    std::string userId = req.path_params.at("user_id");
 
     if (userId.empty()) {
         sendJsonResponse(res, 400, false, "缺少用户ID参数");
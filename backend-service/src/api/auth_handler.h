@@ -13,6 +13,7 @@
 
 // 前向声明
 class AuthService;
+class Router;
 
 /**
  * @brief 认证API处理器类
@@ -34,16 +35,9 @@ public:
     /**
      * @brief 注册路由到HTTP服务器
      * 
-     * @param server HTTP服务器实例
+     * @param router 路由器
      */
-    void registerRoutes(httplib::Server& server);
-    
-    /**
-     * @brief 注册通配符路由（必须最后注册以避免覆盖其他路由）
-     * 
-     * @param server HTTP服务器实例
-     */
-    void registerWildcardRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
     
 private:
     /**
@@ -8,6 +8,7 @@
 #include "base_handler.h"
 #include "core/auth_service.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
 #include <sstream>
 #include <ctime>
 
@@ -28,6 +29,7 @@ std::string BaseHandler::extractToken(const httplib::Request& req) {
 
 // 从JWT令牌中获取用户ID
 int BaseHandler::getUserIdFromToken(const std::string& token) {
+    TraceSpan span("auth");
     try {
         auto authService = std::make_unique<AuthService>();
         TokenValidationResult validation = authService->validateToken(token);
@@ -75,6 +77,7 @@ void BaseHandler::sendJsonResponse(httplib::Response& res,
                                    bool success,
                                    const std::string& message,
                                    const Json::Value& data) {
+    TraceSpan span("json");
     Json::Value response;
     response["success"] = success;
     response["message"] = message;
@@ -6,6 +6,7 @@
  */
 
 #include "api/comment_handler.h"
+#include "server/router.h"
 #include "utils/logger.h"
 #include <json/json.h>
 #include <chrono>
@@ -19,26 +20,26 @@ CommentHandler::CommentHandler() {
 }
 
 // 注册所有路由
-void CommentHandler::registerRoutes(httplib::Server& server) {
+void CommentHandler::registerRoutes(Router& router) {
     Logger::info("CommentHandler::registerRoutes - START");
 
     // 创建评论
     Logger::info("Registering: POST /api/v1/posts/:post_id/comments");
-    server.Post("/api/v1/posts/:post_id/comments", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/posts/:post_id/comments", [this](const httplib::Request& req, httplib::Response& res) {
         Logger::info("CommentHandler::handleCreateComment called");
         handleCreateComment(req, res);
     });
 
     // 获取评论列表
     Logger::info("Registering: GET /api/v1/posts/:post_id/comments");
-    server.Get("/api/v1/posts/:post_id/comments", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/posts/:post_id/comments", [this](const httplib::Request& req, httplib::Response& res) {
         Logger::info("CommentHandler::handleGetComments called");
         handleGetComments(req, res);
     });
 
     // 删除评论
     Logger::info("Registering: DELETE /api/v1/posts/:post_id/comments/:comment_id");
-    server.Delete("/api/v1/posts/:post_id/comments/:comment_id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/posts/:post_id/comments/:comment_id", [this](const httplib::Request& req, httplib::Response& res) {
         Logger::info("CommentHandler::handleDeleteComment called");
         handleDeleteComment(req, res);
     });
@@ -183,6 +184,7 @@ void CommentHandler::handleGetComments(const httplib::Request& req, httplib::Res
             Json::Value data;
             data["comments"] = commentsArray;
             data["total"] = result.total;
+            data["total_is_estimate"] = result.totalIsEstimate;
             data["page"] = page;
             data["page_size"] = pageSize;
             data["has_more"] = result.hasMore;
@@ -12,6 +12,8 @@
 #include "core/user_service.h"
 #include <memory>
 
+class Router;
+
 /**
  * @brief 评论API处理器类
  *
@@ -31,9 +33,9 @@ public:
 
     /**
      * @brief 注册所有路由
-     * @param server HTTP服务器实例
+     * @param router 路由器
      */
-    void registerRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
 
 private:
     std::unique_ptr<CommentService> commentService_;
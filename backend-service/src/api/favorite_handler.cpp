@@ -6,6 +6,7 @@
  */
 
 #include "api/favorite_handler.h"
+#include "server/router.h"
 #include "utils/logger.h"
 #include <json/json.h>
 #include <chrono>
@@ -19,24 +20,24 @@ FavoriteHandler::FavoriteHandler() {
 }
 
 // 注册所有路由
-void FavoriteHandler::registerRoutes(httplib::Server& server) {
+void FavoriteHandler::registerRoutes(Router& router) {
     // 收藏帖子
-    server.Post("/api/v1/posts/:post_id/favorite", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/posts/:post_id/favorite", [this](const httplib::Request& req, httplib::Response& res) {
         handleFavorite(req, res);
     });
 
     // 取消收藏
-    server.Delete("/api/v1/posts/:post_id/favorite", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/posts/:post_id/favorite", [this](const httplib::Request& req, httplib::Response& res) {
         handleUnfavorite(req, res);
     });
 
     // 查询收藏状态
-    server.Get("/api/v1/posts/:post_id/favorite/status", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/posts/:post_id/favorite/status", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetFavoriteStatus(req, res);
     });
 
     // 获取用户收藏列表
-    server.Get("/api/v1/my/favorites", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/my/favorites", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetUserFavorites(req, res);
     });
 
@@ -262,6 +263,7 @@ void FavoriteHandler::handleGetUserFavorites(const httplib::Request& req, httpli
 
         data["posts"] = postsArray;
         data["total"] = result.total;
+        data["total_is_estimate"] = result.totalIsEstimate;
         data["page"] = page;
         data["page_size"] = pageSize;
         data["total_pages"] = (result.total + pageSize - 1) / pageSize;
@@ -13,6 +13,8 @@
 #include "core/like_service.h"
 #include <memory>
 
+class Router;
+
 /**
  * @brief 收藏API处理器类
  *
@@ -32,9 +34,9 @@ public:
 
     /**
      * @brief 注册所有路由
-     * @param server HTTP服务器实例
+     * @param router 路由器
      */
-    void registerRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
 
 private:
     std::unique_ptr<FavoriteService> favoriteService_;
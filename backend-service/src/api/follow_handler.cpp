@@ -6,6 +6,7 @@
  */
 
 #include "api/follow_handler.h"
+#include "server/router.h"
 #include "security/jwt_manager.h"
 #include "utils/logger.h"
 #include <json/json.h>
@@ -16,47 +17,47 @@ FollowHandler::FollowHandler()
 }
 
 // 注册所有路由
-void FollowHandler::registerRoutes(httplib::Server& server) {
+void FollowHandler::registerRoutes(Router& router) {
     Logger::info("FollowHandler: Registering POST /api/v1/users/:user_id/follow");
 
     // POST /api/v1/users/:user_id/follow - 关注用户
-    server.Post("/api/v1/users/:user_id/follow", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/users/:user_id/follow", [this](const httplib::Request& req, httplib::Response& res) {
         Logger::info("POST /api/v1/users/:user_id/follow lambda called - path: " + req.path);
         handleFollow(req, res);
     });
 
     // DELETE /api/v1/users/:user_id/follow - 取消关注
-    server.Delete("/api/v1/users/:user_id/follow", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/users/:user_id/follow", [this](const httplib::Request& req, httplib::Response& res) {
         handleUnfollow(req, res);
     });
 
     // GET /api/v1/users/:user_id/follow/status - 检查关注关系
-    server.Get("/api/v1/users/:user_id/follow/status", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:user_id/follow/status", [this](const httplib::Request& req, httplib::Response& res) {
         handleCheckFollowStatus(req, res);
     });
 
     // GET /api/v1/users/:user_id/following - 获取关注列表
-    server.Get("/api/v1/users/:user_id/following", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:user_id/following", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetFollowingList(req, res);
     });
 
     // GET /api/v1/users/:user_id/followers - 获取粉丝列表
-    server.Get("/api/v1/users/:user_id/followers", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:user_id/followers", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetFollowerList(req, res);
     });
 
     // GET /api/v1/users/:user_id/mutual-follows - 获取互关列表
-    server.Get("/api/v1/users/:user_id/mutual-follows", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:user_id/mutual-follows", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetMutualFollows(req, res);
     });
 
     // GET /api/v1/users/:user_id/stats - 获取用户统计信息
-    server.Get("/api/v1/users/:user_id/stats", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:user_id/stats", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetUserStats(req, res);
     });
 
     // POST /api/v1/users/follow/batch-status - 批量检查关注关系
-    server.Post("/api/v1/users/follow/batch-status", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/users/follow/batch-status", [this](const httplib::Request& req, httplib::Response& res) {
         handleBatchCheckFollowStatus(req, res);
     });
 
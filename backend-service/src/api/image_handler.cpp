@@ -6,6 +6,7 @@
  */
 
 #include "api/image_handler.h"
+#include "server/router.h"
 #include "core/image_service.h"
 #include "core/auth_service.h"
 #include "security/jwt_manager.h"
@@ -25,34 +26,34 @@ ImageHandler::~ImageHandler() {
 }
 
 // 注册路由
-void ImageHandler::registerRoutes(httplib::Server& server) {
+void ImageHandler::registerRoutes(Router& router) {
     // POST /api/v1/images - 上传图片
-    server.Post("/api/v1/images", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/images", [this](const httplib::Request& req, httplib::Response& res) {
         handleUpload(req, res);
     });
     
     // GET /api/v1/images - 获取最新图片列表
-    server.Get("/api/v1/images", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/images", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetRecent(req, res);
     });
     
     // GET /api/v1/images/:id - 获取图片详情
-    server.Get("/api/v1/images/:id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/images/:id", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetById(req, res);
     });
     
-    // PUT /api/v1/images/:id - 更新图文配文 (使用正则表达式以兼容cpp-httplib 0.26.0)
-    server.Put(R"(/api/v1/images/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+    // PUT /api/v1/images/:id - 更新图文配文（图片数字ID）
+    router.Put("/api/v1/images/:id<int>", [this](const httplib::Request& req, httplib::Response& res) {
         handleUpdate(req, res);
     });
     
-    // DELETE /api/v1/images/:id - 删除图片 (使用正则表达式以兼容cpp-httplib 0.26.0)
-    server.Delete(R"(/api/v1/images/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+    // DELETE /api/v1/images/:id - 删除图片（图片数字ID）
+    router.Delete("/api/v1/images/:id<int>", [this](const httplib::Request& req, httplib::Response& res) {
         handleDelete(req, res);
     });
     
     // GET /api/v1/users/:id/images - 获取用户图片列表
-    server.Get("/api/v1/users/:id/images", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:id/images", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetUserImages(req, res);
     });
     
@@ -196,8 +197,8 @@ void ImageHandler::handleUpdate(const httplib::Request& req, httplib::Response&
             return;
         }
         
-        // 2. 从正则匹配中获取图片ID (cpp-httplib 0.26.0兼容)
-        std::string imageId = req.matches.size() > 1 ? req.matches[1].str() : "";
+        // 2. 从路径参数获取图片ID
+        std::string imageId = req.path_params.at("id");
         if (imageId.empty()) {
             sendJsonResponse(res, 400, false, "缺少图片ID参数");
             return;
@@ -250,8 +251,8 @@ void ImageHandler::handleDelete(const httplib::Request& req, httplib::Response&
             return;
         }
         
-        // 2. 从正则匹配中获取图片ID (cpp-httplib 0.26.0兼容)
-        std::string imageId = req.matches.size() > 1 ? req.matches[1].str() : "";
+        // 2. 从路径参数获取图片ID
+        std::string imageId = req.path_params.at("id");
         if (imageId.empty()) {
             sendJsonResponse(res, 400, false, "缺少图片ID参数");
             return;
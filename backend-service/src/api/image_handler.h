@@ -13,6 +13,7 @@
 
 // 前向声明
 class ImageService;
+class Router;
 
 /**
  * @brief 图片API处理器类
@@ -34,9 +35,9 @@ public:
     /**
      * @brief 注册路由到HTTP服务器
      * 
-     * @param server HTTP服务器实例
+     * @param router 路由器
      */
-    void registerRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
     
 private:
     /**
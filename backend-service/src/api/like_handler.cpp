@@ -6,6 +6,7 @@
  */
 
 #include "api/like_handler.h"
+#include "server/router.h"
 #include "utils/logger.h"
 #include <json/json.h>
 #include <chrono>
@@ -17,19 +18,19 @@ LikeHandler::LikeHandler() {
 }
 
 // 注册所有路由
-void LikeHandler::registerRoutes(httplib::Server& server) {
+void LikeHandler::registerRoutes(Router& router) {
     // 点赞帖子
-    server.Post("/api/v1/posts/:post_id/like", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/posts/:post_id/like", [this](const httplib::Request& req, httplib::Response& res) {
         handleLike(req, res);
     });
 
     // 取消点赞
-    server.Delete("/api/v1/posts/:post_id/like", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/posts/:post_id/like", [this](const httplib::Request& req, httplib::Response& res) {
         handleUnlike(req, res);
     });
 
     // 查询点赞状态
-    server.Get("/api/v1/posts/:post_id/like/status", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/posts/:post_id/like/status", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetLikeStatus(req, res);
     });
 
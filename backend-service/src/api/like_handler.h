@@ -11,6 +11,8 @@
 #include "core/like_service.h"
 #include <memory>
 
+class Router;
+
 /**
  * @brief 点赞API处理器类
  *
@@ -30,9 +32,9 @@ public:
 
     /**
      * @brief 注册所有路由
-     * @param server HTTP服务器实例
+     * @param router 路由器
      */
-    void registerRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
 
 private:
     std::unique_ptr<LikeService> likeService_;
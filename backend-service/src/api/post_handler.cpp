@@ -6,7 +6,9 @@
  */
 
 #include "api/post_handler.h"
+#include "server/router.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
 #include "utils/url_helper.h"
 #include "utils/base64_decoder.h"
 #include "database/user_repository.h"
@@ -29,49 +31,54 @@ PostHandler::PostHandler() {
 }
 
 // 注册所有路由
-void PostHandler::registerRoutes(httplib::Server& server) {
+void PostHandler::registerRoutes(Router& router) {
     // 创建帖子
-    server.Post("/api/v1/posts", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/posts", [this](const httplib::Request& req, httplib::Response& res) {
         handleCreatePost(req, res);
     });
     
     // 获取帖子详情
-    server.Get("/api/v1/posts/:post_id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/posts/:post_id", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetPostDetail(req, res);
     });
     
     // 更新帖子
-    server.Put("/api/v1/posts/:post_id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Put("/api/v1/posts/:post_id", [this](const httplib::Request& req, httplib::Response& res) {
         handleUpdatePost(req, res);
     });
 
     // 删除帖子
-    server.Delete("/api/v1/posts/:post_id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/posts/:post_id", [this](const httplib::Request& req, httplib::Response& res) {
         handleDeletePost(req, res);
     });
 
-    // 获取Feed流
-    server.Get("/api/v1/posts", [this](const httplib::Request& req, httplib::Response& res) {
+    // 获取Feed流（?sort=hot 按热度排序）
+    router.Get("/api/v1/posts", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetRecentPosts(req, res);
     });
 
+    // 获取关注时间线
+    router.Get("/api/v1/feed/following", [this](const httplib::Request& req, httplib::Response& res) {
+        handleGetFollowingFeed(req, res);
+    });
+
     // 获取用户帖子列表 (支持逻辑ID和物理ID)
-    server.Get("/api/v1/users/:user_id/posts", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/users/:user_id/posts", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetUserPosts(req, res);
     });
 
     // 向帖子添加图片
-    server.Post("/api/v1/posts/:post_id/images", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/posts/:post_id/images", [this](const httplib::Request& req, httplib::Response& res) {
         handleAddImageToPost(req, res);
     });
 
     // 删除帖子中的图片
-    server.Delete("/api/v1/posts/:post_id/images/:image_id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/posts/:post_id/images/:image_id", [this](const httplib::Request& req, httplib::Response& res) {
         handleRemoveImageFromPost(req, res);
     });
 
     // 调整图片顺序
-    server.Put("/api/v1/posts/:post_id/images/order", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Put("/api/v1/posts/:post_id/images/order", [this](const httplib::Request& req, httplib::Response& res) {
         handleReorderImages(req, res);
     });
     
@@ -708,14 +715,21 @@ void PostHandler::handleGetRecentPosts(const httplib::Request& req, httplib::Res
         
         Logger::info("[GET FEED] Query params - Page: " + std::to_string(page) + 
                     ", PageSize: " + std::to_string(pageSize) + 
+                    ", Sort: " + (req.has_param("sort") ? req.get_param_value("sort") : std::string("latest")) + 
                     ", IsGuest: " + std::string(isGuest ? "true" : "false"));
 
         // ========================================
         // 第3步: 查询帖子列表（基础数据）
         // ========================================
-        auto startTime = std::chrono::steady_clock::now();
-        
-        PostQueryResult result = postService_->getRecentPosts(page, pageSize);
+        // sort=hot 按热度排序，默认按发布时间倒序
+        bool sortByHot = req.has_param("sort") && req.get_param_value("sort") == "hot";
+        PostQueryResult result;
+        {
+            TraceSpan span("posts");
+            result = sortByHot
+                ? postService_->getHotPosts(page, pageSize)
+                : postService_->getRecentPosts(page, pageSize);
+        }
         
         if (!result.success) {
             Logger::error("[GET FEED] ✗ Failed to query posts: " + result.message);
@@ -743,6 +757,7 @@ void PostHandler::handleGetRecentPosts(const httplib::Request& req, httplib::Res
         std::unordered_map<int, User> authorMap;
         
         if (!authorIds.empty()) {
+            TraceSpan span("users");
             authorMap = userService_->batchGetUsers(authorIds);
             Logger::info("[GET FEED] ✓ Authors queried: " + std::to_string(authorMap.size()) + 
                         "/" + std::to_string(authorIds.size()) + " authors found");
@@ -756,8 +771,14 @@ void PostHandler::handleGetRecentPosts(const httplib::Request& req, httplib::Res
         
         if (!isGuest && !postIds.empty()) {
             // 登录用户：批量查询真实的点赞/收藏状态
-            likeStatusMap = likeService_->batchCheckLikedStatus(currentUserId, postIds);
-            favoriteStatusMap = favoriteService_->batchCheckFavoritedStatus(currentUserId, postIds);
+            {
+                TraceSpan span("likes");
+                likeStatusMap = likeService_->batchCheckLikedStatus(currentUserId, postIds);
+            }
+            {
+                TraceSpan span("favorites");
+                favoriteStatusMap = favoriteService_->batchCheckFavoritedStatus(currentUserId, postIds);
+            }
             
             int likedCount = 0, favoritedCount = 0;
             for (const auto& pair : likeStatusMap) if (pair.second) likedCount++;
@@ -778,6 +799,7 @@ void PostHandler::handleGetRecentPosts(const httplib::Request& req, httplib::Res
         // ========================================
         // 第7步: 组装JSON响应
         // ========================================
+        TraceSpan assembleSpan("assemble");
         Json::Value data;
         Json::Value postsArray(Json::arrayValue);
 
@@ -810,17 +832,15 @@ void PostHandler::handleGetRecentPosts(const httplib::Request& req, httplib::Res
 
         data["posts"] = postsArray;
         data["total"] = result.total;
+        data["total_is_estimate"] = result.totalIsEstimate;
         data["page"] = result.page;
         data["page_size"] = result.pageSize;
         
-        auto endTime = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            endTime - startTime
-        ).count();
-        
-        Logger::info("[GET FEED] ✓ Response assembled - Total time: " + 
-                    std::to_string(duration) + "ms, " +
-                    "Mode: " + std::string(isGuest ? "Guest" : "Authenticated"));
+        assembleSpan.end();
+
+        // 各阶段耗时见 Server-Timing 响应头 / trace
+        Logger::info("[GET FEED] ✓ Response assembled - Mode: " +
+                    std::string(isGuest ? "Guest" : "Authenticated"));
 
         sendSuccessResponse(res, "查询成功", data);
 
@@ -830,6 +850,106 @@ void PostHandler::handleGetRecentPosts(const httplib::Request& req, httplib::Res
     }
 }
 
+// GET /api/v1/feed/following - 获取关注时间线
+void PostHandler::handleGetFollowingFeed(const httplib::Request& req, httplib::Response& res) {
+    try {
+        // 1. 验证JWT令牌（关注时间线必须登录）
+        std::string token = extractToken(req);
+        if (token.empty()) {
+            sendErrorResponse(res, 401, "未提供认证令牌");
+            return;
+        }
+
+        int currentUserId = getUserIdFromToken(token);
+        if (currentUserId <= 0) {
+            sendErrorResponse(res, 401, "无效的认证令牌");
+            return;
+        }
+
+        // 2. 获取分页参数
+        int page = 1;
+        int pageSize = 20;
+
+        if (req.has_param("page")) {
+            page = std::stoi(req.get_param_value("page"));
+        }
+
+        if (req.has_param("page_size")) {
+            pageSize = std::stoi(req.get_param_value("page_size"));
+        }
+
+        // 3. 查询关注时间线
+        PostQueryResult result = FeedService::getInstance().getFollowingFeed(currentUserId, page, pageSize);
+        if (!result.success) {
+            sendErrorResponse(res, 400, result.message);
+            return;
+        }
+
+        // 4. 组装JSON响应
+        Json::Value data;
+        data["posts"] = buildPostListJson(result.posts, currentUserId);
+        data["total"] = result.total;
+        data["total_is_estimate"] = result.totalIsEstimate;
+        data["page"] = result.page;
+        data["page_size"] = result.pageSize;
+
+        sendSuccessResponse(res, "查询成功", data);
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in handleGetFollowingFeed: " + std::string(e.what()));
+        sendErrorResponse(res, 500, "服务器内部错误");
+    }
+}
+
+// 组装帖子列表JSON（作者信息 + 互动状态）
+Json::Value PostHandler::buildPostListJson(const std::vector<Post>& posts, int currentUserId) {
+    Json::Value postsArray(Json::arrayValue);
+    if (posts.empty()) {
+        return postsArray;
+    }
+
+    std::vector<int> postIds;
+    std::vector<int> authorIds;
+    for (const auto& post : posts) {
+        postIds.push_back(post.getId());
+        authorIds.push_back(post.getUserId());
+    }
+
+    // 批量查询作者信息和互动状态
+    std::unordered_map<int, User> authorMap = userService_->batchGetUsers(authorIds);
+    std::unordered_map<int, bool> likeStatusMap;
+    std::unordered_map<int, bool> favoriteStatusMap;
+    if (currentUserId > 0) {
+        likeStatusMap = likeService_->batchCheckLikedStatus(currentUserId, postIds);
+        favoriteStatusMap = favoriteService_->batchCheckFavoritedStatus(currentUserId, postIds);
+    }
+
+    for (const auto& post : posts) {
+        Json::Value postJson = postToJson(post, true);
+
+        Json::Value authorInfo;
+        auto authorIt = authorMap.find(post.getUserId());
+        if (authorIt != authorMap.end()) {
+            authorInfo["user_id"] = authorIt->second.getUserId();  // 使用逻辑ID
+            authorInfo["username"] = authorIt->second.getUsername();
+            authorInfo["avatar_url"] = UrlHelper::toFullUrl(authorIt->second.getAvatarUrl());
+        } else {
+            authorInfo["user_id"] = "";
+            authorInfo["username"] = "Unknown";
+            authorInfo["avatar_url"] = "";
+        }
+        postJson["author"] = authorInfo;
+
+        // 互动状态（字段必须存在）
+        postJson["has_liked"] = likeStatusMap[post.getId()];
+        postJson["has_favorited"] = favoriteStatusMap[post.getId()];
+
+        postsArray.append(postJson);
+    }
+
+    return postsArray;
+}
+
 // GET /api/v1/users/:user_id/posts - 获取用户帖子列表
 void PostHandler::handleGetUserPosts(const httplib::Request& req, httplib::Response& res) {
     try {
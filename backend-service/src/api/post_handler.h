@@ -9,11 +9,14 @@
 
 #include "api/base_handler.h"
 #include "core/post_service.h"
+#include "core/feed_service.h"
 #include "core/user_service.h"
 #include "core/like_service.h"
 #include "core/favorite_service.h"
 #include <memory>
 
+class Router;
+
 /**
  * @brief 帖子API处理器类
  * 
@@ -33,9 +36,9 @@ public:
     
     /**
      * @brief 注册所有路由
-     * @param server HTTP服务器实例
+     * @param router 路由器
      */
-    void registerRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
 
 private:
     std::unique_ptr<PostService> postService_;
@@ -72,7 +75,7 @@ private:
     void handleDeletePost(const httplib::Request& req, httplib::Response& res);
     
     /**
-     * @brief GET /api/v1/posts - 获取Feed流（最新帖子列表）
+     * @brief GET /api/v1/posts - 获取Feed流（最新帖子列表，sort=hot 时按热度排序）
      * @param req HTTP请求
      * @param res HTTP响应
      */
@@ -106,6 +109,21 @@ private:
      */
     void handleReorderImages(const httplib::Request& req, httplib::Response& res);
     
+    /**
+     * @brief GET /api/v1/feed/following - 获取关注时间线（需要登录）
+     * @param req HTTP请求
+     * @param res HTTP响应
+     */
+    void handleGetFollowingFeed(const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 组装帖子列表JSON（作者信息 + 点赞/收藏状态）
+     * @param posts 帖子列表
+     * @param currentUserId 当前用户ID（0表示游客，不查询互动状态）
+     * @return 帖子JSON数组
+     */
+    Json::Value buildPostListJson(const std::vector<Post>& posts, int currentUserId);
+
     /**
      * @brief 将Post对象转换为JSON
      * @param post Post对象
@@ -7,6 +7,7 @@
  */
 
 #include "api/share_handler.h"
+#include "server/router.h"
 #include "core/share_service.h"
 #include "security/jwt_manager.h"
 #include "utils/logger.h"
@@ -23,24 +24,24 @@ ShareHandler::ShareHandler()
 ShareHandler::~ShareHandler() = default;
 
 // 注册路由
-void ShareHandler::registerRoutes(httplib::Server& server) {
+void ShareHandler::registerRoutes(Router& router) {
     // POST /api/v1/shares/posts - 创建分享记录
-    server.Post("/api/v1/shares/posts", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Post("/api/v1/shares/posts", [this](const httplib::Request& req, httplib::Response& res) {
         handleCreateShare(req, res);
     });
 
     // GET /api/v1/shares/received - 获取收到的分享列表
-    server.Get("/api/v1/shares/received", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/shares/received", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetReceivedShares(req, res);
     });
 
     // GET /api/v1/shares/sent - 获取发出的分享列表
-    server.Get("/api/v1/shares/sent", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Get("/api/v1/shares/sent", [this](const httplib::Request& req, httplib::Response& res) {
         handleGetSentShares(req, res);
     });
 
     // DELETE /api/v1/shares/:id - 删除分享记录
-    server.Delete("/api/v1/shares/:id", [this](const httplib::Request& req, httplib::Response& res) {
+    router.Delete("/api/v1/shares/:id", [this](const httplib::Request& req, httplib::Response& res) {
         handleDeleteShare(req, res);
     });
 
@@ -210,6 +211,7 @@ void ShareHandler::handleGetReceivedShares(const httplib::Request& req, httplib:
 
             data["shares"] = sharesArray;
             data["total"] = result.total;
+            data["total_is_estimate"] = result.totalIsEstimate;
             data["page"] = result.page;
             data["page_size"] = result.pageSize;
             data["has_more"] = result.hasMore;
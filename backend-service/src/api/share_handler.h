@@ -15,6 +15,7 @@
 // 前向声明
 class ShareService;
 class JWTManager;
+class Router;
 
 /**
  * @brief 分享API处理器类
@@ -41,7 +42,7 @@ public:
      * @brief 注册路由
      * @param server HTTP服务器对象
      */
-    void registerRoutes(httplib::Server& server);
+    void registerRoutes(Router& router);
 
 private:
     std::unique_ptr<ShareService> shareService_;
@@ -0,0 +1,390 @@
+/**
+ * @file static_file_handler.cpp
+ * @brief 静态资源处理器实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "api/static_file_handler.h"
+#include "server/router.h"
+#include "server/sendfile_channel.h"
+#include "core/thumbnail_cache.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// 每次调用 content provider 最多发送的字节数
+constexpr size_t kMaxChunkBytes = 1024 * 1024;
+
+// immutable 资源的 max-age（一年）
+constexpr int kImmutableMaxAge = 31536000;
+
+/**
+ * @brief 已打开的静态文件（RAII，响应发送完毕后关闭）
+ */
+class OpenFile {
+public:
+    OpenFile(int fd, size_t size) : fd_(fd), size_(size), map_(nullptr) {}
+
+    ~OpenFile() {
+        if (map_ != nullptr) {
+            munmap(map_, size_);
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    OpenFile(const OpenFile&) = delete;
+    OpenFile& operator=(const OpenFile&) = delete;
+
+    int fd() const { return fd_; }
+    size_t size() const { return size_; }
+
+    // 按需映射（仅在无法使用 sendfile 时）
+    const char* data() {
+        if (map_ == nullptr) {
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (p == MAP_FAILED) {
+                return nullptr;
+            }
+            map_ = p;
+        }
+        return static_cast<const char*>(map_);
+    }
+
+private:
+    int fd_;
+    size_t size_;
+    void* map_;
+};
+
+}  // namespace
+
+// 构造函数
+StaticFileHandler::StaticFileHandler()
+    : served_(0)
+    , partial_(0)
+    , notModified_(0)
+    , notFound_(0)
+    , sendfileBytes_(0)
+    , mappedBytes_(0)
+    , memoryBytes_(0) {
+    auto& config = ConfigManager::getInstance();
+    enableCache_ = config.get<bool>("static.enable_cache", true);
+    immutable_ = config.get<bool>("static.immutable", true);
+    cacheMaxAge_ = config.get<int>("static.cache_max_age", 3600);
+}
+
+// 析构函数
+StaticFileHandler::~StaticFileHandler() = default;
+
+// 挂载目录
+void StaticFileHandler::mount(Router& router, const std::string& prefix, const std::string& dir,
+                              bool memoryCache) {
+    router.Get(prefix + "/:name", [this, dir, memoryCache](const httplib::Request& req, httplib::Response& res) {
+        handleFile(dir, memoryCache, req, res);
+    });
+}
+
+// 处理静态文件请求
+void StaticFileHandler::handleFile(const std::string& dir, bool memoryCache,
+                                   const httplib::Request& req, httplib::Response& res) {
+    std::string name = req.path_params.at("name");
+    if (!isSafeName(name)) {
+        notFound_++;
+        res.status = 404;
+        return;
+    }
+
+    // 热点缩略图直接从内存返回，不访问文件系统
+    auto& thumbnailCache = ThumbnailCache::getInstance();
+    bool useCache = memoryCache && thumbnailCache.isEnabled();
+    if (useCache) {
+        auto entry = thumbnailCache.get(name);
+        if (entry) {
+            serveEntry(name, entry, req, res);
+            return;
+        }
+    }
+    uint64_t generation = thumbnailCache.generation();
+
+    std::string path = dir + "/" + name;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        notFound_++;
+        res.status = 404;
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        notFound_++;
+        res.status = 404;
+        return;
+    }
+    auto file = std::make_shared<OpenFile>(fd, static_cast<size_t>(st.st_size));
+
+    // 首次读取时填充缩略图缓存，本次也从内存返回；
+    // TinyLFU 不会准入的文件不读入内存，直接走下面的 sendfile
+    if (useCache && thumbnailCache.admits(name, file->size())) {
+        auto entry = std::make_shared<ThumbnailCache::Entry>();
+        entry->modifiedAt = st.st_mtime;
+        if (readFile(file->fd(), file->size(), entry->data)) {
+            thumbnailCache.put(name, entry, generation);
+            serveEntry(name, entry, req, res);
+            return;
+        }
+    }
+
+    std::string etag;
+    std::string lastModified;
+    if (applyValidators(name, file->size(), st.st_mtime, req, res, etag, lastModified)) {
+        return;
+    }
+
+    served_++;
+    std::string contentType = contentTypeFor(name);
+    if (file->size() == 0) {
+        res.set_content("", contentType);
+        return;
+    }
+
+    // If-Range 不匹配时忽略 Range 返回完整内容。
+    // httplib 对 content provider 总是按 req.ranges 切片，因此这种少见情况改用内存响应体
+    if (!rangeApplies(req, etag, lastModified)) {
+        const char* data = file->data();
+        if (data == nullptr) {
+            res.status = 500;
+            return;
+        }
+        mappedBytes_ += file->size();
+        res.status = 200;
+        res.set_content(data, file->size(), contentType);
+        return;
+    }
+
+    if (!req.ranges.empty()) {
+        partial_++;
+    }
+
+    // res.status 保持未设置时 httplib 会按 Range 返回200或206
+    res.set_content_provider(
+        file->size(), contentType,
+        [this, file](size_t offset, size_t length, httplib::DataSink& sink) -> bool {
+            size_t chunk = std::min(length, kMaxChunkBytes);
+
+            if (SendfileChannel::available()) {
+                if (!SendfileChannel::send(file->fd(), static_cast<off_t>(offset), chunk)) {
+                    return false;
+                }
+                sendfileBytes_ += chunk;
+                // 数据已在套接字上，流只需推进偏移
+                return sink.write(nullptr, chunk);
+            }
+
+            const char* data = file->data();
+            if (data == nullptr) {
+                Logger::error("Failed to mmap static file");
+                return false;
+            }
+            mappedBytes_ += chunk;
+            return sink.write(data + offset, chunk);
+        });
+}
+
+// 从内存缓存项返回
+void StaticFileHandler::serveEntry(const std::string& name, std::shared_ptr<const ThumbnailCache::Entry> entry,
+                                   const httplib::Request& req, httplib::Response& res) {
+    std::string etag;
+    std::string lastModified;
+    if (applyValidators(name, entry->data.size(), entry->modifiedAt, req, res, etag, lastModified)) {
+        return;
+    }
+
+    served_++;
+    std::string contentType = contentTypeFor(name);
+    if (entry->data.empty() || !rangeApplies(req, etag, lastModified)) {
+        memoryBytes_ += entry->data.size();
+        res.status = 200;
+        res.set_content(entry->data, contentType);
+        return;
+    }
+
+    if (!req.ranges.empty()) {
+        partial_++;
+    }
+
+    res.set_content_provider(
+        entry->data.size(), contentType,
+        [this, entry](size_t offset, size_t length, httplib::DataSink& sink) -> bool {
+            memoryBytes_ += length;
+            return sink.write(entry->data.data() + offset, length);
+        });
+}
+
+// 设置缓存校验头并处理条件请求
+bool StaticFileHandler::applyValidators(const std::string& name, size_t size, time_t modifiedAt,
+                                        const httplib::Request& req, httplib::Response& res,
+                                        std::string& etag, std::string& lastModified) {
+    // 强 ETag：文件名中的业务ID + 文件大小
+    std::string stem = name.substr(0, name.rfind('.'));
+    std::ostringstream etagStream;
+    etagStream << '"' << stem << '-' << std::hex << size << '"';
+    etag = etagStream.str();
+    lastModified = formatHttpDate(modifiedAt);
+
+    res.set_header("ETag", etag);
+    res.set_header("Last-Modified", lastModified);
+    res.set_header("Accept-Ranges", "bytes");
+    if (!enableCache_) {
+        res.set_header("Cache-Control", "no-cache");
+    } else if (immutable_) {
+        res.set_header("Cache-Control", "public, max-age=" + std::to_string(kImmutableMaxAge) + ", immutable");
+    } else {
+        res.set_header("Cache-Control", "public, max-age=" + std::to_string(cacheMaxAge_));
+    }
+
+    // If-None-Match 优先于 If-Modified-Since
+    bool notModified = false;
+    if (req.has_header("If-None-Match")) {
+        notModified = etagMatches(req.get_header_value("If-None-Match"), etag);
+    } else if (req.has_header("If-Modified-Since")) {
+        time_t since = parseHttpDate(req.get_header_value("If-Modified-Since"));
+        notModified = since != -1 && modifiedAt <= since;
+    }
+    if (notModified) {
+        notModified_++;
+        res.status = 304;
+    }
+    return notModified;
+}
+
+// 判断 Range 是否生效（If-Range 不匹配时忽略 Range）
+bool StaticFileHandler::rangeApplies(const httplib::Request& req, const std::string& etag,
+                                     const std::string& lastModified) {
+    if (req.ranges.empty() || !req.has_header("If-Range")) {
+        return true;
+    }
+    std::string ifRange = req.get_header_value("If-Range");
+    return ifRange.empty() || ifRange[0] != '"' ? ifRange == lastModified : ifRange == etag;
+}
+
+// 读取整个文件
+bool StaticFileHandler::readFile(int fd, size_t size, std::string& data) {
+    data.resize(size);
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = pread(fd, &data[total], size - total, static_cast<off_t>(total));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 获取统计信息
+Json::Value StaticFileHandler::getStats() const {
+    Json::Value stats;
+    stats["served"] = static_cast<Json::UInt64>(served_.load());
+    stats["partial"] = static_cast<Json::UInt64>(partial_.load());
+    stats["not_modified"] = static_cast<Json::UInt64>(notModified_.load());
+    stats["not_found"] = static_cast<Json::UInt64>(notFound_.load());
+    stats["sendfile_bytes"] = static_cast<Json::UInt64>(sendfileBytes_.load());
+    stats["mapped_bytes"] = static_cast<Json::UInt64>(mappedBytes_.load());
+    stats["memory_bytes"] = static_cast<Json::UInt64>(memoryBytes_.load());
+    return stats;
+}
+
+// 检查文件名是否安全
+bool StaticFileHandler::isSafeName(const std::string& name) {
+    if (name.empty() || name[0] == '.' || name.find("..") != std::string::npos) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](unsigned char c) {
+        return std::isalnum(c) || c == '_' || c == '-' || c == '.';
+    });
+}
+
+// 根据扩展名获取MIME类型
+std::string StaticFileHandler::contentTypeFor(const std::string& name) {
+    size_t dot = name.rfind('.');
+    std::string ext = dot == std::string::npos ? "" : name.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (ext == "jpg" || ext == "jpeg") {
+        return "image/jpeg";
+    }
+    if (ext == "png") {
+        return "image/png";
+    }
+    if (ext == "webp") {
+        return "image/webp";
+    }
+    if (ext == "gif") {
+        return "image/gif";
+    }
+    return "application/octet-stream";
+}
+
+// 格式化 HTTP 日期
+std::string StaticFileHandler::formatHttpDate(time_t t) {
+    struct tm tmValue;
+    gmtime_r(&t, &tmValue);
+    char buffer[64];
+    strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tmValue);
+    return buffer;
+}
+
+// 解析 HTTP 日期
+time_t StaticFileHandler::parseHttpDate(const std::string& value) {
+    struct tm tmValue;
+    memset(&tmValue, 0, sizeof(tmValue));
+    if (strptime(value.c_str(), "%a, %d %b %Y %H:%M:%S", &tmValue) == nullptr) {
+        return -1;
+    }
+    return timegm(&tmValue);
+}
+
+// 判断 If-None-Match 是否命中
+bool StaticFileHandler::etagMatches(const std::string& header, const std::string& etag) {
+    size_t pos = 0;
+    while (pos < header.size()) {
+        size_t comma = header.find(',', pos);
+        std::string item = header.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        pos = comma == std::string::npos ? header.size() : comma + 1;
+
+        size_t begin = item.find_first_not_of(" \t");
+        if (begin == std::string::npos) {
+            continue;
+        }
+        size_t end = item.find_last_not_of(" \t");
+        item = item.substr(begin, end - begin + 1);
+
+        // If-None-Match 使用弱比较
+        if (item.compare(0, 2, "W/") == 0) {
+            item = item.substr(2);
+        }
+        if (item == "*" || item == etag) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file static_file_handler.h
+ * @brief 静态资源处理器（图片、缩略图、头像）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "httplib.h"
+#include "core/thumbnail_cache.h"
+#include <json/json.h>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+
+class Router;
+
+/**
+ * @brief 静态资源处理器
+ *
+ * 替代 httplib 的 set_mount_point（每次请求都把整个文件读入内存）：
+ * - epoll 后端和启用 kTLS 的 TLS 连接使用 sendfile 零拷贝发送，其余情况使用 mmap 映射发送
+ * - 支持 Range（由 httplib 按 content provider 切片，返回206/416）
+ * - 强 ETag 由文件名中的业务ID（IMG_xxx / USR_xxx）与文件大小组成
+ * - 支持 If-None-Match / If-Modified-Since / If-Range 条件请求
+ * - 上传文件按ID写入后不再修改，默认返回 immutable 的 Cache-Control
+ * - 缩略图目录可启用 ThumbnailCache，热点缩略图直接从内存返回
+ */
+class StaticFileHandler {
+public:
+    /**
+     * @brief 构造函数：读取 static.* 缓存配置
+     */
+    StaticFileHandler();
+
+    /**
+     * @brief 析构函数
+     */
+    ~StaticFileHandler();
+
+    /**
+     * @brief 挂载目录到URL前缀
+     *
+     * GET/HEAD {prefix}/{filename}
+     *
+     * @param router 路由器
+     * @param prefix URL前缀（如 /uploads/images）
+     * @param dir 本地目录
+     * @param memoryCache 是否使用 ThumbnailCache 缓存文件内容
+     */
+    void mount(Router& router, const std::string& prefix, const std::string& dir,
+               bool memoryCache = false);
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+private:
+    /**
+     * @brief 处理静态文件请求
+     */
+    void handleFile(const std::string& dir, bool memoryCache, const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 从内存缓存项返回响应
+     */
+    void serveEntry(const std::string& name, std::shared_ptr<const ThumbnailCache::Entry> entry,
+                    const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 设置 ETag/Last-Modified/Cache-Control 并处理 If-None-Match/If-Modified-Since
+     * @param etag 输出：ETag
+     * @param lastModified 输出：Last-Modified
+     * @return 已返回304时返回true
+     */
+    bool applyValidators(const std::string& name, size_t size, time_t modifiedAt,
+                         const httplib::Request& req, httplib::Response& res,
+                         std::string& etag, std::string& lastModified);
+
+    /**
+     * @brief 判断 Range 是否生效（If-Range 不匹配时返回false）
+     */
+    static bool rangeApplies(const httplib::Request& req, const std::string& etag, const std::string& lastModified);
+
+    /**
+     * @brief 读取整个文件
+     * @return 成功返回true
+     */
+    static bool readFile(int fd, size_t size, std::string& data);
+
+    /**
+     * @brief 检查文件名是否安全（只允许字母、数字、'_'、'-'、'.'，且不含 ".."）
+     */
+    static bool isSafeName(const std::string& name);
+
+    /**
+     * @brief 根据扩展名获取MIME类型
+     */
+    static std::string contentTypeFor(const std::string& name);
+
+    /**
+     * @brief 格式化 HTTP 日期（RFC 7231 IMF-fixdate）
+     */
+    static std::string formatHttpDate(time_t t);
+
+    /**
+     * @brief 解析 HTTP 日期
+     * @return 成功返回时间戳，失败返回-1
+     */
+    static time_t parseHttpDate(const std::string& value);
+
+    /**
+     * @brief 判断 If-None-Match 是否命中（弱比较）
+     */
+    static bool etagMatches(const std::string& header, const std::string& etag);
+
+    bool enableCache_;
+    bool immutable_;
+    int cacheMaxAge_;           // 非 immutable 时的 max-age（秒）
+
+    std::atomic<uint64_t> served_;
+    std::atomic<uint64_t> partial_;
+    std::atomic<uint64_t> notModified_;
+    std::atomic<uint64_t> notFound_;
+    std::atomic<uint64_t> sendfileBytes_;
+    std::atomic<uint64_t> mappedBytes_;
+    std::atomic<uint64_t> memoryBytes_;
+};
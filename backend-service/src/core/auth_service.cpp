@@ -7,6 +7,7 @@
 
 #include "core/auth_service.h"
 #include "database/user_repository.h"
+#include "database/db_operation_scope.h"
 #include "security/jwt_manager.h"
 #include "security/password_hasher.h"
 #include "utils/logger.h"
@@ -697,10 +698,14 @@ UploadAvatarResult AuthService::uploadAvatar(int userId, const std::string& temp
         
         std::string userIdStr = existingUser->getUserId();
         
-        // 2. 调用AvatarProcessor处理图片
+        // 2. 调用AvatarProcessor处理图片（不访问数据库，期间暂停请求的连接作用域）
         // 使用相对路径 "../uploads/avatars/" 与图片存储保持一致
         std::string avatarDir = "../uploads/avatars";
-        auto processResult = AvatarProcessor::processAvatar(tempFilePath, userIdStr, avatarDir);
+        AvatarProcessResult processResult;
+        {
+            DbOperationScope::Suspension suspendDb;
+            processResult = AvatarProcessor::processAvatar(tempFilePath, userIdStr, avatarDir);
+        }
         
         if (!processResult.success) {
             result.message = processResult.message;
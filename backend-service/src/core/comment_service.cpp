@@ -6,6 +6,8 @@
  */
 
 #include "core/comment_service.h"
+#include "core/hot_ranking_engine.h"
+#include "core/count_service.h"
 #include "database/comment_repository.h"
 #include "database/post_repository.h"
 #include "database/user_repository.h"
@@ -107,8 +109,18 @@ CommentResult CommentService::createComment(int userId, const std::string& postI
             return result;
         }
 
+        // 获取数据库连接（整个操作只占用这一个连接）
+        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+        if (!connGuard.isValid()) {
+            result.statusCode = 500;
+            result.message = "数据库连接失败";
+            return result;
+        }
+
+        MYSQL* conn = connGuard.get();
+
         // 2. 查询帖子是否存在
-        auto post = postRepo_->findByPostId(postId);
+        auto post = postRepo_->findByPostId(conn, postId);
         if (!post.has_value()) {
             result.statusCode = 404;
             result.message = "帖子不存在";
@@ -126,16 +138,6 @@ CommentResult CommentService::createComment(int userId, const std::string& postI
         comment.setContent(content);
         comment.setCreateTime(std::time(nullptr));
 
-        // 获取数据库连接
-        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
-        if (!connGuard.isValid()) {
-            result.statusCode = 500;
-            result.message = "数据库连接失败";
-            return result;
-        }
-
-        MYSQL* conn = connGuard.get();
-
         // 5. 开启事务
         if (mysql_query(conn, "START TRANSACTION") != 0) {
             Logger::error("Failed to start transaction: " + std::string(mysql_error(conn)));
@@ -169,8 +171,11 @@ CommentResult CommentService::createComment(int userId, const std::string& postI
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(post->getId(), HotRankingEngine::Signal::Comment, 1);
+
         // 9. 查询最新评论数
-        auto updatedPost = postRepo_->findByPostId(postId);
+        auto updatedPost = postRepo_->findByPostId(conn, postId);
         int newCommentCount = updatedPost.has_value() ? updatedPost->getCommentCount() : (post->getCommentCount() + 1);
 
         result.success = true;
@@ -205,15 +210,7 @@ CommentListResult CommentService::getCommentsByPost(const std::string& postId, i
             pageSize = 20;
         }
 
-        // 2. 查询帖子是否存在
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -223,12 +220,24 @@ CommentListResult CommentService::getCommentsByPost(const std::string& postId, i
 
         MYSQL* conn = connGuard.get();
 
+        // 2. 查询帖子是否存在
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 3. 查询评论列表（分页）
         int offset = (page - 1) * pageSize;
         std::vector<Comment> comments = commentRepo_->findByPostId(conn, post->getId(), pageSize, offset);
 
-        // 4. 统计总评论数
-        int total = commentRepo_->countByPostId(conn, post->getId());
+        // 4. 统计总评论数（post_comments 可配置为缓存近似值）
+        int postPhysicalId = post->getId();
+        CountResult count = CountService::getInstance().getCount(
+            "post_comments", std::to_string(postPhysicalId), conn,
+            [repo = commentRepo_.get(), postPhysicalId](MYSQL* c) { return repo->countByPostId(c, postPhysicalId); });
+        int total = count.value;
 
         // 5. 计算是否有更多评论
         bool hasMore = (offset + comments.size()) < total;
@@ -238,6 +247,7 @@ CommentListResult CommentService::getCommentsByPost(const std::string& postId, i
         result.message = "获取评论列表成功";
         result.comments = comments;
         result.total = total;
+        result.totalIsEstimate = count.isEstimate;
         result.hasMore = hasMore;
 
         Logger::info("Found " + std::to_string(comments.size()) + " comments (total=" + std::to_string(total) + ")");
@@ -298,7 +308,7 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
         }
 
         const char* query = "SELECT user_id FROM posts WHERE id = ?";
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             result.statusCode = 500;
             result.message = "数据库查询失败";
             return result;
@@ -316,7 +326,7 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
             return result;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             result.statusCode = 500;
             result.message = "数据库查询失败";
             return result;
@@ -334,13 +344,13 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
             return result;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             result.statusCode = 500;
             result.message = "数据库查询失败";
             return result;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) != 0) {
+        if (stmt.fetch() != 0) {
             result.statusCode = 404;
             result.message = "帖子不存在";
             return result;
@@ -389,6 +399,9 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(comment->getPostId(), HotRankingEngine::Signal::Comment, -1);
+
         // 8. 查询最新评论数（通过SQL直接查询comment_count字段）
         const char* countQuery = "SELECT comment_count FROM posts WHERE id = ?";
         MySQLStatement countStmt(conn);
@@ -398,7 +411,7 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
             return result;
         }
 
-        if (mysql_stmt_prepare(countStmt.get(), countQuery, strlen(countQuery)) != 0) {
+        if (countStmt.prepare(countQuery, strlen(countQuery)) != 0) {
             result.statusCode = 500;
             result.message = "查询评论数失败";
             return result;
@@ -416,7 +429,7 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
             return result;
         }
 
-        if (mysql_stmt_execute(countStmt.get()) != 0) {
+        if (countStmt.execute() != 0) {
             result.statusCode = 500;
             result.message = "查询评论数失败";
             return result;
@@ -434,13 +447,13 @@ CommentResult CommentService::deleteComment(int userId, const std::string& comme
             return result;
         }
 
-        if (mysql_stmt_store_result(countStmt.get()) != 0) {
+        if (countStmt.storeResult() != 0) {
             result.statusCode = 500;
             result.message = "查询评论数失败";
             return result;
         }
 
-        mysql_stmt_fetch(countStmt.get());
+        countStmt.fetch();
 
         result.success = true;
         result.statusCode = 200;
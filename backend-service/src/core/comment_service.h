@@ -41,10 +41,11 @@ struct CommentListResult {
     std::string message;             // 消息
     std::vector<Comment> comments;   // 评论列表
     int total;                       // 总评论数
+    bool totalIsEstimate;            // total 是否为缓存的近似值
     bool hasMore;                    // 是否有更多评论
 
     CommentListResult()
-        : success(false), statusCode(500), message(""), comments(), total(0), hasMore(false) {}
+        : success(false), statusCode(500), message(""), comments(), total(0), totalIsEstimate(false), hasMore(false) {}
 };
 
 /**
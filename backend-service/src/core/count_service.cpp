@@ -0,0 +1,228 @@
+/**
+ * @file count_service.cpp
+ * @brief 分页总数计数服务实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "core/count_service.h"
+#include "database/connection_guard.h"
+#include "database/connection_pool.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <exception>
+
+namespace {
+
+// 解析模式字符串（无法识别时使用默认值）
+CountService::Mode parseMode(const std::string& value, CountService::Mode fallback) {
+    if (value == "exact") {
+        return CountService::Mode::Exact;
+    }
+    if (value == "approximate") {
+        return CountService::Mode::Approximate;
+    }
+    return fallback;
+}
+
+const char* modeName(CountService::Mode mode) {
+    return mode == CountService::Mode::Approximate ? "approximate" : "exact";
+}
+
+}  // namespace
+
+// 获取单例实例
+CountService& CountService::getInstance() {
+    static CountService instance;
+    return instance;
+}
+
+// 构造函数：读取计数配置并启动刷新线程
+CountService::CountService()
+    : stopping_(false)
+    , exactCounts_(0)
+    , estimateHits_(0)
+    , freshHits_(0)
+    , asyncRefreshes_(0) {
+    auto& config = ConfigManager::getInstance();
+    defaultMode_ = parseMode(config.get<std::string>("counts.default_mode", "exact"), Mode::Exact);
+    ttlSeconds_ = config.get<int>("counts.ttl_seconds", 60);
+    maxEntries_ = config.get<int>("counts.max_entries", 100000);
+
+    const Json::Value& endpoints = config.getConfig()["counts"]["endpoints"];
+    if (endpoints.isObject()) {
+        for (const auto& name : endpoints.getMemberNames()) {
+            if (endpoints[name].isString()) {
+                endpointModes_[name] = parseMode(endpoints[name].asString(), defaultMode_);
+            }
+        }
+    }
+
+    worker_ = std::thread(&CountService::refreshLoop, this);
+
+    Logger::info("CountService initialized (default_mode=" + std::string(modeName(defaultMode_)) +
+                ", ttl_seconds=" + std::to_string(ttlSeconds_) +
+                ", max_entries=" + std::to_string(maxEntries_) + ")");
+}
+
+// 析构函数：停止刷新线程
+CountService::~CountService() {
+    shutdown();
+}
+
+// 停止刷新线程
+void CountService::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    queueCondition_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+// 获取接口的计数模式
+CountService::Mode CountService::getMode(const std::string& endpoint) const {
+    auto it = endpointModes_.find(endpoint);
+    return it != endpointModes_.end() ? it->second : defaultMode_;
+}
+
+// 获取计数
+CountResult CountService::getCount(const std::string& endpoint, const std::string& key,
+                                   MYSQL* conn, const Counter& counter) {
+    if (getMode(endpoint) == Mode::Exact) {
+        exactCounts_++;
+        int value = runCounter(conn, counter);
+        return CountResult(value < 0 ? 0 : value, false);
+    }
+
+    std::string cacheKey = endpoint + ":" + key;
+    std::time_t now = std::time(nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(cacheKey);
+        if (it != entries_.end()) {
+            Entry& entry = it->second;
+            // 缓存值都是近似值：计算之后的写入不会反映在其中
+            if (now - entry.computedAt < ttlSeconds_) {
+                freshHits_++;
+                return CountResult(entry.value, true);
+            }
+
+            // 已过期：返回旧值，后台刷新
+            if (!entry.refreshing && !stopping_) {
+                entry.refreshing = true;
+                queue_.push_back(RefreshTask{cacheKey, counter});
+                queueCondition_.notify_one();
+            }
+            estimateHits_++;
+            return CountResult(entry.value, true);
+        }
+    }
+
+    // 首次请求：同步计算（不持有锁执行SQL）
+    exactCounts_++;
+    int value = runCounter(conn, counter);
+    if (value < 0) {
+        return CountResult(0, false);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    storeLocked(cacheKey, value, now);
+    return CountResult(value, false);
+}
+
+// 获取统计信息
+Json::Value CountService::getStats() const {
+    Json::Value stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats["entries"] = static_cast<Json::UInt64>(entries_.size());
+        stats["queued_refreshes"] = static_cast<Json::UInt64>(queue_.size());
+    }
+    stats["default_mode"] = modeName(defaultMode_);
+    Json::Value endpoints(Json::objectValue);
+    for (const auto& item : endpointModes_) {
+        endpoints[item.first] = modeName(item.second);
+    }
+    stats["endpoints"] = endpoints;
+    stats["ttl_seconds"] = ttlSeconds_;
+    stats["exact_counts"] = static_cast<Json::UInt64>(exactCounts_.load());
+    stats["fresh_hits"] = static_cast<Json::UInt64>(freshHits_.load());
+    stats["estimate_hits"] = static_cast<Json::UInt64>(estimateHits_.load());
+    stats["async_refreshes"] = static_cast<Json::UInt64>(asyncRefreshes_.load());
+    return stats;
+}
+
+// 执行计数
+int CountService::runCounter(MYSQL* conn, const Counter& counter) {
+    try {
+        if (conn) {
+            return counter(conn);
+        }
+
+        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+        if (!connGuard.isValid()) {
+            Logger::error("Failed to get database connection for count");
+            return -1;
+        }
+        return counter(connGuard.get());
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in CountService::runCounter: " + std::string(e.what()));
+        return -1;
+    }
+}
+
+// 写入缓存条目（调用方需持有锁）
+void CountService::storeLocked(const std::string& cacheKey, int value, std::time_t now) {
+    auto it = entries_.find(cacheKey);
+    if (it != entries_.end()) {
+        it->second.value = value;
+        it->second.computedAt = now;
+        it->second.refreshing = false;
+        return;
+    }
+
+    entries_.emplace(cacheKey, Entry{value, now, false});
+    insertionOrder_.push_back(cacheKey);
+
+    // 超出容量：淘汰最早插入的条目
+    while (static_cast<int>(entries_.size()) > maxEntries_ && !insertionOrder_.empty()) {
+        entries_.erase(insertionOrder_.front());
+        insertionOrder_.pop_front();
+    }
+}
+
+// 后台刷新线程主循环
+void CountService::refreshLoop() {
+    while (true) {
+        RefreshTask task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queueCondition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        int value = runCounter(nullptr, task.counter);
+        asyncRefreshes_++;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(task.cacheKey);
+        if (it == entries_.end()) {
+            continue;  // 刷新期间已被淘汰
+        }
+        if (value < 0) {
+            it->second.refreshing = false;  // 刷新失败，下次过期读取时重试
+            continue;
+        }
+        storeLocked(task.cacheKey, value, std::time(nullptr));
+    }
+}
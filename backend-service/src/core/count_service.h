@@ -0,0 +1,160 @@
+/**
+ * @file count_service.h
+ * @brief 分页总数计数服务（精确 / 缓存近似两种模式）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <mysql/mysql.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <json/json.h>
+
+/**
+ * @brief 计数结果
+ */
+struct CountResult {
+    int value;              // 计数值
+    bool isEstimate;        // 是否为缓存的近似值（响应中标记 total_is_estimate）
+
+    CountResult() : value(0), isEstimate(false) {}
+    CountResult(int v, bool estimate) : value(v), isEstimate(estimate) {}
+};
+
+/**
+ * @brief 分页总数计数服务（单例）
+ *
+ * 每个接口（endpoint）可独立配置计数模式：
+ * - exact：每次请求都执行 COUNT(*)（默认）
+ * - approximate：按 (endpoint, key) 缓存计数值；只有首次请求同步计算的值是精确值，
+ *   之后从缓存返回的值都标记为近似（计算后可能已有写入）；
+ *   超过 ttl_seconds 后继续返回旧值，同时交给后台线程异步刷新
+ *
+ * 设计要点：
+ * - 后台只有一个刷新线程，同一个key在队列中最多出现一次
+ * - 异步刷新在后台线程中自行获取数据库连接，计数函数不能捕获调用方的连接；
+ *   可以捕获服务的仓储成员：服务随 HttpServer 存活到进程退出，退出前先调用 shutdown()
+ *   停止并等待刷新线程，之后才析构服务和静态对象
+ * - 缓存条目超过 max_entries 时按插入顺序淘汰
+ */
+class CountService {
+public:
+    /**
+     * @brief 计数函数：接收一个可用的数据库连接，返回计数值（失败返回负数）
+     */
+    using Counter = std::function<int(MYSQL* conn)>;
+
+    /**
+     * @brief 计数模式
+     */
+    enum class Mode {
+        Exact,
+        Approximate
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return CountService引用
+     */
+    static CountService& getInstance();
+
+    /**
+     * @brief 获取计数
+     * @param endpoint 接口名（对应 counts.endpoints 下的配置项）
+     * @param key 计数对象标识（例如用户ID、帖子ID）
+     * @param conn 调用方已持有的连接，用于同步计算；为nullptr时自行获取
+     * @param counter 计数函数
+     * @return 计数结果
+     */
+    CountResult getCount(const std::string& endpoint, const std::string& key,
+                         MYSQL* conn, const Counter& counter);
+
+    /**
+     * @brief 获取接口的计数模式
+     * @param endpoint 接口名
+     * @return 计数模式
+     */
+    Mode getMode(const std::string& endpoint) const;
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    /**
+     * @brief 停止刷新线程并等待其退出（丢弃未执行的刷新任务，可重复调用）
+     *
+     * 关闭服务器时在析构服务对象之前调用；之后的过期读取直接返回旧值
+     */
+    void shutdown();
+
+    // 禁止拷贝
+    CountService(const CountService&) = delete;
+    CountService& operator=(const CountService&) = delete;
+
+private:
+    CountService();
+    ~CountService();
+
+    /**
+     * @brief 缓存条目
+     */
+    struct Entry {
+        int value;
+        std::time_t computedAt;
+        bool refreshing;        // 已在刷新队列中
+    };
+
+    /**
+     * @brief 刷新任务
+     */
+    struct RefreshTask {
+        std::string cacheKey;
+        Counter counter;
+    };
+
+    /**
+     * @brief 执行计数（conn为nullptr时从连接池获取）
+     * @return 计数值，失败返回-1
+     */
+    int runCounter(MYSQL* conn, const Counter& counter);
+
+    /**
+     * @brief 写入缓存条目（调用方需持有锁）
+     */
+    void storeLocked(const std::string& cacheKey, int value, std::time_t now);
+
+    /**
+     * @brief 后台刷新线程主循环
+     */
+    void refreshLoop();
+
+    std::unordered_map<std::string, Entry> entries_;
+    std::deque<std::string> insertionOrder_;    // 淘汰顺序
+    std::deque<RefreshTask> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable queueCondition_;
+    std::thread worker_;
+    bool stopping_;
+
+    std::atomic<uint64_t> exactCounts_;         // 同步执行的 COUNT 次数
+    std::atomic<uint64_t> estimateHits_;        // 返回过期缓存值的次数
+    std::atomic<uint64_t> freshHits_;           // 命中未过期缓存的次数
+    std::atomic<uint64_t> asyncRefreshes_;      // 后台刷新次数
+
+    Mode defaultMode_;
+    std::unordered_map<std::string, Mode> endpointModes_;
+    int ttlSeconds_;
+    int maxEntries_;
+};
@@ -6,8 +6,11 @@
  */
 
 #include "core/favorite_service.h"
+#include "core/hot_ranking_engine.h"
+#include "core/count_service.h"
 #include "database/favorite_repository.h"
 #include "database/post_repository.h"
+#include "database/user_stats_repository.h"
 #include "database/connection_guard.h"
 #include "database/connection_pool.h"
 #include "utils/logger.h"
@@ -16,6 +19,7 @@
 FavoriteService::FavoriteService() {
     favoriteRepo_ = std::make_unique<FavoriteRepository>();
     postRepo_ = std::make_unique<PostRepository>();
+    userStatsRepo_ = std::make_unique<UserStatsRepository>();
     Logger::info("FavoriteService initialized");
 }
 
@@ -31,15 +35,7 @@ FavoriteResult FavoriteService::favoritePost(int userId, const std::string& post
     try {
         Logger::info("User " + std::to_string(userId) + " favoriting post " + postId);
 
-        // 1. 查询帖子
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -49,6 +45,14 @@ FavoriteResult FavoriteService::favoritePost(int userId, const std::string& post
 
         MYSQL* conn = connGuard.get();
 
+        // 1. 查询帖子
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 2. 检查是否已收藏（幂等性）
         if (favoriteRepo_->exists(conn, userId, post->getId())) {
             result.success = true;
@@ -83,6 +87,14 @@ FavoriteResult FavoriteService::favoritePost(int userId, const std::string& post
             return result;
         }
 
+        // 同步更新作者的用户统计
+        if (!userStatsRepo_->adjustTotalFavorites(conn, post->getUserId(), 1)) {
+            mysql_query(conn, "ROLLBACK");
+            result.statusCode = 500;
+            result.message = "更新用户统计失败";
+            return result;
+        }
+
         // 6. 提交事务
         if (mysql_query(conn, "COMMIT") != 0) {
             Logger::error("Failed to commit transaction: " + std::string(mysql_error(conn)));
@@ -92,8 +104,11 @@ FavoriteResult FavoriteService::favoritePost(int userId, const std::string& post
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(post->getId(), HotRankingEngine::Signal::Favorite, 1);
+
         // 7. 查询最新收藏数
-        auto updatedPost = postRepo_->findByPostId(postId);
+        auto updatedPost = postRepo_->findByPostId(conn, postId);
         int newFavoriteCount = updatedPost.has_value() ? updatedPost->getFavoriteCount() : (post->getFavoriteCount() + 1);
 
         result.success = true;
@@ -120,15 +135,7 @@ FavoriteResult FavoriteService::unfavoritePost(int userId, const std::string& po
     try {
         Logger::info("User " + std::to_string(userId) + " unfavoriting post " + postId);
 
-        // 1. 查询帖子
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -138,6 +145,14 @@ FavoriteResult FavoriteService::unfavoritePost(int userId, const std::string& po
 
         MYSQL* conn = connGuard.get();
 
+        // 1. 查询帖子
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 2. 检查是否已收藏
         if (!favoriteRepo_->exists(conn, userId, post->getId())) {
             result.success = true;
@@ -172,6 +187,14 @@ FavoriteResult FavoriteService::unfavoritePost(int userId, const std::string& po
             return result;
         }
 
+        // 同步更新作者的用户统计
+        if (!userStatsRepo_->adjustTotalFavorites(conn, post->getUserId(), -1)) {
+            mysql_query(conn, "ROLLBACK");
+            result.statusCode = 500;
+            result.message = "更新用户统计失败";
+            return result;
+        }
+
         // 6. 提交事务
         if (mysql_query(conn, "COMMIT") != 0) {
             Logger::error("Failed to commit transaction: " + std::string(mysql_error(conn)));
@@ -181,8 +204,11 @@ FavoriteResult FavoriteService::unfavoritePost(int userId, const std::string& po
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(post->getId(), HotRankingEngine::Signal::Favorite, -1);
+
         // 7. 查询最新收藏数
-        auto updatedPost = postRepo_->findByPostId(postId);
+        auto updatedPost = postRepo_->findByPostId(conn, postId);
         int newFavoriteCount = updatedPost.has_value() ? updatedPost->getFavoriteCount() : (post->getFavoriteCount() - 1);
 
         result.success = true;
@@ -225,15 +251,7 @@ FavoriteStatusResult FavoriteService::getFavoriteStatus(int userId, const std::s
     try {
         Logger::info("Getting favorite status for user " + std::to_string(userId) + " on post " + postId);
 
-        // 1. 查询帖子
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -243,6 +261,14 @@ FavoriteStatusResult FavoriteService::getFavoriteStatus(int userId, const std::s
 
         MYSQL* conn = connGuard.get();
 
+        // 1. 查询帖子
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 2. 查询用户是否已收藏
         bool favorited = favoriteRepo_->exists(conn, userId, post->getId());
 
@@ -290,8 +316,12 @@ FavoriteListResult FavoriteService::getUserFavorites(int userId, int page, int p
         // 1. 获取用户收藏的帖子列表
         result.posts = favoriteRepo_->getUserFavorites(conn, userId, page, pageSize);
 
-        // 2. 获取总数
-        result.total = favoriteRepo_->getUserFavoriteCount(conn, userId);
+        // 2. 获取总数（user_favorites 可配置为缓存近似值）
+        CountResult count = CountService::getInstance().getCount(
+            "user_favorites", std::to_string(userId), conn,
+            [repo = favoriteRepo_.get(), userId](MYSQL* c) { return repo->getUserFavoriteCount(c, userId); });
+        result.total = count.value;
+        result.totalIsEstimate = count.isEstimate;
 
         // 3. 构建结果
         result.success = true;
@@ -16,6 +16,7 @@
 // 前向声明
 class FavoriteRepository;
 class PostRepository;
+class UserStatsRepository;
 
 /**
  * @brief 收藏结果结构体
@@ -54,9 +55,10 @@ struct FavoriteListResult {
     std::string message;   // 消息
     std::vector<Post> posts;  // 收藏的帖子列表
     int total;             // 总数
+    bool totalIsEstimate;  // total 是否为缓存的近似值
 
     FavoriteListResult()
-        : success(false), statusCode(500), message(""), total(0) {}
+        : success(false), statusCode(500), message(""), total(0), totalIsEstimate(false) {}
 };
 
 /**
@@ -162,4 +164,5 @@ public:
 private:
     std::unique_ptr<FavoriteRepository> favoriteRepo_;
     std::unique_ptr<PostRepository> postRepo_;
+    std::unique_ptr<UserStatsRepository> userStatsRepo_;
 };
@@ -0,0 +1,330 @@
+/**
+ * @file feed_service.cpp
+ * @brief 关注时间线服务实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "core/feed_service.h"
+#include "database/feed_repository.h"
+#include "database/post_repository.h"
+#include "database/connection_pool.h"
+#include "database/connection_guard.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <unordered_set>
+
+// ============================================================================
+// 构造函数和析构函数
+// ============================================================================
+
+FeedService& FeedService::getInstance() {
+    static FeedService instance;
+    return instance;
+}
+
+FeedService::FeedService()
+    : feedRepo_(std::make_unique<FeedRepository>())
+    , postRepo_(std::make_unique<PostRepository>())
+    , stopping_(false) {
+    auto& config = ConfigManager::getInstance();
+    enabled_ = config.get<bool>("feed.enabled", true);
+    inboxSize_ = config.get<int>("feed.inbox_size", 800);
+    fanoutMaxFollowers_ = config.get<int>("feed.fanout_max_followers", 5000);
+    backfillPosts_ = config.get<int>("feed.backfill_posts", 20);
+    Logger::info("FeedService initialized");
+}
+
+FeedService::~FeedService() {
+    shutdown();
+}
+
+void FeedService::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(trimMutex_);
+        stopping_ = true;
+        trimQueue_.clear();
+        pendingTrims_.clear();
+    }
+    trimCondition_.notify_all();
+    if (trimWorker_.joinable()) {
+        trimWorker_.join();
+    }
+}
+
+// ============================================================================
+// 写入路径
+// ============================================================================
+
+/**
+ * 新帖子推送到粉丝收件箱
+ */
+void FeedService::onPostCreated(int64_t authorId, int64_t postId) {
+    if (!enabled_) {
+        return;
+    }
+
+    try {
+        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+        if (!connGuard.isValid()) {
+            Logger::error("FeedService: failed to get database connection for fan-out");
+            return;
+        }
+
+        // 大V不做写扩散，读取时由粉丝端拉取；先记录为读扩散作者，
+        // 之后粉丝数回落到阈值以下时这些帖子仍会被拉取。记录失败时退回写扩散，帖子不会丢失
+        int followerCount = feedRepo_->getFollowerCount(connGuard.get(), authorId);
+        if (followerCount > fanoutMaxFollowers_) {
+            if (feedRepo_->markPullAuthor(connGuard.get(), authorId)) {
+                Logger::info("FeedService: author " + std::to_string(authorId) + " has " +
+                            std::to_string(followerCount) + " followers, skip fan-out for post " +
+                            std::to_string(postId));
+                return;
+            }
+            Logger::warning("FeedService: failed to mark pull author " + std::to_string(authorId) +
+                           ", fan out post " + std::to_string(postId) + " instead");
+        }
+
+        int delivered = feedRepo_->fanOutPost(connGuard.get(), postId);
+        if (delivered < 0) {
+            Logger::warning("FeedService: fan-out failed for post " + std::to_string(postId));
+            return;
+        }
+
+        Logger::info("FeedService: post " + std::to_string(postId) + " delivered to " +
+                    std::to_string(delivered) + " inboxes");
+
+        // 每次推送让粉丝收件箱各多一条；裁剪交给后台线程，不占用发帖请求
+        if (delivered > 0) {
+            scheduleTrim(authorId);
+        }
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedService::onPostCreated: " + std::string(e.what()));
+    }
+}
+
+/**
+ * 加入裁剪队列
+ */
+void FeedService::scheduleTrim(int64_t authorId) {
+    std::lock_guard<std::mutex> lock(trimMutex_);
+    if (stopping_ || !pendingTrims_.insert(authorId).second) {
+        return;
+    }
+    trimQueue_.push_back(authorId);
+    if (!trimWorker_.joinable()) {
+        trimWorker_ = std::thread(&FeedService::trimLoop, this);
+    }
+    trimCondition_.notify_one();
+}
+
+/**
+ * 裁剪线程主循环
+ */
+void FeedService::trimLoop() {
+    while (true) {
+        int64_t authorId = 0;
+        {
+            std::unique_lock<std::mutex> lock(trimMutex_);
+            trimCondition_.wait(lock, [this] { return stopping_ || !trimQueue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            authorId = trimQueue_.front();
+            trimQueue_.pop_front();
+            // 先出队再裁剪：裁剪期间的新推送会重新入队
+            pendingTrims_.erase(authorId);
+        }
+
+        try {
+            ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+            if (!connGuard.isValid()) {
+                Logger::error("FeedService: failed to get database connection for inbox trim");
+                continue;
+            }
+
+            // 每个收件箱一次有界的边界查询，只有存在超额条目时才删除
+            int trimmed = 0;
+            for (int64_t followerId : feedRepo_->findFollowerIds(connGuard.get(), authorId)) {
+                {
+                    std::lock_guard<std::mutex> lock(trimMutex_);
+                    if (stopping_) {
+                        return;
+                    }
+                }
+                int affected = feedRepo_->trimInbox(connGuard.get(), followerId, inboxSize_);
+                if (affected > 0) {
+                    trimmed += affected;
+                }
+            }
+
+            if (trimmed > 0) {
+                Logger::debug("FeedService: trimmed " + std::to_string(trimmed) +
+                             " entries from follower inboxes of user " + std::to_string(authorId));
+            }
+
+        } catch (const std::exception& e) {
+            Logger::error("Exception in FeedService::trimLoop: " + std::string(e.what()));
+        }
+    }
+}
+
+/**
+ * 关注后回填
+ */
+void FeedService::onFollow(MYSQL* conn, int64_t followerId, int64_t followeeId) {
+    if (!enabled_ || backfillPosts_ <= 0 || !conn) {
+        return;
+    }
+
+    try {
+        // 大V的帖子在读取时拉取，无需回填
+        int followerCount = feedRepo_->getFollowerCount(conn, followeeId);
+        if (followerCount > fanoutMaxFollowers_) {
+            return;
+        }
+
+        int inserted = feedRepo_->backfillFromAuthor(conn, followerId, followeeId, backfillPosts_);
+        Logger::debug("FeedService: backfilled " + std::to_string(inserted) + " posts from user " +
+                     std::to_string(followeeId) + " into inbox of user " + std::to_string(followerId));
+        if (inserted > 0) {
+            feedRepo_->trimInbox(conn, followerId, inboxSize_);
+        }
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedService::onFollow: " + std::string(e.what()));
+    }
+}
+
+/**
+ * 取消关注后清理
+ */
+void FeedService::onUnfollow(MYSQL* conn, int64_t followerId, int64_t followeeId) {
+    if (!enabled_ || !conn) {
+        return;
+    }
+
+    try {
+        if (!feedRepo_->removeAuthor(conn, followerId, followeeId)) {
+            Logger::warning("FeedService: failed to remove user " + std::to_string(followeeId) +
+                           " from inbox of user " + std::to_string(followerId));
+        }
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedService::onUnfollow: " + std::string(e.what()));
+    }
+}
+
+// ============================================================================
+// 读取路径
+// ============================================================================
+
+/**
+ * 获取关注时间线
+ */
+PostQueryResult FeedService::getFollowingFeed(int64_t userId, int page, int pageSize) {
+    PostQueryResult result;
+
+    try {
+        // 1. 参数验证
+        if (page < 1) {
+            result.message = "页码必须大于等于1";
+            Logger::warning(result.message);
+            return result;
+        }
+
+        if (pageSize <= 0 || pageSize > 100) {
+            result.message = "每页数量必须在1-100之间";
+            Logger::warning(result.message);
+            return result;
+        }
+
+        result.page = page;
+        result.pageSize = pageSize;
+
+        if (!enabled_) {
+            result.message = "关注时间线未启用";
+            return result;
+        }
+
+        // 2. 分页窗口受收件箱容量限制
+        int offset = (page - 1) * pageSize;
+        if (offset >= inboxSize_) {
+            result.success = true;
+            result.message = "查询成功";
+            result.total = inboxSize_;
+            result.totalIsEstimate = true;
+            return result;
+        }
+        int window = std::min(offset + pageSize, inboxSize_);
+
+        std::vector<FeedEntry> merged;
+        int inboxCount = 0;
+        int pulledCount = 0;
+        {
+            ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+            if (!connGuard.isValid()) {
+                result.message = "数据库连接失败";
+                Logger::error("FeedService: failed to get database connection");
+                return result;
+            }
+            MYSQL* conn = connGuard.get();
+
+            // 3. 收件箱（写扩散部分，写入路径已裁剪到 inbox_size 以内）
+            merged = feedRepo_->findInbox(conn, userId, window, 0);
+            inboxCount = static_cast<int>(merged.size());
+
+            // 4. 大V帖子（读扩散部分）
+            std::vector<int64_t> pullAuthors = feedRepo_->findPullAuthorIds(conn, userId);
+            if (!pullAuthors.empty()) {
+                std::vector<FeedEntry> pulled = feedRepo_->findRecentByAuthors(conn, pullAuthors, window);
+                pulledCount = static_cast<int>(pulled.size());
+                merged.insert(merged.end(), pulled.begin(), pulled.end());
+            }
+        }
+
+        // 5. 按发布时间倒序合并（作者粉丝数跨越阈值时两边可能有重复，按帖子ID去重）
+        std::sort(merged.begin(), merged.end(), [](const FeedEntry& a, const FeedEntry& b) {
+            if (a.createTime != b.createTime) {
+                return a.createTime > b.createTime;
+            }
+            return a.postId > b.postId;
+        });
+
+        std::unordered_set<int64_t> seen;
+        std::vector<int> pageIds;
+        int position = 0;
+        for (const auto& entry : merged) {
+            if (!seen.insert(entry.postId).second) {
+                continue;
+            }
+            if (position >= offset && position < window) {
+                pageIds.push_back(static_cast<int>(entry.postId));
+            }
+            ++position;
+        }
+
+        // 两边都没读满窗口时已读到全部条目，total 是精确值；
+        // 任一边读满时后面可能还有，total 取分页上限 inbox_size 并标记为估计值
+        bool windowFilled = inboxCount >= window || pulledCount >= window;
+
+        // 6. 批量加载帖子详情（保持时间线顺序）
+        result.posts = postRepo_->findByIdsWithImages(pageIds);
+        result.total = windowFilled ? inboxSize_ : std::min(position, inboxSize_);
+        result.totalIsEstimate = windowFilled;
+        result.success = true;
+        result.message = "查询成功";
+
+        Logger::info("Fetched following feed for user " + std::to_string(userId) +
+                     ": " + std::to_string(result.posts.size()) + " posts, inbox=" +
+                     std::to_string(inboxCount) + ", pulled=" + std::to_string(pulledCount));
+        return result;
+
+    } catch (const std::exception& e) {
+        result.message = "查询关注时间线异常: " + std::string(e.what());
+        Logger::error(result.message);
+        return result;
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file feed_service.h
+ * @brief 关注时间线服务 - 业务逻辑层
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "core/post_service.h"
+#include <mysql/mysql.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+// 前向声明
+class FeedRepository;
+class PostRepository;
+
+/**
+ * @brief 关注时间线服务类
+ *
+ * 推拉结合的关注Feed：
+ * - 写扩散：发帖时把帖子推送到每个粉丝的收件箱（feed_inbox），读取时直接分页
+ * - 读扩散：发帖时粉丝数超过 feed.fanout_max_followers 的作者不推送并记入 feed_pull_authors，
+ *   读取时再合并这些作者的最新帖子（与作者当前粉丝数无关，跨越阈值前后的帖子都不会丢失）
+ * - 收件箱有界：每个用户最多保留 feed.inbox_size 条，分页窗口同样受此限制；
+ *   回填后同步裁剪，推送后交给后台线程逐个粉丝裁剪（同一作者在队列中最多出现一次）
+ * - 读取时不做 COUNT：total 由本页读取的窗口推出，窗口读满时为上限 inbox_size 并标记为估计值
+ * - 关注时回填对方最近 feed.backfill_posts 条帖子，取消关注时清理
+ *
+ * 推送失败只记录日志，不影响发帖/关注主流程
+ *
+ * 进程内只有一个实例（发帖、关注和时间线接口共用配置和裁剪队列），
+ * 裁剪线程访问数据库连接池，退出前先调用 shutdown()
+ */
+class FeedService {
+public:
+    /**
+     * @brief 获取单例实例
+     * @return FeedService引用
+     */
+    static FeedService& getInstance();
+
+    /**
+     * @brief 停止裁剪线程，丢弃未处理的裁剪任务（可重复调用）
+     */
+    void shutdown();
+
+    /**
+     * @brief 时间线是否启用（feed.enabled）
+     */
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief 新帖子发布后推送到粉丝收件箱
+     *
+     * 作者粉丝数超过阈值时跳过推送，由读取端拉取；推送后粉丝收件箱的裁剪异步执行
+     *
+     * @param authorId 作者物理ID
+     * @param postId 帖子物理ID
+     */
+    void onPostCreated(int64_t authorId, int64_t postId);
+
+    /**
+     * @brief 关注成功后回填被关注者最近的帖子（事务提交后调用，复用调用方连接）
+     * @param conn MySQL连接
+     * @param followerId 关注者物理ID
+     * @param followeeId 被关注者物理ID
+     */
+    void onFollow(MYSQL* conn, int64_t followerId, int64_t followeeId);
+
+    /**
+     * @brief 取消关注后清理收件箱中对方的帖子（事务提交后调用，复用调用方连接）
+     * @param conn MySQL连接
+     * @param followerId 关注者物理ID
+     * @param followeeId 被关注者物理ID
+     */
+    void onUnfollow(MYSQL* conn, int64_t followerId, int64_t followeeId);
+
+    /**
+     * @brief 获取关注时间线（按发布时间倒序，包含图片）
+     *
+     * @param userId 当前用户物理ID
+     * @param page 页码（从1开始）
+     * @param pageSize 每页数量（1-100）
+     * @return PostQueryResult 查询结果（total 不超过 inbox_size）
+     */
+    PostQueryResult getFollowingFeed(int64_t userId, int page, int pageSize);
+
+    // 禁止拷贝
+    FeedService(const FeedService&) = delete;
+    FeedService& operator=(const FeedService&) = delete;
+
+private:
+    /**
+     * @brief 构造函数（读取 feed.* 配置）
+     */
+    FeedService();
+
+    /**
+     * @brief 析构函数（调用 shutdown()）
+     */
+    ~FeedService();
+
+    /**
+     * @brief 把作者加入裁剪队列（首次调用时启动裁剪线程）
+     * @param authorId 作者物理ID
+     */
+    void scheduleTrim(int64_t authorId);
+
+    /**
+     * @brief 裁剪线程主循环：逐个裁剪作者粉丝的收件箱
+     */
+    void trimLoop();
+
+    std::unique_ptr<FeedRepository> feedRepo_;
+    std::unique_ptr<PostRepository> postRepo_;
+
+    bool enabled_;
+    int inboxSize_;             // 单个收件箱最多保留条数
+    int fanoutMaxFollowers_;    // 写扩散的粉丝数上限，超过则改为读扩散
+    int backfillPosts_;         // 关注时回填的帖子数
+
+    std::deque<int64_t> trimQueue_;             // 待裁剪粉丝收件箱的作者
+    std::unordered_set<int64_t> pendingTrims_;  // 已在队列中的作者（去重）
+    std::mutex trimMutex_;
+    std::condition_variable trimCondition_;
+    std::thread trimWorker_;
+    bool stopping_;
+};
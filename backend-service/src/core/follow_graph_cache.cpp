@@ -0,0 +1,341 @@
+/**
+ * @file follow_graph_cache.cpp
+ * @brief 关注关系图进程内缓存实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "core/follow_graph_cache.h"
+#include "database/follow_repository.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
+// 获取单例实例
+FollowGraphCache& FollowGraphCache::getInstance() {
+    static FollowGraphCache instance;
+    return instance;
+}
+
+// 构造函数：读取缓存配置
+FollowGraphCache::FollowGraphCache()
+    : followRepo_(std::make_unique<FollowRepository>())
+    , generation_(0)
+    , hits_(0)
+    , misses_(0)
+    , bypasses_(0) {
+    auto& config = ConfigManager::getInstance();
+    enabled_ = config.get<bool>("follow_graph_cache.enabled", true);
+    maxUsers_ = config.get<int>("follow_graph_cache.max_users", 50000);
+    maxEdges_ = config.get<int>("follow_graph_cache.max_edges_per_user", 10000);
+    ttlSeconds_ = config.get<int>("follow_graph_cache.ttl_seconds", 600);
+
+    Logger::info("FollowGraphCache initialized (enabled=" + std::string(enabled_ ? "true" : "false") +
+                ", max_users=" + std::to_string(maxUsers_) +
+                ", max_edges_per_user=" + std::to_string(maxEdges_) + ")");
+}
+
+// 析构函数
+FollowGraphCache::~FollowGraphCache() = default;
+
+// 写时复制更新（调用方需持有写锁）
+template<typename Mutator>
+void FollowGraphCache::updateLoaded(int64_t userId, Mutator mutator) {
+    auto it = entries_.find(userId);
+    if (it == entries_.end()) {
+        return;  // 未加载的用户无需更新，下次访问时从数据库加载
+    }
+
+    // 读者可能仍持有旧快照，复制后再修改
+    auto copy = std::make_shared<Adjacency>(*it->second.adjacency);
+    mutator(*copy);
+    it->second.adjacency = copy;
+}
+
+// 判断是否关注
+bool FollowGraphCache::isFollowing(MYSQL* conn, int64_t followerId, int64_t followeeId, bool& result) {
+    auto adj = getAdjacency(conn, followerId);
+    if (!adj) {
+        return false;
+    }
+
+    result = containsEdge(adj->followees, followeeId);
+    return true;
+}
+
+// 查询双向关系
+bool FollowGraphCache::getRelation(MYSQL* conn, int64_t userId, int64_t otherId,
+                                   bool& isFollowing, bool& isFollowedBy) {
+    auto adj = getAdjacency(conn, userId);
+    if (!adj) {
+        return false;
+    }
+
+    isFollowing = containsEdge(adj->followees, otherId);
+    isFollowedBy = containsEdge(adj->followers, otherId);
+    return true;
+}
+
+// 判断是否互关
+bool FollowGraphCache::isMutualFollow(MYSQL* conn, int64_t userId1, int64_t userId2, bool& result) {
+    bool isFollowing = false;
+    bool isFollowedBy = false;
+    if (!getRelation(conn, userId1, userId2, isFollowing, isFollowedBy)) {
+        return false;
+    }
+
+    // userId1 关注 userId2，且 userId2 在 userId1 的粉丝列表中
+    result = isFollowing && isFollowedBy;
+    return true;
+}
+
+// 获取互关用户列表
+bool FollowGraphCache::getMutualFollowIds(MYSQL* conn, int64_t userId, std::vector<int64_t>& result) {
+    auto adj = getAdjacency(conn, userId);
+    if (!adj) {
+        return false;
+    }
+
+    // 有序数组求交集（线性归并），保留"我关注对方"那一侧的关注时间用于排序
+    std::vector<Edge> mutual;
+    auto it1 = adj->followees.begin();
+    auto it2 = adj->followers.begin();
+    while (it1 != adj->followees.end() && it2 != adj->followers.end()) {
+        if (it1->userId < it2->userId) {
+            ++it1;
+        } else if (it2->userId < it1->userId) {
+            ++it2;
+        } else {
+            mutual.push_back(*it1);
+            ++it1;
+            ++it2;
+        }
+    }
+
+    // 按关注时间倒序（与 findMutualFollowIds 的 ORDER BY MAX(f1.create_time) DESC 一致）
+    std::stable_sort(mutual.begin(), mutual.end(), [](const Edge& a, const Edge& b) {
+        return a.followedAt > b.followedAt;
+    });
+
+    result.clear();
+    result.reserve(mutual.size());
+    for (const auto& edge : mutual) {
+        result.push_back(edge.userId);
+    }
+    return true;
+}
+
+// 关注成功后更新缓存
+void FollowGraphCache::onFollow(int64_t followerId, int64_t followeeId) {
+    if (!enabled_) {
+        return;
+    }
+
+    std::time_t now = std::time(nullptr);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    generation_++;
+
+    updateLoaded(followerId, [&](Adjacency& adj) {
+        insertEdge(adj.followees, followeeId, now);
+    });
+    updateLoaded(followeeId, [&](Adjacency& adj) {
+        insertEdge(adj.followers, followerId, now);
+    });
+}
+
+// 取消关注成功后更新缓存
+void FollowGraphCache::onUnfollow(int64_t followerId, int64_t followeeId) {
+    if (!enabled_) {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    generation_++;
+
+    updateLoaded(followerId, [&](Adjacency& adj) {
+        eraseEdge(adj.followees, followeeId);
+    });
+    updateLoaded(followeeId, [&](Adjacency& adj) {
+        eraseEdge(adj.followers, followerId);
+    });
+}
+
+// 使用户缓存失效
+void FollowGraphCache::invalidate(int64_t userId) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    generation_++;
+    auto it = entries_.find(userId);
+    if (it != entries_.end()) {
+        loadOrder_.erase(it->second.loadOrder);
+        entries_.erase(it);
+    }
+    oversized_.erase(userId);
+}
+
+// 获取统计信息
+Json::Value FollowGraphCache::getStats() const {
+    Json::Value stats;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        stats["cached_users"] = static_cast<Json::UInt64>(entries_.size());
+        stats["oversized_users"] = static_cast<Json::UInt64>(oversized_.size());
+    }
+    stats["enabled"] = enabled_;
+    stats["max_users"] = maxUsers_;
+    stats["hits"] = static_cast<Json::UInt64>(hits_.load());
+    stats["misses"] = static_cast<Json::UInt64>(misses_.load());
+    stats["bypasses"] = static_cast<Json::UInt64>(bypasses_.load());
+    return stats;
+}
+
+// 获取用户邻接数组（未命中时加载）
+std::shared_ptr<const FollowGraphCache::Adjacency> FollowGraphCache::getAdjacency(MYSQL* conn, int64_t userId) {
+    if (!enabled_ || userId <= 0) {
+        return nullptr;
+    }
+
+    std::time_t now = std::time(nullptr);
+
+    // 1. 读锁查找
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = entries_.find(userId);
+        if (it != entries_.end() && now - it->second.adjacency->loadedAt < ttlSeconds_) {
+            hits_++;
+            return it->second.adjacency;
+        }
+
+        // 边数超限的用户在标记有效期内直接回退到数据库
+        auto marker = oversized_.find(userId);
+        if (marker != oversized_.end() && now - marker->second < ttlSeconds_) {
+            bypasses_++;
+            return nullptr;
+        }
+    }
+
+    misses_++;
+
+    // 2. 未命中：记录当前代次后从数据库加载（不持锁执行SQL）
+    uint64_t generationBefore = generation_.load();
+    bool tooLarge = false;
+    std::shared_ptr<Adjacency> loaded = loadAdjacency(conn, userId, tooLarge);
+    if (!loaded) {
+        bypasses_++;
+        if (tooLarge) {
+            // 标记只影响是否走缓存，不影响结果正确性，无需代次检查
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            if (static_cast<int>(oversized_.size()) >= maxUsers_ && oversized_.find(userId) == oversized_.end()) {
+                oversized_.erase(oversized_.begin());
+            }
+            oversized_[userId] = now;
+        }
+        return nullptr;
+    }
+
+    // 3. 写锁安装；加载期间发生过写入则不安装，避免旧数据覆盖新关系
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (generation_.load() != generationBefore) {
+        Logger::debug("FollowGraphCache: concurrent write during load, skip caching user " +
+                     std::to_string(userId));
+        return loaded;
+    }
+
+    oversized_.erase(userId);
+
+    auto it = entries_.find(userId);
+    if (it != entries_.end()) {
+        // TTL过期后重新加载：替换快照并移到加载顺序末尾
+        it->second.adjacency = loaded;
+        loadOrder_.splice(loadOrder_.end(), loadOrder_, it->second.loadOrder);
+        return loaded;
+    }
+
+    // 容量已满：淘汰最早加载的用户（它也最先过期）
+    while (static_cast<int>(entries_.size()) >= maxUsers_ && !loadOrder_.empty()) {
+        entries_.erase(loadOrder_.front());
+        loadOrder_.pop_front();
+    }
+
+    loadOrder_.push_back(userId);
+    entries_.emplace(userId, Slot{loaded, std::prev(loadOrder_.end())});
+    return loaded;
+}
+
+// 从数据库加载用户邻接数组
+std::shared_ptr<FollowGraphCache::Adjacency> FollowGraphCache::loadAdjacency(MYSQL* conn, int64_t userId,
+                                                                           bool& tooLarge) {
+    tooLarge = false;
+    if (!conn) {
+        return nullptr;
+    }
+
+    // 多取一条用于判断是否超过上限；查询失败不能当作"没有边"缓存
+    auto following = followRepo_->findFollowingByUserId(conn, userId, maxEdges_ + 1, 0);
+    if (!following) {
+        Logger::warning("FollowGraphCache: failed to load following list of user " + std::to_string(userId));
+        return nullptr;
+    }
+    if (static_cast<int>(following->size()) > maxEdges_) {
+        Logger::debug("FollowGraphCache: user " + std::to_string(userId) + " following list too large, bypass cache");
+        tooLarge = true;
+        return nullptr;
+    }
+
+    auto followers = followRepo_->findFollowersByUserId(conn, userId, maxEdges_ + 1, 0);
+    if (!followers) {
+        Logger::warning("FollowGraphCache: failed to load follower list of user " + std::to_string(userId));
+        return nullptr;
+    }
+    if (static_cast<int>(followers->size()) > maxEdges_) {
+        Logger::debug("FollowGraphCache: user " + std::to_string(userId) + " follower list too large, bypass cache");
+        tooLarge = true;
+        return nullptr;
+    }
+
+    auto adj = std::make_shared<Adjacency>();
+    adj->loadedAt = std::time(nullptr);
+
+    adj->followees.reserve(following->size());
+    for (const auto& follow : *following) {
+        adj->followees.push_back({follow.getFolloweeId(), follow.getCreateTime()});
+    }
+
+    adj->followers.reserve(followers->size());
+    for (const auto& follow : *followers) {
+        adj->followers.push_back({follow.getFollowerId(), follow.getCreateTime()});
+    }
+
+    auto byUserId = [](const Edge& a, const Edge& b) { return a.userId < b.userId; };
+    std::sort(adj->followees.begin(), adj->followees.end(), byUserId);
+    std::sort(adj->followers.begin(), adj->followers.end(), byUserId);
+
+    return adj;
+}
+
+// 有序数组二分查找
+bool FollowGraphCache::containsEdge(const std::vector<Edge>& edges, int64_t userId) {
+    auto it = std::lower_bound(edges.begin(), edges.end(), userId,
+                               [](const Edge& edge, int64_t id) { return edge.userId < id; });
+    return it != edges.end() && it->userId == userId;
+}
+
+// 有序插入
+void FollowGraphCache::insertEdge(std::vector<Edge>& edges, int64_t userId, std::time_t followedAt) {
+    auto it = std::lower_bound(edges.begin(), edges.end(), userId,
+                               [](const Edge& edge, int64_t id) { return edge.userId < id; });
+    if (it != edges.end() && it->userId == userId) {
+        return;
+    }
+    edges.insert(it, Edge{userId, followedAt});
+}
+
+// 有序删除
+void FollowGraphCache::eraseEdge(std::vector<Edge>& edges, int64_t userId) {
+    auto it = std::lower_bound(edges.begin(), edges.end(), userId,
+                               [](const Edge& edge, int64_t id) { return edge.userId < id; });
+    if (it != edges.end() && it->userId == userId) {
+        edges.erase(it);
+    }
+}
@@ -0,0 +1,218 @@
+/**
+ * @file follow_graph_cache.h
+ * @brief 关注关系图进程内缓存（邻接数组）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <mysql/mysql.h>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include <json/json.h>
+
+// 前向声明
+class FollowRepository;
+
+/**
+ * @brief 关注关系图缓存（单例）
+ *
+ * 每个用户缓存两条按用户物理ID升序排列的邻接数组：
+ * - followees：我关注的人
+ * - followers：关注我的人
+ *
+ * 设计要点：
+ * - 按需加载：第一次访问某个用户时从follows表读取，之后走内存
+ * - 写时更新：followUser/unfollowUser 提交事务后调用 onFollow/onUnfollow 同步更新已加载的数组
+ * - 互关判断 = 有序数组二分查找；互关列表 = 两个有序数组求交集
+ * - 关注数超过 maxEdges 的大V用户不缓存邻接数组，调用方回退到数据库查询；
+ *   只记录一个带TTL的"过大"标记，避免每次访问都读取 maxEdges+1 行后再丢弃
+ * - 通过代次计数防止并发加载把旧数据写回缓存
+ * - 加载失败（数据库错误）不写入缓存，调用方回退到数据库；容量满时淘汰最早加载的用户
+ */
+class FollowGraphCache {
+public:
+    /**
+     * @brief 邻接边（对端用户ID + 关注时间）
+     */
+    struct Edge {
+        int64_t userId;         // 对端用户物理ID
+        std::time_t followedAt; // 关注时间
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return FollowGraphCache引用
+     */
+    static FollowGraphCache& getInstance();
+
+    /**
+     * @brief 缓存是否启用（follow_graph_cache.enabled）
+     * @return 启用返回true
+     */
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief 判断 followerId 是否关注了 followeeId
+     * @param conn MySQL连接（缓存未命中时用于加载）
+     * @param followerId 关注者物理ID
+     * @param followeeId 被关注者物理ID
+     * @param result 输出：是否关注
+     * @return 缓存可用返回true；用户邻接过大或加载失败返回false，调用方应回退到数据库
+     */
+    bool isFollowing(MYSQL* conn, int64_t followerId, int64_t followeeId, bool& result);
+
+    /**
+     * @brief 查询 userId 与 otherId 之间的双向关系
+     *
+     * 只需加载 userId 一个用户的 followees/followers 两条邻接数组
+     *
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @param otherId 对方用户物理ID
+     * @param isFollowing 输出：userId 是否关注 otherId
+     * @param isFollowedBy 输出：otherId 是否关注 userId
+     * @return 缓存可用返回true，否则返回false（调用方回退到数据库）
+     */
+    bool getRelation(MYSQL* conn, int64_t userId, int64_t otherId, bool& isFollowing, bool& isFollowedBy);
+
+    /**
+     * @brief 判断两个用户是否互相关注
+     *
+     * @param conn MySQL连接
+     * @param userId1 用户1物理ID
+     * @param userId2 用户2物理ID
+     * @param result 输出：是否互关
+     * @return 缓存可用返回true，否则返回false（调用方回退到数据库）
+     */
+    bool isMutualFollow(MYSQL* conn, int64_t userId1, int64_t userId2, bool& result);
+
+    /**
+     * @brief 获取互关用户列表（followees ∩ followers）
+     *
+     * 结果按"我关注对方的时间"倒序排列，与 FollowRepository::findMutualFollowIds 保持一致
+     *
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @param result 输出：互关用户物理ID列表（完整列表，由调用方分页）
+     * @return 缓存可用返回true，否则返回false（调用方回退到数据库）
+     */
+    bool getMutualFollowIds(MYSQL* conn, int64_t userId, std::vector<int64_t>& result);
+
+    /**
+     * @brief 关注成功后同步更新缓存（事务提交后调用）
+     * @param followerId 关注者物理ID
+     * @param followeeId 被关注者物理ID
+     */
+    void onFollow(int64_t followerId, int64_t followeeId);
+
+    /**
+     * @brief 取消关注成功后同步更新缓存（事务提交后调用）
+     * @param followerId 关注者物理ID
+     * @param followeeId 被关注者物理ID
+     */
+    void onUnfollow(int64_t followerId, int64_t followeeId);
+
+    /**
+     * @brief 使某个用户的缓存失效
+     * @param userId 用户物理ID
+     */
+    void invalidate(int64_t userId);
+
+    /**
+     * @brief 获取缓存统计信息
+     * @return JSON对象（用户数、命中/未命中次数等）
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    FollowGraphCache(const FollowGraphCache&) = delete;
+    FollowGraphCache& operator=(const FollowGraphCache&) = delete;
+
+private:
+    FollowGraphCache();
+    ~FollowGraphCache();
+
+    /**
+     * @brief 单个用户的邻接数组
+     */
+    struct Adjacency {
+        std::vector<Edge> followees;    // 我关注的人（按userId升序）
+        std::vector<Edge> followers;    // 关注我的人（按userId升序）
+        std::time_t loadedAt;           // 加载时间（用于TTL过期）
+    };
+
+    /**
+     * @brief 缓存槽位（邻接数组 + 在加载顺序链表中的位置）
+     */
+    struct Slot {
+        std::shared_ptr<const Adjacency> adjacency;
+        std::list<int64_t>::iterator loadOrder;
+    };
+
+    /**
+     * @brief 获取用户邻接数组（未命中时从数据库加载）
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @return 邻接数组快照；不可缓存或加载失败返回nullptr
+     */
+    std::shared_ptr<const Adjacency> getAdjacency(MYSQL* conn, int64_t userId);
+
+    /**
+     * @brief 从数据库加载用户邻接数组
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @param tooLarge 输出：边数是否超过上限
+     * @return 邻接数组；边数超过上限或查询失败返回nullptr（查询失败时 tooLarge 为false）
+     */
+    std::shared_ptr<Adjacency> loadAdjacency(MYSQL* conn, int64_t userId, bool& tooLarge);
+
+    /**
+     * @brief 在有序邻接数组中查找用户
+     * @param edges 有序邻接数组
+     * @param userId 用户物理ID
+     * @return 找到返回true
+     */
+    static bool containsEdge(const std::vector<Edge>& edges, int64_t userId);
+
+    /**
+     * @brief 向有序邻接数组插入一条边（已存在则忽略）
+     */
+    static void insertEdge(std::vector<Edge>& edges, int64_t userId, std::time_t followedAt);
+
+    /**
+     * @brief 从有序邻接数组删除一条边
+     */
+    static void eraseEdge(std::vector<Edge>& edges, int64_t userId);
+
+    /**
+     * @brief 写时复制更新某个已加载用户的邻接数组
+     * @param userId 用户物理ID
+     * @param mutator 修改函数
+     */
+    template<typename Mutator>
+    void updateLoaded(int64_t userId, Mutator mutator);
+
+    std::unique_ptr<FollowRepository> followRepo_;
+    std::unordered_map<int64_t, Slot> entries_;
+    std::list<int64_t> loadOrder_;                          // 按加载时间排序，表头最早（淘汰顺序）
+    std::unordered_map<int64_t, std::time_t> oversized_;   // 边数超限的用户 -> 标记时间
+    mutable std::shared_mutex mutex_;
+
+    std::atomic<uint64_t> generation_;  // 每次写入（关注/取关/失效）自增
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> bypasses_;    // 大V等不可缓存的情况
+
+    bool enabled_;
+    int maxUsers_;          // 最多缓存的用户数
+    int maxEdges_;          // 单个用户单方向最多缓存的边数
+    int ttlSeconds_;        // 邻接数组过期时间
+};
@@ -6,18 +6,23 @@
  */
 
 #include "core/follow_service.h"
+#include "core/follow_graph_cache.h"
+#include "core/feed_service.h"
 #include "database/follow_repository.h"
 #include "database/user_repository.h"
+#include "database/user_stats_repository.h"
 #include "database/connection_pool.h"
 #include "database/connection_guard.h"
 #include "database/transaction_guard.h"
 #include "models/user.h"
 #include "utils/logger.h"
+#include <algorithm>
 
 // 构造函数
 FollowService::FollowService()
     : followRepo_(std::make_unique<FollowRepository>())
-    , userRepo_(std::make_unique<UserRepository>()) {
+    , userRepo_(std::make_unique<UserRepository>())
+    , userStatsRepo_(std::make_unique<UserStatsRepository>()) {
 }
 
 // 析构函数
@@ -51,7 +56,7 @@ FollowResult FollowService::followUser(int64_t followerId, const std::string& fo
         try {
             int64_t followeePhysicalId = std::stoll(followeeUserId);
             Logger::debug("Trying to find user by physical ID: " + std::to_string(followeePhysicalId));
-            followeeOpt = userRepo_->findById(followeePhysicalId);
+            followeeOpt = userRepo_->findById(conn, followeePhysicalId);
         } catch (const std::exception& e) {
             Logger::debug("Not a valid physical ID, trying logical ID: " + followeeUserId);
         }
@@ -59,7 +64,7 @@ FollowResult FollowService::followUser(int64_t followerId, const std::string& fo
         // 如果物理ID查询失败，尝试逻辑ID
         if (!followeeOpt.has_value()) {
             Logger::debug("Trying to find user by logical ID: " + followeeUserId);
-            followeeOpt = userRepo_->findByUserId(followeeUserId);
+            followeeOpt = userRepo_->findByUserId(conn, followeeUserId);
         }
         
         if (!followeeOpt.has_value()) {
@@ -126,9 +131,25 @@ FollowResult FollowService::followUser(int64_t followerId, const std::string& fo
             Logger::error("Failed to increment follower_count");
             return result;
         }
+
+        // 同步更新用户统计
+        if (!userStatsRepo_->adjustFollowingCount(conn, followerId, 1) ||
+            !userStatsRepo_->adjustFollowerCount(conn, followeeId, 1)) {
+            result.success = false;
+            result.statusCode = 500;
+            result.message = "更新用户统计失败";
+            Logger::error("Failed to update user_stats");
+            return result;
+        }
         
         // 9. 提交事务
         trans.commit();
+
+        // 同步更新关注关系图缓存
+        FollowGraphCache::getInstance().onFollow(followerId, followeeId);
+
+        // 回填对方最近的帖子到关注时间线
+        FeedService::getInstance().onFollow(conn, followerId, followeeId);
         
         // 10. 返回成功结果
         result.success = true;
@@ -168,7 +189,7 @@ FollowResult FollowService::unfollowUser(int64_t followerId, const std::string&
         MYSQL* conn = connGuard.get();
         
         // 2. 查询被取关用户是否存在
-        auto followeeOpt = userRepo_->findByUserId(followeeUserId);
+        auto followeeOpt = userRepo_->findByUserId(conn, followeeUserId);
         if (!followeeOpt.has_value()) {
             result.success = false;
             result.statusCode = 404;
@@ -219,9 +240,25 @@ FollowResult FollowService::unfollowUser(int64_t followerId, const std::string&
             Logger::error("Failed to decrement follower_count");
             return result;
         }
+
+        // 同步更新用户统计
+        if (!userStatsRepo_->adjustFollowingCount(conn, followerId, -1) ||
+            !userStatsRepo_->adjustFollowerCount(conn, followeeId, -1)) {
+            result.success = false;
+            result.statusCode = 500;
+            result.message = "更新用户统计失败";
+            Logger::error("Failed to update user_stats");
+            return result;
+        }
         
         // 8. 提交事务
         trans.commit();
+
+        // 同步更新关注关系图缓存
+        FollowGraphCache::getInstance().onUnfollow(followerId, followeeId);
+
+        // 从关注时间线中移除对方的帖子
+        FeedService::getInstance().onUnfollow(conn, followerId, followeeId);
         
         // 9. 返回成功结果
         result.success = true;
@@ -261,7 +298,7 @@ FollowStatusResult FollowService::checkFollowStatus(int64_t followerId, const st
         MYSQL* conn = connGuard.get();
         
         // 2. 查询目标用户是否存在
-        auto followeeOpt = userRepo_->findByUserId(followeeUserId);
+        auto followeeOpt = userRepo_->findByUserId(conn, followeeUserId);
         if (!followeeOpt.has_value()) {
             result.success = false;
             result.statusCode = 404;
@@ -272,11 +309,18 @@ FollowStatusResult FollowService::checkFollowStatus(int64_t followerId, const st
         
         int64_t followeeId = followeeOpt->getId();
         
-        // 3. 检查我是否关注该用户
-        result.isFollowing = followRepo_->exists(conn, followerId, followeeId);
-        
-        // 4. 检查该用户是否关注我
-        result.isFollowedBy = followRepo_->exists(conn, followeeId, followerId);
+        // 3. 优先从关注关系图缓存判断（只需加载我的邻接数组）
+        auto& graphCache = FollowGraphCache::getInstance();
+        bool isFollowing = false;
+        bool isFollowedBy = false;
+        if (graphCache.getRelation(conn, followerId, followeeId, isFollowing, isFollowedBy)) {
+            result.isFollowing = isFollowing;
+            result.isFollowedBy = isFollowedBy;
+        } else {
+            // 缓存不可用（大V或加载失败），回退到数据库查询
+            result.isFollowing = followRepo_->exists(conn, followerId, followeeId);
+            result.isFollowedBy = followRepo_->exists(conn, followeeId, followerId);
+        }
         
         result.success = true;
         result.statusCode = 200;
@@ -310,7 +354,7 @@ std::vector<UserListInfo> FollowService::getFollowingList(const std::string& use
         MYSQL* conn = connGuard.get();
         
         // 2. 查询用户是否存在
-        auto userOpt = userRepo_->findByUserId(userId);
+        auto userOpt = userRepo_->findByUserId(conn, userId);
         if (!userOpt.has_value()) {
             Logger::warning("User not found: " + userId);
             return userList;
@@ -322,7 +366,12 @@ std::vector<UserListInfo> FollowService::getFollowingList(const std::string& use
         int offset = (page - 1) * pageSize;
 
         // 4. 查询关注列表（第1次数据库查询）
-        auto follows = followRepo_->findFollowingByUserId(conn, targetUserId, pageSize, offset);
+        auto followsOpt = followRepo_->findFollowingByUserId(conn, targetUserId, pageSize, offset);
+        if (!followsOpt) {
+            Logger::error("Failed to query following list for user " + userId);
+            return userList;
+        }
+        auto& follows = *followsOpt;
 
         // 5. 获取总数
         total = followRepo_->countFollowing(conn, targetUserId);
@@ -429,7 +478,7 @@ std::vector<UserListInfo> FollowService::getFollowerList(const std::string& user
         MYSQL* conn = connGuard.get();
         
         // 2. 查询用户是否存在
-        auto userOpt = userRepo_->findByUserId(userId);
+        auto userOpt = userRepo_->findByUserId(conn, userId);
         if (!userOpt.has_value()) {
             Logger::warning("User not found: " + userId);
             return userList;
@@ -441,7 +490,12 @@ std::vector<UserListInfo> FollowService::getFollowerList(const std::string& user
         int offset = (page - 1) * pageSize;
 
         // 4. 查询粉丝列表（第1次数据库查询）
-        auto follows = followRepo_->findFollowersByUserId(conn, targetUserId, pageSize, offset);
+        auto followsOpt = followRepo_->findFollowersByUserId(conn, targetUserId, pageSize, offset);
+        if (!followsOpt) {
+            Logger::error("Failed to query follower list for user " + userId);
+            return userList;
+        }
+        auto& follows = *followsOpt;
 
         // 5. 获取总数
         total = followRepo_->countFollowers(conn, targetUserId);
@@ -542,7 +596,7 @@ std::vector<UserListInfo> FollowService::getMutualFollowList(const std::string&
         MYSQL* conn = connGuard.get();
 
         // 2. 查询用户是否存在
-        auto userOpt = userRepo_->findByUserId(userId);
+        auto userOpt = userRepo_->findByUserId(conn, userId);
         if (!userOpt.has_value()) {
             Logger::warning("User not found: " + userId);
             return userList;
@@ -553,11 +607,22 @@ std::vector<UserListInfo> FollowService::getMutualFollowList(const std::string&
         // 3. 计算分页参数
         int offset = (page - 1) * pageSize;
 
-        // 4. 查询互关用户ID列表（第1次数据库查询）
-        auto mutualFollowIds = followRepo_->findMutualFollowIds(conn, targetUserId, pageSize, offset);
-
-        // 5. 获取总数
-        total = followRepo_->countMutualFollows(conn, targetUserId);
+        // 4. 查询互关用户ID列表：优先在内存中对邻接数组求交集
+        std::vector<int64_t> mutualFollowIds;
+        std::vector<int64_t> allMutualIds;
+        if (FollowGraphCache::getInstance().getMutualFollowIds(conn, targetUserId, allMutualIds)) {
+            // 5. 总数即交集大小，分页在内存中完成
+            total = static_cast<int>(allMutualIds.size());
+            if (offset < total) {
+                auto first = allMutualIds.begin() + offset;
+                auto last = allMutualIds.begin() + std::min(total, offset + pageSize);
+                mutualFollowIds.assign(first, last);
+            }
+        } else {
+            // 缓存不可用，回退到数据库查询
+            mutualFollowIds = followRepo_->findMutualFollowIds(conn, targetUserId, pageSize, offset);
+            total = followRepo_->countMutualFollows(conn, targetUserId);
+        }
 
         // 如果没有互关好友，直接返回
         if (mutualFollowIds.empty()) {
@@ -627,7 +692,13 @@ std::optional<UserStats> FollowService::getUserStats(const std::string& userId)
         
         MYSQL* conn = connGuard.get();
         
-        // 2. 调用Repository获取统计信息
+        // 2. 优先读取物化统计行（一次主键查询）
+        auto stats = userStatsRepo_->findByUserId(conn, userId);
+        if (stats.has_value()) {
+            return stats;
+        }
+
+        // 3. 统计行尚未建立时回退到聚合查询
         return userRepo_->getUserStats(conn, userId);
         
     } catch (const std::exception& e) {
@@ -660,7 +731,7 @@ std::map<std::string, bool> FollowService::batchCheckFollowStatus(int64_t follow
         std::map<int64_t, std::string> idMapping;  // 物理ID -> 业务ID 映射
         
         for (const auto& userIdStr : followeeUserIds) {
-            auto userOpt = userRepo_->findByUserId(userIdStr);
+            auto userOpt = userRepo_->findByUserId(conn, userIdStr);
             if (userOpt.has_value()) {
                 int64_t physicalId = userOpt->getId();
                 followeeIds.push_back(physicalId);
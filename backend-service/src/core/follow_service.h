@@ -17,6 +17,7 @@
 // 前向声明
 class FollowRepository;
 class UserRepository;
+class UserStatsRepository;
 
 /**
  * @brief 关注结果结构体
@@ -187,5 +188,6 @@ public:
 private:
     std::unique_ptr<FollowRepository> followRepo_;
     std::unique_ptr<UserRepository> userRepo_;
+    std::unique_ptr<UserStatsRepository> userStatsRepo_;
 };
 
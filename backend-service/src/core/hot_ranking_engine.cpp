@@ -0,0 +1,256 @@
+/**
+ * @file hot_ranking_engine.cpp
+ * @brief 热门帖子排行引擎实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "core/hot_ranking_engine.h"
+#include "database/post_repository.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 加载失败后的重试间隔（秒），不超过 refresh_seconds
+constexpr int kReloadRetrySeconds = 10;
+
+}  // namespace
+
+// 获取单例实例
+HotRankingEngine& HotRankingEngine::getInstance() {
+    static HotRankingEngine instance;
+    return instance;
+}
+
+// 构造函数：读取排行配置
+HotRankingEngine::HotRankingEngine()
+    : postRepo_(std::make_unique<PostRepository>())
+    , loadedAt_(0)
+    , nextReloadAt_(0)
+    , reloads_(0)
+    , reloadFailures_(0)
+    , signals_(0) {
+    auto& config = ConfigManager::getInstance();
+    enabled_ = config.get<bool>("hot_ranking.enabled", true);
+    maxPosts_ = config.get<int>("hot_ranking.max_posts", 5000);
+    maxAgeHours_ = config.get<int>("hot_ranking.max_age_hours", 72);
+    refreshSeconds_ = config.get<int>("hot_ranking.refresh_seconds", 300);
+    halfLifeHours_ = config.get<double>("hot_ranking.half_life_hours", 12.0);
+    weightLike_ = config.get<double>("hot_ranking.weights.like", 1.0);
+    weightFavorite_ = config.get<double>("hot_ranking.weights.favorite", 2.0);
+    weightComment_ = config.get<double>("hot_ranking.weights.comment", 3.0);
+    weightShare_ = config.get<double>("hot_ranking.weights.share", 4.0);
+    weightView_ = config.get<double>("hot_ranking.weights.view", 0.1);
+
+    if (halfLifeHours_ <= 0) {
+        halfLifeHours_ = 12.0;
+    }
+
+    Logger::info("HotRankingEngine initialized (enabled=" + std::string(enabled_ ? "true" : "false") +
+                ", max_posts=" + std::to_string(maxPosts_) +
+                ", max_age_hours=" + std::to_string(maxAgeHours_) + ")");
+}
+
+// 析构函数
+HotRankingEngine::~HotRankingEngine() = default;
+
+// 新帖子加入候选集
+void HotRankingEngine::onPostCreated(int64_t postId, std::time_t createTime) {
+    if (!enabled_) {
+        return;
+    }
+
+    Entry entry{0, 0, 0, 0, 0, createTime, 0.0};
+    entry.key = computeKey(entry);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    upsertLocked(postId, entry);
+}
+
+// 互动计数变化
+void HotRankingEngine::onSignal(int64_t postId, Signal signal, int delta) {
+    if (!enabled_) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(postId);
+    if (it == entries_.end()) {
+        return;
+    }
+
+    signals_++;
+    Entry entry = it->second;
+    switch (signal) {
+        case Signal::Like:     entry.likes = std::max(0, entry.likes + delta); break;
+        case Signal::Favorite: entry.favorites = std::max(0, entry.favorites + delta); break;
+        case Signal::Comment:  entry.comments = std::max(0, entry.comments + delta); break;
+        case Signal::Share:    entry.shares = std::max(0, entry.shares + delta); break;
+        case Signal::View:     entry.views = std::max(0, entry.views + delta); break;
+    }
+    entry.key = computeKey(entry);
+    upsertLocked(postId, entry);
+}
+
+// 移除帖子
+void HotRankingEngine::remove(int64_t postId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(postId);
+    if (it == entries_.end()) {
+        return;
+    }
+    eraseLocked(it);
+}
+
+// 获取一页热门帖子ID
+bool HotRankingEngine::getTopPostIds(int offset, int limit, std::vector<int64_t>& postIds, int& total) {
+    if (!enabled_) {
+        return false;
+    }
+
+    if (!refreshIfStale()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    evictExpiredLocked(std::time(nullptr));
+
+    total = static_cast<int>(ranking_.size());
+    postIds.clear();
+    if (offset >= total || limit <= 0) {
+        return true;
+    }
+
+    auto it = ranking_.begin();
+    std::advance(it, offset);
+    for (int i = 0; i < limit && it != ranking_.end(); ++i, ++it) {
+        postIds.push_back(it->second);
+    }
+    return true;
+}
+
+// 获取统计信息
+Json::Value HotRankingEngine::getStats() const {
+    Json::Value stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats["candidates"] = static_cast<Json::UInt64>(entries_.size());
+    }
+    stats["enabled"] = enabled_;
+    stats["max_posts"] = maxPosts_;
+    stats["loaded_at"] = static_cast<Json::Int64>(loadedAt_.load());
+    stats["reloads"] = static_cast<Json::UInt64>(reloads_.load());
+    stats["reload_failures"] = static_cast<Json::UInt64>(reloadFailures_.load());
+    stats["signals"] = static_cast<Json::UInt64>(signals_.load());
+    return stats;
+}
+
+// 计算排序键：log2(互动加权和) + 发布时间/半衰期
+double HotRankingEngine::computeKey(const Entry& entry) const {
+    double engagement = entry.likes * weightLike_ +
+                        entry.favorites * weightFavorite_ +
+                        entry.comments * weightComment_ +
+                        entry.shares * weightShare_ +
+                        entry.views * weightView_ +
+                        1.0;
+    return std::log2(engagement) + static_cast<double>(entry.createTime) / (halfLifeHours_ * 3600.0);
+}
+
+// 插入或更新（调用方需持有锁）
+void HotRankingEngine::upsertLocked(int64_t postId, Entry entry) {
+    auto it = entries_.find(postId);
+    if (it != entries_.end()) {
+        ranking_.erase(RankKey(it->second.key, postId));
+        byCreateTime_.erase(AgeKey(it->second.createTime, postId));
+        it->second = entry;
+    } else {
+        entries_.emplace(postId, entry);
+    }
+    ranking_.insert(RankKey(entry.key, postId));
+    byCreateTime_.insert(AgeKey(entry.createTime, postId));
+
+    // 超出容量：淘汰热度最低的帖子
+    while (static_cast<int>(ranking_.size()) > maxPosts_ && !ranking_.empty()) {
+        eraseLocked(entries_.find(std::prev(ranking_.end())->second));
+    }
+}
+
+// 从三个索引中删除（调用方需持有锁）
+void HotRankingEngine::eraseLocked(std::unordered_map<int64_t, Entry>::iterator it) {
+    ranking_.erase(RankKey(it->second.key, it->first));
+    byCreateTime_.erase(AgeKey(it->second.createTime, it->first));
+    entries_.erase(it);
+}
+
+// 淘汰超出时间窗口的帖子（调用方需持有锁）
+void HotRankingEngine::evictExpiredLocked(std::time_t now) {
+    std::time_t cutoff = now - static_cast<std::time_t>(maxAgeHours_) * 3600;
+    while (!byCreateTime_.empty() && byCreateTime_.begin()->first < cutoff) {
+        eraseLocked(entries_.find(byCreateTime_.begin()->second));
+    }
+}
+
+// 需要时从数据库重新加载
+bool HotRankingEngine::refreshIfStale() {
+    std::time_t now = std::time(nullptr);
+    if (loadedAt_.load() != 0 && now < nextReloadAt_.load()) {
+        return true;
+    }
+
+    // 已有线程在加载时，其余请求继续使用旧数据（首次加载除外）
+    std::unique_lock<std::mutex> reloadLock(reloadMutex_, std::defer_lock);
+    if (loadedAt_.load() != 0) {
+        if (!reloadLock.try_lock()) {
+            return true;
+        }
+    } else {
+        reloadLock.lock();
+        if (loadedAt_.load() != 0) {
+            return true;  // 等待期间其他线程已完成首次加载
+        }
+        if (now < nextReloadAt_.load()) {
+            return false;  // 首次加载刚失败过，重试前调用方回退到按时间排序
+        }
+    }
+
+    // 不持有 mutex_ 执行SQL
+    HotScoreParams params{weightLike_, weightFavorite_, weightComment_,
+                          weightShare_, weightView_, halfLifeHours_};
+    auto rows = postRepo_->getRecentEngagement(maxAgeHours_, maxPosts_, params);
+    if (!rows) {
+        // 保留当前排行，稍后重试，不把失败当作"没有帖子"
+        reloadFailures_++;
+        nextReloadAt_ = now + std::min(kReloadRetrySeconds, refreshSeconds_);
+        Logger::warning("HotRankingEngine reload failed, keeping previous ranking");
+        return loadedAt_.load() != 0;
+    }
+
+    std::unordered_map<int64_t, Entry> entries;
+    Ranking ranking;
+    AgeIndex byCreateTime;
+    entries.reserve(rows->size());
+    for (const auto& row : *rows) {
+        Entry entry{row.likeCount, row.favoriteCount, row.commentCount,
+                    row.shareCount, row.viewCount, row.createTime, 0.0};
+        entry.key = computeKey(entry);
+        entries.emplace(row.postId, entry);
+        ranking.insert(RankKey(entry.key, row.postId));
+        byCreateTime.insert(AgeKey(row.createTime, row.postId));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.swap(entries);
+        ranking_.swap(ranking);
+        byCreateTime_.swap(byCreateTime);
+    }
+
+    loadedAt_ = now;
+    nextReloadAt_ = now + refreshSeconds_;
+    reloads_++;
+    Logger::info("HotRankingEngine reloaded " + std::to_string(rows->size()) + " candidate posts");
+    return true;
+}
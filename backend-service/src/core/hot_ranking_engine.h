@@ -0,0 +1,189 @@
+/**
+ * @file hot_ranking_engine.h
+ * @brief 热门帖子排行引擎（时间衰减热度 + 进程内Top-K）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <json/json.h>
+
+// 前向声明
+class PostRepository;
+
+/**
+ * @brief 热门帖子排行引擎（单例）
+ *
+ * 热度 = 互动加权和 × 2^(-帖龄/半衰期)，互动加权和 =
+ *   like×w_like + favorite×w_favorite + comment×w_comment + share×w_share + view×w_view + 1
+ *
+ * 设计要点：
+ * - 取对数后 log2(热度) = log2(互动加权和) + 发布时间/半衰期 - 当前时间/半衰期，
+ *   最后一项对所有帖子相同，因此排序键只在互动变化时才需要重算，不随时间漂移
+ * - 候选集为最近 max_age_hours 内热度最高的最多 max_posts 条帖子，用有序集合做可更新的Top-K堆，
+ *   超出容量时淘汰排序键最小的帖子；全量加载在数据库中按同一排序键截取，两条路径保持一致
+ * - 另按发布时间维护有序索引，读取时只从最旧一端淘汰超出时间窗口的帖子，不扫描整个候选集
+ * - 点赞/收藏/评论/分享服务在事务提交后调用 onSignal 增量更新
+ * - 每 refresh_seconds 从数据库重新加载一次，修正浏览数等未增量上报的计数；
+ *   加载失败时保留当前排行，稍后重试，不会用空结果替换
+ */
+class HotRankingEngine {
+public:
+    /**
+     * @brief 互动信号类型
+     */
+    enum class Signal {
+        Like,
+        Favorite,
+        Comment,
+        Share,
+        View
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return HotRankingEngine引用
+     */
+    static HotRankingEngine& getInstance();
+
+    /**
+     * @brief 排行是否启用（hot_ranking.enabled）
+     */
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief 新帖子发布后加入候选集
+     * @param postId 帖子物理ID
+     * @param createTime 发布时间
+     */
+    void onPostCreated(int64_t postId, std::time_t createTime);
+
+    /**
+     * @brief 互动计数变化（事务提交后调用）
+     *
+     * 不在候选集中的帖子（过旧或尚未加载）直接忽略
+     *
+     * @param postId 帖子物理ID
+     * @param signal 信号类型
+     * @param delta 变化量（+1 / -1）
+     */
+    void onSignal(int64_t postId, Signal signal, int delta);
+
+    /**
+     * @brief 从候选集移除帖子（帖子删除或查询时发现已不可见）
+     * @param postId 帖子物理ID
+     */
+    void remove(int64_t postId);
+
+    /**
+     * @brief 按热度从高到低获取一页帖子ID
+     *
+     * 候选集为空或超过刷新间隔时先从数据库加载
+     *
+     * @param offset 偏移量
+     * @param limit 数量
+     * @param postIds 输出：帖子物理ID列表
+     * @param total 输出：候选集大小（分页总数）
+     * @return 排行可用返回true；未启用或首次加载失败返回false（调用方回退到按时间排序）
+     */
+    bool getTopPostIds(int offset, int limit, std::vector<int64_t>& postIds, int& total);
+
+    /**
+     * @brief 获取排行统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    HotRankingEngine(const HotRankingEngine&) = delete;
+    HotRankingEngine& operator=(const HotRankingEngine&) = delete;
+
+private:
+    HotRankingEngine();
+    ~HotRankingEngine();
+
+    /**
+     * @brief 单个帖子的互动计数
+     */
+    struct Entry {
+        int likes;
+        int favorites;
+        int comments;
+        int shares;
+        int views;
+        std::time_t createTime;
+        double key;             // 排序键（log2热度 + 当前时间项）
+    };
+
+    using RankKey = std::pair<double, int64_t>;                     // (排序键, 帖子ID)
+    using Ranking = std::set<RankKey, std::greater<RankKey>>;       // 热度从高到低
+    using AgeKey = std::pair<std::time_t, int64_t>;                 // (发布时间, 帖子ID)
+    using AgeIndex = std::set<AgeKey>;                              // 发布时间从旧到新
+
+    /**
+     * @brief 计算排序键
+     */
+    double computeKey(const Entry& entry) const;
+
+    /**
+     * @brief 插入或更新一条记录（调用方需持有锁）
+     */
+    void upsertLocked(int64_t postId, Entry entry);
+
+    /**
+     * @brief 从三个索引中删除一条记录（调用方需持有锁）
+     * @param it entries_ 中的位置
+     */
+    void eraseLocked(std::unordered_map<int64_t, Entry>::iterator it);
+
+    /**
+     * @brief 淘汰超出时间窗口的帖子（调用方需持有锁）
+     *
+     * 沿发布时间索引从最旧一端删除，只访问已过期的帖子
+     *
+     * @param now 当前时间
+     */
+    void evictExpiredLocked(std::time_t now);
+
+    /**
+     * @brief 需要时从数据库重新加载候选集
+     * @return 排行已加载过（本次或之前）返回true；从未加载成功返回false
+     */
+    bool refreshIfStale();
+
+    std::unique_ptr<PostRepository> postRepo_;
+
+    std::unordered_map<int64_t, Entry> entries_;
+    Ranking ranking_;
+    AgeIndex byCreateTime_;
+    mutable std::mutex mutex_;
+
+    std::mutex reloadMutex_;                // 保证同一时间只有一个线程在加载
+    std::atomic<std::time_t> loadedAt_;     // 上次成功加载时间（0表示未加载）
+    std::atomic<std::time_t> nextReloadAt_; // 下次加载时间（失败后提前重试）
+    std::atomic<uint64_t> reloads_;
+    std::atomic<uint64_t> reloadFailures_;
+    std::atomic<uint64_t> signals_;
+
+    bool enabled_;
+    int maxPosts_;              // 候选集容量（Top-K 的 K）
+    int maxAgeHours_;           // 候选时间窗口
+    int refreshSeconds_;        // 全量重载间隔
+    double halfLifeHours_;      // 热度半衰期
+    double weightLike_;
+    double weightFavorite_;
+    double weightComment_;
+    double weightShare_;
+    double weightView_;
+};
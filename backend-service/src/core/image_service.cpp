@@ -6,6 +6,7 @@
  */
 
 #include "core/image_service.h"
+#include "core/thumbnail_cache.h"
 #include "database/image_repository.h"
 #include "utils/image_processor.h"
 #include "utils/config_manager.h"
@@ -305,6 +306,7 @@ bool ImageService::deleteImage(const std::string& imageId, int userId) {
         }
         if (!image.getThumbnailUrl().empty()) {
             std::remove(image.getThumbnailUrl().c_str());
+            ThumbnailCache::getInstance().invalidate(image.getThumbnailUrl());
         }
     } catch (const std::exception& e) {
         Logger::warning("Failed to delete image files: " + std::string(e.what()));
@@ -6,8 +6,10 @@
  */
 
 #include "core/like_service.h"
+#include "core/hot_ranking_engine.h"
 #include "database/like_repository.h"
 #include "database/post_repository.h"
+#include "database/user_stats_repository.h"
 #include "database/connection_guard.h"
 #include "database/connection_pool.h"
 #include "utils/logger.h"
@@ -16,6 +18,7 @@
 LikeService::LikeService() {
     likeRepo_ = std::make_unique<LikeRepository>();
     postRepo_ = std::make_unique<PostRepository>();
+    userStatsRepo_ = std::make_unique<UserStatsRepository>();
     Logger::info("LikeService initialized");
 }
 
@@ -31,15 +34,7 @@ LikeResult LikeService::likePost(int userId, const std::string& postId) {
     try {
         Logger::info("User " + std::to_string(userId) + " liking post " + postId);
 
-        // 1. 查询帖子
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -49,6 +44,14 @@ LikeResult LikeService::likePost(int userId, const std::string& postId) {
 
         MYSQL* conn = connGuard.get();
 
+        // 1. 查询帖子
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 2. 检查是否已点赞（幂等性）
         if (likeRepo_->exists(conn, userId, post->getId())) {
             result.success = true;
@@ -83,6 +86,14 @@ LikeResult LikeService::likePost(int userId, const std::string& postId) {
             return result;
         }
 
+        // 同步更新作者的用户统计
+        if (!userStatsRepo_->adjustTotalLikes(conn, post->getUserId(), 1)) {
+            mysql_query(conn, "ROLLBACK");
+            result.statusCode = 500;
+            result.message = "更新用户统计失败";
+            return result;
+        }
+
         // 6. 提交事务
         if (mysql_query(conn, "COMMIT") != 0) {
             Logger::error("Failed to commit transaction: " + std::string(mysql_error(conn)));
@@ -92,8 +103,11 @@ LikeResult LikeService::likePost(int userId, const std::string& postId) {
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(post->getId(), HotRankingEngine::Signal::Like, 1);
+
         // 7. 查询最新点赞数
-        auto updatedPost = postRepo_->findByPostId(postId);
+        auto updatedPost = postRepo_->findByPostId(conn, postId);
         int newLikeCount = updatedPost.has_value() ? updatedPost->getLikeCount() : (post->getLikeCount() + 1);
 
         result.success = true;
@@ -120,15 +134,7 @@ LikeResult LikeService::unlikePost(int userId, const std::string& postId) {
     try {
         Logger::info("User " + std::to_string(userId) + " unliking post " + postId);
 
-        // 1. 查询帖子
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -138,6 +144,14 @@ LikeResult LikeService::unlikePost(int userId, const std::string& postId) {
 
         MYSQL* conn = connGuard.get();
 
+        // 1. 查询帖子
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 2. 检查是否已点赞
         if (!likeRepo_->exists(conn, userId, post->getId())) {
             result.success = true;
@@ -172,6 +186,14 @@ LikeResult LikeService::unlikePost(int userId, const std::string& postId) {
             return result;
         }
 
+        // 同步更新作者的用户统计
+        if (!userStatsRepo_->adjustTotalLikes(conn, post->getUserId(), -1)) {
+            mysql_query(conn, "ROLLBACK");
+            result.statusCode = 500;
+            result.message = "更新用户统计失败";
+            return result;
+        }
+
         // 6. 提交事务
         if (mysql_query(conn, "COMMIT") != 0) {
             Logger::error("Failed to commit transaction: " + std::string(mysql_error(conn)));
@@ -181,8 +203,11 @@ LikeResult LikeService::unlikePost(int userId, const std::string& postId) {
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(post->getId(), HotRankingEngine::Signal::Like, -1);
+
         // 7. 查询最新点赞数
-        auto updatedPost = postRepo_->findByPostId(postId);
+        auto updatedPost = postRepo_->findByPostId(conn, postId);
         int newLikeCount = updatedPost.has_value() ? updatedPost->getLikeCount() : (post->getLikeCount() - 1);
 
         result.success = true;
@@ -225,15 +250,7 @@ LikeStatusResult LikeService::getLikeStatus(int userId, const std::string& postI
     try {
         Logger::info("Getting like status for user " + std::to_string(userId) + " on post " + postId);
 
-        // 1. 查询帖子
-        auto post = postRepo_->findByPostId(postId);
-        if (!post.has_value()) {
-            result.statusCode = 404;
-            result.message = "帖子不存在";
-            return result;
-        }
-
-        // 获取数据库连接
+        // 获取数据库连接（整个操作只占用这一个连接）
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             result.statusCode = 500;
@@ -243,6 +260,14 @@ LikeStatusResult LikeService::getLikeStatus(int userId, const std::string& postI
 
         MYSQL* conn = connGuard.get();
 
+        // 1. 查询帖子
+        auto post = postRepo_->findByPostId(conn, postId);
+        if (!post.has_value()) {
+            result.statusCode = 404;
+            result.message = "帖子不存在";
+            return result;
+        }
+
         // 2. 查询用户是否已点赞
         bool liked = likeRepo_->exists(conn, userId, post->getId());
 
@@ -15,6 +15,7 @@
 // 前向声明
 class LikeRepository;
 class PostRepository;
+class UserStatsRepository;
 
 /**
  * @brief 点赞结果结构体
@@ -137,4 +138,5 @@ public:
 private:
     std::unique_ptr<LikeRepository> likeRepo_;
     std::unique_ptr<PostRepository> postRepo_;
+    std::unique_ptr<UserStatsRepository> userStatsRepo_;
 };
@@ -7,14 +7,24 @@
 
 #include "core/post_service.h"
 #include "core/image_service.h"
+#include "core/feed_service.h"
+#include "core/hot_ranking_engine.h"
+#include "core/count_service.h"
 #include "database/post_repository.h"
 #include "database/image_repository.h"
 #include "database/tag_repository.h"
+#include "database/user_stats_repository.h"
+#include "database/connection_pool.h"
+#include "database/connection_guard.h"
+#include "database/db_operation_scope.h"
+#include "database/transaction_guard.h"
 #include "database/transaction_manager.h"
 #include "utils/logger.h"
 #include <random>
 #include <sstream>
 #include <chrono>
+#include <ctime>
+#include <unordered_set>
 
 // ============================================================================
 // 构造函数和析构函数
@@ -25,6 +35,7 @@ PostService::PostService() {
     imageService_ = std::make_unique<ImageService>();
     imageRepo_ = std::make_unique<ImageRepository>();
     tagRepo_ = std::make_unique<TagRepository>();
+    userStatsRepo_ = std::make_unique<UserStatsRepository>();
     Logger::info("PostService initialized");
 }
 
@@ -87,40 +98,68 @@ PostCreateResult PostService::createPost(
         post.setFavoriteCount(0);
         post.setViewCount(0);
 
-        // 6. 创建帖子记录
-        if (!postRepo_->createPost(post)) {
-            result.message = "创建帖子记录失败";
-            Logger::error(result.message);
-            return result;
+        // 6. 创建帖子记录，与作者的 post_count 放在同一事务中
+        {
+            ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+            if (!connGuard.isValid()) {
+                result.message = "创建帖子记录失败";
+                Logger::error("Failed to get database connection");
+                return result;
+            }
+            MYSQL* conn = connGuard.get();
+
+            TransactionGuard trans(conn);
+            if (!postRepo_->createPost(conn, post)) {
+                result.message = "创建帖子记录失败";
+                Logger::error(result.message);
+                return result;
+            }
+            if (!userStatsRepo_->adjustPostCount(conn, userId, 1)) {
+                result.message = "创建帖子记录失败";
+                Logger::error("Failed to update post_count in user_stats for user " + std::to_string(userId));
+                return result;
+            }
+            if (!trans.commit()) {
+                result.message = "创建帖子记录失败";
+                Logger::error("Failed to commit post creation: " + postId);
+                return result;
+            }
         }
 
         Logger::info("Post created with ID: " + postId + ", physical ID: " + std::to_string(post.getId()));
 
-        // 7. 处理图片上传
+        // 7. 处理图片上传（压缩、缩略图不访问数据库，期间暂停请求的连接作用域，连接先还给连接池）
+        std::vector<Image> processedImages;
+        {
+            DbOperationScope::Suspension suspendDb;
+            for (size_t i = 0; i < imagePaths.size(); i++) {
+                Logger::info("Processing image " + std::to_string(i + 1) + "/" + std::to_string(imagePaths.size()));
+
+                // 调用imageService处理图片（压缩、缩略图）
+                std::vector<std::string> emptyTags;
+                ImageUploadResult imgResult = imageService_->uploadImage(
+                    userId,
+                    imagePaths[i],
+                    title,  // 使用帖子标题作为图片标题
+                    "",
+                    emptyTags
+                );
+
+                if (!imgResult.success) {
+                    Logger::warning("Image processing failed: " + imgResult.message);
+                    // 继续处理下一张图片，但记录失败
+                    continue;
+                }
+                processedImages.push_back(imgResult.image);
+            }
+        }
+
+        // 保存图片记录
         std::vector<Image> savedImages;
         int actualImageCount = 0;
 
-        for (size_t i = 0; i < imagePaths.size(); i++) {
-            Logger::info("Processing image " + std::to_string(i + 1) + "/" + std::to_string(imagePaths.size()));
-
-            // 调用imageService处理图片（压缩、缩略图）
-            std::vector<std::string> emptyTags;
-            ImageUploadResult imgResult = imageService_->uploadImage(
-                userId,
-                imagePaths[i],
-                title,  // 使用帖子标题作为图片标题
-                "",
-                emptyTags
-            );
-
-            if (!imgResult.success) {
-                Logger::warning("Image processing failed: " + imgResult.message);
-                // 继续处理下一张图片，但记录失败
-                continue;
-            }
-
+        for (Image& image : processedImages) {
             // 设置图片的postId和displayOrder
-            Image image = imgResult.image;
             image.setPostId(post.getId());
             image.setDisplayOrder(actualImageCount);  // 使用实际保存的图片数量作为顺序
 
@@ -137,8 +176,10 @@ PostCreateResult PostService::createPost(
         // 8. 验证至少有一张图片成功上传
         if (savedImages.empty()) {
             Logger::error("No images were successfully processed");
-            // 删除刚创建的帖子记录
-            postRepo_->deletePost(postId);
+            // 删除刚创建的帖子记录（同一事务内回退 post_count）
+            if (!deletePost(postId, userId)) {
+                Logger::error("Failed to roll back post without images: " + postId);
+            }
             result.message = "所有图片处理失败，帖子创建失败";
             return result;
         }
@@ -190,6 +231,12 @@ PostCreateResult PostService::createPost(
             Logger::info("Tag linked successfully: " + tagName);
         }
 
+        // 推送到粉丝的关注时间线（失败不影响发帖结果）
+        FeedService::getInstance().onPostCreated(userId, post.getId());
+
+        // 加入热门排行候选集
+        HotRankingEngine::getInstance().onPostCreated(post.getId(), std::time(nullptr));
+
         // 11. 查询完整帖子信息（包含图片）
         auto postWithImages = postRepo_->findByPostIdWithImages(postId);
         if (!postWithImages.has_value()) {
@@ -301,18 +348,48 @@ bool PostService::deletePost(const std::string& postId, int userId) {
     try {
         Logger::info("Deleting post: " + postId + " by user: " + std::to_string(userId));
 
-        // 1. 权限验证
-        if (!checkOwnership(postId, userId)) {
+        // 整个操作只占用这一个连接
+        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+        if (!connGuard.isValid()) {
+            Logger::error("Failed to get database connection");
+            return false;
+        }
+        MYSQL* conn = connGuard.get();
+
+        // 1. 权限验证（同时取得帖子的点赞/收藏数，用于回退作者统计）
+        auto postOpt = postRepo_->findByPostId(conn, postId);
+        if (!postOpt.has_value()) {
+            Logger::warning("Post not found for deletion: " + postId);
+            return false;
+        }
+        if (postOpt->getUserId() != userId) {
             Logger::warning("User " + std::to_string(userId) + " does not own post " + postId);
             return false;
         }
 
-        // 2. 删除帖子（级联删除由数据库外键处理）
-        if (!postRepo_->deletePost(postId)) {
+        // 2. 删除帖子与更新作者统计放在同一事务中（级联删除由数据库外键处理）
+        TransactionGuard trans(conn);
+
+        if (!postRepo_->deletePost(conn, postId)) {
             Logger::error("Failed to delete post: " + postId);
             return false;
         }
 
+        if (!userStatsRepo_->adjustPostCount(conn, userId, -1) ||
+            !userStatsRepo_->adjustTotalLikes(conn, userId, -postOpt->getLikeCount()) ||
+            !userStatsRepo_->adjustTotalFavorites(conn, userId, -postOpt->getFavoriteCount())) {
+            Logger::error("Failed to update user_stats when deleting post: " + postId);
+            return false;
+        }
+
+        if (!trans.commit()) {
+            Logger::error("Failed to commit post deletion: " + postId);
+            return false;
+        }
+
+        // 3. 从热门排行中移除
+        HotRankingEngine::getInstance().remove(postOpt->getId());
+
         Logger::info("Post deleted successfully: " + postId);
         return true;
 
@@ -355,14 +432,18 @@ PostQueryResult PostService::getRecentPosts(int page, int pageSize, bool include
                    posts = postRepo_->getRecentPosts(page, pageSize);
                }
 
-        // 3. 查询总数
-        int totalCount = postRepo_->getTotalCount();
+        // 3. 查询总数（posts_total 可配置为缓存近似值）
+        CountResult count = CountService::getInstance().getCount(
+            "posts_total", "all", nullptr,
+            [repo = postRepo_.get()](MYSQL* conn) { return repo->getTotalCount(conn); });
+        int totalCount = count.value;
 
         // 4. 构建结果
         result.success = true;
         result.message = "查询成功";
         result.posts = posts;
         result.total = totalCount;
+        result.totalIsEstimate = count.isEstimate;
         result.page = page;
         result.pageSize = pageSize;
 
@@ -376,6 +457,69 @@ PostQueryResult PostService::getRecentPosts(int page, int pageSize, bool include
     }
 }
 
+/**
+ * 获取热门帖子列表
+ */
+PostQueryResult PostService::getHotPosts(int page, int pageSize) {
+    PostQueryResult result;
+
+    try {
+        // 1. 参数验证
+        if (page < 1) {
+            result.message = "页码必须大于等于1";
+            Logger::warning(result.message);
+            return result;
+        }
+
+        if (pageSize <= 0 || pageSize > 100) {
+            result.message = "每页数量必须在1-100之间";
+            Logger::warning(result.message);
+            return result;
+        }
+
+        // 2. 从内存排行取一页帖子ID
+        auto& engine = HotRankingEngine::getInstance();
+        std::vector<int64_t> rankedIds;
+        int total = 0;
+        if (!engine.getTopPostIds((page - 1) * pageSize, pageSize, rankedIds, total)) {
+            return getRecentPosts(page, pageSize);
+        }
+
+        // 3. 批量加载帖子详情（保持排行顺序）
+        std::vector<int> postIds(rankedIds.begin(), rankedIds.end());
+        std::vector<Post> posts = postRepo_->findByIdsWithImages(postIds);
+
+        // 已删除或不再可见的帖子从排行中移除
+        if (posts.size() != postIds.size()) {
+            std::unordered_set<int> found;
+            for (const auto& post : posts) {
+                found.insert(post.getId());
+            }
+            for (int postId : postIds) {
+                if (found.find(postId) == found.end()) {
+                    engine.remove(postId);
+                }
+            }
+        }
+
+        // 4. 构建结果
+        result.success = true;
+        result.message = "查询成功";
+        result.posts = posts;
+        result.total = total;
+        result.page = page;
+        result.pageSize = pageSize;
+
+        Logger::info("Fetched " + std::to_string(posts.size()) + " hot posts, candidates: " + std::to_string(total));
+        return result;
+
+    } catch (const std::exception& e) {
+        result.message = "查询热门帖子异常: " + std::string(e.what());
+        Logger::error(result.message);
+        return result;
+    }
+}
+
 /**
  * 获取用户帖子列表
  */
@@ -409,8 +553,17 @@ PostQueryResult PostService::getUserPosts(int userId, int page, int pageSize, bo
             posts = postRepo_->findByUserId(userId, page, pageSize);
         }
 
-        // 3. 查询用户帖子总数
-        int totalCount = postRepo_->getUserPostCount(userId);
+        // 3. 查询用户帖子总数（优先读取用户统计行，缺失时回退到COUNT查询）
+        int totalCount = -1;
+        {
+            ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+            if (connGuard.isValid()) {
+                totalCount = userStatsRepo_->getPostCount(connGuard.get(), userId);
+            }
+        }
+        if (totalCount < 0) {
+            totalCount = postRepo_->getUserPostCount(userId);
+        }
 
         // 4. 构建结果
         result.success = true;
@@ -544,15 +697,19 @@ bool PostService::addImageToPost(const std::string& postId, int userId, const st
             return false;
         }
 
-        // 4. 处理图片（压缩、缩略图）
+        // 4. 处理图片（压缩、缩略图；期间暂停请求的连接作用域）
         std::vector<std::string> emptyTags;
-        ImageUploadResult imgResult = imageService_->uploadImage(
-            userId,
-            imagePath,
-            post.getTitle(),  // 使用帖子标题作为图片标题
-            "",
-            emptyTags
-        );
+        ImageUploadResult imgResult;
+        {
+            DbOperationScope::Suspension suspendDb;
+            imgResult = imageService_->uploadImage(
+                userId,
+                imagePath,
+                post.getTitle(),  // 使用帖子标题作为图片标题
+                "",
+                emptyTags
+            );
+        }
 
         if (!imgResult.success) {
             Logger::error("Failed to process image: " + imgResult.message);
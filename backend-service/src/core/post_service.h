@@ -18,6 +18,7 @@ class PostRepository;
 class ImageService;
 class TagRepository;
 class ImageRepository;
+class UserStatsRepository;
 
 // ============================================================================
 // Result结构体定义
@@ -42,10 +43,11 @@ struct PostQueryResult {
     std::string message;
     std::vector<Post> posts;
     int total;
+    bool totalIsEstimate;   // total 是否为缓存的近似值
     int page;
     int pageSize;
 
-    PostQueryResult() : success(false), message(""), total(0), page(0), pageSize(0) {}
+    PostQueryResult() : success(false), message(""), total(0), totalIsEstimate(false), page(0), pageSize(0) {}
 };
 
 /**
@@ -82,6 +84,7 @@ public:
      * 6. 上传并处理图片
      * 7. 关联标签（如果有）
      * 8. 提交事务
+     * 9. 推送到粉丝的关注时间线
      *
      * @param userId 创建用户ID
      * @param title 帖子标题
@@ -143,6 +146,18 @@ public:
      */
     PostQueryResult getRecentPosts(int page, int pageSize, bool includeImages = true);
 
+    /**
+     * @brief 获取热门帖子列表（sort=hot）
+     *
+     * 按时间衰减的互动热度排序，排行由 HotRankingEngine 在内存中维护；
+     * 排行未启用时回退到按创建时间排序
+     *
+     * @param page 页码（从1开始）
+     * @param pageSize 每页数量
+     * @return PostQueryResult 查询结果
+     */
+    PostQueryResult getHotPosts(int page, int pageSize);
+
     /**
      * @brief 获取用户的帖子列表
      *
@@ -216,6 +231,7 @@ private:
     std::unique_ptr<ImageService> imageService_;
     std::unique_ptr<TagRepository> tagRepo_;
     std::unique_ptr<ImageRepository> imageRepo_;
+    std::unique_ptr<UserStatsRepository> userStatsRepo_;
 
     /**
      * @brief 生成唯一帖子ID
@@ -7,6 +7,9 @@
  */
 
 #include "core/share_service.h"
+#include "core/follow_graph_cache.h"
+#include "core/hot_ranking_engine.h"
+#include "core/count_service.h"
 #include "database/share_repository.h"
 #include "database/follow_repository.h"
 #include "database/post_repository.h"
@@ -60,16 +63,15 @@ std::string ShareService::generateShareId() {
 }
 
 // 检查两个用户是否互相关注
-bool ShareService::checkMutualFollow(int userId1, int userId2) {
+bool ShareService::checkMutualFollow(MYSQL* conn, int userId1, int userId2) {
     try {
-        ConnectionGuard guard(DatabaseConnectionPool::getInstance());
-        if (!guard.isValid()) {
-            Logger::error("Failed to get database connection in checkMutualFollow");
-            return false;
+        // 优先使用关注关系图缓存（内存中二分查找，无需数据库往返）
+        bool isMutual = false;
+        if (FollowGraphCache::getInstance().isMutualFollow(conn, userId1, userId2, isMutual)) {
+            return isMutual;
         }
 
-        MYSQL* conn = guard.get();
-
+        // 缓存不可用时回退到数据库查询
         // 检查 userId1 是否关注 userId2
         bool user1FollowsUser2 = followRepo_->exists(conn, userId1, userId2);
         if (!user1FollowsUser2) {
@@ -173,7 +175,7 @@ std::map<int, ShareListItem::SenderInfo> ShareService::batchGetUserInfo(const st
 
         // 批量查询用户（使用UserRepository的查询方法）
         for (int userId : userIds) {
-            auto userOpt = userRepo_->findById(userId);
+            auto userOpt = userRepo_->findById(conn, userId);
             if (userOpt.has_value()) {
                 User user = userOpt.value();
                 ShareListItem::SenderInfo info;
@@ -259,8 +261,18 @@ CreateShareResult ShareService::createShare(int senderId, const std::string& pos
             return result;
         }
 
+        // 获取数据库连接（整个操作只占用这一个连接）
+        ConnectionGuard guard(DatabaseConnectionPool::getInstance());
+        if (!guard.isValid()) {
+            result.statusCode = 500;
+            result.message = "数据库连接失败";
+            return result;
+        }
+
+        MYSQL* conn = guard.get();
+
         // 3. 通过业务ID查询帖子
-        auto postOpt = postRepo_->findByPostId(postId);
+        auto postOpt = postRepo_->findByPostId(conn, postId);
         if (!postOpt.has_value()) {
             result.statusCode = 404;
             result.message = "帖子不存在";
@@ -269,7 +281,7 @@ CreateShareResult ShareService::createShare(int senderId, const std::string& pos
         int postPhysicalId = postOpt.value().getId();
 
         // 4. 通过业务ID查询接收者用户
-        auto receiverOpt = userRepo_->findByUserId(receiverId);
+        auto receiverOpt = userRepo_->findByUserId(conn, receiverId);
         if (!receiverOpt.has_value()) {
             result.statusCode = 404;
             result.message = "接收者不存在";
@@ -284,17 +296,8 @@ CreateShareResult ShareService::createShare(int senderId, const std::string& pos
             return result;
         }
 
-        ConnectionGuard guard(DatabaseConnectionPool::getInstance());
-        if (!guard.isValid()) {
-            result.statusCode = 500;
-            result.message = "数据库连接失败";
-            return result;
-        }
-
-        MYSQL* conn = guard.get();
-
         // 6. 验证是否互相关注（使用物理ID）
-        if (!checkMutualFollow(senderId, receiverPhysicalId)) {
+        if (!checkMutualFollow(conn, senderId, receiverPhysicalId)) {
             result.statusCode = 403;
             result.message = "只能分享给互相关注的用户";
             return result;
@@ -325,6 +328,9 @@ CreateShareResult ShareService::createShare(int senderId, const std::string& pos
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(postPhysicalId, HotRankingEngine::Signal::Share, 1);
+
         // 10. 返回成功结果
         result.success = true;
         result.statusCode = 201;
@@ -375,8 +381,12 @@ ShareListResult ShareService::getReceivedShares(int receiverId, int page, int pa
 
         MYSQL* conn = guard.get();
 
-        // 2. 查询总数
-        int total = shareRepo_->countReceivedShares(conn, receiverId);
+        // 2. 查询总数（received_shares 可配置为缓存近似值）
+        CountResult count = CountService::getInstance().getCount(
+            "received_shares", std::to_string(receiverId), conn,
+            [repo = shareRepo_.get(), receiverId](MYSQL* c) { return repo->countReceivedShares(c, receiverId); });
+        int total = count.value;
+        result.totalIsEstimate = count.isEstimate;
 
         // 3. 查询分享列表（基础数据）
         int offset = (page - 1) * pageSize;
@@ -593,6 +603,9 @@ DeleteShareResult ShareService::deleteShare(int shareId, int operatorId) {
             return result;
         }
 
+        // 更新热门排行
+        HotRankingEngine::getInstance().onSignal(share.getPostId(), HotRankingEngine::Signal::Share, -1);
+
         // 5. 返回成功结果
         result.success = true;
         result.statusCode = 200;
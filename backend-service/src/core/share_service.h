@@ -12,6 +12,7 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <mysql/mysql.h>
 #include "models/share.h"
 
 // 前向声明
@@ -73,12 +74,14 @@ struct ShareListResult {
     std::string message;                // 消息
     std::vector<ShareListItem> shares;  // 分享列表
     int total;                          // 总数
+    bool totalIsEstimate;               // total 是否为缓存的近似值
     int page;                           // 当前页码
     int pageSize;                       // 每页数量
     bool hasMore;                       // 是否有更多
 
     ShareListResult()
-        : success(false), statusCode(500), message(""), total(0), page(1), pageSize(20), hasMore(false) {}
+        : success(false), statusCode(500), message(""), total(0), totalIsEstimate(false),
+          page(1), pageSize(20), hasMore(false) {}
 };
 
 /**
@@ -184,11 +187,12 @@ private:
 
     /**
      * @brief 检查两个用户是否互相关注
+     * @param conn MySQL连接（调用方持有的连接）
      * @param userId1 用户1的物理ID
      * @param userId2 用户2的物理ID
      * @return 互关返回true，否则返回false
      */
-    bool checkMutualFollow(int userId1, int userId2);
+    bool checkMutualFollow(MYSQL* conn, int userId1, int userId2);
 
     /**
      * @brief 批量获取帖子信息（复用PostRepository）
@@ -0,0 +1,339 @@
+/**
+ * @file thumbnail_cache.cpp
+ * @brief 热点缩略图内存缓存实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "core/thumbnail_cache.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+constexpr int kSketchDepth = 4;
+constexpr uint8_t kMaxCounter = 15;
+
+// 假定的缩略图平均大小（用于估算每个分片的条目数）
+constexpr size_t kAverageThumbnailBytes = 8 * 1024;
+
+uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * @brief count-min sketch 访问频率估算（4行，计数上限15）
+ *
+ * 累计记录次数达到 sampleSize 后所有计数减半，旧热点逐渐衰减
+ */
+class FrequencySketch {
+public:
+    explicit FrequencySketch(size_t width)
+        : width_(nextPowerOfTwo(std::max<size_t>(width, 64)))
+        , table_(width_ * kSketchDepth, 0)
+        , additions_(0)
+        , sampleSize_(width_ * 10) {
+    }
+
+    void increment(uint64_t hash) {
+        bool added = false;
+        for (int i = 0; i < kSketchDepth; ++i) {
+            uint8_t& counter = table_[index(hash, i)];
+            if (counter < kMaxCounter) {
+                counter++;
+                added = true;
+            }
+        }
+        if (added && ++additions_ >= sampleSize_) {
+            reset();
+        }
+    }
+
+    int estimate(uint64_t hash) const {
+        int result = kMaxCounter;
+        for (int i = 0; i < kSketchDepth; ++i) {
+            result = std::min<int>(result, table_[index(hash, i)]);
+        }
+        return result;
+    }
+
+private:
+    size_t index(uint64_t hash, int row) const {
+        return static_cast<size_t>(row) * width_ +
+               static_cast<size_t>(mix64(hash + static_cast<uint64_t>(row) * 0x9E3779B97F4A7C15ULL) & (width_ - 1));
+    }
+
+    void reset() {
+        for (auto& counter : table_) {
+            counter >>= 1;
+        }
+        additions_ /= 2;
+    }
+
+    size_t width_;
+    std::vector<uint8_t> table_;
+    size_t additions_;
+    size_t sampleSize_;
+};
+
+// 取路径最后一段作为文件名
+std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+}  // namespace
+
+/**
+ * @brief 缓存分片（独立加锁）
+ */
+struct ThumbnailCache::Shard {
+    struct Slot {
+        std::shared_ptr<const Entry> entry;
+        std::list<std::string>::iterator position;
+    };
+
+    Shard(size_t capacityBytes, size_t sketchWidth)
+        : capacity(capacityBytes)
+        , bytes(0)
+        , sketch(sketchWidth) {
+    }
+
+    std::mutex mutex;
+    std::list<std::string> lru;                     // 头部为最近使用
+    std::unordered_map<std::string, Slot> entries;
+    size_t capacity;
+    size_t bytes;
+    FrequencySketch sketch;
+};
+
+// 获取单例实例
+ThumbnailCache& ThumbnailCache::getInstance() {
+    static ThumbnailCache instance;
+    return instance;
+}
+
+// 构造函数：读取缓存配置并创建分片
+ThumbnailCache::ThumbnailCache()
+    : generation_(0)
+    , hits_(0)
+    , misses_(0)
+    , admitted_(0)
+    , rejected_(0)
+    , evictions_(0)
+    , invalidations_(0) {
+    auto& config = ConfigManager::getInstance();
+    enabled_ = config.get<bool>("thumbnail_cache.enabled", true);
+    int maxMb = std::max(1, config.get<int>("thumbnail_cache.max_bytes_mb", 64));
+    int maxEntryKb = std::max(1, config.get<int>("thumbnail_cache.max_entry_kb", 256));
+    int shardCount = std::min(256, std::max(1, config.get<int>("thumbnail_cache.shards", 16)));
+
+    maxBytes_ = static_cast<size_t>(maxMb) * 1024 * 1024;
+    maxEntryBytes_ = static_cast<size_t>(maxEntryKb) * 1024;
+
+    size_t shardBytes = maxBytes_ / static_cast<size_t>(shardCount);
+    size_t sketchWidth = shardBytes / kAverageThumbnailBytes * 2;
+    shards_.reserve(static_cast<size_t>(shardCount));
+    for (int i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>(shardBytes, sketchWidth));
+    }
+
+    Logger::info("ThumbnailCache initialized (enabled=" + std::string(enabled_ ? "true" : "false") +
+                ", max_bytes_mb=" + std::to_string(maxMb) +
+                ", shards=" + std::to_string(shardCount) + ")");
+}
+
+// 析构函数
+ThumbnailCache::~ThumbnailCache() = default;
+
+// 根据文件名选择分片
+ThumbnailCache::Shard& ThumbnailCache::shardFor(const std::string& name, uint64_t& hash) {
+    hash = static_cast<uint64_t>(std::hash<std::string>{}(name));
+    return *shards_[mix64(hash) % shards_.size()];
+}
+
+// 查询缓存
+std::shared_ptr<const ThumbnailCache::Entry> ThumbnailCache::get(const std::string& name) {
+    if (!enabled_) {
+        return nullptr;
+    }
+
+    uint64_t hash = 0;
+    Shard& shard = shardFor(name, hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.sketch.increment(hash);
+
+    auto it = shard.entries.find(name);
+    if (it == shard.entries.end()) {
+        misses_++;
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.position);
+    hits_++;
+    return it->second.entry;
+}
+
+// 预判是否准入
+bool ThumbnailCache::admits(const std::string& name, size_t size) {
+    if (!enabled_) {
+        return false;
+    }
+
+    uint64_t hash = 0;
+    Shard& shard = shardFor(name, hash);
+    if (size > maxEntryBytes_ || size > shard.capacity) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t victims = 0;
+    return admitLocked(shard, name, hash, size, victims);
+}
+
+// TinyLFU 准入判断（调用方需持有分片锁）
+bool ThumbnailCache::admitLocked(Shard& shard, const std::string& name, uint64_t hash, size_t size, size_t& victims) {
+    size_t bytes = shard.bytes;
+    auto existing = shard.entries.find(name);
+    if (existing != shard.entries.end()) {
+        bytes -= existing->second.entry->data.size();
+    }
+
+    victims = 0;
+    if (bytes + size <= shard.capacity) {
+        return true;
+    }
+
+    // 空间不足：候选项频率必须高于所有需要淘汰的牺牲项才准入
+    int candidateFreq = shard.sketch.estimate(hash);
+    size_t freed = 0;
+    for (auto it = shard.lru.rbegin(); it != shard.lru.rend() && bytes - freed + size > shard.capacity; ++it) {
+        if (*it == name) {
+            continue;
+        }
+        uint64_t victimHash = static_cast<uint64_t>(std::hash<std::string>{}(*it));
+        if (shard.sketch.estimate(victimHash) >= candidateFreq) {
+            rejected_++;
+            return false;
+        }
+        freed += shard.entries.at(*it).entry->data.size();
+        victims++;
+    }
+    return true;
+}
+
+// 填充缓存
+bool ThumbnailCache::put(const std::string& name, std::shared_ptr<const Entry> entry, uint64_t generation) {
+    if (!enabled_ || !entry) {
+        return false;
+    }
+
+    size_t size = entry->data.size();
+    uint64_t hash = 0;
+    Shard& shard = shardFor(name, hash);
+    if (size > maxEntryBytes_ || size > shard.capacity) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // 读取文件期间有缩略图被删除，放弃这次填充
+    if (generation != generation_.load()) {
+        return false;
+    }
+
+    // 替换：旧内容已过期，先移除再按新插入处理（被拒绝时不保留旧内容）
+    auto existing = shard.entries.find(name);
+    if (existing != shard.entries.end()) {
+        shard.bytes -= existing->second.entry->data.size();
+        shard.lru.erase(existing->second.position);
+        shard.entries.erase(existing);
+    }
+
+    size_t victims = 0;
+    if (!admitLocked(shard, name, hash, size, victims)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < victims; ++i) {
+        const std::string& victim = shard.lru.back();
+        auto victimIt = shard.entries.find(victim);
+        shard.bytes -= victimIt->second.entry->data.size();
+        shard.entries.erase(victimIt);
+        shard.lru.pop_back();
+        evictions_++;
+    }
+
+    shard.lru.push_front(name);
+    shard.entries[name] = Shard::Slot{std::move(entry), shard.lru.begin()};
+    shard.bytes += size;
+    admitted_++;
+    return true;
+}
+
+// 使缩略图失效
+void ThumbnailCache::invalidate(const std::string& pathOrName) {
+    std::string name = baseName(pathOrName);
+    if (name.empty()) {
+        return;
+    }
+
+    generation_++;
+    invalidations_++;
+
+    uint64_t hash = 0;
+    Shard& shard = shardFor(name, hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(name);
+    if (it == shard.entries.end()) {
+        return;
+    }
+    shard.bytes -= it->second.entry->data.size();
+    shard.lru.erase(it->second.position);
+    shard.entries.erase(it);
+}
+
+// 获取缓存统计信息
+Json::Value ThumbnailCache::getStats() const {
+    Json::Value stats;
+    size_t entries = 0;
+    size_t bytes = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        entries += shard->entries.size();
+        bytes += shard->bytes;
+    }
+
+    stats["enabled"] = enabled_;
+    stats["shards"] = static_cast<Json::UInt64>(shards_.size());
+    stats["entries"] = static_cast<Json::UInt64>(entries);
+    stats["bytes"] = static_cast<Json::UInt64>(bytes);
+    stats["max_bytes"] = static_cast<Json::UInt64>(maxBytes_);
+    stats["hits"] = static_cast<Json::UInt64>(hits_.load());
+    stats["misses"] = static_cast<Json::UInt64>(misses_.load());
+    stats["admitted"] = static_cast<Json::UInt64>(admitted_.load());
+    stats["rejected"] = static_cast<Json::UInt64>(rejected_.load());
+    stats["evictions"] = static_cast<Json::UInt64>(evictions_.load());
+    stats["invalidations"] = static_cast<Json::UInt64>(invalidations_.load());
+
+    uint64_t total = hits_.load() + misses_.load();
+    stats["hit_rate"] = total > 0 ? static_cast<double>(hits_.load()) / static_cast<double>(total) : 0.0;
+    return stats;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file thumbnail_cache.h
+ * @brief 热点缩略图内存缓存（分片LRU + TinyLFU准入）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+/**
+ * @brief 缩略图缓存（单例）
+ *
+ * 缓存 /uploads/thumbnails 下的文件内容，键为缩略图文件名（IMG_xxx_thumb.jpg）：
+ * - 按字节预算分片，每个分片独立加锁、独立LRU链表
+ * - 首次读取文件后调用 put 填充；分片空间不足需要淘汰时，
+ *   只有候选项的访问频率高于LRU尾部的牺牲项才准入（TinyLFU）；
+ *   读文件之前可用 admits 预判，不会准入的文件不必读入内存
+ * - 替换已有条目与新插入走同一准入和淘汰流程，分片字节数不会超过容量
+ * - 访问频率由每个分片的 count-min sketch 估算，计数达到采样上限后整体减半以适应热点变化
+ * - ImageService::deleteImage 删除文件后调用 invalidate；
+ *   通过代次计数防止并发读取把已删除的文件写回缓存
+ */
+class ThumbnailCache {
+public:
+    /**
+     * @brief 缓存项（不可变，读者持有快照）
+     */
+    struct Entry {
+        std::string data;           // 文件内容
+        std::time_t modifiedAt;     // 文件修改时间（用于 Last-Modified）
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return ThumbnailCache引用
+     */
+    static ThumbnailCache& getInstance();
+
+    /**
+     * @brief 缓存是否启用（thumbnail_cache.enabled）
+     */
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief 单个文件允许缓存的最大字节数
+     */
+    size_t maxEntryBytes() const { return maxEntryBytes_; }
+
+    /**
+     * @brief 当前代次（读文件之前获取，put 时传回）
+     */
+    uint64_t generation() const { return generation_.load(); }
+
+    /**
+     * @brief 查询缓存（同时记录一次访问频率）
+     * @param name 缩略图文件名
+     * @return 命中返回缓存项，否则返回nullptr
+     */
+    std::shared_ptr<const Entry> get(const std::string& name);
+
+    /**
+     * @brief 预判 put 是否会准入（不修改缓存）
+     * @param name 缩略图文件名
+     * @param size 文件字节数
+     * @return 大小在上限内且空间足够或TinyLFU准入返回true
+     */
+    bool admits(const std::string& name, size_t size);
+
+    /**
+     * @brief 填充缓存
+     * @param name 缩略图文件名
+     * @param entry 文件内容
+     * @param generation 读取文件前通过 generation() 获得的代次
+     * @return 已准入返回true；超出大小、代次已变化或TinyLFU拒绝返回false
+     */
+    bool put(const std::string& name, std::shared_ptr<const Entry> entry, uint64_t generation);
+
+    /**
+     * @brief 使缩略图失效
+     * @param pathOrName 文件名、物理路径或URL（取最后一段作为文件名）
+     */
+    void invalidate(const std::string& pathOrName);
+
+    /**
+     * @brief 获取缓存统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+private:
+    ThumbnailCache();
+    ~ThumbnailCache();
+
+    struct Shard;
+
+    /**
+     * @brief 根据文件名选择分片
+     */
+    Shard& shardFor(const std::string& name, uint64_t& hash);
+
+    /**
+     * @brief TinyLFU 准入判断（调用方需持有分片锁，不修改分片）
+     *
+     * 同名的已有条目视为已释放，不作为牺牲项
+     *
+     * @param shard 分片
+     * @param name 缩略图文件名
+     * @param hash 文件名哈希
+     * @param size 候选项字节数
+     * @param victims 输出：准入时需要从LRU尾部淘汰的条目数（不含同名条目）
+     * @return 准入返回true
+     */
+    bool admitLocked(Shard& shard, const std::string& name, uint64_t hash, size_t size, size_t& victims);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    bool enabled_;
+    size_t maxBytes_;           // 总字节预算
+    size_t maxEntryBytes_;      // 单个文件上限
+
+    std::atomic<uint64_t> generation_;  // 每次失效自增
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> admitted_;
+    std::atomic<uint64_t> rejected_;    // TinyLFU 拒绝准入
+    std::atomic<uint64_t> evictions_;
+    std::atomic<uint64_t> invalidations_;
+};
@@ -27,7 +27,7 @@ bool CommentRepository::create(MYSQL* conn, const Comment& comment) {
         // SQL 插入语句
         const char* query = "INSERT INTO comments (comment_id, post_id, user_id, content) VALUES (?, ?, ?, ?)";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -68,7 +68,7 @@ bool CommentRepository::create(MYSQL* conn, const Comment& comment) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -98,7 +98,7 @@ std::optional<Comment> CommentRepository::findByCommentId(MYSQL* conn, const std
         const char* query = "SELECT id, comment_id, post_id, user_id, content, UNIX_TIMESTAMP(create_time) "
                            "FROM comments WHERE comment_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -118,7 +118,7 @@ std::optional<Comment> CommentRepository::findByCommentId(MYSQL* conn, const std
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -163,12 +163,12 @@ std::optional<Comment> CommentRepository::findByCommentId(MYSQL* conn, const std
             return std::nullopt;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             Comment comment;
             comment.setId(id);
             comment.setCommentId(std::string(commentIdBuf, commentIdLen));
@@ -205,7 +205,7 @@ std::vector<Comment> CommentRepository::findByPostId(MYSQL* conn, int postId, in
         const char* query = "SELECT id, comment_id, post_id, user_id, content, UNIX_TIMESTAMP(create_time) "
                            "FROM comments WHERE post_id = ? ORDER BY create_time DESC LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return comments;
         }
@@ -228,7 +228,7 @@ std::vector<Comment> CommentRepository::findByPostId(MYSQL* conn, int postId, in
             return comments;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return comments;
         }
@@ -273,12 +273,12 @@ std::vector<Comment> CommentRepository::findByPostId(MYSQL* conn, int postId, in
             return comments;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return comments;
         }
 
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Comment comment;
             comment.setId(id);
             comment.setCommentId(std::string(commentIdBuf, commentIdLen));
@@ -313,7 +313,7 @@ int CommentRepository::countByPostId(MYSQL* conn, int postId) {
 
         const char* query = "SELECT COUNT(*) FROM comments WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -330,7 +330,7 @@ int CommentRepository::countByPostId(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -348,12 +348,12 @@ int CommentRepository::countByPostId(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -380,7 +380,7 @@ bool CommentRepository::deleteByCommentId(MYSQL* conn, const std::string& commen
 
         const char* query = "DELETE FROM comments WHERE comment_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -400,7 +400,7 @@ bool CommentRepository::deleteByCommentId(MYSQL* conn, const std::string& commen
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -429,7 +429,7 @@ bool CommentRepository::existsByCommentId(MYSQL* conn, const std::string& commen
 
         const char* query = "SELECT COUNT(*) FROM comments WHERE comment_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -449,7 +449,7 @@ bool CommentRepository::existsByCommentId(MYSQL* conn, const std::string& commen
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -467,12 +467,12 @@ bool CommentRepository::existsByCommentId(MYSQL* conn, const std::string& commen
             return false;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return count > 0;
         }
 
@@ -499,7 +499,7 @@ bool CommentRepository::isCommentOwner(MYSQL* conn, const std::string& commentId
 
         const char* query = "SELECT COUNT(*) FROM comments WHERE comment_id = ? AND user_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -522,7 +522,7 @@ bool CommentRepository::isCommentOwner(MYSQL* conn, const std::string& commentId
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -540,12 +540,12 @@ bool CommentRepository::isCommentOwner(MYSQL* conn, const std::string& commentId
             return false;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return count > 0;
         }
 
@@ -575,7 +575,7 @@ std::vector<Comment> CommentRepository::findByUserId(MYSQL* conn, int userId, in
         const char* query = "SELECT id, comment_id, post_id, user_id, content, UNIX_TIMESTAMP(create_time) "
                            "FROM comments WHERE user_id = ? ORDER BY create_time DESC LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return comments;
         }
@@ -598,7 +598,7 @@ std::vector<Comment> CommentRepository::findByUserId(MYSQL* conn, int userId, in
             return comments;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return comments;
         }
@@ -643,12 +643,12 @@ std::vector<Comment> CommentRepository::findByUserId(MYSQL* conn, int userId, in
             return comments;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return comments;
         }
 
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Comment comment;
             comment.setId(id);
             comment.setCommentId(std::string(commentIdBuf, commentIdLen));
@@ -6,21 +6,35 @@
  */
 
 #include "connection_guard.h"
+#include "db_operation_scope.h"
 #include "utils/logger.h"
 
 // ============================================================================
 // 构造函数：从连接池获取连接
 // ============================================================================
 
-ConnectionGuard::ConnectionGuard(DatabaseConnectionPool& pool)
-    : pool_(pool), conn_(pool.getConnection()) {
-    
+ConnectionGuard::ConnectionGuard(DatabaseConnectionPool& pool, CallSite site)
+    : pool_(pool), lent_(nullptr), scope_(nullptr) {
+
+    // 操作作用域内：借用作用域的连接，整段操作只占用一个连接
+    DbOperationScope* scope = DbOperationScope::current();
+    if (scope && &scope->pool() == &pool) {
+        lent_ = scope->borrow(site);
+        if (lent_) {
+            scope_ = scope;
+        } else {
+            Logger::warning("ConnectionGuard: Failed to acquire scoped connection in " + std::string(site.function));
+        }
+        return;
+    }
+
+    conn_ = pool.getConnection(site);
     if (conn_) {
         // 连接获取成功
         Logger::debug("ConnectionGuard: Connection acquired from pool");
     } else {
         // 连接获取失败（连接池耗尽或超时）
-        Logger::warning("ConnectionGuard: Failed to acquire connection from pool");
+        Logger::warning("ConnectionGuard: Failed to acquire connection from pool in " + std::string(site.function));
     }
 }
 
@@ -29,6 +43,10 @@ ConnectionGuard::ConnectionGuard(DatabaseConnectionPool& pool)
 // ============================================================================
 
 ConnectionGuard::~ConnectionGuard() {
+    if (scope_) {
+        // 借用的作用域连接不归还，只结束借用
+        scope_->giveBack();
+    }
     if (conn_) {
         // 归还连接到连接池
         pool_.returnConnection(std::move(conn_));
@@ -44,7 +62,8 @@ ConnectionGuard::~ConnectionGuard() {
 MYSQL* ConnectionGuard::get() const {
     // 如果连接有效，返回原始MYSQL指针
     // 如果连接无效，返回nullptr
-    return conn_ ? conn_->get() : nullptr;
+    MySQLConnection* conn = getConnection();
+    return conn ? conn->get() : nullptr;
 }
 
 // ============================================================================
@@ -53,9 +72,10 @@ MYSQL* ConnectionGuard::get() const {
 
 bool ConnectionGuard::isValid() const {
     // 检查两个条件：
-    // 1. conn_ 不为空（成功获取到连接）
-    // 2. conn_->isValid() 返回true（连接仍然有效）
-    return conn_ && conn_->isValid();
+    // 1. 持有或借用到连接
+    // 2. conn->isValid() 返回true（连接仍然有效）
+    MySQLConnection* conn = getConnection();
+    return conn && conn->isValid();
 }
 
 // ============================================================================
@@ -63,7 +83,7 @@ bool ConnectionGuard::isValid() const {
 // ============================================================================
 
 MySQLConnection* ConnectionGuard::getConnection() const {
-    // 返回智能指针持有的原始指针
-    return conn_.get();
+    // 返回借用的请求连接，或智能指针持有的原始指针
+    return lent_ ? lent_ : conn_.get();
 }
 
@@ -35,6 +35,8 @@
 #include "connection_pool.h"
 #include <memory>
 
+class DbOperationScope;
+
 /**
  * @brief 数据库连接守卫类（RAII模式）
  * 
@@ -53,19 +55,21 @@ public:
     /**
      * @brief 构造函数，从连接池获取连接
      * @param pool 数据库连接池引用
+     * @param site 借用位置，默认取构造 guard 的仓储方法（/debug/runtime 借用者列表用）
      * 
      * 说明：
-     * - 自动调用 pool.getConnection() 获取连接
+     * - 自动调用 pool.getConnection(site) 获取连接
+     * - 当前线程上有 DbOperationScope 时改为借用作用域的连接，不再占用第二个连接
      * - 如果连接池耗尽，会等待可用连接（带超时）
      * - 获取失败时，conn_ 为 nullptr
      */
-    explicit ConnectionGuard(DatabaseConnectionPool& pool);
+    explicit ConnectionGuard(DatabaseConnectionPool& pool, CallSite site = CallSite::current());
     
     /**
      * @brief 析构函数，自动归还连接到连接池
      * 
      * 说明：
-     * - 如果 conn_ 不为空，调用 pool.returnConnection()
+     * - 如果 conn_ 不为空，调用 pool.returnConnection()（借用的作用域连接只结束借用，由 DbOperationScope 归还）
      * - 无论函数如何退出（正常返回、异常、break等），都会执行
      * - 这是RAII模式的核心：资源自动释放
      */
@@ -127,5 +131,7 @@ public:
 private:
     DatabaseConnectionPool& pool_;                  // 连接池引用
     std::unique_ptr<MySQLConnection> conn_;         // 持有的连接（智能指针）
+    MySQLConnection* lent_;                         // 从 DbOperationScope 借用的连接（不归还）
+    DbOperationScope* scope_;                       // 借出 lent_ 的作用域（析构时结束借用）
 };
 
@@ -8,8 +8,35 @@
 #include "database/connection_pool.h"
 #include "utils/config_manager.h"
 #include "utils/logger.h"
+#include "utils/metrics_registry.h"
+#include "utils/tracer.h"
 #include <json/json.h>
+#include <algorithm>
 #include <stdexcept>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+long currentThreadId() {
+    static thread_local const long tid = static_cast<long>(syscall(SYS_gettid));
+    return tid;
+}
+
+// Trim the build directory prefix: /home/x/backend-service/src/database/a.cpp -> database/a.cpp
+const char* shortFile(const char* file) {
+    const char* src = std::strstr(file, "/src/");
+    return src ? src + 5 : file;
+}
+
+std::string describe(const CallSite& site) {
+    return std::string(shortFile(site.file)) + ":" + std::to_string(site.line);
+}
+
+}  // namespace
 
 // ============================================================================
 // MySQLConnection Implementation
@@ -105,6 +132,7 @@ bool DatabaseConnectionPool::initialize() {
     password_ = config.get<std::string>("database.password", "");
     poolSize_ = config.get<int>("database.pool_size", 10);
     connectionTimeout_ = config.get<int>("database.connection_timeout", 30);
+    longHoldMs_ = config.get<int>("database.long_hold_ms", 1000);
     
     Logger::info("Initializing database connection pool...");
     Logger::info("Host: " + host_ + ":" + std::to_string(port_));
@@ -134,7 +162,14 @@ bool DatabaseConnectionPool::initialize() {
     return true;
 }
 
-std::unique_ptr<MySQLConnection> DatabaseConnectionPool::getConnection() {
+std::unique_ptr<MySQLConnection> DatabaseConnectionPool::getConnection(CallSite site) {
+    static Histogram& waitTime = MetricsRegistry::getInstance().histogram(
+        "db_pool_wait_seconds", "Time spent waiting for a database connection");
+    static Counter& timeouts = MetricsRegistry::getInstance().counter(
+        "db_pool_timeouts_total", "Database connection requests that timed out");
+
+    TraceSpan span("db.pool_wait");
+    auto waitStart = std::chrono::steady_clock::now();
     std::unique_lock<std::mutex> lock(poolMutex_);
     
     if (!initialized_) {
@@ -148,7 +183,10 @@ std::unique_ptr<MySQLConnection> DatabaseConnectionPool::getConnection() {
         
         auto timeout = std::chrono::seconds(connectionTimeout_);
         if (!poolCondition_.wait_for(lock, timeout, [this] { return !connections_.empty(); })) {
-            Logger::error("Connection pool timeout");
+            waitTime.recordDuration(std::chrono::steady_clock::now() - waitStart);
+            timeouts.inc();
+            Logger::error("Connection pool timeout at " + describe(site) + " in " + site.function +
+                         " (" + std::to_string(borrowed_.size()) + " connections checked out)");
             return nullptr;
         }
     }
@@ -156,30 +194,105 @@ std::unique_ptr<MySQLConnection> DatabaseConnectionPool::getConnection() {
     // Get connection from pool
     auto conn = std::move(connections_.front());
     connections_.pop();
+    waitTime.recordDuration(std::chrono::steady_clock::now() - waitStart);
     
     // Validate connection
     if (!conn->isValid()) {
         Logger::warning("Invalid connection detected, creating new one");
         conn = createConnection();
     }
-    
+
+    if (!conn) {
+        return nullptr;
+    }
+
+    // A thread that already holds a connection and asks for another can deadlock the pool:
+    // with every connection held by an outer checkout, all inner ones wait for each other.
+    long threadId = currentThreadId();
+    const Borrow* outer = nullptr;
+    int depth = 0;
+    for (const auto& entry : borrowed_) {
+        if (entry.second.threadId == threadId) {
+            ++depth;
+            if (!outer || entry.second.since < outer->since) {
+                outer = &entry.second;
+            }
+        }
+    }
+    CallSite outerSite = outer ? outer->site : CallSite{};
+    bool firstAtSite = false;
+    if (depth > 0) {
+        ++nestedCheckouts_;
+        firstAtSite = nestedSites_.insert(describe(site)).second;
+    }
+    borrowed_[conn.get()] = Borrow{threadId, std::chrono::steady_clock::now(), site, depth};
+    lock.unlock();
+
+    // Metrics and logging outside poolMutex_: the registry invokes the pool gauges under its own lock
+    if (depth > 0) {
+        MetricsRegistry::getInstance().counter(
+            "db_pool_nested_checkouts_total", "Checkouts by a thread that already held a connection",
+            {{"site", describe(site)}}).inc();
+        std::string message = "Nested connection checkout (depth " + std::to_string(depth + 1) + ") at " +
+            describe(site) + " in " + site.function + ", outer checkout at " + describe(outerSite) +
+            " in " + outerSite.function;
+        if (firstAtSite) {
+            Logger::warning(message);
+        } else {
+            Logger::debug(message);
+        }
+    }
     return conn;
 }
 
 void DatabaseConnectionPool::returnConnection(std::unique_ptr<MySQLConnection> conn) {
+    static Histogram& holdTime = MetricsRegistry::getInstance().histogram(
+        "db_pool_hold_seconds", "Time a database connection stays checked out");
+    static Counter& longHolds = MetricsRegistry::getInstance().counter(
+        "db_pool_long_holds_total", "Checkouts held longer than database.long_hold_ms");
+
     if (!conn) {
         return;
     }
-    
-    std::lock_guard<std::mutex> lock(poolMutex_);
-    
-    // Validate connection before returning
-    if (conn->isValid()) {
-        connections_.push(std::move(conn));
-        poolCondition_.notify_one();
-    } else {
-        Logger::warning("Discarding invalid connection");
-        // Connection will be destroyed automatically
+
+    bool tracked = false;
+    Borrow borrow{};
+    std::chrono::steady_clock::duration held{};
+    bool longHold = false;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        auto it = borrowed_.find(conn.get());
+        if (it != borrowed_.end()) {
+            tracked = true;
+            borrow = it->second;
+            borrowed_.erase(it);
+            held = std::chrono::steady_clock::now() - borrow.since;
+            longHold = longHoldMs_ > 0 && held >= std::chrono::milliseconds(longHoldMs_);
+            if (longHold) {
+                ++longHolds_;
+            }
+        }
+
+        // Validate connection before returning
+        if (conn->isValid()) {
+            connections_.push(std::move(conn));
+            poolCondition_.notify_one();
+        } else {
+            Logger::warning("Discarding invalid connection");
+            // Connection will be destroyed automatically
+        }
+    }
+
+    if (!tracked) {
+        return;
+    }
+    holdTime.recordDuration(held);
+    if (longHold) {
+        longHolds.inc();
+        Logger::warning("Database connection held for " +
+                       std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(held).count()) +
+                       " ms, acquired at " + describe(borrow.site) + " in " + borrow.site.function +
+                       (borrow.depth > 0 ? " (nested, depth " + std::to_string(borrow.depth + 1) + ")" : ""));
     }
 }
 
@@ -191,10 +304,39 @@ Json::Value DatabaseConnectionPool::getStats() const {
     stats["available_connections"] = static_cast<int>(connections_.size());
     stats["active_connections"] = poolSize_ - static_cast<int>(connections_.size());
     stats["initialized"] = initialized_;
+    stats["nested_checkouts"] = static_cast<Json::UInt64>(nestedCheckouts_);
+    stats["long_holds"] = static_cast<Json::UInt64>(longHolds_);
+    stats["long_hold_ms"] = longHoldMs_;
 
     return stats;
 }
 
+Json::Value DatabaseConnectionPool::getBorrowers() const {
+    std::vector<Borrow> borrows;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        borrows.reserve(borrowed_.size());
+        for (const auto& entry : borrowed_) {
+            borrows.push_back(entry.second);
+        }
+    }
+    std::sort(borrows.begin(), borrows.end(),
+              [](const Borrow& a, const Borrow& b) { return a.since < b.since; });
+
+    auto now = std::chrono::steady_clock::now();
+    Json::Value borrowers(Json::arrayValue);
+    for (const auto& borrow : borrows) {
+        Json::Value entry;
+        entry["thread"] = static_cast<Json::Int64>(borrow.threadId);
+        entry["depth"] = borrow.depth;
+        entry["held_ms"] = std::chrono::duration<double, std::milli>(now - borrow.since).count();
+        entry["site"] = describe(borrow.site);
+        entry["function"] = borrow.site.function;
+        borrowers.append(entry);
+    }
+    return borrowers;
+}
+
 std::unique_ptr<MySQLConnection> DatabaseConnectionPool::createConnection() {
     MYSQL* mysql = mysql_init(nullptr);
     if (!mysql) {
@@ -8,13 +8,33 @@
 #pragma once
 
 #include <mysql/mysql.h>
+#include <chrono>
 #include <memory>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <json/json.h>
 
+/**
+ * @brief Source location of a pool checkout
+ *
+ * Used as a default argument (CallSite site = CallSite::current()), so the builtins
+ * expand at the caller: ConnectionGuard forwards its own caller, i.e. the repository method.
+ */
+struct CallSite {
+    const char* file = "";
+    int line = 0;
+    const char* function = "";
+
+    static constexpr CallSite current(const char* file = __builtin_FILE(), int line = __builtin_LINE(),
+                                      const char* function = __builtin_FUNCTION()) {
+        return {file, line, function};
+    }
+};
+
 /**
  * @brief RAII wrapper for MySQL connection
  */
@@ -80,9 +100,10 @@ public:
     
     /**
      * @brief Get connection from pool
+     * @param site Caller location, recorded while the connection is borrowed
      * @return Unique pointer to MySQL connection
      */
-    std::unique_ptr<MySQLConnection> getConnection();
+    std::unique_ptr<MySQLConnection> getConnection(CallSite site = CallSite::current());
     
     /**
      * @brief Return connection to pool
@@ -95,6 +116,12 @@ public:
      * @return JSON object with pool stats
      */
     Json::Value getStats() const;
+
+    /**
+     * @brief Connections currently checked out: holder thread, nesting depth, hold time and call site
+     * @return JSON array, longest hold first
+     */
+    Json::Value getBorrowers() const;
     
     // Prevent copying
     DatabaseConnectionPool(const DatabaseConnectionPool&) = delete;
@@ -117,6 +144,23 @@ private:
     int connectionTimeout_;
     
     bool initialized_;
+
+    /**
+     * @brief A checked-out connection
+     */
+    struct Borrow {
+        long threadId;                                  // OS thread id (matches the log's thread column)
+        std::chrono::steady_clock::time_point since;
+        CallSite site;
+        int depth;                                      // connections this thread already held at checkout
+    };
+    std::unordered_map<const MySQLConnection*, Borrow> borrowed_;   // guarded by poolMutex_
+
+    // Leak / long-hold detection (guarded by poolMutex_)
+    int longHoldMs_ = 1000;                             // database.long_hold_ms, 0 disables the warning
+    uint64_t nestedCheckouts_ = 0;
+    uint64_t longHolds_ = 0;
+    std::unordered_set<std::string> nestedSites_;       // inner call sites already warned about
     
     /**
      * @brief Create new MySQL connection
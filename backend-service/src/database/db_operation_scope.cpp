@@ -0,0 +1,76 @@
+/**
+ * @file db_operation_scope.cpp
+ * @brief 操作级数据库作用域实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "database/db_operation_scope.h"
+#include "utils/config_manager.h"
+
+namespace {
+
+thread_local DbOperationScope* currentScope = nullptr;
+
+bool scopeEnabled() {
+    static const bool enabled =
+        ConfigManager::getInstance().get<bool>("database.operation_scoped_connection", true);
+    return enabled;
+}
+
+}  // namespace
+
+DbOperationScope::DbOperationScope(DatabaseConnectionPool& pool)
+    : pool_(pool), previous_(currentScope), borrowers_(0), installed_(scopeEnabled()) {
+    // 外层已有同一连接池的作用域（如服务在处理器作用域内再创建）：并入外层
+    if (previous_ && &previous_->pool_ == &pool) {
+        installed_ = false;
+    }
+    if (installed_) {
+        currentScope = this;
+    }
+}
+
+DbOperationScope::~DbOperationScope() {
+    if (installed_) {
+        currentScope = previous_;
+    }
+    if (conn_) {
+        pool_.returnConnection(std::move(conn_));
+    }
+}
+
+DbOperationScope* DbOperationScope::current() {
+    return currentScope;
+}
+
+MySQLConnection* DbOperationScope::borrow(CallSite site) {
+    if (!conn_) {
+        conn_ = pool_.getConnection(site);
+    }
+    if (conn_) {
+        borrowers_++;
+    }
+    return conn_.get();
+}
+
+void DbOperationScope::giveBack() {
+    borrowers_--;
+}
+
+DbOperationScope::Suspension::Suspension() : scope_(currentScope) {
+    if (!scope_) {
+        return;
+    }
+    currentScope = scope_->previous_;
+    // 外层 guard 仍在使用连接时不能归还，只停止借给新的 guard
+    if (scope_->conn_ && scope_->borrowers_ == 0) {
+        scope_->pool_.returnConnection(std::move(scope_->conn_));
+    }
+}
+
+DbOperationScope::Suspension::~Suspension() {
+    if (scope_) {
+        currentScope = scope_;
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file db_operation_scope.h
+ * @brief 操作级数据库作用域：一次业务操作内的所有仓储调用共用同一个连接
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "connection_pool.h"
+#include <memory>
+
+/**
+ * @brief 操作级数据库作用域（RAII，HttpServer 在每个路由处理器外创建）
+ *
+ * 仓储中不接收 MYSQL* 的方法各自取连接；一个处理器连续调用多个服务或仓储方法时，
+ * 每次调用都要借还一次连接，嵌套调用时还会同时占用多个连接。
+ * 作用域存在期间，当前线程上的 ConnectionGuard 不再从连接池取连接，而是借用作用域的连接：
+ * - 第一次借用时才从连接池取连接，不访问数据库的请求不占用连接
+ * - 嵌套的 guard 拿到同一个 MYSQL*，析构时不归还
+ * - 作用域析构时归还连接
+ * - 已有同一连接池的作用域时，内层作用域并入外层，不再另取连接
+ *
+ * 图片处理等耗时步骤用 Suspension 暂停作用域：暂停时若没有 guard 正在借用，连接先归还连接池，
+ * 步骤结束后下一次借用再重新获取，连接不会在整个步骤期间被占住。
+ * 同一连接上的调用严格串行：外层语句的结果集须在调用下一个仓储方法前读完。
+ * database.operation_scoped_connection 为 false 时作用域不生效，恢复每个 guard 各取一次连接。
+ */
+class DbOperationScope {
+public:
+    /**
+     * @brief 暂停当前线程上的作用域（RAII，包住不访问数据库的耗时步骤）
+     *
+     * 暂停期间 ConnectionGuard 直接从连接池取连接；
+     * 外层仍有 guard 借用作用域连接时连接保留，只是不再借给新的 guard。
+     */
+    class Suspension {
+    public:
+        Suspension();
+        ~Suspension();
+
+        Suspension(const Suspension&) = delete;
+        Suspension& operator=(const Suspension&) = delete;
+
+    private:
+        DbOperationScope* scope_;   // 被暂停的作用域；没有时为nullptr
+    };
+
+    /**
+     * @brief 在当前线程上安装作用域（配置关闭或已有外层作用域时不安装）
+     * @param pool 借出连接的连接池
+     */
+    explicit DbOperationScope(DatabaseConnectionPool& pool);
+
+    /**
+     * @brief 卸载作用域并归还连接
+     */
+    ~DbOperationScope();
+
+    /**
+     * @brief 当前线程上生效的作用域
+     * @return 没有时返回nullptr
+     */
+    static DbOperationScope* current();
+
+    /**
+     * @brief 借用作用域的连接，首次调用时从连接池获取
+     * @param site 借用位置（记录为连接池中这次借用的调用点）
+     * @return 连接；连接池超时时返回nullptr，下次借用会重新获取
+     *
+     * 借用成功后须调用 giveBack()（ConnectionGuard 析构时调用）
+     */
+    MySQLConnection* borrow(CallSite site);
+
+    /**
+     * @brief 结束一次借用（连接仍由作用域持有）
+     */
+    void giveBack();
+
+    /**
+     * @brief 借出连接的连接池
+     */
+    DatabaseConnectionPool& pool() const { return pool_; }
+
+    DbOperationScope(const DbOperationScope&) = delete;
+    DbOperationScope& operator=(const DbOperationScope&) = delete;
+
+private:
+    DatabaseConnectionPool& pool_;
+    std::unique_ptr<MySQLConnection> conn_;     // 首次借用前、暂停归还后为空
+    DbOperationScope* previous_;                // 嵌套安装时恢复外层作用域
+    int borrowers_;                             // 正在借用连接的 guard 数
+    bool installed_;
+};
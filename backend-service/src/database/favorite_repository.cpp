@@ -11,7 +11,6 @@
 #include <cstring>
 #include <stdexcept>
 #include <sstream>
-#include <chrono>
 
 // 创建收藏记录
 bool FavoriteRepository::create(MYSQL* conn, int userId, int postId) {
@@ -29,7 +28,7 @@ bool FavoriteRepository::create(MYSQL* conn, int userId, int postId) {
         // SQL 插入语句
         const char* query = "INSERT INTO favorites (user_id, post_id) VALUES (?, ?)";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -51,7 +50,7 @@ bool FavoriteRepository::create(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             // 检查是否是唯一约束冲突（ER_DUP_ENTRY = 1062）
             unsigned int err_no = mysql_stmt_errno(stmt.get());
             if (err_no == 1062) {
@@ -89,7 +88,7 @@ bool FavoriteRepository::deleteByUserAndPost(MYSQL* conn, int userId, int postId
         // SQL 删除语句
         const char* query = "DELETE FROM favorites WHERE user_id = ? AND post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -111,7 +110,7 @@ bool FavoriteRepository::deleteByUserAndPost(MYSQL* conn, int userId, int postId
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -150,7 +149,7 @@ bool FavoriteRepository::exists(MYSQL* conn, int userId, int postId) {
         // SQL 查询语句
         const char* query = "SELECT COUNT(*) FROM favorites WHERE user_id = ? AND post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -172,7 +171,7 @@ bool FavoriteRepository::exists(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -190,12 +189,12 @@ bool FavoriteRepository::exists(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return count > 0;
         }
 
@@ -223,7 +222,7 @@ int FavoriteRepository::countByPostId(MYSQL* conn, int postId) {
         // SQL 查询语句
         const char* query = "SELECT COUNT(*) FROM favorites WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -241,7 +240,7 @@ int FavoriteRepository::countByPostId(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -259,12 +258,12 @@ int FavoriteRepository::countByPostId(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -295,7 +294,7 @@ std::vector<Favorite> FavoriteRepository::findByUserId(MYSQL* conn, int userId,
         const char* query = "SELECT id, user_id, post_id, UNIX_TIMESTAMP(create_time) as create_time "
                            "FROM favorites WHERE user_id = ? ORDER BY create_time DESC LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return favorites;
         }
@@ -321,7 +320,7 @@ std::vector<Favorite> FavoriteRepository::findByUserId(MYSQL* conn, int userId,
             return favorites;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return favorites;
         }
@@ -349,13 +348,13 @@ std::vector<Favorite> FavoriteRepository::findByUserId(MYSQL* conn, int userId,
             return favorites;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return favorites;
         }
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Favorite favorite;
             favorite.setId(static_cast<int>(id));
             favorite.setUserId(static_cast<int>(user_id));
@@ -403,7 +402,7 @@ std::vector<Post> FavoriteRepository::getUserFavorites(MYSQL* conn, int userId,
             LIMIT ? OFFSET ?
         )";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -426,7 +425,7 @@ std::vector<Post> FavoriteRepository::getUserFavorites(MYSQL* conn, int userId,
             return posts;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -487,13 +486,13 @@ std::vector<Post> FavoriteRepository::getUserFavorites(MYSQL* conn, int userId,
             return posts;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Post post;
             post.setId(static_cast<int>(id));
             post.setPostId(std::string(post_id, post_id_len));
@@ -533,7 +532,7 @@ int FavoriteRepository::getUserFavoriteCount(MYSQL* conn, int userId) {
 
         const char* query = "SELECT COUNT(*) FROM favorites WHERE user_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -550,7 +549,7 @@ int FavoriteRepository::getUserFavoriteCount(MYSQL* conn, int userId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -568,12 +567,12 @@ int FavoriteRepository::getUserFavoriteCount(MYSQL* conn, int userId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -641,7 +640,7 @@ std::unordered_map<int, bool> FavoriteRepository::batchExistsForPosts(
             return result;
         }
         
-        if (mysql_stmt_prepare(stmt.get(), sql.c_str(), sql.length()) != 0) {
+        if (stmt.prepare(sql.c_str(), sql.length()) != 0) {
             Logger::error("batchExistsForPosts: 预编译失败: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -674,9 +673,7 @@ std::unordered_map<int, bool> FavoriteRepository::batchExistsForPosts(
         // ========================================
         // 第5步：执行查询
         // ========================================
-        auto startTime = std::chrono::steady_clock::now();
-        
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("batchExistsForPosts: 执行查询失败: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -700,19 +697,14 @@ std::unordered_map<int, bool> FavoriteRepository::batchExistsForPosts(
         // 第7步：读取结果集
         // ========================================
         int favoritedCount = 0;
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             result[favoritedPostId] = true;  // 标记为已收藏
             favoritedCount++;
         }
         
-        auto endTime = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            endTime - startTime
-        ).count();
-        
-        Logger::info("batchExistsForPosts: 批量查询完成，" + std::to_string(favoritedCount) + "/" + 
-                    std::to_string(postIds.size()) + " 个帖子已收藏，耗时: " + 
-                    std::to_string(duration) + "ms");
+        // 查询耗时由 MySQLStatement 统计
+        Logger::debug("batchExistsForPosts: 批量查询完成，" + std::to_string(favoritedCount) + "/" + 
+                     std::to_string(postIds.size()) + " 个帖子已收藏");
         
         return result;
         
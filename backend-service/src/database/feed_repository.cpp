@@ -0,0 +1,345 @@
+/**
+ * @file feed_repository.cpp
+ * @brief 关注时间线收件箱数据访问层实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "database/feed_repository.h"
+#include "database/mysql_statement.h"
+#include "utils/logger.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// 构建IN子句占位符："?,?,?"
+std::string buildPlaceholders(size_t count) {
+    std::string placeholders;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) placeholders += ",";
+        placeholders += "?";
+    }
+    return placeholders;
+}
+
+// 准备语句并绑定 LONGLONG 参数（params 必须在执行结束前保持有效）
+bool prepareWithParams(MySQLStatement& stmt, const std::string& query, std::vector<int64_t>& params) {
+    if (stmt.prepare(query.c_str(), query.length()) != 0) {
+        Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
+        return false;
+    }
+
+    std::vector<MYSQL_BIND> bind(params.size());
+    if (!bind.empty()) {
+        memset(bind.data(), 0, sizeof(MYSQL_BIND) * bind.size());
+        for (size_t i = 0; i < params.size(); ++i) {
+            bind[i].buffer_type = MYSQL_TYPE_LONGLONG;
+            bind[i].buffer = &params[i];
+        }
+
+        if (mysql_stmt_bind_param(stmt.get(), bind.data()) != 0) {
+            Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
+            return false;
+        }
+    }
+
+    if (stmt.execute() != 0) {
+        Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace
+
+// 写扩散：推送帖子到所有粉丝的收件箱
+int FeedRepository::fanOutPost(MYSQL* conn, int64_t postId) {
+    const std::string query =
+        "INSERT IGNORE INTO feed_inbox (user_id, post_id, author_id, create_time) "
+        "SELECT f.follower_id, p.id, p.user_id, p.create_time "
+        "FROM posts p "
+        "JOIN follows f ON f.followee_id = p.user_id "
+        "WHERE p.id = ? AND p.status = 'APPROVED'";
+
+    int affected = executeUpdate(conn, query, {postId});
+    if (affected >= 0) {
+        Logger::debug("Fan-out post " + std::to_string(postId) + " to " +
+                     std::to_string(affected) + " inboxes");
+    }
+    return affected;
+}
+
+// 关注时回填作者最近的帖子
+int FeedRepository::backfillFromAuthor(MYSQL* conn, int64_t userId, int64_t authorId, int limit) {
+    const std::string query =
+        "INSERT IGNORE INTO feed_inbox (user_id, post_id, author_id, create_time) "
+        "SELECT ?, p.id, p.user_id, p.create_time "
+        "FROM posts p "
+        "WHERE p.user_id = ? AND p.status = 'APPROVED' "
+        "ORDER BY p.create_time DESC "
+        "LIMIT ?";
+
+    return executeUpdate(conn, query, {userId, authorId, static_cast<int64_t>(limit)});
+}
+
+// 取消关注时清理作者的帖子
+bool FeedRepository::removeAuthor(MYSQL* conn, int64_t userId, int64_t authorId) {
+    const std::string query = "DELETE FROM feed_inbox WHERE user_id = ? AND author_id = ?";
+    return executeUpdate(conn, query, {userId, authorId}) >= 0;
+}
+
+// 按时间倒序读取收件箱
+std::vector<FeedEntry> FeedRepository::findInbox(MYSQL* conn, int64_t userId, int limit, int offset) {
+    const std::string query =
+        "SELECT post_id, author_id, UNIX_TIMESTAMP(create_time) "
+        "FROM feed_inbox "
+        "WHERE user_id = ? "
+        "ORDER BY create_time DESC, post_id DESC "
+        "LIMIT ? OFFSET ?";
+
+    return queryEntries(conn, query, {userId, static_cast<int64_t>(limit), static_cast<int64_t>(offset)});
+}
+
+// 裁剪收件箱
+int FeedRepository::trimInbox(MYSQL* conn, int64_t userId, int keep) {
+    if (keep < 0) {
+        return 0;
+    }
+
+    // 第 keep+1 新的条目即第一条超额条目；idx_user_time 上最多走 keep+1 个索引项
+    const std::string boundaryQuery =
+        "SELECT post_id, author_id, UNIX_TIMESTAMP(create_time) "
+        "FROM feed_inbox "
+        "WHERE user_id = ? "
+        "ORDER BY create_time DESC, post_id DESC "
+        "LIMIT 1 OFFSET ?";
+
+    std::vector<FeedEntry> boundary = queryEntries(conn, boundaryQuery, {userId, static_cast<int64_t>(keep)});
+    if (boundary.empty()) {
+        return 0;
+    }
+
+    // 删除边界及更旧的条目（与读取相同的 (create_time, post_id) 排序）
+    const std::string deleteQuery =
+        "DELETE FROM feed_inbox "
+        "WHERE user_id = ? AND (create_time < FROM_UNIXTIME(?) "
+        "  OR (create_time = FROM_UNIXTIME(?) AND post_id <= ?))";
+
+    int64_t boundaryTime = static_cast<int64_t>(boundary[0].createTime);
+    int affected = executeUpdate(conn, deleteQuery, {userId, boundaryTime, boundaryTime, boundary[0].postId});
+    if (affected > 0) {
+        Logger::debug("Trimmed " + std::to_string(affected) + " entries from inbox of user " +
+                     std::to_string(userId));
+    }
+    return affected;
+}
+
+// 查询作者的粉丝ID列表
+std::vector<int64_t> FeedRepository::findFollowerIds(MYSQL* conn, int64_t authorId) {
+    const std::string query = "SELECT follower_id FROM follows WHERE followee_id = ?";
+    return queryIds(conn, query, {authorId});
+}
+
+// 查询用户粉丝数
+int FeedRepository::getFollowerCount(MYSQL* conn, int64_t userId) {
+    const std::string query = "SELECT follower_count FROM users WHERE id = ?";
+    return queryCount(conn, query, {userId});
+}
+
+// 记录跳过写扩散的作者
+bool FeedRepository::markPullAuthor(MYSQL* conn, int64_t authorId) {
+    const std::string query =
+        "INSERT INTO feed_pull_authors (author_id) VALUES (?) "
+        "ON DUPLICATE KEY UPDATE update_time = CURRENT_TIMESTAMP";
+
+    return executeUpdate(conn, query, {authorId}) >= 0;
+}
+
+// 查询用户关注的读扩散作者
+std::vector<int64_t> FeedRepository::findPullAuthorIds(MYSQL* conn, int64_t userId) {
+    const std::string query =
+        "SELECT f.followee_id "
+        "FROM follows f "
+        "JOIN feed_pull_authors a ON a.author_id = f.followee_id "
+        "WHERE f.follower_id = ?";
+
+    return queryIds(conn, query, {userId});
+}
+
+// 读扩散：查询一组作者最近的帖子
+std::vector<FeedEntry> FeedRepository::findRecentByAuthors(MYSQL* conn, const std::vector<int64_t>& authorIds, int limit) {
+    if (authorIds.empty() || limit <= 0) {
+        return {};
+    }
+
+    std::string query =
+        "SELECT id, user_id, UNIX_TIMESTAMP(create_time) "
+        "FROM posts "
+        "WHERE user_id IN (" + buildPlaceholders(authorIds.size()) + ") AND status = 'APPROVED' "
+        "ORDER BY create_time DESC, id DESC "
+        "LIMIT ?";
+
+    std::vector<int64_t> params = authorIds;
+    params.push_back(limit);
+    return queryEntries(conn, query, std::move(params));
+}
+
+// 执行单值查询
+int FeedRepository::queryCount(MYSQL* conn, const std::string& query, std::vector<int64_t> params) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return -1;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return -1;
+        }
+
+        if (!prepareWithParams(stmt, query, params)) {
+            return -1;
+        }
+
+        int64_t value = 0;
+        MYSQL_BIND result_bind[1];
+        memset(result_bind, 0, sizeof(result_bind));
+
+        result_bind[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        result_bind[0].buffer = &value;
+
+        if (mysql_stmt_bind_result(stmt.get(), result_bind) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return -1;
+        }
+
+        if (stmt.fetch() == 0) {
+            return static_cast<int>(value);
+        }
+
+        return -1;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedRepository::queryCount: " + std::string(e.what()));
+        return -1;
+    }
+}
+
+// 执行返回单列ID的查询
+std::vector<int64_t> FeedRepository::queryIds(MYSQL* conn, const std::string& query, std::vector<int64_t> params) {
+    std::vector<int64_t> ids;
+
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return ids;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return ids;
+        }
+
+        if (!prepareWithParams(stmt, query, params)) {
+            return ids;
+        }
+
+        int64_t id = 0;
+        MYSQL_BIND result_bind[1];
+        memset(result_bind, 0, sizeof(result_bind));
+
+        result_bind[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        result_bind[0].buffer = &id;
+
+        if (mysql_stmt_bind_result(stmt.get(), result_bind) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return ids;
+        }
+
+        while (stmt.fetch() == 0) {
+            ids.push_back(id);
+        }
+
+        return ids;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedRepository::queryIds: " + std::string(e.what()));
+        return ids;
+    }
+}
+
+// 执行返回时间线条目的查询
+std::vector<FeedEntry> FeedRepository::queryEntries(MYSQL* conn, const std::string& query, std::vector<int64_t> params) {
+    std::vector<FeedEntry> entries;
+
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return entries;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return entries;
+        }
+
+        if (!prepareWithParams(stmt, query, params)) {
+            return entries;
+        }
+
+        int64_t postId = 0, authorId = 0, createTime = 0;
+        MYSQL_BIND result_bind[3];
+        memset(result_bind, 0, sizeof(result_bind));
+
+        result_bind[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        result_bind[0].buffer = &postId;
+
+        result_bind[1].buffer_type = MYSQL_TYPE_LONGLONG;
+        result_bind[1].buffer = &authorId;
+
+        result_bind[2].buffer_type = MYSQL_TYPE_LONGLONG;
+        result_bind[2].buffer = &createTime;
+
+        if (mysql_stmt_bind_result(stmt.get(), result_bind) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return entries;
+        }
+
+        while (stmt.fetch() == 0) {
+            entries.push_back({postId, authorId, static_cast<std::time_t>(createTime)});
+        }
+
+        return entries;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedRepository::queryEntries: " + std::string(e.what()));
+        return entries;
+    }
+}
+
+// 执行写语句
+int FeedRepository::executeUpdate(MYSQL* conn, const std::string& query, std::vector<int64_t> params) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return -1;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return -1;
+        }
+
+        if (!prepareWithParams(stmt, query, params)) {
+            return -1;
+        }
+
+        return static_cast<int>(mysql_stmt_affected_rows(stmt.get()));
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in FeedRepository::executeUpdate: " + std::string(e.what()));
+        return -1;
+    }
+}
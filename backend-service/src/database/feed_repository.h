@@ -0,0 +1,176 @@
+/**
+ * @file feed_repository.h
+ * @brief 关注时间线收件箱数据访问层定义
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <mysql/mysql.h>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 时间线条目（帖子ID + 作者ID + 发布时间）
+ */
+struct FeedEntry {
+    int64_t postId;             // 帖子物理ID
+    int64_t authorId;           // 作者物理ID
+    std::time_t createTime;     // 帖子发布时间
+};
+
+/**
+ * @brief 关注时间线收件箱数据访问类
+ *
+ * 负责 feed_inbox 表的读写，以及读扩散时直接从 posts 表拉取大V帖子；
+ * 跳过写扩散的作者记录在 feed_pull_authors 表中，读取端按该表拉取
+ */
+class FeedRepository {
+public:
+    /**
+     * @brief 构造函数
+     */
+    FeedRepository() = default;
+
+    /**
+     * @brief 析构函数
+     */
+    ~FeedRepository() = default;
+
+    /**
+     * @brief 把帖子推送到作者所有粉丝的收件箱（写扩散）
+     *
+     * 单条 INSERT IGNORE ... SELECT FROM follows 完成，只推送已审核通过的帖子
+     *
+     * @param conn MySQL连接
+     * @param postId 帖子物理ID
+     * @return 写入的收件箱条数，失败返回-1
+     */
+    int fanOutPost(MYSQL* conn, int64_t postId);
+
+    /**
+     * @brief 回填某个作者最近的帖子到用户收件箱（关注时调用）
+     * @param conn MySQL连接
+     * @param userId 收件箱所属用户ID（物理ID）
+     * @param authorId 作者ID（物理ID）
+     * @param limit 最多回填条数
+     * @return 写入条数，失败返回-1
+     */
+    int backfillFromAuthor(MYSQL* conn, int64_t userId, int64_t authorId, int limit);
+
+    /**
+     * @brief 从用户收件箱中删除某个作者的所有帖子（取消关注时调用）
+     * @param conn MySQL连接
+     * @param userId 收件箱所属用户ID（物理ID）
+     * @param authorId 作者ID（物理ID）
+     * @return 成功返回true，失败返回false
+     */
+    bool removeAuthor(MYSQL* conn, int64_t userId, int64_t authorId);
+
+    /**
+     * @brief 按时间倒序读取收件箱
+     * @param conn MySQL连接
+     * @param userId 用户ID（物理ID）
+     * @param limit 每页数量
+     * @param offset 偏移量
+     * @return 时间线条目列表
+     */
+    std::vector<FeedEntry> findInbox(MYSQL* conn, int64_t userId, int limit, int offset);
+
+    /**
+     * @brief 裁剪收件箱，只保留最新的 keep 条
+     *
+     * 先沿 idx_user_time 取第 keep+1 新的条目作为边界，不存在说明没有超额，直接返回；
+     * 存在时只删除边界及更旧的条目，不对整个收件箱排序编号
+     *
+     * @param conn MySQL连接
+     * @param userId 用户ID（物理ID）
+     * @param keep 保留条数
+     * @return 删除的条数，失败返回-1
+     */
+    int trimInbox(MYSQL* conn, int64_t userId, int keep);
+
+    /**
+     * @brief 查询作者的粉丝ID列表（写扩散后逐个裁剪收件箱）
+     * @param conn MySQL连接
+     * @param authorId 作者ID（物理ID）
+     * @return 粉丝ID列表
+     */
+    std::vector<int64_t> findFollowerIds(MYSQL* conn, int64_t authorId);
+
+    /**
+     * @brief 查询用户粉丝数（读取 users.follower_count 冗余字段）
+     * @param conn MySQL连接
+     * @param userId 用户ID（物理ID）
+     * @return 粉丝数，失败返回-1
+     */
+    int getFollowerCount(MYSQL* conn, int64_t userId);
+
+    /**
+     * @brief 记录作者有未推送的帖子（发帖时因粉丝数超过阈值跳过写扩散）
+     * @param conn MySQL连接
+     * @param authorId 作者ID（物理ID）
+     * @return 成功返回true，失败返回false
+     */
+    bool markPullAuthor(MYSQL* conn, int64_t authorId);
+
+    /**
+     * @brief 查询用户关注的读扩散作者（feed_pull_authors 中有记录的作者）
+     *
+     * 不按作者当前粉丝数判断：粉丝数回落到阈值以下后，之前未推送的帖子仍从这里拉取
+     *
+     * @param conn MySQL连接
+     * @param userId 用户ID（物理ID）
+     * @return 作者ID列表
+     */
+    std::vector<int64_t> findPullAuthorIds(MYSQL* conn, int64_t userId);
+
+    /**
+     * @brief 按时间倒序查询一组作者最近的帖子（读扩散）
+     * @param conn MySQL连接
+     * @param authorIds 作者ID列表
+     * @param limit 最多返回条数
+     * @return 时间线条目列表
+     */
+    std::vector<FeedEntry> findRecentByAuthors(MYSQL* conn, const std::vector<int64_t>& authorIds, int limit);
+
+private:
+    /**
+     * @brief 执行带 LONGLONG 参数的单值 COUNT 查询
+     * @param conn MySQL连接
+     * @param query SQL语句
+     * @param params 参数列表
+     * @return 查询结果，失败返回-1
+     */
+    int queryCount(MYSQL* conn, const std::string& query, std::vector<int64_t> params);
+
+    /**
+     * @brief 执行返回单列 BIGINT ID 的查询
+     * @param conn MySQL连接
+     * @param query SQL语句
+     * @param params LONGLONG参数列表
+     * @return ID列表
+     */
+    std::vector<int64_t> queryIds(MYSQL* conn, const std::string& query, std::vector<int64_t> params);
+
+    /**
+     * @brief 执行返回 (post_id, user_id, create_time) 的查询
+     * @param conn MySQL连接
+     * @param query SQL语句
+     * @param params LONGLONG参数列表
+     * @return 时间线条目列表
+     */
+    std::vector<FeedEntry> queryEntries(MYSQL* conn, const std::string& query, std::vector<int64_t> params);
+
+    /**
+     * @brief 执行带 LONGLONG 参数的写语句
+     * @param conn MySQL连接
+     * @param query SQL语句
+     * @param params 参数列表
+     * @return 受影响行数，失败返回-1
+     */
+    int executeUpdate(MYSQL* conn, const std::string& query, std::vector<int64_t> params);
+};
@@ -28,7 +28,7 @@ bool FollowRepository::create(MYSQL* conn, int64_t followerId, int64_t followeeI
         // SQL 插入语句
         const char* query = "INSERT INTO follows (follower_id, followee_id) VALUES (?, ?)";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -50,7 +50,7 @@ bool FollowRepository::create(MYSQL* conn, int64_t followerId, int64_t followeeI
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             // 检查是否是唯一约束冲突（ER_DUP_ENTRY = 1062）
             unsigned int err_no = mysql_stmt_errno(stmt.get());
             if (err_no == 1062) {
@@ -88,7 +88,7 @@ bool FollowRepository::deleteByFollowerAndFollowee(MYSQL* conn, int64_t follower
         // SQL 删除语句
         const char* query = "DELETE FROM follows WHERE follower_id = ? AND followee_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -110,7 +110,7 @@ bool FollowRepository::deleteByFollowerAndFollowee(MYSQL* conn, int64_t follower
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -149,7 +149,7 @@ bool FollowRepository::exists(MYSQL* conn, int64_t followerId, int64_t followeeI
         // SQL 查询语句
         const char* query = "SELECT 1 FROM follows WHERE follower_id = ? AND followee_id = ? LIMIT 1";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -171,7 +171,7 @@ bool FollowRepository::exists(MYSQL* conn, int64_t followerId, int64_t followeeI
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -190,7 +190,7 @@ bool FollowRepository::exists(MYSQL* conn, int64_t followerId, int64_t followeeI
         }
 
         // 获取结果
-        int fetch_result = mysql_stmt_fetch(stmt.get());
+        int fetch_result = stmt.fetch();
         return (fetch_result == 0);  // 0表示成功获取一行数据
 
     } catch (const std::exception& e) {
@@ -215,7 +215,7 @@ int FollowRepository::countFollowing(MYSQL* conn, int64_t userId) {
         // SQL 统计语句
         const char* query = "SELECT COUNT(*) FROM follows WHERE follower_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -232,7 +232,7 @@ int FollowRepository::countFollowing(MYSQL* conn, int64_t userId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -251,7 +251,7 @@ int FollowRepository::countFollowing(MYSQL* conn, int64_t userId) {
         }
 
         // 获取结果
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -279,7 +279,7 @@ int FollowRepository::countFollowers(MYSQL* conn, int64_t userId) {
         // SQL 统计语句
         const char* query = "SELECT COUNT(*) FROM follows WHERE followee_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -296,7 +296,7 @@ int FollowRepository::countFollowers(MYSQL* conn, int64_t userId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -315,7 +315,7 @@ int FollowRepository::countFollowers(MYSQL* conn, int64_t userId) {
         }
 
         // 获取结果
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -328,18 +328,18 @@ int FollowRepository::countFollowers(MYSQL* conn, int64_t userId) {
 }
 
 // 查询用户关注的人列表（我关注的人）
-std::vector<Follow> FollowRepository::findFollowingByUserId(MYSQL* conn, int64_t userId, int limit, int offset) {
+std::optional<std::vector<Follow>> FollowRepository::findFollowingByUserId(MYSQL* conn, int64_t userId, int limit, int offset) {
     std::vector<Follow> follows;
     
     try {
         if (!conn) {
             Logger::error("Database connection is null");
-            return follows;
+            return std::nullopt;
         }
 
         MySQLStatement stmt(conn);
         if (!stmt.isValid()) {
-            return follows;
+            return std::nullopt;
         }
 
         // SQL 查询语句
@@ -350,9 +350,9 @@ std::vector<Follow> FollowRepository::findFollowingByUserId(MYSQL* conn, int64_t
             "ORDER BY create_time DESC "
             "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
         // 绑定参数
@@ -373,12 +373,12 @@ std::vector<Follow> FollowRepository::findFollowingByUserId(MYSQL* conn, int64_t
 
         if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
             Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
         // 绑定结果
@@ -400,11 +400,11 @@ std::vector<Follow> FollowRepository::findFollowingByUserId(MYSQL* conn, int64_t
 
         if (mysql_stmt_bind_result(stmt.get(), result_bind) != 0) {
             Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Follow follow(id, follower_id, followee_id);
             follow.setCreateTime(static_cast<std::time_t>(create_time));
             follows.push_back(follow);
@@ -415,23 +415,23 @@ std::vector<Follow> FollowRepository::findFollowingByUserId(MYSQL* conn, int64_t
 
     } catch (const std::exception& e) {
         Logger::error("Exception in FollowRepository::findFollowingByUserId: " + std::string(e.what()));
-        return follows;
+        return std::nullopt;
     }
 }
 
 // 查询用户的粉丝列表（关注我的人）
-std::vector<Follow> FollowRepository::findFollowersByUserId(MYSQL* conn, int64_t userId, int limit, int offset) {
+std::optional<std::vector<Follow>> FollowRepository::findFollowersByUserId(MYSQL* conn, int64_t userId, int limit, int offset) {
     std::vector<Follow> follows;
     
     try {
         if (!conn) {
             Logger::error("Database connection is null");
-            return follows;
+            return std::nullopt;
         }
 
         MySQLStatement stmt(conn);
         if (!stmt.isValid()) {
-            return follows;
+            return std::nullopt;
         }
 
         // SQL 查询语句
@@ -442,9 +442,9 @@ std::vector<Follow> FollowRepository::findFollowersByUserId(MYSQL* conn, int64_t
             "ORDER BY create_time DESC "
             "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
         // 绑定参数
@@ -465,12 +465,12 @@ std::vector<Follow> FollowRepository::findFollowersByUserId(MYSQL* conn, int64_t
 
         if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
             Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
         // 绑定结果
@@ -492,11 +492,11 @@ std::vector<Follow> FollowRepository::findFollowersByUserId(MYSQL* conn, int64_t
 
         if (mysql_stmt_bind_result(stmt.get(), result_bind) != 0) {
             Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
-            return follows;
+            return std::nullopt;
         }
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Follow follow(id, follower_id, followee_id);
             follow.setCreateTime(static_cast<std::time_t>(create_time));
             follows.push_back(follow);
@@ -507,7 +507,7 @@ std::vector<Follow> FollowRepository::findFollowersByUserId(MYSQL* conn, int64_t
 
     } catch (const std::exception& e) {
         Logger::error("Exception in FollowRepository::findFollowersByUserId: " + std::string(e.what()));
-        return follows;
+        return std::nullopt;
     }
 }
 
@@ -545,7 +545,7 @@ std::map<int64_t, bool> FollowRepository::batchCheckExists(MYSQL* conn, int64_t
             return result;
         }
 
-        if (mysql_stmt_prepare(stmt.get(), query.c_str(), query.length()) != 0) {
+        if (stmt.prepare(query.c_str(), query.length()) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -570,7 +570,7 @@ std::map<int64_t, bool> FollowRepository::batchCheckExists(MYSQL* conn, int64_t
             return result;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -589,7 +589,7 @@ std::map<int64_t, bool> FollowRepository::batchCheckExists(MYSQL* conn, int64_t
         }
 
         // 获取所有结果，将已关注的用户标记为true
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             result[followee_id] = true;
         }
 
@@ -640,7 +640,7 @@ std::vector<int64_t> FollowRepository::findMutualFollowIds(MYSQL* conn, int64_t
             "ORDER BY MAX(f1.create_time) DESC "
             "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return mutualFollowIds;
         }
@@ -666,7 +666,7 @@ std::vector<int64_t> FollowRepository::findMutualFollowIds(MYSQL* conn, int64_t
             return mutualFollowIds;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return mutualFollowIds;
         }
@@ -685,7 +685,7 @@ std::vector<int64_t> FollowRepository::findMutualFollowIds(MYSQL* conn, int64_t
         }
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             mutualFollowIds.push_back(mutual_user_id);
         }
 
@@ -721,7 +721,7 @@ int FollowRepository::countMutualFollows(MYSQL* conn, int64_t userId) {
             "  AND f1.follower_id = f2.followee_id "
             "WHERE f1.follower_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -738,7 +738,7 @@ int FollowRepository::countMutualFollows(MYSQL* conn, int64_t userId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -756,7 +756,7 @@ int FollowRepository::countMutualFollows(MYSQL* conn, int64_t userId) {
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             Logger::debug("Counted " + std::to_string(count) +
                          " mutual follows for user_id=" + std::to_string(userId));
             return static_cast<int>(count);
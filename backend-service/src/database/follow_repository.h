@@ -80,9 +80,9 @@ public:
      * @param userId 用户ID（物理ID）
      * @param limit 每页数量
      * @param offset 偏移量
-     * @return 关注列表（包含用户基本信息）
+     * @return 关注列表（包含用户基本信息）；查询失败返回std::nullopt（与"没有关注"区分）
      */
-    std::vector<Follow> findFollowingByUserId(MYSQL* conn, int64_t userId, int limit, int offset);
+    std::optional<std::vector<Follow>> findFollowingByUserId(MYSQL* conn, int64_t userId, int limit, int offset);
 
     /**
      * @brief 查询用户的粉丝列表（关注我的人）
@@ -90,9 +90,9 @@ public:
      * @param userId 用户ID（物理ID）
      * @param limit 每页数量
      * @param offset 偏移量
-     * @return 粉丝列表（包含用户基本信息）
+     * @return 粉丝列表（包含用户基本信息）；查询失败返回std::nullopt（与"没有粉丝"区分）
      */
-    std::vector<Follow> findFollowersByUserId(MYSQL* conn, int64_t userId, int limit, int offset);
+    std::optional<std::vector<Follow>> findFollowersByUserId(MYSQL* conn, int64_t userId, int limit, int offset);
 
     /**
      * @brief 批量检查关注关系
@@ -38,7 +38,7 @@ bool ImageRepository::createImage(const Image& image) {
         // SQL 插入语句（新字段：post_id, display_order；移除：title, description, status）
         const char* query = "INSERT INTO images (image_id, post_id, display_order, user_id, file_url, thumbnail_url, file_size, width, height, mime_type) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
         
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -102,7 +102,7 @@ bool ImageRepository::createImage(const Image& image) {
             return false;
         }
         
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -117,8 +117,8 @@ bool ImageRepository::createImage(const Image& image) {
 }
 
 // 从预编译语句构建 Image 对象（新字段结构）
-Image ImageRepository::buildImageFromStatement(void* stmtPtr) {
-    MYSQL_STMT* stmt = static_cast<MYSQL_STMT*>(stmtPtr);
+Image ImageRepository::buildImageFromStatement(MySQLStatement& statement) {
+    MYSQL_STMT* stmt = statement.get();
     Image image;
     
     // 准备结果绑定（13个字段：id, image_id, post_id, display_order, user_id, file_url, thumbnail_url, file_size, width, height, mime_type, create_time, update_time）
@@ -223,7 +223,7 @@ Image ImageRepository::buildImageFromStatement(void* stmtPtr) {
     }
     
     // 获取数据
-    if (mysql_stmt_fetch(stmt) == 0) {
+    if (statement.fetch() == 0) {
         image.setId(static_cast<int>(id));
         image.setImageId(std::string(imageId, imageId_length));
         image.setPostId(postId);
@@ -281,7 +281,7 @@ std::optional<Image> ImageRepository::findByImageId(const std::string& imageId)
                             "LEFT JOIN users u ON i.user_id = u.id "
                             "WHERE i.image_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -299,12 +299,12 @@ std::optional<Image> ImageRepository::findByImageId(const std::string& imageId)
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
-        Image image = buildImageFromStatement(stmt.get());
+        Image image = buildImageFromStatement(stmt);
 
         // 获取user_logical_id字段
         MYSQL_BIND logicalIdBind[1];
@@ -354,7 +354,7 @@ bool ImageRepository::updateImage(const Image& image) {
 
         const char* query = "UPDATE images SET display_order = ? WHERE image_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -378,7 +378,7 @@ bool ImageRepository::updateImage(const Image& image) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -408,7 +408,7 @@ bool ImageRepository::deleteImage(const std::string& imageId) {
 
         const char* query = "DELETE FROM images WHERE image_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -426,7 +426,7 @@ bool ImageRepository::deleteImage(const std::string& imageId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -465,7 +465,7 @@ std::vector<Image> ImageRepository::findByPostId(int postId) {
                             "WHERE i.post_id = ? "
                             "ORDER BY i.display_order";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return images;
         }
@@ -482,7 +482,7 @@ std::vector<Image> ImageRepository::findByPostId(int postId) {
             return images;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return images;
         }
@@ -599,10 +599,10 @@ std::vector<Image> ImageRepository::findByPostId(int postId) {
         }
 
         // 稳定结果集
-        mysql_stmt_store_result(stmt.get());
+        stmt.storeResult();
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Image image;
             image.setId(static_cast<int>(id));
             image.setImageId(std::string(imageId, imageId_length));
@@ -688,7 +688,7 @@ std::vector<Image> ImageRepository::findByPostIds(const std::vector<int>& postId
             return images;
         }
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return images;
         }
@@ -710,7 +710,7 @@ std::vector<Image> ImageRepository::findByPostIds(const std::vector<int>& postId
             return images;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return images;
         }
@@ -827,10 +827,10 @@ std::vector<Image> ImageRepository::findByPostIds(const std::vector<int>& postId
         }
 
         // 稳定结果集
-        mysql_stmt_store_result(stmt.get());
+        stmt.storeResult();
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Image image;
             image.setId(static_cast<int>(id));
             image.setImageId(std::string(imageId, imageId_length));
@@ -894,7 +894,7 @@ bool ImageRepository::deleteByPostId(int postId) {
 
         const char* query = "DELETE FROM images WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -911,7 +911,7 @@ bool ImageRepository::deleteByPostId(int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -941,7 +941,7 @@ int ImageRepository::getImageCountByPostId(int postId) {
 
         const char* query = "SELECT COUNT(*) FROM images WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -958,7 +958,7 @@ int ImageRepository::getImageCountByPostId(int postId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -976,7 +976,7 @@ int ImageRepository::getImageCountByPostId(int postId) {
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
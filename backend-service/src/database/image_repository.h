@@ -12,6 +12,8 @@
 #include <vector>
 #include <string>
 
+class MySQLStatement;
+
 /**
  * @brief 图片数据访问类
  * 
@@ -88,9 +90,9 @@ public:
 private:
     /**
      * @brief 从预编译语句构建Image对象
-     * @param stmtPtr MYSQL_STMT指针
+     * @param statement 预编译语句
      * @return Image对象
      */
-    Image buildImageFromStatement(void* stmtPtr);
+    Image buildImageFromStatement(MySQLStatement& statement);
 };
 
@@ -11,7 +11,6 @@
 #include <cstring>
 #include <stdexcept>
 #include <sstream>
-#include <chrono>
 
 // 创建点赞记录
 bool LikeRepository::create(MYSQL* conn, int userId, int postId) {
@@ -29,7 +28,7 @@ bool LikeRepository::create(MYSQL* conn, int userId, int postId) {
         // SQL 插入语句
         const char* query = "INSERT INTO likes (user_id, post_id) VALUES (?, ?)";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -51,7 +50,7 @@ bool LikeRepository::create(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             // 检查是否是唯一约束冲突（ER_DUP_ENTRY = 1062）
             unsigned int err_no = mysql_stmt_errno(stmt.get());
             if (err_no == 1062) {
@@ -89,7 +88,7 @@ bool LikeRepository::deleteByUserAndPost(MYSQL* conn, int userId, int postId) {
         // SQL 删除语句
         const char* query = "DELETE FROM likes WHERE user_id = ? AND post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -111,7 +110,7 @@ bool LikeRepository::deleteByUserAndPost(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -150,7 +149,7 @@ bool LikeRepository::exists(MYSQL* conn, int userId, int postId) {
         // SQL 查询语句
         const char* query = "SELECT COUNT(*) FROM likes WHERE user_id = ? AND post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -172,7 +171,7 @@ bool LikeRepository::exists(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -190,12 +189,12 @@ bool LikeRepository::exists(MYSQL* conn, int userId, int postId) {
             return false;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return count > 0;
         }
 
@@ -223,7 +222,7 @@ int LikeRepository::countByPostId(MYSQL* conn, int postId) {
         // SQL 查询语句
         const char* query = "SELECT COUNT(*) FROM likes WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -241,7 +240,7 @@ int LikeRepository::countByPostId(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -259,12 +258,12 @@ int LikeRepository::countByPostId(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -295,7 +294,7 @@ std::vector<Like> LikeRepository::findByUserId(MYSQL* conn, int userId, int limi
         const char* query = "SELECT id, user_id, post_id, UNIX_TIMESTAMP(create_time) as create_time "
                            "FROM likes WHERE user_id = ? ORDER BY create_time DESC LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return likes;
         }
@@ -321,7 +320,7 @@ std::vector<Like> LikeRepository::findByUserId(MYSQL* conn, int userId, int limi
             return likes;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return likes;
         }
@@ -349,13 +348,13 @@ std::vector<Like> LikeRepository::findByUserId(MYSQL* conn, int userId, int limi
             return likes;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return likes;
         }
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Like like;
             like.setId(static_cast<int>(id));
             like.setUserId(static_cast<int>(user_id));
@@ -429,7 +428,7 @@ std::unordered_map<int, bool> LikeRepository::batchExistsForPosts(
             return result;
         }
         
-        if (mysql_stmt_prepare(stmt.get(), sql.c_str(), sql.length()) != 0) {
+        if (stmt.prepare(sql.c_str(), sql.length()) != 0) {
             Logger::error("batchExistsForPosts: 预编译失败: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -462,9 +461,7 @@ std::unordered_map<int, bool> LikeRepository::batchExistsForPosts(
         // ========================================
         // 第5步：执行查询
         // ========================================
-        auto startTime = std::chrono::steady_clock::now();
-        
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("batchExistsForPosts: 执行查询失败: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -488,19 +485,14 @@ std::unordered_map<int, bool> LikeRepository::batchExistsForPosts(
         // 第7步：读取结果集
         // ========================================
         int likedCount = 0;
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             result[likedPostId] = true;  // 标记为已点赞
             likedCount++;
         }
         
-        auto endTime = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            endTime - startTime
-        ).count();
-        
-        Logger::info("batchExistsForPosts: 批量查询完成，" + std::to_string(likedCount) + "/" + 
-                    std::to_string(postIds.size()) + " 个帖子已点赞，耗时: " + 
-                    std::to_string(duration) + "ms");
+        // 查询耗时由 MySQLStatement 统计
+        Logger::debug("batchExistsForPosts: 批量查询完成，" + std::to_string(likedCount) + "/" + 
+                     std::to_string(postIds.size()) + " 个帖子已点赞");
         
         return result;
         
@@ -8,46 +8,70 @@
 #pragma once
 
 #include <mysql/mysql.h>
+#include <chrono>
+#include <cstring>
 #include "utils/logger.h"
+#include "database/query_stats.h"
+#include "utils/tracer.h"
 
 /**
  * @brief MySQL预编译语句RAII封装类
- * 
+ *
  * 自动管理MYSQL_STMT的生命周期，确保资源正确释放
  * 使用RAII模式，在析构时自动调用mysql_stmt_close
+ *
+ * 通过 prepare/execute/storeResult/fetch 调用时分别计时，并统计读取/影响的行数，
+ * 析构时上报给 QueryStats 中调用点的累计值（查询名默认为 "<源文件名>.<函数名>"，
+ * 如 post_repository.getPostById）。返回值与对应的 mysql_stmt_* 函数相同。
+ *
+ * 请求被追踪时，语句从构造到析构记为一个同名 span（附带 SQL 和行数）。
  */
 class MySQLStatement {
 public:
     /**
      * @brief 构造函数
      * @param conn MySQL连接对象
+     * @param function 查询所在函数（默认取调用处）
+     * @param file 查询所在源文件（默认取调用处）
      */
-    explicit MySQLStatement(MYSQL* conn) {
+    explicit MySQLStatement(MYSQL* conn,
+                            const char* function = __builtin_FUNCTION(),
+                            const char* file = __builtin_FILE())
+        : function_(function), file_(file)
+        , span_(Tracer::active() ? QueryStats::queryName(function, file) : std::string()) {
         stmt_ = mysql_stmt_init(conn);
         if (!stmt_) {
             Logger::error("Failed to initialize MySQL statement");
         }
     }
-    
+
     /**
      * @brief 析构函数
-     * 
-     * 自动关闭预编译语句，释放资源
+     *
+     * 上报查询耗时，然后关闭预编译语句，释放资源
      */
     ~MySQLStatement() {
+        if (prepared_) {
+            if (span_.recording()) {
+                span_.setAttribute("db.statement", timing_.sql);
+                span_.setAttribute("db.rows", std::to_string(timing_.rows));
+            }
+            QueryStats& stats = QueryStats::getInstance();
+            stats.record(stats.aggregate(function_, file_), std::move(timing_));
+        }
         if (stmt_) {
             mysql_stmt_close(stmt_);
         }
     }
-    
+
     /**
      * @brief 获取MYSQL_STMT指针
      * @return MYSQL_STMT指针
      */
-    MYSQL_STMT* get() { 
-        return stmt_; 
+    MYSQL_STMT* get() {
+        return stmt_;
     }
-    
+
     /**
      * @brief 检查语句是否有效
      * @return 有效返回true，否则返回false
@@ -55,7 +79,77 @@ public:
     bool isValid() const {
         return stmt_ != nullptr;
     }
-    
+
+    /**
+     * @brief 预编译SQL（mysql_stmt_prepare）
+     *
+     * SQL 文本只记下地址，语句累计耗时超过慢查询阈值时才复制（请求被追踪时直接复制）；
+     * query 须在最后一次 execute/storeResult/fetch 之前保持有效
+     *
+     * @return 成功返回0
+     */
+    int prepare(const char* query, unsigned long length) {
+        prepared_ = true;
+        sqlText_ = query;
+        sqlLength_ = length;
+        slowThresholdMicros_ = QueryStats::getInstance().slowThresholdMicros();
+        if (span_.recording()) {
+            captureSql();
+        }
+        auto start = Clock::now();
+        int ret = mysql_stmt_prepare(stmt_, query, length);
+        timing_.prepareMicros += elapsedMicros(start);
+        timing_.failed |= ret != 0;
+        captureSqlIfSlow();
+        return ret;
+    }
+
+    /**
+     * @brief 执行语句（mysql_stmt_execute）
+     * @return 成功返回0
+     */
+    int execute() {
+        auto start = Clock::now();
+        int ret = mysql_stmt_execute(stmt_);
+        timing_.executeMicros += elapsedMicros(start);
+        timing_.failed |= ret != 0;
+        if (ret == 0 && mysql_stmt_field_count(stmt_) == 0) {
+            timing_.rows += mysql_stmt_affected_rows(stmt_);
+        }
+        captureSqlIfSlow();
+        return ret;
+    }
+
+    /**
+     * @brief 把结果集缓存到客户端（mysql_stmt_store_result）
+     * @return 成功返回0
+     */
+    int storeResult() {
+        auto start = Clock::now();
+        int ret = mysql_stmt_store_result(stmt_);
+        timing_.fetchMicros += elapsedMicros(start);
+        timing_.failed |= ret != 0;
+        captureSqlIfSlow();
+        return ret;
+    }
+
+    /**
+     * @brief 读取下一行（mysql_stmt_fetch）
+     * @return 0/MYSQL_DATA_TRUNCATED 表示读到一行，MYSQL_NO_DATA 表示结束
+     */
+    int fetch() {
+        auto start = Clock::now();
+        int ret = mysql_stmt_fetch(stmt_);
+        timing_.fetchMicros += elapsedMicros(start);
+        if (ret == 0 || ret == MYSQL_DATA_TRUNCATED) {
+            timing_.rows++;
+        } else if (ret != MYSQL_NO_DATA) {
+            timing_.failed = true;
+        }
+        captureSqlIfSlow();
+        return ret;
+    }
+
     /**
      * @brief 获取错误信息
      * @return 错误信息字符串
@@ -66,16 +160,49 @@ public:
         }
         return "Statement not initialized";
     }
-    
+
     // 禁止拷贝
     MySQLStatement(const MySQLStatement&) = delete;
     MySQLStatement& operator=(const MySQLStatement&) = delete;
-    
+
     // 禁止移动（简化实现）
     MySQLStatement(MySQLStatement&&) = delete;
     MySQLStatement& operator=(MySQLStatement&&) = delete;
-    
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    static uint64_t elapsedMicros(Clock::time_point start) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    }
+
+    /**
+     * @brief 复制 SQL 文本（只复制一次）
+     */
+    void captureSql() {
+        if (sqlText_) {
+            timing_.sql.assign(sqlText_, sqlLength_);
+            sqlText_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief 累计耗时达到慢查询阈值时复制 SQL（此时调用方的 SQL 文本仍有效）
+     */
+    void captureSqlIfSlow() {
+        if (sqlText_ && timing_.totalMicros() >= slowThresholdMicros_) {
+            captureSql();
+        }
+    }
+
     MYSQL_STMT* stmt_;  ///< MySQL预编译语句指针
+    const char* function_;
+    const char* file_;
+    TraceSpan span_;        ///< 必须在 function_/file_ 之后初始化
+    bool prepared_ = false;
+    const char* sqlText_ = nullptr;     ///< prepare 传入的 SQL，复制后置空
+    unsigned long sqlLength_ = 0;
+    uint64_t slowThresholdMicros_ = 0;
+    QueryTiming timing_;
 };
-
@@ -16,7 +16,6 @@
 #include <memory>
 #include <sstream>
 #include <map>
-#include <chrono>
 
 // 构造函数
 PostRepository::PostRepository() {
@@ -33,7 +32,23 @@ bool PostRepository::createPost(Post& post) {
             return false;
         }
 
-        MySQLStatement stmt(connGuard.get());
+        return createPost(connGuard.get(), post);
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in createPost: " + std::string(e.what()));
+        return false;
+    }
+}
+
+// 创建帖子记录（使用调用方连接）
+bool PostRepository::createPost(MYSQL* conn, Post& post) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return false;
+        }
+
+        MySQLStatement stmt(conn);
         if (!stmt.isValid()) {
             return false;
         }
@@ -41,7 +56,7 @@ bool PostRepository::createPost(Post& post) {
         // SQL 插入语句
         const char* query = "INSERT INTO posts (post_id, user_id, title, description, image_count, status) VALUES (?, ?, ?, ?, ?, ?)";
         
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -89,7 +104,7 @@ bool PostRepository::createPost(Post& post) {
             return false;
         }
         
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -107,8 +122,8 @@ bool PostRepository::createPost(Post& post) {
 }
 
 // 从预编译语句构建Post对象
-Post PostRepository::buildPostFromStatement(void* stmtPtr) {
-    MYSQL_STMT* stmt = static_cast<MYSQL_STMT*>(stmtPtr);
+Post PostRepository::buildPostFromStatement(MySQLStatement& statement) {
+    MYSQL_STMT* stmt = statement.get();
     Post post;
     
     // 准备结果绑定（12个字段：id, post_id, user_id, title, description, image_count, like_count, favorite_count, view_count, status, create_time, update_time）
@@ -207,7 +222,7 @@ Post PostRepository::buildPostFromStatement(void* stmtPtr) {
     }
     
     // 获取数据
-    if (mysql_stmt_fetch(stmt) == 0) {
+    if (statement.fetch() == 0) {
         post.setId(static_cast<int>(id));
         post.setPostId(std::string(postId, postId_length));
         post.setUserId(static_cast<int>(userId));
@@ -248,14 +263,24 @@ Post PostRepository::buildPostFromStatement(void* stmtPtr) {
 
 // 根据业务ID查找帖子（不包含图片）
 std::optional<Post> PostRepository::findByPostId(const std::string& postId) {
+    ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+    if (!connGuard.isValid()) {
+        Logger::error("Failed to get database connection");
+        return std::nullopt;
+    }
+
+    return findByPostId(connGuard.get(), postId);
+}
+
+// 根据业务ID查找帖子（使用调用方连接）
+std::optional<Post> PostRepository::findByPostId(MYSQL* conn, const std::string& postId) {
     try {
-        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
-        if (!connGuard.isValid()) {
-            Logger::error("Failed to get database connection");
+        if (!conn) {
+            Logger::error("Database connection is null");
             return std::nullopt;
         }
 
-        MySQLStatement stmt(connGuard.get());
+        MySQLStatement stmt(conn);
         if (!stmt.isValid()) {
             return std::nullopt;
         }
@@ -272,7 +297,7 @@ std::optional<Post> PostRepository::findByPostId(const std::string& postId) {
             "LEFT JOIN users u ON p.user_id = u.id "
             "WHERE p.post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -290,7 +315,7 @@ std::optional<Post> PostRepository::findByPostId(const std::string& postId) {
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -409,7 +434,7 @@ std::optional<Post> PostRepository::findByPostId(const std::string& postId) {
         }
 
         // 获取数据
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             Post post;
             post.setId(static_cast<int>(id));
             post.setPostId(std::string(post_id, post_id_length));
@@ -510,7 +535,7 @@ bool PostRepository::updatePost(const Post& post) {
 
         const char* query = "UPDATE posts SET title = ?, description = ? WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -542,7 +567,7 @@ bool PostRepository::updatePost(const Post& post) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -565,14 +590,30 @@ bool PostRepository::deletePost(const std::string& postId) {
             return false;
         }
 
-        MySQLStatement stmt(connGuard.get());
+        return deletePost(connGuard.get(), postId);
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in deletePost: " + std::string(e.what()));
+        return false;
+    }
+}
+
+// 删除帖子（使用调用方连接）
+bool PostRepository::deletePost(MYSQL* conn, const std::string& postId) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return false;
+        }
+
+        MySQLStatement stmt(conn);
         if (!stmt.isValid()) {
             return false;
         }
 
         const char* query = "DELETE FROM posts WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -590,7 +631,7 @@ bool PostRepository::deletePost(const std::string& postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -633,7 +674,7 @@ std::vector<Post> PostRepository::getRecentPosts(int page, int pageSize) {
             "ORDER BY p.create_time DESC "
             "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -656,7 +697,7 @@ std::vector<Post> PostRepository::getRecentPosts(int page, int pageSize) {
             return posts;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -766,10 +807,10 @@ std::vector<Post> PostRepository::getRecentPosts(int page, int pageSize) {
         }
 
         // 稳定结果集
-        mysql_stmt_store_result(stmt.get());
+        stmt.storeResult();
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Post post;
             post.setId(static_cast<int>(id));
             post.setPostId(std::string(postId, postId_length));
@@ -868,14 +909,347 @@ std::vector<Post> PostRepository::getRecentPostsWithImages(int page, int pageSiz
     return posts;
 }
 
+// 根据物理ID列表批量查询帖子（不包含图片）
+std::vector<Post> PostRepository::findByIds(const std::vector<int>& postIds) {
+    std::vector<Post> posts;
+    if (postIds.empty()) {
+        return posts;
+    }
+
+    try {
+        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+        if (!connGuard.isValid()) {
+            Logger::error("Failed to get database connection");
+            return posts;
+        }
+
+        MySQLStatement stmt(connGuard.get());
+        if (!stmt.isValid()) {
+            return posts;
+        }
+
+        // 构建IN子句的占位符
+        std::string placeholders;
+        for (size_t i = 0; i < postIds.size(); ++i) {
+            if (i > 0) placeholders += ",";
+            placeholders += "?";
+        }
+
+        std::string query =
+            "SELECT "
+            "  p.id, p.post_id, p.user_id, p.title, p.description, "
+            "  p.image_count, p.like_count, p.favorite_count, p.view_count, "
+            "  p.status, p.create_time, p.update_time, "
+            "  COALESCE(u.user_id, '') AS user_logical_id "
+            "FROM posts p "
+            "LEFT JOIN users u ON p.user_id = u.id "
+            "WHERE p.id IN (" + placeholders + ") AND p.status = 'APPROVED'";
+
+        if (stmt.prepare(query.c_str(), query.length()) != 0) {
+            Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return posts;
+        }
+
+        // 绑定参数
+        std::vector<int> postIdsCopy = postIds;  // 需要可修改的副本
+        std::vector<MYSQL_BIND> bind(postIdsCopy.size());
+        memset(bind.data(), 0, sizeof(MYSQL_BIND) * bind.size());
+        for (size_t i = 0; i < postIdsCopy.size(); ++i) {
+            bind[i].buffer_type = MYSQL_TYPE_LONG;
+            bind[i].buffer = &postIdsCopy[i];
+        }
+
+        if (mysql_stmt_bind_param(stmt.get(), bind.data()) != 0) {
+            Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
+            return posts;
+        }
+
+        if (stmt.execute() != 0) {
+            Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return posts;
+        }
+
+        // 准备结果绑定（13个字段，与 getRecentPosts 一致）
+        MYSQL_BIND result[13];
+        memset(result, 0, sizeof(result));
+
+        long long id;
+        char postId[37] = {0};
+        long long userId_result;
+        char title[256] = {0};
+        char description[4096] = {0};
+        int imageCount, likeCount, favoriteCount, viewCount;
+        char status[20] = {0};
+        MYSQL_TIME createTime, updateTime;
+        char userLogicalId[128] = {0};
+
+        unsigned long postId_length, title_length, description_length, status_length, userLogicalIdLength;
+        bool description_is_null, userLogicalIdIsNull;
+
+        int idx = 0;
+
+        result[idx].buffer_type = MYSQL_TYPE_LONGLONG;
+        result[idx].buffer = &id;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_STRING;
+        result[idx].buffer = postId;
+        result[idx].buffer_length = sizeof(postId);
+        result[idx].length = &postId_length;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_LONGLONG;
+        result[idx].buffer = &userId_result;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_STRING;
+        result[idx].buffer = title;
+        result[idx].buffer_length = sizeof(title);
+        result[idx].length = &title_length;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_STRING;
+        result[idx].buffer = description;
+        result[idx].buffer_length = sizeof(description);
+        result[idx].length = &description_length;
+        result[idx].is_null = &description_is_null;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_LONG;
+        result[idx].buffer = &imageCount;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_LONG;
+        result[idx].buffer = &likeCount;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_LONG;
+        result[idx].buffer = &favoriteCount;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_LONG;
+        result[idx].buffer = &viewCount;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_STRING;
+        result[idx].buffer = status;
+        result[idx].buffer_length = sizeof(status);
+        result[idx].length = &status_length;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_TIMESTAMP;
+        result[idx].buffer = &createTime;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_TIMESTAMP;
+        result[idx].buffer = &updateTime;
+        idx++;
+
+        result[idx].buffer_type = MYSQL_TYPE_STRING;
+        result[idx].buffer = userLogicalId;
+        result[idx].buffer_length = sizeof(userLogicalId);
+        result[idx].length = &userLogicalIdLength;
+        result[idx].is_null = &userLogicalIdIsNull;
+        idx++;
+
+        if (mysql_stmt_bind_result(stmt.get(), result) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return posts;
+        }
+
+        stmt.storeResult();
+
+        // IN 查询不保证顺序，先按ID收集再按调用方给定的顺序输出
+        std::map<int, Post> postMap;
+        while (stmt.fetch() == 0) {
+            Post post;
+            post.setId(static_cast<int>(id));
+            post.setPostId(std::string(postId, postId_length));
+            post.setUserId(static_cast<int>(userId_result));
+            post.setTitle(std::string(title, title_length));
+
+            if (!description_is_null) {
+                post.setDescription(std::string(description, description_length));
+            }
+
+            post.setImageCount(imageCount);
+            post.setLikeCount(likeCount);
+            post.setFavoriteCount(favoriteCount);
+            post.setViewCount(viewCount);
+            post.setStatus(Post::stringToStatus(std::string(status, status_length)));
+
+            struct tm tm_create = {0};
+            tm_create.tm_year = createTime.year - 1900;
+            tm_create.tm_mon = createTime.month - 1;
+            tm_create.tm_mday = createTime.day;
+            tm_create.tm_hour = createTime.hour;
+            tm_create.tm_min = createTime.minute;
+            tm_create.tm_sec = createTime.second;
+            post.setCreateTime(mktime(&tm_create));
+
+            struct tm tm_update = {0};
+            tm_update.tm_year = updateTime.year - 1900;
+            tm_update.tm_mon = updateTime.month - 1;
+            tm_update.tm_mday = updateTime.day;
+            tm_update.tm_hour = updateTime.hour;
+            tm_update.tm_min = updateTime.minute;
+            tm_update.tm_sec = updateTime.second;
+            post.setUpdateTime(mktime(&tm_update));
+
+            if (!userLogicalIdIsNull && userLogicalIdLength > 0) {
+                post.setUserLogicalId(std::string(userLogicalId, userLogicalIdLength));
+            }
+
+            postMap[post.getId()] = post;
+        }
+
+        posts.reserve(postMap.size());
+        for (int postIdValue : postIds) {
+            auto it = postMap.find(postIdValue);
+            if (it != postMap.end()) {
+                posts.push_back(it->second);
+            }
+        }
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in findByIds: " + std::string(e.what()));
+    }
+
+    return posts;
+}
+
+// 根据物理ID列表批量查询帖子（包含图片）
+std::vector<Post> PostRepository::findByIdsWithImages(const std::vector<int>& postIds) {
+    std::vector<Post> posts = findByIds(postIds);
+    loadImagesForPosts(posts);
+    return posts;
+}
+
+// 查询时间窗口内热度最高帖子的互动计数
+std::optional<std::vector<PostEngagement>> PostRepository::getRecentEngagement(int maxAgeHours, int limit,
+                                                                              const HotScoreParams& params) {
+    std::vector<PostEngagement> result;
+
+    try {
+        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+        if (!connGuard.isValid()) {
+            Logger::error("Failed to get database connection");
+            return std::nullopt;
+        }
+
+        MySQLStatement stmt(connGuard.get());
+        if (!stmt.isValid()) {
+            return std::nullopt;
+        }
+
+        // 分享数没有冗余字段，按 idx_post_shares 索引做相关子查询；
+        // 先对整个时间窗口计算热度再截取，不能只取最新的 limit 条
+        const char* query =
+            "SELECT c.id, c.like_count, c.favorite_count, c.comment_count, c.share_count, "
+            "  c.view_count, c.create_ts "
+            "FROM ("
+            "  SELECT p.id, p.like_count, p.favorite_count, p.comment_count, "
+            "    (SELECT COUNT(*) FROM shares s WHERE s.post_id = p.id) AS share_count, "
+            "    p.view_count, UNIX_TIMESTAMP(p.create_time) AS create_ts "
+            "  FROM posts p "
+            "  WHERE p.status = 'APPROVED' AND p.create_time >= NOW() - INTERVAL ? HOUR"
+            ") c "
+            "ORDER BY LOG2(c.like_count * ? + c.favorite_count * ? + c.comment_count * ? + "
+            "  c.share_count * ? + c.view_count * ? + 1) + c.create_ts / ? DESC "
+            "LIMIT ?";
+
+        if (stmt.prepare(query, strlen(query)) != 0) {
+            Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        double weights[5] = {params.weightLike, params.weightFavorite, params.weightComment,
+                             params.weightShare, params.weightView};
+        double halfLifeSeconds = params.halfLifeHours * 3600.0;
+
+        MYSQL_BIND bind[8];
+        memset(bind, 0, sizeof(bind));
+
+        bind[0].buffer_type = MYSQL_TYPE_LONG;
+        bind[0].buffer = &maxAgeHours;
+
+        for (int i = 0; i < 5; ++i) {
+            bind[1 + i].buffer_type = MYSQL_TYPE_DOUBLE;
+            bind[1 + i].buffer = &weights[i];
+        }
+
+        bind[6].buffer_type = MYSQL_TYPE_DOUBLE;
+        bind[6].buffer = &halfLifeSeconds;
+
+        bind[7].buffer_type = MYSQL_TYPE_LONG;
+        bind[7].buffer = &limit;
+
+        if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
+            Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        if (stmt.execute() != 0) {
+            Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        long long id = 0, shareCount = 0, createTime = 0;
+        int likeCount = 0, favoriteCount = 0, commentCount = 0, viewCount = 0;
+
+        MYSQL_BIND resultBind[7];
+        memset(resultBind, 0, sizeof(resultBind));
+
+        resultBind[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        resultBind[0].buffer = &id;
+        resultBind[1].buffer_type = MYSQL_TYPE_LONG;
+        resultBind[1].buffer = &likeCount;
+        resultBind[2].buffer_type = MYSQL_TYPE_LONG;
+        resultBind[2].buffer = &favoriteCount;
+        resultBind[3].buffer_type = MYSQL_TYPE_LONG;
+        resultBind[3].buffer = &commentCount;
+        resultBind[4].buffer_type = MYSQL_TYPE_LONGLONG;
+        resultBind[4].buffer = &shareCount;
+        resultBind[5].buffer_type = MYSQL_TYPE_LONG;
+        resultBind[5].buffer = &viewCount;
+        resultBind[6].buffer_type = MYSQL_TYPE_LONGLONG;
+        resultBind[6].buffer = &createTime;
+
+        if (mysql_stmt_bind_result(stmt.get(), resultBind) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        if (stmt.storeResult() != 0) {
+            Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        while (stmt.fetch() == 0) {
+            PostEngagement engagement;
+            engagement.postId = static_cast<int>(id);
+            engagement.likeCount = likeCount;
+            engagement.favoriteCount = favoriteCount;
+            engagement.commentCount = commentCount;
+            engagement.shareCount = static_cast<int>(shareCount);
+            engagement.viewCount = viewCount;
+            engagement.createTime = static_cast<std::time_t>(createTime);
+            result.push_back(engagement);
+        }
+
+        return result;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in getRecentEngagement: " + std::string(e.what()));
+        return std::nullopt;
+    }
+}
+
 // 获取最新帖子列表（包含图片，使用LEFT JOIN优化，推荐使用）
 std::vector<Post> PostRepository::getRecentPostsWithImagesOptimized(int page, int pageSize) {
     std::vector<Post> posts;
     
     try {
-        // 记录查询开始时间
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
         ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
         if (!connGuard.isValid()) {
             Logger::error("Failed to get database connection");
@@ -906,7 +1280,7 @@ std::vector<Post> PostRepository::getRecentPostsWithImagesOptimized(int page, in
             return posts;
         }
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -930,7 +1304,7 @@ std::vector<Post> PostRepository::getRecentPostsWithImagesOptimized(int page, in
         }
 
         // 执行查询
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -1111,13 +1485,13 @@ std::vector<Post> PostRepository::getRecentPostsWithImagesOptimized(int page, in
             return posts;
         }
 
-        mysql_stmt_store_result(stmt.get());
+        stmt.storeResult();
 
         // 处理结果 - 合并相同帖子的图片
         std::map<int, Post> postMap;
         int currentPostId = -1;
         
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             int postPhysicalId = static_cast<int>(id);
             
             // 如果是新帖子，创建Post对象
@@ -1212,18 +1586,8 @@ std::vector<Post> PostRepository::getRecentPostsWithImagesOptimized(int page, in
             posts.push_back(pair.second);
         }
 
-        // 记录查询结束时间
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        
-        Logger::info("Query completed in " + std::to_string(duration.count()) + "ms, fetched " + 
-                     std::to_string(posts.size()) + " posts with images using optimized LEFT JOIN");
-        
-        // 如果查询时间过长，记录警告
-        if (duration.count() > 500) {
-            Logger::warning("Slow query detected: getRecentPostsWithImagesOptimized took " + 
-                           std::to_string(duration.count()) + "ms");
-        }
+        // 查询耗时和慢查询由 MySQLStatement/QueryStats 统计
+        Logger::debug("Fetched " + std::to_string(posts.size()) + " posts with images using optimized LEFT JOIN");
 
     } catch (const std::exception& e) {
         Logger::error("Exception in getRecentPostsWithImagesOptimized: " + std::string(e.what()));
@@ -1261,7 +1625,7 @@ std::vector<Post> PostRepository::findByUserId(int userId, int page, int pageSiz
             "ORDER BY p.create_time DESC "
             "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -1287,7 +1651,7 @@ std::vector<Post> PostRepository::findByUserId(int userId, int page, int pageSiz
             return posts;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return posts;
         }
@@ -1397,10 +1761,10 @@ std::vector<Post> PostRepository::findByUserId(int userId, int page, int pageSiz
         }
 
         // 稳定结果集
-        mysql_stmt_store_result(stmt.get());
+        stmt.storeResult();
 
         // 获取所有结果
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Post post;
             post.setId(static_cast<int>(id));
             post.setPostId(std::string(postId, postId_length));
@@ -1478,7 +1842,7 @@ bool PostRepository::incrementViewCount(const std::string& postId) {
 
         const char* query = "UPDATE posts SET view_count = view_count + 1 WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1496,7 +1860,7 @@ bool PostRepository::incrementViewCount(const std::string& postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1525,7 +1889,7 @@ bool PostRepository::updateImageCount(const std::string& postId, int imageCount)
 
         const char* query = "UPDATE posts SET image_count = ? WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1546,7 +1910,7 @@ bool PostRepository::updateImageCount(const std::string& postId, int imageCount)
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1561,26 +1925,36 @@ bool PostRepository::updateImageCount(const std::string& postId, int imageCount)
 
 // 获取帖子总数
 int PostRepository::getTotalCount() {
+    ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+    if (!connGuard.isValid()) {
+        Logger::error("Failed to get database connection");
+        return 0;
+    }
+
+    return getTotalCount(connGuard.get());
+}
+
+// 获取帖子总数（使用调用方连接）
+int PostRepository::getTotalCount(MYSQL* conn) {
     try {
-        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
-        if (!connGuard.isValid()) {
-            Logger::error("Failed to get database connection");
+        if (!conn) {
+            Logger::error("Database connection is null");
             return 0;
         }
 
-        MySQLStatement stmt(connGuard.get());
+        MySQLStatement stmt(conn);
         if (!stmt.isValid()) {
             return 0;
         }
 
         const char* query = "SELECT COUNT(*) FROM posts WHERE status = 'APPROVED'";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -1598,7 +1972,7 @@ int PostRepository::getTotalCount() {
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -1626,7 +2000,7 @@ int PostRepository::getUserPostCount(int userId) {
 
         const char* query = "SELECT COUNT(*) FROM posts WHERE user_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -1643,7 +2017,7 @@ int PostRepository::getUserPostCount(int userId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -1661,7 +2035,7 @@ int PostRepository::getUserPostCount(int userId) {
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -1689,7 +2063,7 @@ bool PostRepository::incrementLikeCount(MYSQL* conn, int postId) {
         // 使用原子操作更新计数
         const char* query = "UPDATE posts SET like_count = like_count + 1 WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1706,7 +2080,7 @@ bool PostRepository::incrementLikeCount(MYSQL* conn, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1736,7 +2110,7 @@ bool PostRepository::decrementLikeCount(MYSQL* conn, int postId) {
         // 使用原子操作更新计数，确保不会小于0
         const char* query = "UPDATE posts SET like_count = like_count - 1 WHERE id = ? AND like_count > 0";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1753,7 +2127,7 @@ bool PostRepository::decrementLikeCount(MYSQL* conn, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1783,7 +2157,7 @@ bool PostRepository::incrementFavoriteCount(MYSQL* conn, int postId) {
         // 使用原子操作更新计数
         const char* query = "UPDATE posts SET favorite_count = favorite_count + 1 WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1800,7 +2174,7 @@ bool PostRepository::incrementFavoriteCount(MYSQL* conn, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1830,7 +2204,7 @@ bool PostRepository::decrementFavoriteCount(MYSQL* conn, int postId) {
         // 使用原子操作更新计数，确保不会小于0
         const char* query = "UPDATE posts SET favorite_count = favorite_count - 1 WHERE id = ? AND favorite_count > 0";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1847,7 +2221,7 @@ bool PostRepository::decrementFavoriteCount(MYSQL* conn, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1877,7 +2251,7 @@ bool PostRepository::incrementCommentCount(MYSQL* conn, int postId) {
         // 使用原子操作更新计数
         const char* query = "UPDATE posts SET comment_count = comment_count + 1 WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1894,7 +2268,7 @@ bool PostRepository::incrementCommentCount(MYSQL* conn, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1924,7 +2298,7 @@ bool PostRepository::decrementCommentCount(MYSQL* conn, int postId) {
         // 使用原子操作更新计数，确保不会小于0
         const char* query = "UPDATE posts SET comment_count = comment_count - 1 WHERE id = ? AND comment_count > 0";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1941,7 +2315,7 @@ bool PostRepository::decrementCommentCount(MYSQL* conn, int postId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -12,6 +12,34 @@
 #include <optional>
 #include <vector>
 #include <string>
+#include <ctime>
+
+class MySQLStatement;
+
+/**
+ * @brief 帖子互动计数快照（热度排行使用）
+ */
+struct PostEngagement {
+    int postId;                 // 帖子物理ID
+    int likeCount;              // 点赞数
+    int favoriteCount;          // 收藏数
+    int commentCount;           // 评论数
+    int shareCount;             // 分享数（来自shares表）
+    int viewCount;              // 浏览数
+    std::time_t createTime;     // 发布时间
+};
+
+/**
+ * @brief 热度计算参数（与 HotRankingEngine 的排序键一致，用于在数据库中预选候选集）
+ */
+struct HotScoreParams {
+    double weightLike;
+    double weightFavorite;
+    double weightComment;
+    double weightShare;
+    double weightView;
+    double halfLifeHours;
+};
 
 /**
  * @brief 帖子数据访问类
@@ -36,6 +64,14 @@ public:
      * @return 成功返回true，失败返回false
      */
     bool createPost(Post& post);
+
+    /**
+     * @brief 创建帖子记录（使用调用方连接，便于与作者统计放在同一事务中）
+     * @param conn MySQL连接
+     * @param post 帖子对象（成功后写入自增ID）
+     * @return 成功返回true，失败返回false
+     */
+    bool createPost(MYSQL* conn, Post& post);
     
     /**
      * @brief 根据业务ID查找帖子（不包含图片）
@@ -43,6 +79,14 @@ public:
      * @return 如果找到返回Post对象，否则返回std::nullopt
      */
     std::optional<Post> findByPostId(const std::string& postId);
+
+    /**
+     * @brief 根据业务ID查找帖子（使用调用方连接，避免持有连接时再从连接池取第二个）
+     * @param conn MySQL连接
+     * @param postId 业务逻辑ID
+     * @return 如果找到返回Post对象，否则返回std::nullopt
+     */
+    std::optional<Post> findByPostId(MYSQL* conn, const std::string& postId);
     
     /**
      * @brief 根据业务ID查找帖子（包含图片，使用JOIN查询）
@@ -64,6 +108,14 @@ public:
      * @return 成功返回true，失败返回false
      */
     bool deletePost(const std::string& postId);
+
+    /**
+     * @brief 删除帖子（使用调用方连接，便于与其他更新放在同一事务中）
+     * @param conn MySQL连接
+     * @param postId 业务逻辑ID
+     * @return 成功返回true，失败返回false
+     */
+    bool deletePost(MYSQL* conn, const std::string& postId);
     
     /**
      * @brief 获取最新帖子列表（不包含图片）
@@ -89,7 +141,35 @@ public:
      * @note 使用LEFT JOIN + 一次查询获取所有数据，性能更优
      */
     std::vector<Post> getRecentPostsWithImagesOptimized(int page, int pageSize);
-    
+
+    /**
+     * @brief 根据物理ID列表批量查询帖子（不包含图片）
+     * @param postIds 帖子物理ID列表
+     * @return 帖子列表，顺序与 postIds 一致（不存在或未审核通过的帖子被跳过）
+     */
+    std::vector<Post> findByIds(const std::vector<int>& postIds);
+
+    /**
+     * @brief 根据物理ID列表批量查询帖子（包含图片）
+     * @param postIds 帖子物理ID列表
+     * @return 帖子列表（包含images），顺序与 postIds 一致
+     */
+    std::vector<Post> findByIdsWithImages(const std::vector<int>& postIds);
+
+    /**
+     * @brief 查询时间窗口内热度最高帖子的互动计数（热度排行加载候选集）
+     *
+     * 对窗口内所有帖子按 log2(互动加权和) + 发布时间/半衰期 排序后再截取，
+     * 与排行引擎增量更新时淘汰热度最低帖子的规则一致
+     *
+     * @param maxAgeHours 只查询最近多少小时内发布的帖子
+     * @param limit 最多返回条数
+     * @param params 热度计算参数
+     * @return 互动计数列表（按热度倒序）；查询失败返回std::nullopt
+     */
+    std::optional<std::vector<PostEngagement>> getRecentEngagement(int maxAgeHours, int limit,
+                                                                   const HotScoreParams& params);
+
     /**
      * @brief 根据用户ID查找帖子列表（不包含图片）
      * @param userId 用户ID
@@ -128,6 +208,13 @@ public:
      * @return 帖子总数
      */
     int getTotalCount();
+
+    /**
+     * @brief 获取帖子总数（使用调用方连接）
+     * @param conn MySQL连接
+     * @return 帖子总数
+     */
+    int getTotalCount(MYSQL* conn);
     
     /**
      * @brief 获取用户的帖子总数
@@ -187,10 +274,10 @@ public:
 private:
     /**
      * @brief 从预编译语句构建Post对象
-     * @param stmtPtr MYSQL_STMT指针
+     * @param statement 预编译语句
      * @return Post对象
      */
-    Post buildPostFromStatement(void* stmtPtr);
+    Post buildPostFromStatement(MySQLStatement& statement);
     
     /**
      * @brief 批量加载帖子的图片
@@ -0,0 +1,209 @@
+/**
+ * @file query_stats.cpp
+ * @brief 数据库查询耗时统计与慢查询记录实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "database/query_stats.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include "utils/metrics_registry.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+double toMillis(uint64_t micros) {
+    return static_cast<double>(micros) / 1000.0;
+}
+
+/**
+ * @brief 调用点键（__builtin_FUNCTION / __builtin_FILE 返回的字面量地址）
+ */
+struct SiteKey {
+    const char* function;
+    const char* file;
+
+    bool operator==(const SiteKey& other) const {
+        return function == other.function && file == other.file;
+    }
+};
+
+struct SiteKeyHash {
+    size_t operator()(const SiteKey& key) const {
+        std::hash<const void*> hash;
+        return hash(key.function) ^ (hash(key.file) * 31);
+    }
+};
+
+}  // namespace
+
+struct QueryStats::Aggregate {
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> rows{0};
+        std::atomic<uint64_t> prepareMicros{0};
+        std::atomic<uint64_t> executeMicros{0};
+        std::atomic<uint64_t> fetchMicros{0};
+        std::atomic<uint64_t> maxMicros{0};
+    };
+
+    std::string name;
+    Histogram* latency = nullptr;
+    std::array<Shard, metrics_detail::kShards> shards;
+};
+
+QueryStats& QueryStats::getInstance() {
+    static QueryStats instance;
+    return instance;
+}
+
+QueryStats::QueryStats()
+    : slowNext_(0)
+    , slowTotal_(0) {
+    auto& config = ConfigManager::getInstance();
+    slowThresholdMicros_ = static_cast<uint64_t>(std::max(0, config.get<int>("database.slow_query.threshold_ms", 100))) * 1000;
+    slowCapacity_ = static_cast<size_t>(std::max(1, config.get<int>("database.slow_query.buffer_size", 128)));
+    slowQueries_.reserve(slowCapacity_);
+}
+
+QueryStats::~QueryStats() = default;
+
+std::string QueryStats::queryName(const char* function, const char* file) {
+    const char* base = std::strrchr(file, '/');
+    base = base ? base + 1 : file;
+    const char* dot = std::strrchr(base, '.');
+    std::string name(base, dot ? static_cast<size_t>(dot - base) : std::strlen(base));
+    name += '.';
+    name += function;
+    return name;
+}
+
+QueryStats::Aggregate& QueryStats::aggregate(const char* function, const char* file) {
+    // 同名字面量可能被链接器合并，键同时包含函数名和文件名的地址
+    static thread_local std::unordered_map<SiteKey, Aggregate*, SiteKeyHash> sites;
+    SiteKey key{function, file};
+    auto cached = sites.find(key);
+    if (cached != sites.end()) {
+        return *cached->second;
+    }
+
+    std::string name = queryName(function, file);
+    Aggregate* result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<Aggregate>& slot = aggregates_[name];
+        if (!slot) {
+            slot = std::make_unique<Aggregate>();
+            slot->name = name;
+            slot->latency = &MetricsRegistry::getInstance().histogram(
+                "db_query_duration_seconds", "Prepared statement time (prepare + execute + fetch) by query",
+                {{"query", name}});
+        }
+        result = slot.get();
+    }
+    sites.emplace(key, result);
+    return *result;
+}
+
+void QueryStats::record(Aggregate& aggregate, QueryTiming&& timing) {
+    uint64_t total = timing.totalMicros();
+
+    Aggregate::Shard& shard = aggregate.shards[metrics_detail::shardIndex()];
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    if (timing.failed) {
+        shard.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.rows.fetch_add(timing.rows, std::memory_order_relaxed);
+    shard.prepareMicros.fetch_add(timing.prepareMicros, std::memory_order_relaxed);
+    shard.executeMicros.fetch_add(timing.executeMicros, std::memory_order_relaxed);
+    shard.fetchMicros.fetch_add(timing.fetchMicros, std::memory_order_relaxed);
+    uint64_t max = shard.maxMicros.load(std::memory_order_relaxed);
+    while (total > max && !shard.maxMicros.compare_exchange_weak(max, total, std::memory_order_relaxed)) {
+    }
+    aggregate.latency->record(total);
+
+    if (total < slowThresholdMicros_) {
+        return;
+    }
+
+    Logger::warning("Slow query " + aggregate.name + ": " + std::to_string(toMillis(total)) + "ms, rows=" +
+                    std::to_string(timing.rows));
+    timing.name = aggregate.name;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    SlowQuery entry{std::move(timing), std::time(nullptr)};
+    if (slowQueries_.size() < slowCapacity_) {
+        slowQueries_.push_back(std::move(entry));
+    } else {
+        slowQueries_[slowNext_] = std::move(entry);
+    }
+    slowNext_ = (slowNext_ + 1) % slowCapacity_;
+    slowTotal_++;
+}
+
+Json::Value QueryStats::getSlowQueries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Json::Value queries(Json::arrayValue);
+    size_t size = slowQueries_.size();
+    for (size_t i = 0; i < size; ++i) {
+        // 从最近写入的位置往回遍历
+        const SlowQuery& entry = slowQueries_[(slowNext_ + slowCapacity_ - 1 - i) % slowCapacity_];
+        const QueryTiming& timing = entry.timing;
+
+        Json::Value item;
+        item["query"] = timing.name;
+        item["sql"] = timing.sql;
+        item["total_ms"] = toMillis(timing.totalMicros());
+        item["prepare_ms"] = toMillis(timing.prepareMicros);
+        item["execute_ms"] = toMillis(timing.executeMicros);
+        item["fetch_ms"] = toMillis(timing.fetchMicros);
+        item["rows"] = static_cast<Json::UInt64>(timing.rows);
+        item["failed"] = timing.failed;
+        item["timestamp"] = static_cast<Json::Int64>(entry.at);
+        queries.append(item);
+    }
+    return queries;
+}
+
+Json::Value QueryStats::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Json::Value stats;
+    stats["slow_threshold_ms"] = toMillis(slowThresholdMicros_);
+    stats["slow_total"] = static_cast<Json::UInt64>(slowTotal_);
+
+    Json::Value queries(Json::objectValue);
+    for (const auto& [name, aggregate] : aggregates_) {
+        uint64_t count = 0, failures = 0, rows = 0, prepareMicros = 0, executeMicros = 0, fetchMicros = 0;
+        uint64_t maxMicros = 0;
+        for (const auto& shard : aggregate->shards) {
+            count += shard.count.load(std::memory_order_relaxed);
+            failures += shard.failures.load(std::memory_order_relaxed);
+            rows += shard.rows.load(std::memory_order_relaxed);
+            prepareMicros += shard.prepareMicros.load(std::memory_order_relaxed);
+            executeMicros += shard.executeMicros.load(std::memory_order_relaxed);
+            fetchMicros += shard.fetchMicros.load(std::memory_order_relaxed);
+            maxMicros = std::max(maxMicros, shard.maxMicros.load(std::memory_order_relaxed));
+        }
+
+        Json::Value item;
+        item["count"] = static_cast<Json::UInt64>(count);
+        item["failures"] = static_cast<Json::UInt64>(failures);
+        item["rows"] = static_cast<Json::UInt64>(rows);
+        double divisor = static_cast<double>(std::max<uint64_t>(count, 1));
+        item["avg_prepare_ms"] = toMillis(prepareMicros) / divisor;
+        item["avg_execute_ms"] = toMillis(executeMicros) / divisor;
+        item["avg_fetch_ms"] = toMillis(fetchMicros) / divisor;
+        item["max_ms"] = toMillis(maxMicros);
+        queries[name] = item;
+    }
+    stats["queries"] = queries;
+    return stats;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file query_stats.h
+ * @brief 数据库查询耗时统计与慢查询记录
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <json/json.h>
+
+class Histogram;
+
+/**
+ * @brief 单次查询的耗时
+ */
+struct QueryTiming {
+    std::string name;               // 查询名（只在进入慢查询记录时填写）
+    std::string sql;                // 只在超过慢查询阈值或请求被追踪时复制
+    uint64_t prepareMicros = 0;
+    uint64_t executeMicros = 0;
+    uint64_t fetchMicros = 0;       // store_result + 逐行 fetch
+    uint64_t rows = 0;              // SELECT 为读取的行数，写操作为影响的行数
+    bool failed = false;
+
+    uint64_t totalMicros() const { return prepareMicros + executeMicros + fetchMicros; }
+};
+
+/**
+ * @brief 查询统计（单例）
+ *
+ * MySQLStatement 析构时上报一次 QueryTiming：
+ * - 按查询名累计次数、失败数、行数和各阶段耗时，并写入 Prometheus 直方图
+ *   db_query_duration_seconds{query="..."}
+ * - 总耗时超过 database.slow_query.threshold_ms 的查询进入环形缓冲区
+ *   （容量 database.slow_query.buffer_size，新记录覆盖最旧的），由 /debug/slow-queries 查看
+ *
+ * 每个调用点（源文件 + 函数）的累计值只在线程第一次执行该调用点时加锁查找，
+ * 之后走线程局部缓存；累计值与 MetricsRegistry 一样按线程分片，写入只做 relaxed 原子加，
+ * 只有慢查询才加锁写环形缓冲区。
+ */
+class QueryStats {
+public:
+    /**
+     * @brief 单个查询名的累计值（定义在 query_stats.cpp）
+     */
+    struct Aggregate;
+
+    static QueryStats& getInstance();
+
+    /**
+     * @brief 查询名："<源文件名（不含目录和扩展名）>.<函数名>"
+     */
+    static std::string queryName(const char* function, const char* file);
+
+    /**
+     * @brief 取调用点的累计值
+     * @param function 查询所在函数（__builtin_FUNCTION，字面量地址在进程内不变）
+     * @param file 查询所在源文件（__builtin_FILE）
+     * @return 累计值，进程内一直有效
+     */
+    Aggregate& aggregate(const char* function, const char* file);
+
+    /**
+     * @brief 记录一次查询
+     * @param aggregate 查询所属的累计值
+     * @param timing 查询耗时
+     */
+    void record(Aggregate& aggregate, QueryTiming&& timing);
+
+    /**
+     * @brief 慢查询阈值（微秒）
+     */
+    uint64_t slowThresholdMicros() const { return slowThresholdMicros_; }
+
+    /**
+     * @brief 获取最近的慢查询（最新的在前）
+     * @return JSON数组
+     */
+    Json::Value getSlowQueries() const;
+
+    /**
+     * @brief 获取按查询名汇总的统计
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    QueryStats(const QueryStats&) = delete;
+    QueryStats& operator=(const QueryStats&) = delete;
+
+private:
+    QueryStats();
+    ~QueryStats();
+
+    /**
+     * @brief 慢查询记录
+     */
+    struct SlowQuery {
+        QueryTiming timing;
+        std::time_t at;
+    };
+
+    uint64_t slowThresholdMicros_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<Aggregate>> aggregates_;   // 只增不删，地址稳定
+    std::vector<SlowQuery> slowQueries_;    // 环形缓冲区
+    size_t slowCapacity_;
+    size_t slowNext_;                       // 下一个写入位置
+    uint64_t slowTotal_;
+};
@@ -30,7 +30,7 @@ int ShareRepository::create(MYSQL* conn, const Share& share) {
         const char* query = "INSERT INTO shares (share_id, post_id, sender_id, receiver_id, share_message) "
                            "VALUES (?, ?, ?, ?, ?)";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -77,7 +77,7 @@ int ShareRepository::create(MYSQL* conn, const Share& share) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             // 检查是否是唯一约束冲突（ER_DUP_ENTRY = 1062）
             unsigned int err_no = mysql_stmt_errno(stmt.get());
             if (err_no == 1062) {
@@ -119,7 +119,7 @@ std::optional<Share> ShareRepository::findById(MYSQL* conn, int shareId) {
                            "UNIX_TIMESTAMP(create_time) as create_time "
                            "FROM shares WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -136,7 +136,7 @@ std::optional<Share> ShareRepository::findById(MYSQL* conn, int shareId) {
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -192,12 +192,12 @@ std::optional<Share> ShareRepository::findById(MYSQL* conn, int shareId) {
             return std::nullopt;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
-        int fetch_result = mysql_stmt_fetch(stmt.get());
+        int fetch_result = stmt.fetch();
         if (fetch_result == 0) {
             // 构建Share对象
             Share share;
@@ -241,7 +241,7 @@ std::optional<Share> ShareRepository::findByShareId(MYSQL* conn, const std::stri
                            "UNIX_TIMESTAMP(create_time) as create_time "
                            "FROM shares WHERE share_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -262,7 +262,7 @@ std::optional<Share> ShareRepository::findByShareId(MYSQL* conn, const std::stri
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -318,12 +318,12 @@ std::optional<Share> ShareRepository::findByShareId(MYSQL* conn, const std::stri
             return std::nullopt;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
-        int fetch_result = mysql_stmt_fetch(stmt.get());
+        int fetch_result = stmt.fetch();
         if (fetch_result == 0) {
             Share share;
             share.setId(id);
@@ -364,7 +364,7 @@ bool ShareRepository::exists(MYSQL* conn, int senderId, int receiverId, int post
         // SQL 查询语句
         const char* query = "SELECT 1 FROM shares WHERE sender_id = ? AND receiver_id = ? AND post_id = ? LIMIT 1";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -387,12 +387,12 @@ bool ShareRepository::exists(MYSQL* conn, int senderId, int receiverId, int post
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -429,7 +429,7 @@ std::vector<Share> ShareRepository::findReceivedShares(MYSQL* conn, int receiver
                            "ORDER BY create_time DESC "
                            "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return shares;
         }
@@ -452,7 +452,7 @@ std::vector<Share> ShareRepository::findReceivedShares(MYSQL* conn, int receiver
             return shares;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return shares;
         }
@@ -508,12 +508,12 @@ std::vector<Share> ShareRepository::findReceivedShares(MYSQL* conn, int receiver
             return shares;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return shares;
         }
 
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Share share;
             share.setId(id);
             share.setShareId(share_id_null ? "" : std::string(share_id_buf, share_id_len));
@@ -559,7 +559,7 @@ std::vector<Share> ShareRepository::findSentShares(MYSQL* conn, int senderId, in
                            "ORDER BY create_time DESC "
                            "LIMIT ? OFFSET ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return shares;
         }
@@ -582,7 +582,7 @@ std::vector<Share> ShareRepository::findSentShares(MYSQL* conn, int senderId, in
             return shares;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return shares;
         }
@@ -638,12 +638,12 @@ std::vector<Share> ShareRepository::findSentShares(MYSQL* conn, int senderId, in
             return shares;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return shares;
         }
 
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             Share share;
             share.setId(id);
             share.setShareId(share_id_null ? "" : std::string(share_id_buf, share_id_len));
@@ -681,7 +681,7 @@ int ShareRepository::countReceivedShares(MYSQL* conn, int receiverId) {
 
         const char* query = "SELECT COUNT(*) FROM shares WHERE receiver_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -697,7 +697,7 @@ int ShareRepository::countReceivedShares(MYSQL* conn, int receiverId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -714,12 +714,12 @@ int ShareRepository::countReceivedShares(MYSQL* conn, int receiverId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -746,7 +746,7 @@ int ShareRepository::countSentShares(MYSQL* conn, int senderId) {
 
         const char* query = "SELECT COUNT(*) FROM shares WHERE sender_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -762,7 +762,7 @@ int ShareRepository::countSentShares(MYSQL* conn, int senderId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -779,12 +779,12 @@ int ShareRepository::countSentShares(MYSQL* conn, int senderId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -811,7 +811,7 @@ bool ShareRepository::deleteById(MYSQL* conn, int shareId) {
 
         const char* query = "DELETE FROM shares WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -827,7 +827,7 @@ bool ShareRepository::deleteById(MYSQL* conn, int shareId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -862,7 +862,7 @@ int ShareRepository::countPostShares(MYSQL* conn, int postId) {
 
         const char* query = "SELECT COUNT(*) FROM shares WHERE post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -878,7 +878,7 @@ int ShareRepository::countPostShares(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
@@ -895,12 +895,12 @@ int ShareRepository::countPostShares(MYSQL* conn, int postId) {
             return 0;
         }
 
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return 0;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return static_cast<int>(count);
         }
 
@@ -8,45 +8,20 @@
 #include "database/tag_repository.h"
 #include "database/connection_pool.h"
 #include "database/connection_guard.h"
+#include "database/mysql_statement.h"
 #include "utils/logger.h"
 #include <mysql/mysql.h>
 #include <cstring>
 #include <memory>
 
-// RAII 封装 MYSQL_STMT
-class MySQLStatement {
-public:
-    explicit MySQLStatement(MYSQL* conn) {
-        stmt_ = mysql_stmt_init(conn);
-        if (!stmt_) {
-            Logger::error("Failed to initialize MySQL statement");
-        }
-    }
-    
-    ~MySQLStatement() {
-        if (stmt_) {
-            mysql_stmt_close(stmt_);
-        }
-    }
-    
-    MYSQL_STMT* get() { return stmt_; }
-    
-    // 禁止拷贝
-    MySQLStatement(const MySQLStatement&) = delete;
-    MySQLStatement& operator=(const MySQLStatement&) = delete;
-    
-private:
-    MYSQL_STMT* stmt_;
-};
-
 // 构造函数
 TagRepository::TagRepository() {
     Logger::info("TagRepository initialized");
 }
 
 // 从预编译语句构建 Tag 对象
-Tag TagRepository::buildTagFromStatement(void* stmtPtr) {
-    MYSQL_STMT* stmt = static_cast<MYSQL_STMT*>(stmtPtr);
+Tag TagRepository::buildTagFromStatement(MySQLStatement& statement) {
+    MYSQL_STMT* stmt = statement.get();
     Tag tag;
     
     // 准备结果绑定
@@ -83,7 +58,7 @@ Tag TagRepository::buildTagFromStatement(void* stmtPtr) {
     }
     
     // 获取数据
-    if (mysql_stmt_fetch(stmt) == 0) {
+    if (statement.fetch() == 0) {
         tag.setId(static_cast<int>(id));
         tag.setName(std::string(name, name_length));
         tag.setUseCount(useCount);
@@ -104,21 +79,31 @@ Tag TagRepository::buildTagFromStatement(void* stmtPtr) {
 
 // 根据名称查找标签
 std::optional<Tag> TagRepository::findByName(const std::string& name) {
+    ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+    if (!connGuard.isValid()) {
+        Logger::error("Failed to get database connection");
+        return std::nullopt;
+    }
+
+    return findByName(connGuard.get(), name);
+}
+
+// 根据名称查找标签（使用调用方连接）
+std::optional<Tag> TagRepository::findByName(MYSQL* conn, const std::string& name) {
     try {
-        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
-        if (!connGuard.isValid()) {
-            Logger::error("Failed to get database connection");
+        if (!conn) {
+            Logger::error("Database connection is null");
             return std::nullopt;
         }
 
-        MySQLStatement stmt(connGuard.get());
+        MySQLStatement stmt(conn);
         if (!stmt.get()) {
             return std::nullopt;
         }
         
         const char* query = "SELECT * FROM tags WHERE name = ?";
         
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -136,12 +121,12 @@ std::optional<Tag> TagRepository::findByName(const std::string& name) {
             return std::nullopt;
         }
         
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
         
-        Tag tag = buildTagFromStatement(stmt.get());
+        Tag tag = buildTagFromStatement(stmt);
         
         if (tag.getId() > 0) {
             return tag;
@@ -171,7 +156,7 @@ bool TagRepository::createTag(const Tag& tag) {
         
         const char* query = "INSERT INTO tags (name, use_count) VALUES (?, ?)";
         
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -193,7 +178,7 @@ bool TagRepository::createTag(const Tag& tag) {
             return false;
         }
         
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -223,7 +208,7 @@ bool TagRepository::linkPostTag(int postId, int tagId) {
 
         const char* query = "INSERT INTO post_tags (post_id, tag_id) VALUES (?, ?)";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -243,7 +228,7 @@ bool TagRepository::linkPostTag(int postId, int tagId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -280,7 +265,7 @@ std::vector<Tag> TagRepository::getPostTags(int postId) {
 
         const char* query = "SELECT t.* FROM tags t INNER JOIN post_tags pt ON t.id = pt.tag_id WHERE pt.post_id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return tags;
         }
@@ -297,18 +282,18 @@ std::vector<Tag> TagRepository::getPostTags(int postId) {
             return tags;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return tags;
         }
 
         // 获取所有结果
         while (true) {
-            Tag tag = buildTagFromStatement(stmt.get());
+            Tag tag = buildTagFromStatement(stmt);
             if (tag.getId() > 0) {
                 tags.push_back(tag);
                 // 移动到下一行
-                if (mysql_stmt_fetch(stmt.get()) != 0) {
+                if (stmt.fetch() != 0) {
                     break;
                 }
             } else {
@@ -345,7 +330,7 @@ bool TagRepository::incrementUseCount(int tagId) {
         
         const char* query = "UPDATE tags SET use_count = use_count + 1 WHERE id = ?";
         
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -362,7 +347,7 @@ bool TagRepository::incrementUseCount(int tagId) {
             return false;
         }
         
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
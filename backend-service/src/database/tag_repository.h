@@ -8,10 +8,13 @@
 #pragma once
 
 #include "models/tag.h"
+#include <mysql/mysql.h>
 #include <optional>
 #include <vector>
 #include <string>
 
+class MySQLStatement;
+
 /**
  * @brief 标签数据访问类
  * 
@@ -35,6 +38,14 @@ public:
      * @return 如果找到返回Tag对象，否则返回std::nullopt
      */
     std::optional<Tag> findByName(const std::string& name);
+
+    /**
+     * @brief 根据名称查找标签（使用调用方连接）
+     * @param conn MySQL连接
+     * @param name 标签名称
+     * @return 如果找到返回Tag对象，否则返回std::nullopt
+     */
+    std::optional<Tag> findByName(MYSQL* conn, const std::string& name);
     
     /**
      * @brief 创建标签
@@ -85,9 +96,9 @@ public:
 private:
     /**
      * @brief 从预编译语句构建Tag对象
-     * @param stmtPtr MYSQL_STMT指针
+     * @param statement 预编译语句
      * @return Tag对象
      */
-    Tag buildTagFromStatement(void* stmtPtr);
+    Tag buildTagFromStatement(MySQLStatement& statement);
 };
 
@@ -38,7 +38,7 @@ bool UserRepository::createUser(const User& user) {
         // SQL 插入语句
         const char* query = "INSERT INTO users (user_id, username, password, salt, real_name, phone, email, role, status, avatar_url, device_count) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
         
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -115,7 +115,7 @@ bool UserRepository::createUser(const User& user) {
             return false;
         }
         
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -130,8 +130,8 @@ bool UserRepository::createUser(const User& user) {
 }
 
 // 从预编译语句构建 User 对象
-User UserRepository::buildUserFromStatement(void* stmtPtr) {
-    MYSQL_STMT* stmt = static_cast<MYSQL_STMT*>(stmtPtr);
+User UserRepository::buildUserFromStatement(MySQLStatement& statement) {
+    MYSQL_STMT* stmt = statement.get();
     User user;
     
     // 准备结果绑定（19个字段：原17个 + following_count + follower_count）
@@ -280,7 +280,7 @@ User UserRepository::buildUserFromStatement(void* stmtPtr) {
     }
     
     // 获取数据
-    if (mysql_stmt_fetch(stmt) == 0) {
+    if (statement.fetch() == 0) {
         user.setId(static_cast<int>(id));
         user.setUserId(std::string(userId, userId_length));
         user.setUsername(std::string(username, username_length));
@@ -343,20 +343,30 @@ User UserRepository::buildUserFromStatement(void* stmtPtr) {
 
 // 执行查询并返回单个用户
 std::optional<User> UserRepository::executeQuerySingleUser(const char* query, const std::string& paramValue) {
+    // 使用ConnectionGuard自动管理连接
+    ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
+    if (!connGuard.isValid()) {
+        Logger::error("Failed to get database connection");
+        return std::nullopt;
+    }
+
+    return executeQuerySingleUser(connGuard.get(), query, paramValue);
+}
+
+// 执行查询并返回单个用户（使用调用方连接）
+std::optional<User> UserRepository::executeQuerySingleUser(MYSQL* conn, const char* query, const std::string& paramValue) {
     try {
-        // 使用ConnectionGuard自动管理连接
-        ConnectionGuard connGuard(DatabaseConnectionPool::getInstance());
-        if (!connGuard.isValid()) {
-            Logger::error("Failed to get database connection");
+        if (!conn) {
+            Logger::error("Database connection is null");
             return std::nullopt;
         }
 
-        MySQLStatement stmt(connGuard.get());
+        MySQLStatement stmt(conn);
         if (!stmt.get()) {
             return std::nullopt;
         }
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -374,13 +384,13 @@ std::optional<User> UserRepository::executeQuerySingleUser(const char* query, co
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
         // 存储结果
-        if (mysql_stmt_store_result(stmt.get()) != 0) {
+        if (stmt.storeResult() != 0) {
             Logger::error("Failed to store result: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -391,7 +401,7 @@ std::optional<User> UserRepository::executeQuerySingleUser(const char* query, co
         }
 
         // 构建用户对象
-        User user = buildUserFromStatement(stmt.get());
+        User user = buildUserFromStatement(stmt);
         return user;
 
     } catch (const std::exception& e) {
@@ -406,12 +416,24 @@ std::optional<User> UserRepository::findById(int id) {
     return executeQuerySingleUser(query, std::to_string(id));
 }
 
+// 根据物理ID查询用户（使用调用方连接）
+std::optional<User> UserRepository::findById(MYSQL* conn, int id) {
+    const char* query = "SELECT * FROM users WHERE id = ?";
+    return executeQuerySingleUser(conn, query, std::to_string(id));
+}
+
 // 根据逻辑ID查询用户
 std::optional<User> UserRepository::findByUserId(const std::string& userId) {
     const char* query = "SELECT * FROM users WHERE user_id = ?";
     return executeQuerySingleUser(query, userId);
 }
 
+// 根据逻辑ID查询用户（使用调用方连接）
+std::optional<User> UserRepository::findByUserId(MYSQL* conn, const std::string& userId) {
+    const char* query = "SELECT * FROM users WHERE user_id = ?";
+    return executeQuerySingleUser(conn, query, userId);
+}
+
 // 根据用户名查询用户
 std::optional<User> UserRepository::findByUsername(const std::string& username) {
     const char* query = "SELECT * FROM users WHERE username = ?";
@@ -450,7 +472,7 @@ bool UserRepository::updateUser(const User& user) {
 
         const char* query = "UPDATE users SET username = ?, password = ?, salt = ?, real_name = ?, phone = ?, email = ?, role = ?, status = ?, avatar_url = ?, device_count = ? WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -527,7 +549,7 @@ bool UserRepository::updateUser(const User& user) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -594,7 +616,7 @@ bool UserRepository::updateUserProfile(int userId,
             "update_time = CURRENT_TIMESTAMP "
             "WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("准备SQL语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -664,7 +686,7 @@ bool UserRepository::updateUserProfile(int userId,
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -699,7 +721,7 @@ bool UserRepository::emailExistsForOtherUser(const std::string& email, int exclu
 
         const char* query = "SELECT COUNT(*) FROM users WHERE email = ? AND id != ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("准备SQL语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -720,7 +742,7 @@ bool UserRepository::emailExistsForOtherUser(const std::string& email, int exclu
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -738,7 +760,7 @@ bool UserRepository::emailExistsForOtherUser(const std::string& email, int exclu
             return false;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return count > 0;
         }
 
@@ -767,7 +789,7 @@ bool UserRepository::phoneExistsForOtherUser(const std::string& phone, int exclu
 
         const char* query = "SELECT COUNT(*) FROM users WHERE phone = ? AND id != ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("准备SQL语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -788,7 +810,7 @@ bool UserRepository::phoneExistsForOtherUser(const std::string& phone, int exclu
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -806,7 +828,7 @@ bool UserRepository::phoneExistsForOtherUser(const std::string& phone, int exclu
             return false;
         }
 
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             return count > 0;
         }
 
@@ -834,7 +856,7 @@ bool UserRepository::incrementFollowingCount(MYSQL* conn, int64_t userId) {
         // SQL 原子更新语句
         const char* query = "UPDATE users SET following_count = following_count + 1 WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("预编译语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -851,7 +873,7 @@ bool UserRepository::incrementFollowingCount(MYSQL* conn, int64_t userId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -881,7 +903,7 @@ bool UserRepository::decrementFollowingCount(MYSQL* conn, int64_t userId) {
         // SQL 原子更新语句（防止减成负数）
         const char* query = "UPDATE users SET following_count = following_count - 1 WHERE id = ? AND following_count > 0";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("预编译语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -898,7 +920,7 @@ bool UserRepository::decrementFollowingCount(MYSQL* conn, int64_t userId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -928,7 +950,7 @@ bool UserRepository::incrementFollowerCount(MYSQL* conn, int64_t userId) {
         // SQL 原子更新语句
         const char* query = "UPDATE users SET follower_count = follower_count + 1 WHERE id = ?";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("预编译语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -945,7 +967,7 @@ bool UserRepository::incrementFollowerCount(MYSQL* conn, int64_t userId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -975,7 +997,7 @@ bool UserRepository::decrementFollowerCount(MYSQL* conn, int64_t userId) {
         // SQL 原子更新语句（防止减成负数）
         const char* query = "UPDATE users SET follower_count = follower_count - 1 WHERE id = ? AND follower_count > 0";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("预编译语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -992,7 +1014,7 @@ bool UserRepository::decrementFollowerCount(MYSQL* conn, int64_t userId) {
             return false;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL失败: " + std::string(mysql_stmt_error(stmt.get())));
             return false;
         }
@@ -1023,13 +1045,14 @@ std::optional<UserStats> UserRepository::getUserStats(MYSQL* conn, const std::st
         const char* query = 
             "SELECT u.user_id, u.following_count, u.follower_count, "
             "COUNT(DISTINCT p.id) as post_count, "
-            "COALESCE(SUM(p.like_count), 0) as total_likes "
+            "COALESCE(SUM(p.like_count), 0) as total_likes, "
+            "COALESCE(SUM(p.favorite_count), 0) as total_favorites "
             "FROM users u "
             "LEFT JOIN posts p ON u.id = p.user_id "
             "WHERE u.user_id = ? "
             "GROUP BY u.id";
 
-        if (mysql_stmt_prepare(stmt.get(), query, strlen(query)) != 0) {
+        if (stmt.prepare(query, strlen(query)) != 0) {
             Logger::error("预编译语句失败: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
@@ -1052,18 +1075,18 @@ std::optional<UserStats> UserRepository::getUserStats(MYSQL* conn, const std::st
             return std::nullopt;
         }
 
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("执行SQL失败: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
         // 绑定结果
         char user_id_buf[256];
-        int following_count = 0, follower_count = 0, post_count = 0, total_likes = 0;
+        int following_count = 0, follower_count = 0, post_count = 0, total_likes = 0, total_favorites = 0;
         unsigned long user_id_length;
-        bool is_null[5];
+        bool is_null[6];
 
-        MYSQL_BIND result[5];
+        MYSQL_BIND result[6];
         memset(result, 0, sizeof(result));
 
         result[0].buffer_type = MYSQL_TYPE_STRING;
@@ -1088,13 +1111,17 @@ std::optional<UserStats> UserRepository::getUserStats(MYSQL* conn, const std::st
         result[4].buffer = &total_likes;
         result[4].is_null = &is_null[4];
 
+        result[5].buffer_type = MYSQL_TYPE_LONG;
+        result[5].buffer = &total_favorites;
+        result[5].is_null = &is_null[5];
+
         if (mysql_stmt_bind_result(stmt.get(), result) != 0) {
             Logger::error("绑定结果失败: " + std::string(mysql_stmt_error(stmt.get())));
             return std::nullopt;
         }
 
         // 获取结果
-        if (mysql_stmt_fetch(stmt.get()) == 0) {
+        if (stmt.fetch() == 0) {
             user_id_buf[user_id_length] = '\0';
             UserStats stats(
                 std::string(user_id_buf),
@@ -1103,6 +1130,7 @@ std::optional<UserStats> UserRepository::getUserStats(MYSQL* conn, const std::st
                 post_count,
                 total_likes
             );
+            stats.setTotalFavorites(total_favorites);
             return stats;
         }
 
@@ -1161,7 +1189,7 @@ std::unordered_map<int, User> UserRepository::batchGetUsers(
             return result;
         }
         
-        if (mysql_stmt_prepare(stmt.get(), sql.c_str(), sql.length()) != 0) {
+        if (stmt.prepare(sql.c_str(), sql.length()) != 0) {
             Logger::error("batchGetUsers: 预编译失败: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -1186,9 +1214,7 @@ std::unordered_map<int, User> UserRepository::batchGetUsers(
         // ========================================
         // 第4步: 执行查询
         // ========================================
-        auto startTime = std::chrono::steady_clock::now();
-        
-        if (mysql_stmt_execute(stmt.get()) != 0) {
+        if (stmt.execute() != 0) {
             Logger::error("batchGetUsers: 执行查询失败: " + std::string(mysql_stmt_error(stmt.get())));
             return result;
         }
@@ -1273,7 +1299,7 @@ std::unordered_map<int, User> UserRepository::batchGetUsers(
         // ========================================
         // 第6步: 读取结果集
         // ========================================
-        while (mysql_stmt_fetch(stmt.get()) == 0) {
+        while (stmt.fetch() == 0) {
             User user;
             user.setId(id);
             user.setUserId(std::string(userIdBuf, userIdLen));
@@ -1302,14 +1328,9 @@ std::unordered_map<int, User> UserRepository::batchGetUsers(
             result[id] = user;
         }
         
-        auto endTime = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            endTime - startTime
-        ).count();
-        
-        Logger::info("batchGetUsers: 批量查询完成，找到 " + std::to_string(result.size()) + 
-                    "/" + std::to_string(userIds.size()) + " 个用户，耗时: " + 
-                    std::to_string(duration) + "ms");
+        // 查询耗时由 MySQLStatement 统计
+        Logger::debug("batchGetUsers: 批量查询完成，找到 " + std::to_string(result.size()) + 
+                     "/" + std::to_string(userIds.size()) + " 个用户");
         
         return result;
         
@@ -1337,16 +1358,15 @@ bool UserRepository::updateAvatarUrl(int userId, const std::string& avatarUrl) {
         const char* query = "UPDATE users SET avatar_url = ?, update_time = CURRENT_TIMESTAMP WHERE id = ?";
         
         // 3. 创建预编译语句
-        MYSQL_STMT* stmt = mysql_stmt_init(conn);
-        if (!stmt) {
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
             Logger::error("mysql_stmt_init失败");
             return false;
         }
         
         // 4. 预编译SQL
-        if (mysql_stmt_prepare(stmt, query, strlen(query)) != 0) {
-            Logger::error("mysql_stmt_prepare失败: " + std::string(mysql_stmt_error(stmt)));
-            mysql_stmt_close(stmt);
+        if (stmt.prepare(query, strlen(query)) != 0) {
+            Logger::error("mysql_stmt_prepare失败: " + stmt.getError());
             return false;
         }
         
@@ -1367,22 +1387,19 @@ bool UserRepository::updateAvatarUrl(int userId, const std::string& avatarUrl) {
         bind[1].buffer = (char*)&userId;
         bind[1].is_null = nullptr;
         
-        if (mysql_stmt_bind_param(stmt, bind) != 0) {
-            Logger::error("mysql_stmt_bind_param失败: " + std::string(mysql_stmt_error(stmt)));
-            mysql_stmt_close(stmt);
+        if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
+            Logger::error("mysql_stmt_bind_param失败: " + stmt.getError());
             return false;
         }
         
         // 6. 执行更新
-        if (mysql_stmt_execute(stmt) != 0) {
-            Logger::error("mysql_stmt_execute失败: " + std::string(mysql_stmt_error(stmt)));
-            mysql_stmt_close(stmt);
+        if (stmt.execute() != 0) {
+            Logger::error("mysql_stmt_execute失败: " + stmt.getError());
             return false;
         }
         
         // 7. 检查影响行数
-        my_ulonglong affected = mysql_stmt_affected_rows(stmt);
-        mysql_stmt_close(stmt);
+        my_ulonglong affected = mysql_stmt_affected_rows(stmt.get());
         
         if (affected == 0) {
             Logger::warning("更新头像URL失败: 用户不存在, userId=" + std::to_string(userId));
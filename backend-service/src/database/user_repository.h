@@ -14,6 +14,8 @@
 #include <vector>
 #include <unordered_map>
 
+class MySQLStatement;
+
 /**
  * @brief 用户数据访问类
  * 
@@ -48,6 +50,15 @@ public:
      * @return 用户对象（未找到返回 std::nullopt）
      */
     std::optional<User> findById(int id);
+
+    /**
+     * @brief 根据物理ID查询用户（使用调用方连接）
+     * 
+     * @param conn MySQL连接
+     * @param id 物理ID
+     * @return 用户对象（未找到返回 std::nullopt）
+     */
+    std::optional<User> findById(MYSQL* conn, int id);
     
     /**
      * @brief 根据逻辑ID查询用户
@@ -56,6 +67,15 @@ public:
      * @return 用户对象（未找到返回 std::nullopt）
      */
     std::optional<User> findByUserId(const std::string& userId);
+
+    /**
+     * @brief 根据逻辑ID查询用户（使用调用方连接）
+     * 
+     * @param conn MySQL连接
+     * @param userId 逻辑ID（业务生成）
+     * @return 用户对象（未找到返回 std::nullopt）
+     */
+    std::optional<User> findByUserId(MYSQL* conn, const std::string& userId);
     
     /**
      * @brief 根据用户名查询用户
@@ -237,10 +257,10 @@ private:
     /**
      * @brief 从结果集构建 User 对象
      * 
-     * @param stmt MySQL 预编译语句
+     * @param statement 预编译语句
      * @return 用户对象
      */
-    User buildUserFromStatement(void* stmt);
+    User buildUserFromStatement(MySQLStatement& statement);
     
     /**
      * @brief 执行查询并返回单个用户
@@ -250,5 +270,15 @@ private:
      * @return 用户对象（未找到返回 std::nullopt）
      */
     std::optional<User> executeQuerySingleUser(const char* query, const std::string& paramValue);
+
+    /**
+     * @brief 执行查询并返回单个用户（使用调用方连接）
+     * 
+     * @param conn MySQL连接
+     * @param query SQL 查询语句
+     * @param paramValue 参数值
+     * @return 用户对象（未找到返回 std::nullopt）
+     */
+    std::optional<User> executeQuerySingleUser(MYSQL* conn, const char* query, const std::string& paramValue);
 };
 
@@ -0,0 +1,241 @@
+/**
+ * @file user_stats_repository.cpp
+ * @brief 用户统计物化表数据访问层实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "database/user_stats_repository.h"
+#include "database/mysql_statement.h"
+#include "utils/logger.h"
+#include <cstring>
+#include <stdexcept>
+
+// 根据用户业务ID读取统计行
+std::optional<UserStats> UserStatsRepository::findByUserId(MYSQL* conn, const std::string& userId) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return std::nullopt;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return std::nullopt;
+        }
+
+        // users.user_id 唯一索引定位物理ID，再按主键读取统计行
+        const char* query =
+            "SELECT s.following_count, s.follower_count, s.post_count, s.total_likes, s.total_favorites "
+            "FROM users u "
+            "JOIN user_stats s ON s.user_id = u.id "
+            "WHERE u.user_id = ?";
+
+        if (stmt.prepare(query, strlen(query)) != 0) {
+            Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        // 绑定参数
+        std::string userIdCopy = userId;
+        unsigned long userIdLength = userIdCopy.length();
+
+        MYSQL_BIND bind[1];
+        memset(bind, 0, sizeof(bind));
+
+        bind[0].buffer_type = MYSQL_TYPE_STRING;
+        bind[0].buffer = const_cast<char*>(userIdCopy.c_str());
+        bind[0].buffer_length = userIdCopy.length();
+        bind[0].length = &userIdLength;
+
+        if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
+            Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        if (stmt.execute() != 0) {
+            Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        // 绑定结果
+        int followingCount = 0, followerCount = 0, postCount = 0, totalLikes = 0, totalFavorites = 0;
+        MYSQL_BIND result[5];
+        memset(result, 0, sizeof(result));
+
+        result[0].buffer_type = MYSQL_TYPE_LONG;
+        result[0].buffer = &followingCount;
+
+        result[1].buffer_type = MYSQL_TYPE_LONG;
+        result[1].buffer = &followerCount;
+
+        result[2].buffer_type = MYSQL_TYPE_LONG;
+        result[2].buffer = &postCount;
+
+        result[3].buffer_type = MYSQL_TYPE_LONG;
+        result[3].buffer = &totalLikes;
+
+        result[4].buffer_type = MYSQL_TYPE_LONG;
+        result[4].buffer = &totalFavorites;
+
+        if (mysql_stmt_bind_result(stmt.get(), result) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return std::nullopt;
+        }
+
+        if (stmt.fetch() != 0) {
+            return std::nullopt;
+        }
+
+        UserStats stats(userId, followingCount, followerCount, postCount, totalLikes);
+        stats.setTotalFavorites(totalFavorites);
+        return stats;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in UserStatsRepository::findByUserId: " + std::string(e.what()));
+        return std::nullopt;
+    }
+}
+
+// 读取用户帖子数
+int UserStatsRepository::getPostCount(MYSQL* conn, int64_t userId) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return -1;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return -1;
+        }
+
+        const char* query = "SELECT post_count FROM user_stats WHERE user_id = ?";
+
+        if (stmt.prepare(query, strlen(query)) != 0) {
+            Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return -1;
+        }
+
+        MYSQL_BIND bind[1];
+        memset(bind, 0, sizeof(bind));
+
+        bind[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        bind[0].buffer = &userId;
+
+        if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
+            Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
+            return -1;
+        }
+
+        if (stmt.execute() != 0) {
+            Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return -1;
+        }
+
+        int postCount = 0;
+        MYSQL_BIND result[1];
+        memset(result, 0, sizeof(result));
+
+        result[0].buffer_type = MYSQL_TYPE_LONG;
+        result[0].buffer = &postCount;
+
+        if (mysql_stmt_bind_result(stmt.get(), result) != 0) {
+            Logger::error("Failed to bind result: " + std::string(mysql_stmt_error(stmt.get())));
+            return -1;
+        }
+
+        if (stmt.fetch() == 0) {
+            return postCount;
+        }
+
+        return -1;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in UserStatsRepository::getPostCount: " + std::string(e.what()));
+        return -1;
+    }
+}
+
+// 调整帖子数
+bool UserStatsRepository::adjustPostCount(MYSQL* conn, int64_t userId, int delta) {
+    return adjustColumn(conn, "post_count", userId, delta);
+}
+
+// 调整粉丝数
+bool UserStatsRepository::adjustFollowerCount(MYSQL* conn, int64_t userId, int delta) {
+    return adjustColumn(conn, "follower_count", userId, delta);
+}
+
+// 调整关注数
+bool UserStatsRepository::adjustFollowingCount(MYSQL* conn, int64_t userId, int delta) {
+    return adjustColumn(conn, "following_count", userId, delta);
+}
+
+// 调整获赞数
+bool UserStatsRepository::adjustTotalLikes(MYSQL* conn, int64_t userId, int delta) {
+    return adjustColumn(conn, "total_likes", userId, delta);
+}
+
+// 调整被收藏数
+bool UserStatsRepository::adjustTotalFavorites(MYSQL* conn, int64_t userId, int delta) {
+    return adjustColumn(conn, "total_favorites", userId, delta);
+}
+
+// UPSERT 增量更新
+bool UserStatsRepository::adjustColumn(MYSQL* conn, const char* column, int64_t userId, int delta) {
+    try {
+        if (!conn) {
+            Logger::error("Database connection is null");
+            return false;
+        }
+
+        if (delta == 0) {
+            return true;
+        }
+
+        MySQLStatement stmt(conn);
+        if (!stmt.isValid()) {
+            return false;
+        }
+
+        // 列名来自内部常量，不接受外部输入
+        std::string col(column);
+        std::string query =
+            "INSERT INTO user_stats (user_id, " + col + ") VALUES (?, GREATEST(?, 0)) "
+            "ON DUPLICATE KEY UPDATE " + col + " = GREATEST(CAST(" + col + " AS SIGNED) + ?, 0)";
+
+        if (stmt.prepare(query.c_str(), query.length()) != 0) {
+            Logger::error("Failed to prepare statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return false;
+        }
+
+        MYSQL_BIND bind[3];
+        memset(bind, 0, sizeof(bind));
+
+        bind[0].buffer_type = MYSQL_TYPE_LONGLONG;
+        bind[0].buffer = &userId;
+
+        bind[1].buffer_type = MYSQL_TYPE_LONG;
+        bind[1].buffer = &delta;
+
+        bind[2].buffer_type = MYSQL_TYPE_LONG;
+        bind[2].buffer = &delta;
+
+        if (mysql_stmt_bind_param(stmt.get(), bind) != 0) {
+            Logger::error("Failed to bind parameters: " + std::string(mysql_stmt_error(stmt.get())));
+            return false;
+        }
+
+        if (stmt.execute() != 0) {
+            Logger::error("Failed to execute statement: " + std::string(mysql_stmt_error(stmt.get())));
+            return false;
+        }
+
+        return true;
+
+    } catch (const std::exception& e) {
+        Logger::error("Exception in UserStatsRepository::adjustColumn: " + std::string(e.what()));
+        return false;
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file user_stats_repository.h
+ * @brief 用户统计物化表数据访问层定义
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "models/user_stats.h"
+#include <mysql/mysql.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/**
+ * @brief 用户统计数据访问类
+ *
+ * 负责 user_stats 表的读取和增量更新。
+ * 所有更新方法都接受调用方的连接，以便与业务写操作放在同一事务中。
+ */
+class UserStatsRepository {
+public:
+    /**
+     * @brief 构造函数
+     */
+    UserStatsRepository() = default;
+
+    /**
+     * @brief 析构函数
+     */
+    ~UserStatsRepository() = default;
+
+    /**
+     * @brief 根据用户业务ID读取统计行
+     * @param conn MySQL连接
+     * @param userId 用户业务ID
+     * @return 统计信息（用户不存在或统计行尚未创建返回std::nullopt）
+     */
+    std::optional<UserStats> findByUserId(MYSQL* conn, const std::string& userId);
+
+    /**
+     * @brief 读取用户帖子数
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @return 帖子数；统计行不存在返回-1
+     */
+    int getPostCount(MYSQL* conn, int64_t userId);
+
+    /**
+     * @brief 调整用户帖子数
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @param delta 变化量
+     * @return 成功返回true，失败返回false
+     */
+    bool adjustPostCount(MYSQL* conn, int64_t userId, int delta);
+
+    /**
+     * @brief 调整用户粉丝数
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @param delta 变化量
+     * @return 成功返回true，失败返回false
+     */
+    bool adjustFollowerCount(MYSQL* conn, int64_t userId, int delta);
+
+    /**
+     * @brief 调整用户关注数
+     * @param conn MySQL连接
+     * @param userId 用户物理ID
+     * @param delta 变化量
+     * @return 成功返回true，失败返回false
+     */
+    bool adjustFollowingCount(MYSQL* conn, int64_t userId, int delta);
+
+    /**
+     * @brief 调整用户获赞数
+     * @param conn MySQL连接
+     * @param userId 用户物理ID（帖子作者）
+     * @param delta 变化量
+     * @return 成功返回true，失败返回false
+     */
+    bool adjustTotalLikes(MYSQL* conn, int64_t userId, int delta);
+
+    /**
+     * @brief 调整用户被收藏数
+     * @param conn MySQL连接
+     * @param userId 用户物理ID（帖子作者）
+     * @param delta 变化量
+     * @return 成功返回true，失败返回false
+     */
+    bool adjustTotalFavorites(MYSQL* conn, int64_t userId, int delta);
+
+private:
+    /**
+     * @brief 对指定列执行 UPSERT 增量更新
+     * @param conn MySQL连接
+     * @param column 列名（仅限内部常量）
+     * @param userId 用户物理ID
+     * @param delta 变化量
+     * @return 成功返回true，失败返回false
+     */
+    bool adjustColumn(MYSQL* conn, const char* column, int64_t userId, int delta);
+};
@@ -2,6 +2,7 @@
 // Knot Team
 
 #include <iostream>
+#include <algorithm>
 #include <memory>
 #include <signal.h>
 
@@ -12,6 +13,9 @@
 // 项目头文件
 #include "utils/config_manager.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
+#include "core/count_service.h"
+#include "core/feed_service.h"
 #include "server/http_server.h"
 #include "database/connection_pool.h"
 
@@ -28,8 +32,15 @@ void signalHandler(int signal) {
     if (g_server) {
         g_server->stop();
     }
+
+    // 计数刷新任务引用服务的仓储、时间线裁剪线程使用连接池，必须在 exit() 析构服务和静态对象之前停止
+    CountService::getInstance().shutdown();
+    FeedService::getInstance().shutdown();
     
     Logger::info("服务器已成功停止");
+    // 导出队列中剩余的 trace，再写出异步队列中剩余的日志
+    Tracer::getInstance().shutdown();
+    Logger::shutdown();
     exit(0);
 }
 
@@ -91,12 +102,28 @@ int main(int argc, char* argv[]) {
         else if (logLevelStr == "error") logLevel = LogLevel::ERROR;
         else if (logLevelStr == "fatal") logLevel = LogLevel::FATAL;
 
-        if (!Logger::initialize(logFile, logLevel, consoleOutput)) {
+        // 异步日志：日志调用只格式化并入队，由后台线程写入各输出端
+        AsyncLogOptions asyncOptions;
+        asyncOptions.enabled = config.get<bool>("logging.async.enabled", false);
+        asyncOptions.queueSize = static_cast<size_t>(std::max(1, config.get<int>("logging.async.queue_size", 8192)));
+        asyncOptions.overflowPolicy = config.get<std::string>("logging.async.overflow_policy", "block") == "drop_oldest"
+            ? AsyncOverflowPolicy::DROP_OLDEST : AsyncOverflowPolicy::BLOCK;
+
+        if (!Logger::initialize(logFile, logLevel, consoleOutput, asyncOptions)) {
             std::cerr << "初始化日志系统失败" << std::endl;
             return 1;
         }
 
+        // 访问日志（未配置文件时写入主日志）
+        if (!Logger::initializeAccessLog(config.get<std::string>("logging.access_log.file", ""))) {
+            std::cerr << "初始化访问日志失败" << std::endl;
+            return 1;
+        }
+
         Logger::info("配置文件加载成功");
+
+        // 链路追踪（tracing.enabled 为 false 时不做任何事）
+        Tracer::getInstance().initialize();
         Logger::info("正在初始化 Knot 图片分享服务...");
         
         // 初始化数据库连接池
@@ -13,7 +13,8 @@ UserStats::UserStats()
     , followingCount_(0)
     , followerCount_(0)
     , postCount_(0)
-    , totalLikes_(0) {
+    , totalLikes_(0)
+    , totalFavorites_(0) {
 }
 
 // 带参数的构造函数
@@ -23,7 +24,8 @@ UserStats::UserStats(const std::string& userId, int followingCount, int follower
     , followingCount_(followingCount)
     , followerCount_(followerCount)
     , postCount_(postCount)
-    , totalLikes_(totalLikes) {
+    , totalLikes_(totalLikes)
+    , totalFavorites_(0) {
 }
 
 // 将统计信息转换为JSON
@@ -34,6 +36,7 @@ Json::Value UserStats::toJson() const {
     json["follower_count"] = followerCount_;
     json["post_count"] = postCount_;
     json["total_likes"] = totalLikes_;
+    json["total_favorites"] = totalFavorites_;
     return json;
 }
 
@@ -13,7 +13,7 @@
 /**
  * @brief 用户统计信息模型类
  *
- * 用于返回用户的统计数据，包括关注数、粉丝数、帖子数等
+ * 用于返回用户的统计数据，包括关注数、粉丝数、帖子数、获赞数、被收藏数等
  * 主要用于用户主页展示和API响应
  */
 class UserStats {
@@ -45,6 +45,7 @@ public:
     int getFollowerCount() const { return followerCount_; }
     int getPostCount() const { return postCount_; }
     int getTotalLikes() const { return totalLikes_; }
+    int getTotalFavorites() const { return totalFavorites_; }
 
     // Setters
     void setUserId(const std::string& userId) { userId_ = userId; }
@@ -52,6 +53,7 @@ public:
     void setFollowerCount(int count) { followerCount_ = count; }
     void setPostCount(int count) { postCount_ = count; }
     void setTotalLikes(int likes) { totalLikes_ = likes; }
+    void setTotalFavorites(int favorites) { totalFavorites_ = favorites; }
 
     /**
      * @brief 将统计信息转换为JSON
@@ -65,6 +67,7 @@ private:
     int followerCount_;         // 粉丝数（关注我的人数）
     int postCount_;             // 帖子总数
     int totalLikes_;            // 获赞总数（所有帖子的点赞数总和）
+    int totalFavorites_;        // 被收藏总数（所有帖子的收藏数总和）
 };
 
 
@@ -0,0 +1,213 @@
+/**
+ * @file admission_controller.cpp
+ * @brief 请求准入控制实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/admission_controller.h"
+#include "server/worker_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+
+// 排队时间分布的桶上界（毫秒）
+constexpr double kWaitBucketsMs[] = {1, 5, 10, 50, 100, 500, 1000};
+constexpr int kWaitBucketCount = sizeof(kWaitBucketsMs) / sizeof(kWaitBucketsMs[0]);
+
+const char* kPriorityNames[] = {"critical", "high", "normal", "low"};
+
+bool startsWith(const std::string& s, const char* prefix) {
+    return s.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+
+}  // namespace
+
+// 构造函数
+AdmissionController::AdmissionController(int maxConcurrent, int maxQueue,
+                                         const int (&timeoutMs)[kPriorityCount])
+    : maxConcurrent_(maxConcurrent > 0 ? maxConcurrent : 1)
+    , maxQueue_(maxQueue > 0 ? maxQueue : 0)
+    , inFlight_(0)
+    , queued_(0)
+    , serviceTimeEwmaMs_(0.0) {
+    for (int i = 0; i < kPriorityCount; ++i) {
+        timeoutMs_[i] = timeoutMs[i] > 0 ? timeoutMs[i] : 0;
+    }
+}
+
+// 按路由确定优先级
+AdmissionController::Priority AdmissionController::classify(const httplib::Request& req) {
+    const std::string& path = req.path;
+
+    if (path == "/health" || path == "/metrics") {
+        return Priority::Critical;
+    }
+    if (CpuLane::isCpuHeavy(req)) {
+        return Priority::Low;
+    }
+    if (startsWith(path, "/api/v1/auth/") || startsWith(path, "/api/v1/feed/") ||
+        (req.method == "GET" && path == "/api/v1/posts")) {
+        return Priority::High;
+    }
+    return Priority::Normal;
+}
+
+// 申请准入
+std::unique_ptr<AdmissionController::Ticket> AdmissionController::admit(Priority priority, int& retryAfterSeconds) {
+    int p = static_cast<int>(priority);
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (priority == Priority::Critical) {
+        stats_[p].admitted++;
+        return std::make_unique<Ticket>(*this, false);
+    }
+
+    // 有空闲名额且没有同级或更高优先级的请求在排队：直接放行
+    bool aheadWaiting = false;
+    for (int i = 0; i <= p; ++i) {
+        if (!queues_[i].empty()) {
+            aheadWaiting = true;
+            break;
+        }
+    }
+    if (inFlight_ < maxConcurrent_ && !aheadWaiting) {
+        inFlight_++;
+        recordWaitLocked(priority, 0.0);
+        return std::make_unique<Ticket>(*this, true);
+    }
+
+    // 队列已满或预计排队时间超过截止时间：提前拒绝
+    double estimatedMs = estimateWaitMsLocked(priority);
+    if (queued_ >= maxQueue_ || estimatedMs > timeoutMs_[p]) {
+        stats_[p].rejected++;
+        retryAfterSeconds = retryAfterLocked(estimatedMs);
+        return nullptr;
+    }
+
+    auto waiter = std::make_shared<Waiter>();
+    queues_[p].push_back(waiter);
+    queued_++;
+
+    auto start = std::chrono::steady_clock::now();
+    waiter->condition.wait_for(lock, std::chrono::milliseconds(timeoutMs_[p]),
+                               [&waiter] { return waiter->granted; });
+    double waitedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (!waiter->granted) {
+        auto& queue = queues_[p];
+        queue.erase(std::remove(queue.begin(), queue.end(), waiter), queue.end());
+        queued_--;
+        stats_[p].rejected++;
+        retryAfterSeconds = retryAfterLocked(estimateWaitMsLocked(priority));
+        return nullptr;
+    }
+
+    // 名额已由释放方转交（inFlight_ 不变，queued_ 已减）
+    recordWaitLocked(priority, waitedMs);
+    return std::make_unique<Ticket>(*this, true);
+}
+
+// 释放名额
+void AdmissionController::release(bool counted, std::chrono::steady_clock::time_point start) {
+    if (!counted) {
+        return;
+    }
+
+    double serviceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    serviceTimeEwmaMs_ = serviceTimeEwmaMs_ == 0.0 ? serviceMs : serviceTimeEwmaMs_ * 0.8 + serviceMs * 0.2;
+
+    // 名额直接转交给优先级最高的等待者
+    for (int i = 0; i < kPriorityCount; ++i) {
+        if (!queues_[i].empty()) {
+            auto waiter = queues_[i].front();
+            queues_[i].pop_front();
+            queued_--;
+            waiter->granted = true;
+            waiter->condition.notify_one();
+            return;
+        }
+    }
+
+    if (inFlight_ > 0) {
+        inFlight_--;
+    }
+}
+
+// 估算排队时间（调用方需持有锁）
+double AdmissionController::estimateWaitMsLocked(Priority priority) const {
+    size_t ahead = 0;
+    for (int i = 0; i <= static_cast<int>(priority); ++i) {
+        ahead += queues_[i].size();
+    }
+    return static_cast<double>(ahead + 1) * serviceTimeEwmaMs_ / maxConcurrent_;
+}
+
+// 计算建议的重试间隔（调用方需持有锁）
+int AdmissionController::retryAfterLocked(double estimatedWaitMs) const {
+    double ms = std::max(estimatedWaitMs, serviceTimeEwmaMs_);
+    int seconds = static_cast<int>(std::ceil(ms / 1000.0));
+    return std::min(std::max(seconds, 1), 30);
+}
+
+// 记录排队时间（调用方需持有锁）
+void AdmissionController::recordWaitLocked(Priority priority, double waitMs) {
+    WaitStats& s = stats_[static_cast<int>(priority)];
+    s.admitted++;
+    s.waitCount++;
+    s.waitTotalMs += waitMs;
+    s.waitMaxMs = std::max(s.waitMaxMs, waitMs);
+
+    int bucket = kWaitBucketCount;
+    for (int i = 0; i < kWaitBucketCount; ++i) {
+        if (waitMs <= kWaitBucketsMs[i]) {
+            bucket = i;
+            break;
+        }
+    }
+    s.buckets[bucket]++;
+}
+
+// 获取统计信息
+Json::Value AdmissionController::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Json::Value stats;
+    stats["max_concurrent"] = maxConcurrent_;
+    stats["max_queue"] = maxQueue_;
+    stats["in_flight"] = inFlight_;
+    stats["queued"] = queued_;
+    stats["service_time_ewma_ms"] = serviceTimeEwmaMs_;
+
+    Json::Value priorities;
+    for (int i = 0; i < kPriorityCount; ++i) {
+        const WaitStats& s = stats_[i];
+        Json::Value item;
+        item["admitted"] = static_cast<Json::UInt64>(s.admitted);
+        item["rejected"] = static_cast<Json::UInt64>(s.rejected);
+        item["queue_timeout_ms"] = timeoutMs_[i];
+
+        Json::Value wait;
+        wait["count"] = static_cast<Json::UInt64>(s.waitCount);
+        wait["avg_ms"] = s.waitCount > 0 ? s.waitTotalMs / static_cast<double>(s.waitCount) : 0.0;
+        wait["max_ms"] = s.waitMaxMs;
+
+        Json::Value buckets;
+        for (int b = 0; b < kWaitBucketCount; ++b) {
+            buckets["le_" + std::to_string(static_cast<int>(kWaitBucketsMs[b])) + "ms"] =
+                static_cast<Json::UInt64>(s.buckets[b]);
+        }
+        buckets["gt_" + std::to_string(static_cast<int>(kWaitBucketsMs[kWaitBucketCount - 1])) + "ms"] =
+            static_cast<Json::UInt64>(s.buckets[kWaitBucketCount]);
+        wait["buckets"] = buckets;
+
+        item["queue_wait"] = wait;
+        priorities[kPriorityNames[i]] = item;
+    }
+    stats["priorities"] = priorities;
+    return stats;
+}
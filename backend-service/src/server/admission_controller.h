@@ -0,0 +1,143 @@
+/**
+ * @file admission_controller.h
+ * @brief 请求准入控制（按路由优先级排队、截止时间、过载时提前拒绝）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "httplib.h"
+#include <json/json.h>
+
+/**
+ * @brief 请求准入控制器
+ *
+ * 同时执行的请求数限制为 maxConcurrent，其余请求按优先级进入有界等待队列：
+ * - Critical：/health、/metrics，不受限制，直接放行
+ * - High：认证、关注时间线、帖子列表
+ * - Normal：其他接口
+ * - Low：上传和图片处理
+ *
+ * 名额释放时优先唤醒高优先级的等待者（同优先级先到先得）。
+ * 请求进入队列前先按 EWMA 平均处理时间估算排队时间，估算值超过该优先级的
+ * 截止时间或队列已满时直接返回503（附 Retry-After），不让客户端等到超时。
+ */
+class AdmissionController {
+public:
+    /**
+     * @brief 请求优先级（数值越小越优先）
+     */
+    enum class Priority {
+        Critical = 0,
+        High = 1,
+        Normal = 2,
+        Low = 3
+    };
+
+    static constexpr int kPriorityCount = 4;
+
+    /**
+     * @brief 准入凭证（RAII，析构时释放名额）
+     */
+    class Ticket {
+    public:
+        Ticket(AdmissionController& controller, bool counted)
+            : controller_(controller), counted_(counted), start_(std::chrono::steady_clock::now()) {}
+        ~Ticket() { controller_.release(counted_, start_); }
+
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+    private:
+        AdmissionController& controller_;
+        bool counted_;          // 是否占用并发名额（Critical 不占用）
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    /**
+     * @brief 构造函数
+     * @param maxConcurrent 同时执行的请求数上限
+     * @param maxQueue 等待队列上限
+     * @param timeoutMs 各优先级的排队截止时间（毫秒，下标为 Priority）
+     */
+    AdmissionController(int maxConcurrent, int maxQueue, const int (&timeoutMs)[kPriorityCount]);
+
+    /**
+     * @brief 按请求方法和路径确定优先级（此时尚未读取请求体）
+     * @param req HTTP请求
+     * @return 优先级
+     */
+    static Priority classify(const httplib::Request& req);
+
+    /**
+     * @brief 申请准入
+     * @param priority 请求优先级
+     * @param retryAfterSeconds 输出：被拒绝时建议的重试间隔（秒）
+     * @return 成功返回凭证；被拒绝返回nullptr
+     */
+    std::unique_ptr<Ticket> admit(Priority priority, int& retryAfterSeconds);
+
+    /**
+     * @brief 获取统计信息（含排队等待时间分布）
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+private:
+    /**
+     * @brief 等待中的请求
+     */
+    struct Waiter {
+        std::condition_variable condition;
+        bool granted = false;
+    };
+
+    /**
+     * @brief 单个优先级的排队统计
+     */
+    struct WaitStats {
+        uint64_t admitted = 0;
+        uint64_t rejected = 0;
+        uint64_t waitCount = 0;         // 记录了排队时间的请求数
+        double waitTotalMs = 0.0;
+        double waitMaxMs = 0.0;
+        uint64_t buckets[8] = {0};      // 排队时间分布（见 kWaitBucketsMs，最后一格为溢出）
+    };
+
+    /**
+     * @brief 释放名额，唤醒优先级最高的等待者
+     */
+    void release(bool counted, std::chrono::steady_clock::time_point start);
+
+    /**
+     * @brief 估算新请求的排队时间（调用方需持有锁）
+     */
+    double estimateWaitMsLocked(Priority priority) const;
+
+    /**
+     * @brief 计算建议的重试间隔（调用方需持有锁）
+     */
+    int retryAfterLocked(double estimatedWaitMs) const;
+
+    /**
+     * @brief 记录一次排队时间（调用方需持有锁）
+     */
+    void recordWaitLocked(Priority priority, double waitMs);
+
+    mutable std::mutex mutex_;
+    std::deque<std::shared_ptr<Waiter>> queues_[kPriorityCount];
+    WaitStats stats_[kPriorityCount];
+    int maxConcurrent_;
+    int maxQueue_;
+    int timeoutMs_[kPriorityCount];
+    int inFlight_;
+    int queued_;
+    double serviceTimeEwmaMs_;      // 请求平均处理时间（指数加权）
+};
@@ -0,0 +1,116 @@
+/**
+ * @file connection_stats.cpp
+ * @brief 连接复用统计实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/connection_stats.h"
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// 每连接请求数分布的桶上界
+constexpr uint64_t kRequestBuckets[] = {1, 2, 5, 10, 20, 50, 100};
+
+thread_local uint64_t currentRequests = 0;
+
+}  // namespace
+
+// 构造函数
+ConnectionStats::ConnectionStats()
+    : opened_(0)
+    , closed_(0)
+    , requestsOnClosed_(0)
+    , maxRequests_(0)
+    , pipelined_(0) {
+    std::fill(std::begin(buckets_), std::end(buckets_), 0);
+    openedPerSecond_.fill(0);
+    slotSecond_.fill(0);
+}
+
+// 记录新建连接
+void ConnectionStats::onOpened() {
+    std::time_t now = std::time(nullptr);
+    size_t slot = static_cast<size_t>(now % kRateWindow);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    opened_++;
+    if (slotSecond_[slot] != now) {
+        slotSecond_[slot] = now;
+        openedPerSecond_[slot] = 0;
+    }
+    openedPerSecond_[slot]++;
+}
+
+// 记录连接关闭
+void ConnectionStats::onClosed(uint64_t requests) {
+    int bucket = kBucketCount;
+    for (int i = 0; i < kBucketCount; ++i) {
+        if (requests <= kRequestBuckets[i]) {
+            bucket = i;
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_++;
+    requestsOnClosed_ += requests;
+    maxRequests_ = std::max(maxRequests_, requests);
+    buckets_[bucket]++;
+}
+
+// 当前线程请求数加一
+void ConnectionStats::countRequest() {
+    currentRequests++;
+}
+
+// 取出并清零当前线程的请求计数
+uint64_t ConnectionStats::takeRequestCount() {
+    uint64_t count = currentRequests;
+    currentRequests = 0;
+    return count;
+}
+
+// 获取统计信息
+Json::Value ConnectionStats::getStats() const {
+    std::time_t now = std::time(nullptr);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Json::Value stats;
+    stats["opened"] = static_cast<Json::UInt64>(opened_);
+    stats["closed"] = static_cast<Json::UInt64>(closed_);
+    stats["open"] = static_cast<Json::UInt64>(opened_ - closed_);
+    stats["pipelined_requests"] = static_cast<Json::UInt64>(pipelined_.load());
+
+    // 每秒新建连接数：上一整秒和最近一分钟平均
+    uint64_t lastSecond = 0;
+    uint64_t window = 0;
+    for (int i = 0; i < kRateWindow; ++i) {
+        std::time_t age = now - slotSecond_[i];
+        if (age >= 1 && age <= kRateWindow) {
+            window += openedPerSecond_[i];
+        }
+        if (age == 1) {
+            lastSecond = openedPerSecond_[i];
+        }
+    }
+    Json::Value rate;
+    rate["last_1s"] = static_cast<Json::UInt64>(lastSecond);
+    rate["avg_60s"] = static_cast<double>(window) / kRateWindow;
+    stats["opened_per_second"] = rate;
+
+    // 每连接请求数
+    Json::Value perConnection;
+    perConnection["avg"] = closed_ > 0 ? static_cast<double>(requestsOnClosed_) / static_cast<double>(closed_) : 0.0;
+    perConnection["max"] = static_cast<Json::UInt64>(maxRequests_);
+    Json::Value buckets;
+    for (int i = 0; i < kBucketCount; ++i) {
+        buckets["le_" + std::to_string(kRequestBuckets[i])] = static_cast<Json::UInt64>(buckets_[i]);
+    }
+    buckets["gt_" + std::to_string(kRequestBuckets[kBucketCount - 1])] = static_cast<Json::UInt64>(buckets_[kBucketCount]);
+    perConnection["buckets"] = buckets;
+    stats["requests_per_connection"] = perConnection;
+    return stats;
+}
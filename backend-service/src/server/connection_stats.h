@@ -0,0 +1,80 @@
+/**
+ * @file connection_stats.h
+ * @brief 连接复用统计（每连接请求数、每秒新建连接数）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <json/json.h>
+
+/**
+ * @brief 连接复用统计
+ *
+ * 用于衡量 keep-alive 的效果：客户端加载 feed 后连续请求几十张缩略图，
+ * 如果每个连接只承载一两个请求，TCP/TLS 握手开销就会占主导。
+ * - threaded 后端：WorkerPool 每个任务对应一个连接，请求数由 pre_routing_handler
+ *   通过 countRequest() 记在当前线程上，任务结束时 takeRequestCount() 取出
+ * - epoll 后端：EpollServer 在接受/关闭连接时直接上报 Connection::requestCount
+ */
+class ConnectionStats {
+public:
+    ConnectionStats();
+
+    /**
+     * @brief 记录新建连接
+     */
+    void onOpened();
+
+    /**
+     * @brief 记录连接关闭
+     * @param requests 该连接上处理的请求数
+     */
+    void onClosed(uint64_t requests);
+
+    /**
+     * @brief 记录一个流水线请求（上一个响应写完时已在缓冲区中）
+     */
+    void onPipelined() { pipelined_++; }
+
+    /**
+     * @brief 当前线程正在处理的连接上的请求数加一
+     */
+    static void countRequest();
+
+    /**
+     * @brief 取出并清零当前线程的请求计数
+     * @return 请求数
+     */
+    static uint64_t takeRequestCount();
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    ConnectionStats(const ConnectionStats&) = delete;
+    ConnectionStats& operator=(const ConnectionStats&) = delete;
+
+private:
+    static constexpr int kBucketCount = 7;      // 每连接请求数分布：le_1 ... le_100, gt_100
+    static constexpr int kRateWindow = 60;      // 每秒新建连接数统计窗口（秒）
+
+    mutable std::mutex mutex_;
+    uint64_t opened_;
+    uint64_t closed_;
+    uint64_t requestsOnClosed_;                 // 已关闭连接上的请求总数
+    uint64_t maxRequests_;                      // 单个连接的最大请求数
+    uint64_t buckets_[kBucketCount + 1];
+    std::array<uint64_t, kRateWindow> openedPerSecond_;
+    std::array<std::time_t, kRateWindow> slotSecond_;
+    std::atomic<uint64_t> pipelined_;
+};
@@ -0,0 +1,614 @@
+/**
+ * @file epoll_server.cpp
+ * @brief 基于 epoll 事件循环的 HTTP 服务器后端实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/epoll_server.h"
+#include "server/sendfile_channel.h"
+#include "server/connection_stats.h"
+#include "server/request_framing.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// 单次 epoll_wait 返回的最大事件数
+constexpr int kMaxEvents = 256;
+
+// 事件循环超时（毫秒），同时也是空闲连接清理的间隔
+constexpr int kLoopTimeoutMs = 1000;
+
+// 尽力写出一段原始响应（用于事件循环直接拒绝的请求）
+void sendRawResponse(int fd, const char* response) {
+    ssize_t ret = ::send(fd, response, strlen(response), MSG_NOSIGNAL);
+    (void)ret;
+}
+
+// 读取套接字地址
+void getAddress(const sockaddr_storage& addr, socklen_t len, std::string& ip, int& port) {
+    char host[NI_MAXHOST];
+    char serv[NI_MAXSERV];
+    if (getnameinfo(reinterpret_cast<const sockaddr*>(&addr), len, host, sizeof(host),
+                    serv, sizeof(serv), NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
+        ip = host;
+        port = std::atoi(serv);
+    }
+}
+
+}  // namespace
+
+// ==================== BufferedStream ====================
+
+/**
+ * @brief 为 httplib::process_request 提供的流：读取已缓存的完整请求，写入连接套接字
+ */
+class EpollServer::BufferedStream : public httplib::Stream {
+public:
+    BufferedStream(const Connection& conn, std::string data, time_t writeTimeoutSec, time_t writeTimeoutUsec)
+        : conn_(conn)
+        , data_(std::move(data))
+        , pos_(0)
+        , writeTimeoutMs_(static_cast<int>(writeTimeoutSec * 1000 + writeTimeoutUsec / 1000))
+        , start_(std::chrono::steady_clock::now()) {
+    }
+
+    bool is_readable() const override { return pos_ < data_.size(); }
+
+    bool wait_readable() const override { return is_readable(); }
+
+    bool wait_writable() const override {
+        pollfd pfd{conn_.fd, POLLOUT, 0};
+        return ::poll(&pfd, 1, writeTimeoutMs_) > 0 && (pfd.revents & POLLOUT);
+    }
+
+    ssize_t read(char* ptr, size_t size) override {
+        size_t n = std::min(size, data_.size() - pos_);
+        if (n > 0) {
+            memcpy(ptr, data_.data() + pos_, n);
+            pos_ += n;
+        }
+        return static_cast<ssize_t>(n);
+    }
+
+    // 套接字为非阻塞模式，发送缓冲区满时等待可写（受 write_timeout 限制）
+    ssize_t write(const char* ptr, size_t size) override {
+        // 文件数据已由 content provider 通过 sendfile 直接发送，这里只推进偏移
+        size_t written = SendfileChannel::consumeSent(size);
+        while (written < size) {
+            ssize_t n = ::send(conn_.fd, ptr + written, size - written, MSG_NOSIGNAL);
+            if (n > 0) {
+                written += static_cast<size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (!wait_writable()) {
+                    return -1;
+                }
+            } else {
+                return -1;
+            }
+        }
+        return static_cast<ssize_t>(written);
+    }
+
+    void get_remote_ip_and_port(std::string& ip, int& port) const override {
+        ip = conn_.remoteAddr;
+        port = conn_.remotePort;
+    }
+
+    void get_local_ip_and_port(std::string& ip, int& port) const override {
+        ip = conn_.localAddr;
+        port = conn_.localPort;
+    }
+
+    socket_t socket() const override { return conn_.fd; }
+
+    time_t duration() const override {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    const Connection& conn_;
+    std::string data_;
+    size_t pos_;
+    int writeTimeoutMs_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// ==================== EpollServer ====================
+
+EpollServer::EpollServer()
+    : listenFd_(-1)
+    , running_(false)
+    , stopping_(false)
+    , ioThreads_(0)
+    , nextReactor_(0)
+    , maxPipelineDepth_(16)
+    , accepted_(0)
+    , requests_(0)
+    , idleClosed_(0)
+    , rejected_(0)
+    , pipelined_(0)
+    , pipelineYields_(0)
+    , openConnections_(0) {
+}
+
+EpollServer::~EpollServer() {
+    stopEventLoop();
+}
+
+// 监听并运行事件循环
+bool EpollServer::listenEventLoop(const std::string& host, int port, int ioThreads) {
+    listenFd_ = createListenSocket(host, port);
+    if (listenFd_ < 0) {
+        return false;
+    }
+
+    if (ioThreads < 1) {
+        ioThreads = 1;
+    }
+
+    // httplib 以 svr_sock_ 判断服务器是否在关闭，content provider 的写出循环依赖它
+    svr_sock_ = listenFd_;
+
+    stopping_ = false;
+    ioThreads_ = static_cast<size_t>(ioThreads);
+    taskQueue_.reset(new_task_queue());
+
+    for (int i = 0; i < ioThreads; ++i) {
+        auto reactor = std::make_unique<Reactor>();
+        reactor->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        reactor->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = reactor->wakeFd;
+        epoll_ctl(reactor->epollFd, EPOLL_CTL_ADD, reactor->wakeFd, &ev);
+        reactors_.push_back(std::move(reactor));
+    }
+
+    // 监听套接字只注册在第一个 I/O 线程上，新连接轮询分配
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd_;
+    epoll_ctl(reactors_[0]->epollFd, EPOLL_CTL_ADD, listenFd_, &ev);
+
+    for (size_t i = 0; i < reactors_.size(); ++i) {
+        reactors_[i]->thread = std::thread(&EpollServer::reactorLoop, this, i);
+    }
+
+    running_ = true;
+    Logger::info("Epoll event loop listening on " + host + ":" + std::to_string(port) +
+                " (io_threads=" + std::to_string(ioThreads) + ")");
+
+    {
+        std::unique_lock<std::mutex> lock(stopMutex_);
+        stopCondition_.wait(lock, [this] { return stopping_.load(); });
+    }
+
+    // 先停 I/O 线程，再等待工作线程处理完已分派的请求，最后关闭所有连接
+    for (auto& reactor : reactors_) {
+        if (reactor->thread.joinable()) {
+            reactor->thread.join();
+        }
+    }
+    taskQueue_->shutdown();
+    taskQueue_.reset();
+
+    for (auto& reactor : reactors_) {
+        std::lock_guard<std::mutex> lock(reactor->mutex);
+        for (auto& item : reactor->connections) {
+            ::close(item.first);
+        }
+        reactor->connections.clear();
+        ::close(reactor->wakeFd);
+        ::close(reactor->epollFd);
+    }
+    reactors_.clear();
+    openConnections_ = 0;
+
+    svr_sock_ = INVALID_SOCKET;
+    ::close(listenFd_);
+    listenFd_ = -1;
+    ioThreads_ = 0;
+    running_ = false;
+    return true;
+}
+
+// 停止事件循环
+void EpollServer::stopEventLoop() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        if (stopping_ || !running_) {
+            return;
+        }
+        stopping_ = true;
+
+        // 持锁唤醒：listenEventLoop 拿到锁之后才会回收 reactors_
+        for (auto& reactor : reactors_) {
+            uint64_t one = 1;
+            ssize_t ret = ::write(reactor->wakeFd, &one, sizeof(one));
+            (void)ret;
+        }
+    }
+    stopCondition_.notify_all();
+}
+
+// 设置连接复用统计
+void EpollServer::setConnectionStats(std::shared_ptr<ConnectionStats> stats) {
+    connectionStats_ = std::move(stats);
+}
+
+// 设置单次调度最多处理的流水线请求数
+void EpollServer::setMaxPipelineDepth(size_t depth) {
+    maxPipelineDepth_ = depth > 0 ? depth : 1;
+}
+
+// 获取统计信息
+Json::Value EpollServer::getStats() const {
+    Json::Value stats;
+    stats["io_threads"] = static_cast<Json::UInt64>(ioThreads_.load());
+    stats["open_connections"] = static_cast<Json::Int64>(openConnections_.load());
+    stats["accepted"] = static_cast<Json::UInt64>(accepted_.load());
+    stats["requests"] = static_cast<Json::UInt64>(requests_.load());
+    stats["idle_closed"] = static_cast<Json::UInt64>(idleClosed_.load());
+    stats["rejected"] = static_cast<Json::UInt64>(rejected_.load());
+    stats["max_pipeline_depth"] = static_cast<Json::UInt64>(maxPipelineDepth_);
+    stats["pipelined"] = static_cast<Json::UInt64>(pipelined_.load());
+    stats["pipeline_yields"] = static_cast<Json::UInt64>(pipelineYields_.load());
+    return stats;
+}
+
+// 创建非阻塞监听套接字
+int EpollServer::createListenSocket(const std::string& host, int port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    addrinfo* result = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0) {
+        Logger::error("Failed to resolve listen address: " + host);
+        return -1;
+    }
+
+    int fd = -1;
+    for (addrinfo* rp = result; rp != nullptr; rp = rp->ai_next) {
+        fd = ::socket(rp->ai_family, rp->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, rp->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        int yes = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+        if (::bind(fd, rp->ai_addr, rp->ai_addrlen) == 0 &&
+            ::listen(fd, CPPHTTPLIB_LISTEN_BACKLOG) == 0) {
+            break;
+        }
+
+        ::close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd < 0) {
+        Logger::error("Failed to bind " + host + ":" + std::to_string(port) + ": " + strerror(errno));
+    }
+    return fd;
+}
+
+// I/O 线程主循环
+void EpollServer::reactorLoop(size_t index) {
+    Reactor& reactor = *reactors_[index];
+    epoll_event events[kMaxEvents];
+    std::time_t lastSweep = std::time(nullptr);
+
+    while (!stopping_) {
+        int n = epoll_wait(reactor.epollFd, events, kMaxEvents, kLoopTimeoutMs);
+        if (n < 0 && errno != EINTR) {
+            Logger::error("epoll_wait failed: " + std::string(strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == reactor.wakeFd) {
+                uint64_t value = 0;
+                ssize_t ret = ::read(reactor.wakeFd, &value, sizeof(value));
+                (void)ret;
+                continue;
+            }
+            if (fd == listenFd_) {
+                acceptConnections();
+                continue;
+            }
+
+            std::shared_ptr<Connection> conn;
+            {
+                std::lock_guard<std::mutex> lock(reactor.mutex);
+                auto it = reactor.connections.find(fd);
+                if (it == reactor.connections.end()) {
+                    continue;
+                }
+                conn = it->second;
+            }
+
+            if ((events[i].events & (EPOLLERR | EPOLLHUP)) && !(events[i].events & EPOLLIN)) {
+                std::lock_guard<std::mutex> lock(reactor.mutex);
+                closeConnectionLocked(reactor, fd);
+                continue;
+            }
+            onReadable(reactor, conn);
+        }
+
+        std::time_t now = std::time(nullptr);
+        if (now != lastSweep) {
+            sweepIdle(reactor, now);
+            lastSweep = now;
+        }
+    }
+}
+
+// 接受新连接
+void EpollServer::acceptConnections() {
+    while (true) {
+        sockaddr_storage addr{};
+        socklen_t len = sizeof(addr);
+        int fd = accept4(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                Logger::warning("accept4 failed: " + std::string(strerror(errno)));
+            }
+            return;
+        }
+
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+        auto conn = std::make_shared<Connection>();
+        conn->fd = fd;
+        conn->reactorIndex = nextReactor_++ % reactors_.size();
+        conn->remotePort = 0;
+        conn->localPort = 0;
+        conn->lastActive = std::time(nullptr);
+        conn->requestCount = 0;
+        conn->busy = false;
+        conn->continueSent = false;
+        getAddress(addr, len, conn->remoteAddr, conn->remotePort);
+
+        sockaddr_storage local{};
+        socklen_t localLen = sizeof(local);
+        if (getsockname(fd, reinterpret_cast<sockaddr*>(&local), &localLen) == 0) {
+            getAddress(local, localLen, conn->localAddr, conn->localPort);
+        }
+
+        Reactor& reactor = *reactors_[conn->reactorIndex];
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        reactor.connections.emplace(fd, conn);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.fd = fd;
+        if (epoll_ctl(reactor.epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            reactor.connections.erase(fd);
+            ::close(fd);
+            continue;
+        }
+
+        accepted_++;
+        openConnections_++;
+        if (connectionStats_) {
+            connectionStats_->onOpened();
+        }
+    }
+}
+
+// 处理可读事件（EPOLLONESHOT 保证同一连接不会被并发处理）
+void EpollServer::onReadable(Reactor& reactor, const std::shared_ptr<Connection>& conn) {
+    char buf[16384];
+    long length = RequestFraming::kIncomplete;
+    while (true) {
+        ssize_t n = ::recv(conn->fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            conn->buffer.append(buf, static_cast<size_t>(n));
+            // 每次追加后立即切分：已得出结果（完整请求或超限/非法）就停止读取，
+            // 缓冲区最多超出请求头上限或请求体上限一次 recv 的长度；
+            // 流水线中后续请求留在套接字里，处理完后重新注册时再读
+            length = conn->framing.scan(conn->buffer, payload_max_length_);
+            if (length != RequestFraming::kIncomplete) {
+                break;
+            }
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+
+        // 对端关闭或读取错误
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        closeConnectionLocked(reactor, conn->fd);
+        return;
+    }
+
+    conn->lastActive = std::time(nullptr);
+
+    if (length == RequestFraming::kIncomplete) {
+        // 请求头已完整但请求体未到：客户端可能在等待 100 Continue
+        // （httplib 处理请求时会再发送一次，HTTP/1.1 允许多个 1xx 响应）
+        if (!conn->continueSent && conn->framing.headerComplete() && conn->framing.expectsContinue()) {
+            sendRawResponse(conn->fd, "HTTP/1.1 100 Continue\r\n\r\n");
+            conn->continueSent = true;
+        }
+
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        rearmLocked(*conn);
+        return;
+    }
+
+    if (length < 0) {
+        sendRawResponse(conn->fd, length == RequestFraming::kTooLarge
+            ? "HTTP/1.1 413 Payload Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+            : "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        closeConnectionLocked(reactor, conn->fd);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        conn->busy = true;
+    }
+
+    if (!taskQueue_->enqueue([this, conn]() { processConnection(conn); })) {
+        rejected_++;
+        sendRawResponse(conn->fd,
+            "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        std::lock_guard<std::mutex> lock(reactor.mutex);
+        closeConnectionLocked(reactor, conn->fd);
+    }
+}
+
+// 在工作线程中处理缓冲区中的完整请求（支持流水线请求）
+void EpollServer::processConnection(std::shared_ptr<Connection> conn) {
+    Reactor& reactor = *reactors_[conn->reactorIndex];
+    size_t processed = 0;
+
+    while (true) {
+        // 第一个请求的结果已由 I/O 线程缓存，后续流水线请求从头切分
+        long length = conn->framing.scan(conn->buffer, payload_max_length_);
+        if (length == RequestFraming::kIncomplete) {
+            break;
+        }
+        if (length < 0) {
+            std::lock_guard<std::mutex> lock(reactor.mutex);
+            closeConnectionLocked(reactor, conn->fd);
+            return;
+        }
+
+        // 上一个响应写完时下一个请求已在缓冲区中：流水线请求
+        if (processed > 0) {
+            // 达到单次调度上限，连接放回任务队列末尾，让其他连接先处理
+            if (processed >= maxPipelineDepth_) {
+                pipelineYields_++;
+                if (!taskQueue_->enqueue([this, conn]() { processConnection(conn); })) {
+                    std::lock_guard<std::mutex> lock(reactor.mutex);
+                    closeConnectionLocked(reactor, conn->fd);
+                }
+                return;
+            }
+            pipelined_++;
+            if (connectionStats_) {
+                connectionStats_->onPipelined();
+            }
+        }
+
+        // 整个缓冲区交给请求流，只把其后的流水线数据复制回连接（通常为空），不复制请求体
+        std::string request;
+        request.swap(conn->buffer);
+        if (request.size() > static_cast<size_t>(length)) {
+            conn->buffer.assign(request, static_cast<size_t>(length), std::string::npos);
+            request.resize(static_cast<size_t>(length));
+        }
+        conn->framing.reset();
+        conn->continueSent = false;
+
+        bool closeAfter = stopping_ || conn->requestCount + 1 >= keep_alive_max_count_;
+        bool connectionClosed = false;
+
+        BufferedStream strm(*conn, std::move(request), write_timeout_sec_, write_timeout_usec_);
+        SendfileChannel::Scope sendfileScope(conn->fd,
+            static_cast<int>(write_timeout_sec_ * 1000 + write_timeout_usec_ / 1000));
+        bool ok = process_request(strm, conn->remoteAddr, conn->remotePort,
+                                  conn->localAddr, conn->localPort,
+                                  closeAfter, connectionClosed, nullptr);
+
+        conn->requestCount++;
+        conn->lastActive = std::time(nullptr);
+        requests_++;
+        processed++;
+
+        if (!ok || closeAfter || connectionClosed) {
+            std::lock_guard<std::mutex> lock(reactor.mutex);
+            closeConnectionLocked(reactor, conn->fd);
+            return;
+        }
+    }
+
+    // 交还给 I/O 线程等待下一个请求
+    std::lock_guard<std::mutex> lock(reactor.mutex);
+    conn->busy = false;
+    rearmLocked(*conn);
+}
+
+// 重新注册可读事件（调用方需持有锁）
+void EpollServer::rearmLocked(const Connection& conn) {
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.fd = conn.fd;
+    epoll_ctl(reactors_[conn.reactorIndex]->epollFd, EPOLL_CTL_MOD, conn.fd, &ev);
+}
+
+// 关闭连接（调用方需持有锁）
+void EpollServer::closeConnectionLocked(Reactor& reactor, int fd) {
+    auto it = reactor.connections.find(fd);
+    if (it == reactor.connections.end()) {
+        return;
+    }
+
+    if (connectionStats_) {
+        connectionStats_->onClosed(it->second->requestCount);
+    }
+
+    epoll_ctl(reactor.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    reactor.connections.erase(it);
+    openConnections_--;
+}
+
+// 关闭超时连接
+void EpollServer::sweepIdle(Reactor& reactor, std::time_t now) {
+    std::time_t idleLimit = keep_alive_timeout_sec_ > 0 ? keep_alive_timeout_sec_ : 1;
+    std::time_t readLimit = read_timeout_sec_ > 0 ? read_timeout_sec_ : 1;
+
+    std::lock_guard<std::mutex> lock(reactor.mutex);
+    std::vector<int> expired;
+    for (const auto& item : reactor.connections) {
+        const Connection& conn = *item.second;
+        if (conn.busy) {
+            continue;
+        }
+        // 没有未完成请求的连接按空闲超时，读到一半的请求按读取超时
+        std::time_t limit = conn.buffer.empty() ? idleLimit : readLimit;
+        if (now - conn.lastActive > limit) {
+            expired.push_back(item.first);
+        }
+    }
+
+    for (int fd : expired) {
+        closeConnectionLocked(reactor, fd);
+        idleClosed_++;
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file epoll_server.h
+ * @brief 基于 epoll 事件循环的 HTTP 服务器后端
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "httplib.h"
+#include "server/request_framing.h"
+#include <json/json.h>
+
+class ConnectionStats;
+
+/**
+ * @brief epoll 事件循环 HTTP 服务器
+ *
+ * 继承 httplib::Server，路由注册（各 Handler 的 registerRoutes）、中间件、
+ * 错误处理器和静态文件挂载点全部沿用，只替换连接处理模型：
+ * - I/O 线程用 epoll 管理非阻塞套接字，读取并切分出完整的 HTTP 请求
+ *   （请求头 + Content-Length 或 chunked 请求体）
+ * - 完整请求交给工作线程池（new_task_queue 创建的任务队列），
+ *   由 httplib 的 process_request 完成解析、路由和响应写出
+ * - 空闲的 keep-alive 连接只占用一个 epoll 注册项，不占用工作线程
+ *
+ * 请求体在 I/O 线程中整体缓存，受 payload_max_length 限制（HttpServer 按 server.max_body_mb 设置）；
+ * 请求边界由保存在连接上的 RequestFraming 增量切分，每次可读事件只扫描新到达的字节。
+ */
+class EpollServer : public httplib::Server {
+public:
+    EpollServer();
+    ~EpollServer() override;
+
+    /**
+     * @brief 监听端口并运行事件循环（阻塞直到 stopEventLoop）
+     * @param host 监听地址
+     * @param port 监听端口
+     * @param ioThreads I/O 线程数
+     * @return 正常停止返回true，监听失败返回false
+     */
+    bool listenEventLoop(const std::string& host, int port, int ioThreads);
+
+    /**
+     * @brief 停止事件循环并关闭所有连接
+     */
+    void stopEventLoop();
+
+    /**
+     * @brief 设置连接复用统计（listenEventLoop 之前调用）
+     * @param stats 统计对象
+     */
+    void setConnectionStats(std::shared_ptr<ConnectionStats> stats);
+
+    /**
+     * @brief 设置单次调度最多处理的流水线请求数
+     *
+     * 客户端流水线发送的请求在一次调度中连续处理，达到上限后把连接重新放回任务队列末尾，
+     * 避免单个连接长时间占用工作线程。
+     * （threaded 后端每个请求重新创建 SocketStream，已读入缓冲区的后续请求会丢失，不支持流水线）
+     *
+     * @param depth 请求数（至少为1）
+     */
+    void setMaxPipelineDepth(size_t depth);
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+private:
+    /**
+     * @brief 客户端连接
+     */
+    struct Connection {
+        int fd;
+        size_t reactorIndex;
+        std::string remoteAddr;
+        int remotePort;
+        std::string localAddr;
+        int localPort;
+        std::string buffer;         // 已读取但尚未处理的数据
+        RequestFraming framing;     // buffer 中第一个请求的增量切分状态
+        std::time_t lastActive;     // 最近一次读写时间
+        size_t requestCount;        // 已处理的请求数
+        bool busy;                  // 是否正在工作线程中处理
+        bool continueSent;          // 当前请求是否已回复 100 Continue
+    };
+
+    /**
+     * @brief 单个 I/O 线程（独立的 epoll 实例）
+     */
+    struct Reactor {
+        int epollFd = -1;
+        int wakeFd = -1;
+        std::thread thread;
+        std::mutex mutex;
+        std::unordered_map<int, std::shared_ptr<Connection>> connections;
+    };
+
+    class BufferedStream;
+
+    /**
+     * @brief 创建非阻塞监听套接字
+     * @return 套接字，失败返回-1
+     */
+    int createListenSocket(const std::string& host, int port);
+
+    /**
+     * @brief I/O 线程主循环
+     */
+    void reactorLoop(size_t index);
+
+    /**
+     * @brief 接受新连接并分配到各 I/O 线程
+     */
+    void acceptConnections();
+
+    /**
+     * @brief 处理连接可读事件
+     */
+    void onReadable(Reactor& reactor, const std::shared_ptr<Connection>& conn);
+
+    /**
+     * @brief 在工作线程中处理连接缓冲区中的完整请求
+     */
+    void processConnection(std::shared_ptr<Connection> conn);
+
+    /**
+     * @brief 重新注册连接的可读事件（EPOLLONESHOT，调用方需持有锁）
+     */
+    void rearmLocked(const Connection& conn);
+
+    /**
+     * @brief 关闭连接（调用方需持有锁）
+     */
+    void closeConnectionLocked(Reactor& reactor, int fd);
+
+    /**
+     * @brief 关闭超过空闲/读取超时的连接
+     */
+    void sweepIdle(Reactor& reactor, std::time_t now);
+
+    std::vector<std::unique_ptr<Reactor>> reactors_;
+    std::unique_ptr<httplib::TaskQueue> taskQueue_;
+    int listenFd_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> ioThreads_;
+    std::atomic<size_t> nextReactor_;
+    std::mutex stopMutex_;
+    std::condition_variable stopCondition_;
+    std::shared_ptr<ConnectionStats> connectionStats_;
+    size_t maxPipelineDepth_;
+
+    std::atomic<uint64_t> accepted_;
+    std::atomic<uint64_t> requests_;
+    std::atomic<uint64_t> idleClosed_;
+    std::atomic<uint64_t> rejected_;
+    std::atomic<uint64_t> pipelined_;
+    std::atomic<uint64_t> pipelineYields_;
+    std::atomic<int64_t> openConnections_;
+};
@@ -10,12 +10,34 @@
 #include "api/follow_handler.h"
 #include "api/comment_handler.h"
 #include "api/share_handler.h"
+#include "api/static_file_handler.h"
 #include "utils/config_manager.h"
 #include "utils/logger.h"
 #include "database/connection_pool.h"
 #include "database/connection_guard.h"
+#include "database/db_operation_scope.h"
+#include "database/query_stats.h"
+#include "core/follow_graph_cache.h"
+#include "core/hot_ranking_engine.h"
+#include "core/count_service.h"
+#include "core/thumbnail_cache.h"
+#include "server/worker_pool.h"
+#include "server/admission_controller.h"
+#include "server/epoll_server.h"
+#include "server/tls_server.h"
+#include "server/connection_stats.h"
+#include "server/router.h"
+#include "utils/response_compressor.h"
+#include "utils/metrics_registry.h"
+#include "utils/tracer.h"
+#include "utils/alloc_profiler.h"
 #include <json/json.h>
+#include <openssl/crypto.h>
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
 
 HttpServer::HttpServer()
     : server_(std::make_unique<httplib::Server>()),
@@ -27,6 +49,14 @@ HttpServer::HttpServer()
       followHandler_(std::make_unique<FollowHandler>()),
       commentHandler_(std::make_unique<CommentHandler>()),
       shareHandler_(std::make_unique<ShareHandler>()),
+      staticFileHandler_(std::make_unique<StaticFileHandler>()),
+      router_(std::make_unique<Router>()),
+      workerStats_(std::make_shared<WorkerPoolStats>()),
+      connectionStats_(std::make_shared<ConnectionStats>()),
+      epollServer_(nullptr),
+      tlsServer_(nullptr),
+      ioThreads_(1),
+      allocationHeaders_(false),
       host_("0.0.0.0"),
       port_(8080),
       running_(false) {
@@ -45,8 +75,42 @@ bool HttpServer::initialize() {
         host_ = config.get<std::string>("server.host", "0.0.0.0");
         port_ = config.get<int>("server.port", 8080);
         
+        // 选择连接处理后端：threaded（httplib 每连接一个线程）或 epoll（事件循环）
+        // 启用进程内 TLS 终止（server.tls.enabled）时使用 TlsServer，连接模型为 threaded
+        std::string backend = config.get<std::string>("server.backend", "threaded");
+        if (config.get<bool>("server.tls.enabled", false)) {
+            if (backend == "epoll") {
+                Logger::warning("server.tls is not supported by the epoll backend, falling back to threaded");
+            }
+            auto tlsServer = std::make_unique<TlsServer>();
+            if (!tlsServer->is_valid()) {
+                Logger::error("Failed to initialize TLS, check server.tls.cert_file and server.tls.key_file");
+                return false;
+            }
+            tlsServer_ = tlsServer.get();
+            server_ = std::move(tlsServer);
+        } else if (backend == "epoll") {
+            auto epollServer = std::make_unique<EpollServer>();
+            epollServer_ = epollServer.get();
+            server_ = std::move(epollServer);
+            ioThreads_ = config.get<int>("server.epoll.io_threads", 1);
+        }
+        Logger::info("HTTP server backend: " + std::string(epollServer_ ? "epoll" : "threaded") +
+                    (tlsServer_ ? " (TLS)" : ""));
+
+        adminToken_ = config.get<std::string>("debug.admin_token", "");
+
+        if (AllocProfiler::enabled()) {
+            allocationHeaders_ = config.get<bool>("profiling.allocation_headers", false);
+            Logger::info("Allocation profiling enabled (allocator: " +
+                        AllocProfiler::getStats()["allocator"].asString() + ")");
+        }
+        
         Logger::info("Initializing HTTP server on " + host_ + ":" + std::to_string(port_));
         
+        // 设置工作线程池和超时
+        setupWorkerPool();
+        
         // 设置中间件
         setupMiddleware();
         
@@ -58,6 +122,9 @@ bool HttpServer::initialize() {
         
         // 设置错误处理器
         setupErrorHandlers();
+
+        // 注册导出指标
+        setupMetrics();
         
         Logger::info("HTTP server initialized successfully");
         return true;
@@ -80,7 +147,9 @@ bool HttpServer::start() {
     running_ = true;
     
     // 这是阻塞调用
-    bool result = server_->listen(host_.c_str(), port_);
+    bool result = epollServer_
+        ? epollServer_->listenEventLoop(host_, port_, ioThreads_)
+        : server_->listen(host_.c_str(), port_);
     
     if (!result) {
         Logger::error("Failed to start HTTP server");
@@ -98,75 +167,274 @@ void HttpServer::stop() {
     
     Logger::info("Stopping HTTP server...");
     
-    server_->stop();
+    if (epollServer_) {
+        epollServer_->stopEventLoop();
+    } else {
+        server_->stop();
+    }
     running_ = false;
     
     Logger::info("HTTP server stopped");
 }
 
+// 当前工作线程持有的准入凭证和CPU通道名额（每个线程同一时间只处理一个请求）
+static thread_local std::unique_ptr<AdmissionController::Ticket> currentTicket;
+static thread_local std::unique_ptr<CpuLane::Slot> currentCpuSlot;
+static thread_local std::chrono::steady_clock::time_point requestStart;
+static thread_local AllocationCounters requestAllocations;
+
+// 处理器内的仓储调用共用一个连接（首次访问数据库时才取），处理器返回时归还
+static void invokeWithDbScope(const Router::Handler& handler, const httplib::Request& req,
+                              httplib::Response& res) {
+    DbOperationScope dbScope(DatabaseConnectionPool::getInstance());
+    handler(req, res);
+}
+
+// 返回503并提示客户端稍后重试
+static void sendServiceUnavailable(httplib::Response& res, int retryAfterSeconds) {
+    Json::Value error;
+    error["success"] = false;
+    error["message"] = "服务器繁忙，请稍后重试";
+    error["retry_after"] = retryAfterSeconds;
+    error["timestamp"] = static_cast<Json::Int64>(std::time(nullptr));
+
+    Json::StreamWriterBuilder writer;
+    res.set_content(Json::writeString(writer, error), "application/json");
+    res.set_header("Retry-After", std::to_string(retryAfterSeconds));
+    res.status = 503;
+}
+
+void HttpServer::setupWorkerPool() {
+    auto& config = ConfigManager::getInstance();
+    int threadPoolSize = config.get<int>("server.thread_pool_size", 8);
+    int maxQueued = config.get<int>("server.max_queued_connections", 0);
+    int readTimeout = config.get<int>("server.read_timeout", 30);
+    int writeTimeout = config.get<int>("server.write_timeout", 30);
+    int idleTimeout = config.get<int>("server.idle_timeout", 60);
+    int keepAliveMaxCount = config.get<int>("server.keep_alive_max_count", 100);
+    int pipelineMaxDepth = config.get<int>("server.pipelining.max_depth", 16);
+    int maxBodyMb = config.get<int>("server.max_body_mb", 64);
+
+    if (threadPoolSize < 2) {
+        threadPoolSize = 2;
+    }
+
+    // CPU通道默认占四分之一线程；名额+等待数必须小于线程数，保证元数据请求始终有线程可用
+    int cpuSlots = config.get<int>("server.cpu_lane.slots", std::max(1, threadPoolSize / 4));
+    int cpuMaxWaiting = config.get<int>("server.cpu_lane.max_waiting", cpuSlots);
+    int cpuWaitTimeoutMs = config.get<int>("server.cpu_lane.wait_timeout_ms", 5000);
+    if (cpuSlots >= threadPoolSize) {
+        cpuSlots = threadPoolSize - 1;
+    }
+    if (cpuSlots + cpuMaxWaiting >= threadPoolSize) {
+        cpuMaxWaiting = threadPoolSize - 1 - cpuSlots;
+        Logger::warning("server.cpu_lane.max_waiting clamped to " + std::to_string(cpuMaxWaiting));
+    }
+    cpuLane_ = std::make_unique<CpuLane>(cpuSlots, cpuMaxWaiting, cpuWaitTimeoutMs);
+
+    // 准入控制：并发上限低于线程数，留出的线程用于按优先级排队
+    bool admissionEnabled = config.get<bool>("server.admission.enabled", true);
+    int maxConcurrent = config.get<int>("server.admission.max_concurrent",
+                                        std::max(1, threadPoolSize - threadPoolSize / 4));
+    int maxQueue = config.get<int>("server.admission.max_queue", threadPoolSize - maxConcurrent);
+    int queueTimeoutMs[AdmissionController::kPriorityCount] = {
+        0,
+        config.get<int>("server.admission.queue_timeout_ms.high", 2000),
+        config.get<int>("server.admission.queue_timeout_ms.normal", 1000),
+        config.get<int>("server.admission.queue_timeout_ms.low", 500)
+    };
+    if (admissionEnabled) {
+        admission_ = std::make_unique<AdmissionController>(maxConcurrent, maxQueue, queueTimeoutMs);
+        Logger::info("Admission control: max_concurrent=" + std::to_string(maxConcurrent) +
+                    ", max_queue=" + std::to_string(maxQueue));
+    }
+
+    // threaded 后端每个任务就是一个连接，由线程池统计连接复用；epoll 后端由事件循环统计
+    auto stats = workerStats_;
+    auto connectionStats = epollServer_ ? nullptr : connectionStats_;
+    server_->new_task_queue = [threadPoolSize, maxQueued, stats, connectionStats] {
+        return new WorkerPool(static_cast<size_t>(threadPoolSize),
+                              static_cast<size_t>(maxQueued > 0 ? maxQueued : 0), stats, connectionStats);
+    };
+    if (epollServer_) {
+        epollServer_->setConnectionStats(connectionStats_);
+        epollServer_->setMaxPipelineDepth(static_cast<size_t>(std::max(1, pipelineMaxDepth)));
+    }
+
+    server_->set_read_timeout(readTimeout, 0);
+    server_->set_write_timeout(writeTimeout, 0);
+    server_->set_keep_alive_timeout(idleTimeout);
+    server_->set_keep_alive_max_count(static_cast<size_t>(keepAliveMaxCount > 0 ? keepAliveMaxCount : 1));
+    // httplib 默认不限制请求体大小；epoll 后端按同一上限切分请求
+    server_->set_payload_max_length(static_cast<size_t>(std::max(1, maxBodyMb)) * 1024 * 1024);
+
+    Logger::info("Worker pool: threads=" + std::to_string(threadPoolSize) +
+                ", cpu_lane.slots=" + std::to_string(cpuSlots) +
+                ", cpu_lane.max_waiting=" + std::to_string(cpuMaxWaiting) +
+                ", read_timeout=" + std::to_string(readTimeout) +
+                "s, write_timeout=" + std::to_string(writeTimeout) +
+                "s, idle_timeout=" + std::to_string(idleTimeout) +
+                "s, keep_alive_max_count=" + std::to_string(keepAliveMaxCount) +
+                ", pipelining.max_depth=" + std::to_string(pipelineMaxDepth) +
+                ", max_body_mb=" + std::to_string(maxBodyMb));
+}
+
 void HttpServer::setupMiddleware() {
-    // 请求日志中间件
-    server_->set_pre_routing_handler([](const httplib::Request& req, httplib::Response& res) {
-        Logger::info("Request: " + req.method + " " + req.path);
+    // 请求计时 + 准入控制（在读取请求体之前执行）
+    server_->set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+        requestStart = std::chrono::steady_clock::now();
+        requestAllocations = AllocProfiler::threadCounters();
+        ConnectionStats::countRequest();
+        Tracer::getInstance().beginRequest(req.get_header_value("traceparent"));
+
+        currentCpuSlot.reset();
+        currentTicket.reset();
+
+        // 准入凭证对应占用的工作线程：threaded 后端读取请求体期间线程已被占用，
+        // 在读之前拒绝也省去接收一个随后被丢弃的请求体（epoll 后端到这里时请求体已由 I/O 线程读完）
+        if (admission_) {
+            int retryAfter = 1;
+            currentTicket = admission_->admit(AdmissionController::classify(req), retryAfter);
+            if (!currentTicket) {
+                Logger::warning("Admission rejected " + req.method + " " + req.path +
+                               " (retry after " + std::to_string(retryAfter) + "s)");
+                sendServiceUnavailable(res, retryAfter);
+                return httplib::Server::HandlerResponse::Handled;
+            }
+        }
+
+        // 不带请求体的请求直接由路由器分发，跳过 httplib 的路由表
+        if (router_->dispatchWithoutBody(req, res)) {
+            return httplib::Server::HandlerResponse::Handled;
+        }
+        return httplib::Server::HandlerResponse::Unhandled;
+    });
+
+    // CPU通道：请求体读完之后、处理器执行之前获取，慢速上传在网络传输期间不占名额
+    server_->set_pre_request_handler([this](const httplib::Request& req, httplib::Response& res) {
+        if (CpuLane::isCpuHeavy(req)) {
+            currentCpuSlot = cpuLane_->acquire();
+            if (!currentCpuSlot) {
+                Logger::warning("CPU lane saturated, rejecting " + req.method + " " + req.path);
+                sendServiceUnavailable(res, 1);
+                return httplib::Server::HandlerResponse::Handled;
+            }
+        }
         return httplib::Server::HandlerResponse::Unhandled;
     });
 
-    // 响应日志中间件 + CORS头（合并处理，避免重复设置导致覆盖）
-    server_->set_post_routing_handler([](const httplib::Request& req, httplib::Response& res) {
-        // 1. 记录响应日志
-        Logger::info("Response: " + std::to_string(res.status) + " for " + req.method + " " + req.path);
+    // 访问日志 + CORS头（合并处理，避免重复设置导致覆盖）
+    server_->set_post_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+        // 归还CPU通道名额和准入凭证（处理器已执行完毕）
+        currentCpuSlot.reset();
+        currentTicket.reset();
 
-        // 2. 设置CORS头
+        // 1. 设置CORS头
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
         res.set_header("Access-Control-Allow-Headers", "Content-Type, Authorization");
         res.set_header("Access-Control-Max-Age", "3600");
+
+        // 2. 按 Accept-Encoding 压缩 JSON 响应（在写出响应头之前执行）
+        {
+            TraceSpan span("compress");
+            ResponseCompressor::getInstance().compressResponse(req, res);
+        }
+
+        // 分配剖析：处理器到压缩为止的分配量（不含其后的追踪与日志）
+        AllocationCounters allocations = AllocProfiler::threadCounters() - requestAllocations;
+        if (allocationHeaders_) {
+            res.set_header("X-Alloc-Count", std::to_string(allocations.allocations));
+            res.set_header("X-Alloc-Bytes", std::to_string(allocations.bytes));
+        }
+
+        // 3. 结束追踪，输出 trace id 和各阶段耗时（Server-Timing）
+        const std::string& pattern = Router::matchedPattern();
+        std::string serverTiming;
+        std::string traceId = Tracer::getInstance().endRequest(
+            req.method + " " + (pattern.empty() ? "unmatched" : pattern), res.status, serverTiming);
+        if (!traceId.empty()) {
+            res.set_header("X-Trace-Id", traceId);
+        }
+        if (!serverTiming.empty()) {
+            res.set_header("Server-Timing", serverTiming);
+        }
+
+        // 4. 每个请求一行访问日志（耗时从读完请求头到开始写响应，字节数为压缩后的响应体）
+        auto latency = std::chrono::steady_clock::now() - requestStart;
+        double latencyMs = std::chrono::duration<double, std::milli>(latency).count();
+        size_t bytes = res.content_length_ > 0 ? res.content_length_ : res.body.size();
+        Logger::access(req.method, req.path, res.status, latencyMs, bytes, req.remote_addr, traceId);
+
+        // 5. 按路由记录请求数和耗时直方图
+        router_->recordResponse(res.status, latency, allocations);
     });
 }
 
 void HttpServer::setupRoutes() {
-    // 注册认证相关路由（不包含通配符路由）
-    authHandler_->registerRoutes(*server_);
+    // 各模块路由注册到前缀树路由器，匹配优先级由路径结构决定，与注册顺序无关
+    router_->setInvoker(&invokeWithDbScope);
+
+    // 注册认证相关路由
+    authHandler_->registerRoutes(*router_);
 
     // 注册图片相关路由
-    imageHandler_->registerRoutes(*server_);
+    imageHandler_->registerRoutes(*router_);
 
-    // 注册点赞相关路由（必须在PostHandler之前注册，避免路由冲突）
-    likeHandler_->registerRoutes(*server_);
+    // 注册点赞相关路由
+    likeHandler_->registerRoutes(*router_);
 
-    // 注册收藏相关路由（必须在PostHandler之前注册，避免路由冲突）
-    favoriteHandler_->registerRoutes(*server_);
+    // 注册收藏相关路由
+    favoriteHandler_->registerRoutes(*router_);
 
     // 注册关注相关路由
-    followHandler_->registerRoutes(*server_);
+    followHandler_->registerRoutes(*router_);
 
-    // 注册评论相关路由（必须在PostHandler之前注册，避免路由冲突）
-    commentHandler_->registerRoutes(*server_);
+    // 注册评论相关路由
+    commentHandler_->registerRoutes(*router_);
 
     // 注册分享相关路由（v2.10.0新增）
-    shareHandler_->registerRoutes(*server_);
+    shareHandler_->registerRoutes(*router_);
 
     // 注册帖子相关路由
-    postHandler_->registerRoutes(*server_);
-
-    // 注册认证的通配符路由（必须最后注册，避免覆盖其他/users/*路由）
-    authHandler_->registerWildcardRoutes(*server_);
+    postHandler_->registerRoutes(*router_);
 
     // 设置静态文件服务
     setupStaticFiles();
 
     // 健康检查端点
-    server_->Get("/health", [this](const httplib::Request& req, httplib::Response& res) {
+    router_->Get("/health", [this](const httplib::Request& req, httplib::Response& res) {
         handleHealthCheck(req, res);
     });
 
     // 指标端点
-    server_->Get("/metrics", [this](const httplib::Request& req, httplib::Response& res) {
+    router_->Get("/metrics", [this](const httplib::Request& req, httplib::Response& res) {
         handleMetrics(req, res);
     });
 
+    // 最近的慢查询（最新的在前）
+    router_->Get("/debug/slow-queries", [this](const httplib::Request& req, httplib::Response& res) {
+        if (!checkAdminToken(req, res)) {
+            return;
+        }
+
+        Json::Value response;
+        response["success"] = true;
+        response["data"] = QueryStats::getInstance().getSlowQueries();
+        response["stats"] = QueryStats::getInstance().getStats();
+
+        Json::StreamWriterBuilder writer;
+        res.set_content(Json::writeString(writer, response), "application/json");
+        res.status = 200;
+    });
+
+    // 运行时内部状态快照
+    router_->Get("/debug/runtime", [this](const httplib::Request& req, httplib::Response& res) {
+        handleDebugRuntime(req, res);
+    });
+
     // API版本端点
-    server_->Get("/api/v1/version", [](const httplib::Request& req, httplib::Response& res) {
+    router_->Get("/api/v1/version", [](const httplib::Request& req, httplib::Response& res) {
         Json::Value response;
         response["version"] = "1.0.0";
         response["service"] = "Knot - Image Sharing Service";
@@ -178,6 +446,9 @@ void HttpServer::setupRoutes() {
         res.set_content(jsonStr, "application/json");
         res.status = 200;
     });
+
+    // 路由器接管 httplib 的路由分发
+    router_->install(*server_);
 }
 
 // void HttpServer::setupCORS() {
@@ -287,47 +558,128 @@ void HttpServer::setupStaticFiles() {
         int result3 = system(("mkdir -p " + avatarsDir + " 2>/dev/null").c_str());
         (void)result1; (void)result2; (void)result3; // 避免编译器警告
 
-        // 设置静态文件挂载点
-        server_->set_mount_point("/uploads/images", imagesDir);
-        server_->set_mount_point("/uploads/thumbnails", thumbnailsDir);
-        server_->set_mount_point("/uploads/avatars", avatarsDir);
-
-        // 设置MIME类型映射
-        server_->set_file_extension_and_mimetype_mapping("jpg", "image/jpeg");
-        server_->set_file_extension_and_mimetype_mapping("jpeg", "image/jpeg");
-        server_->set_file_extension_and_mimetype_mapping("png", "image/png");
-        server_->set_file_extension_and_mimetype_mapping("webp", "image/webp");
-
-        // 设置缓存头处理（仅对静态文件）
-        if (enableCache) {
-            // 注意：这里不能再次设置post_routing_handler，因为会覆盖CORS设置
-            // 缓存头已在现有的post_routing_handler中统一处理
-        }
+        // 挂载静态文件（sendfile/mmap 发送，支持 Range 和条件请求）
+        staticFileHandler_->mount(*router_, "/uploads/images", imagesDir);
+        staticFileHandler_->mount(*router_, "/uploads/thumbnails", thumbnailsDir, true);
+        staticFileHandler_->mount(*router_, "/uploads/avatars", avatarsDir);
 
         Logger::info("Static files configured successfully:");
         Logger::info("  - Images: /uploads/images -> " + imagesDir);
         Logger::info("  - Thumbnails: /uploads/thumbnails -> " + thumbnailsDir);
         Logger::info("  - Avatars: /uploads/avatars -> " + avatarsDir);
-        Logger::info("  - Cache enabled: " + std::string(enableCache ? "yes" : "no"));
+        Logger::info("  - Cache enabled: " + std::string(enableCache ? "yes" : "no") +
+                    ", max-age: " + std::to_string(cacheMaxAge));
 
     } catch (const std::exception& e) {
         Logger::error("Failed to setup static files: " + std::string(e.what()));
     }
 }
 
+void HttpServer::setupMetrics() {
+    auto& registry = MetricsRegistry::getInstance();
+    using Type = MetricsRegistry::Type;
+
+    // 缓存命中/未命中（计数已由各缓存维护，导出时读取）
+    registry.addCallback("cache_hits_total", "Cache hits", Type::COUNTER, {{"cache", "thumbnail"}},
+        [] { return ThumbnailCache::getInstance().getStats()["hits"].asDouble(); });
+    registry.addCallback("cache_misses_total", "Cache misses", Type::COUNTER, {{"cache", "thumbnail"}},
+        [] { return ThumbnailCache::getInstance().getStats()["misses"].asDouble(); });
+    registry.addCallback("cache_hits_total", "Cache hits", Type::COUNTER, {{"cache", "follow_graph"}},
+        [] { return FollowGraphCache::getInstance().getStats()["hits"].asDouble(); });
+    registry.addCallback("cache_misses_total", "Cache misses", Type::COUNTER, {{"cache", "follow_graph"}},
+        [] { return FollowGraphCache::getInstance().getStats()["misses"].asDouble(); });
+    registry.addCallback("cache_hits_total", "Cache hits", Type::COUNTER, {{"cache", "counts"}},
+        [] {
+            Json::Value stats = CountService::getInstance().getStats();
+            return stats["fresh_hits"].asDouble() + stats["estimate_hits"].asDouble();
+        });
+    registry.addCallback("cache_misses_total", "Cache misses", Type::COUNTER, {{"cache", "counts"}},
+        [] { return CountService::getInstance().getStats()["exact_counts"].asDouble(); });
+
+    // 工作线程池
+    auto workerStats = workerStats_;
+    registry.addCallback("worker_pool_active_threads", "Worker threads running a task", Type::GAUGE, {},
+        [workerStats] { return static_cast<double>(workerStats->active.load()); });
+    registry.addCallback("worker_pool_queued_tasks", "Connections waiting for a worker thread", Type::GAUGE, {},
+        [workerStats] { return static_cast<double>(workerStats->queued.load()); });
+    registry.addCallback("worker_pool_rejected_total", "Connections rejected because the queue was full",
+        Type::COUNTER, {}, [workerStats] { return static_cast<double>(workerStats->rejected.load()); });
+
+    // 数据库连接池
+    registry.addCallback("db_pool_available_connections", "Idle database connections", Type::GAUGE, {},
+        [] { return DatabaseConnectionPool::getInstance().getStats()["available_connections"].asDouble(); });
+    registry.addCallback("db_pool_size", "Configured database pool size", Type::GAUGE, {},
+        [] { return DatabaseConnectionPool::getInstance().getStats()["pool_size"].asDouble(); });
+}
+
 void HttpServer::handleMetrics(const httplib::Request& req, httplib::Response& res) {
+    // Prometheus 抓取使用文本格式；JSON 汇总保留给运维脚本
+    if (req.get_param_value("format") != "json") {
+        res.set_content(MetricsRegistry::getInstance().renderPrometheus(), "text/plain; version=0.0.4; charset=utf-8");
+        res.status = 200;
+        return;
+    }
+
     Json::Value response;
 
     // 服务器指标
     Json::Value serverMetrics;
     serverMetrics["running"] = running_;
+    serverMetrics["backend"] = epollServer_ ? "epoll" : "threaded";
+    serverMetrics["tls"] = tlsServer_ != nullptr;
     serverMetrics["host"] = host_;
     serverMetrics["port"] = port_;
     response["server"] = serverMetrics;
 
+    // 工作线程池指标
+    Json::Value workerMetrics;
+    workerMetrics["threads"] = static_cast<Json::UInt64>(workerStats_->threads.load());
+    workerMetrics["active"] = static_cast<Json::UInt64>(workerStats_->active.load());
+    workerMetrics["queued"] = static_cast<Json::UInt64>(workerStats_->queued.load());
+    workerMetrics["completed"] = static_cast<Json::UInt64>(workerStats_->completed.load());
+    workerMetrics["rejected"] = static_cast<Json::UInt64>(workerStats_->rejected.load());
+    uint64_t dequeued = workerStats_->dequeued.load();
+    workerMetrics["queue_wait_avg_ms"] = dequeued > 0
+        ? static_cast<double>(workerStats_->queueWaitMicrosTotal.load()) / dequeued / 1000.0 : 0.0;
+    workerMetrics["queue_wait_max_ms"] = static_cast<double>(workerStats_->queueWaitMicrosMax.load()) / 1000.0;
+    if (cpuLane_) {
+        workerMetrics["cpu_lane"] = cpuLane_->getStats();
+    }
+    response["worker_pool"] = workerMetrics;
+    if (admission_) {
+        response["admission"] = admission_->getStats();
+    }
+    if (epollServer_) {
+        response["event_loop"] = epollServer_->getStats();
+    }
+    if (tlsServer_) {
+        response["tls"] = tlsServer_->getStats();
+    }
+
+    // 连接复用指标（keep-alive 参数一并输出，便于对照调优）
+    auto& config = ConfigManager::getInstance();
+    Json::Value connectionMetrics = connectionStats_->getStats();
+    connectionMetrics["keep_alive_max_count"] = config.get<int>("server.keep_alive_max_count", 100);
+    connectionMetrics["idle_timeout"] = config.get<int>("server.idle_timeout", 60);
+    connectionMetrics["pipelining_max_depth"] = config.get<int>("server.pipelining.max_depth", 16);
+    response["connections"] = connectionMetrics;
+
     // 数据库指标
     auto& dbPool = DatabaseConnectionPool::getInstance();
     response["database"] = dbPool.getStats();
+    response["database"]["queries"] = QueryStats::getInstance().getStats();
+
+    // 关注关系图缓存指标
+    response["follow_graph_cache"] = FollowGraphCache::getInstance().getStats();
+    response["hot_ranking"] = HotRankingEngine::getInstance().getStats();
+    response["counts"] = CountService::getInstance().getStats();
+    response["compression"] = ResponseCompressor::getInstance().getStats();
+    response["router"] = router_->getStats();
+    response["static_files"] = staticFileHandler_->getStats();
+    response["thumbnail_cache"] = ThumbnailCache::getInstance().getStats();
+    response["logging"] = Logger::getStats();
+    response["tracing"] = Tracer::getInstance().getStats();
+    response["allocations"] = AllocProfiler::getStats();
 
     // 时间戳
     response["timestamp"] = static_cast<Json::Int64>(std::time(nullptr));
@@ -339,3 +691,102 @@ void HttpServer::handleMetrics(const httplib::Request& req, httplib::Response& r
     res.status = 200;
 }
 
+bool HttpServer::checkAdminToken(const httplib::Request& req, httplib::Response& res) const {
+    Json::Value error;
+    error["success"] = false;
+    if (adminToken_.empty()) {
+        error["error"] = "Forbidden";
+        error["message"] = "debug.admin_token is not configured";
+        res.status = 403;
+    } else {
+        // 定长比较，避免按前缀逐字节猜测令牌
+        std::string token = req.get_header_value("X-Admin-Token");
+        if (token.size() == adminToken_.size() &&
+            CRYPTO_memcmp(token.data(), adminToken_.data(), token.size()) == 0) {
+            return true;
+        }
+        error["error"] = "Unauthorized";
+        error["message"] = "Missing or invalid X-Admin-Token";
+        res.status = 401;
+    }
+
+    Json::StreamWriterBuilder writer;
+    res.set_content(Json::writeString(writer, error), "application/json");
+    return false;
+}
+
+void HttpServer::handleDebugRuntime(const httplib::Request& req, httplib::Response& res) {
+    if (!checkAdminToken(req, res)) {
+        return;
+    }
+
+    // 各部分依次采集，整个快照在几十微秒内完成；generation_us 给出采集窗口
+    auto started = std::chrono::steady_clock::now();
+    Json::Value response;
+
+    // 进程：RSS、峰值 RSS、线程数（/proc/self/status 一次读取）
+    Json::Value process;
+    process["pid"] = static_cast<Json::Int64>(getpid());
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        // 形如 "VmRSS:\t  123456 kB"
+        auto value = [&line]() { return std::strtoull(line.c_str() + line.find(':') + 1, nullptr, 10); };
+        if (line.rfind("VmRSS:", 0) == 0) {
+            process["rss_bytes"] = static_cast<Json::UInt64>(value() * 1024);
+        } else if (line.rfind("VmHWM:", 0) == 0) {
+            process["peak_rss_bytes"] = static_cast<Json::UInt64>(value() * 1024);
+        } else if (line.rfind("Threads:", 0) == 0) {
+            process["threads"] = static_cast<Json::UInt64>(value());
+        }
+    }
+    response["process"] = process;
+
+    // httplib 工作线程利用率
+    Json::Value workers;
+    uint64_t threads = workerStats_->threads.load();
+    uint64_t active = workerStats_->active.load();
+    workers["threads"] = static_cast<Json::UInt64>(threads);
+    workers["active"] = static_cast<Json::UInt64>(active);
+    workers["queued"] = static_cast<Json::UInt64>(workerStats_->queued.load());
+    workers["utilization"] = threads > 0 ? static_cast<double>(active) / static_cast<double>(threads) : 0.0;
+    response["workers"] = workers;
+
+    // 图片处理（缩略图生成、压缩）走 CPU 通道，in_use/waiting 即处理队列深度
+    if (cpuLane_) {
+        response["image_processing"] = cpuLane_->getStats();
+    }
+    if (admission_) {
+        response["admission"] = admission_->getStats();
+    }
+    if (epollServer_) {
+        response["event_loop"] = epollServer_->getStats();
+    }
+    response["connections"] = connectionStats_->getStats();
+
+    // 连接池：借用者按持有时间倒序，附获取连接的源码位置
+    auto& dbPool = DatabaseConnectionPool::getInstance();
+    Json::Value database = dbPool.getStats();
+    database["borrowers"] = dbPool.getBorrowers();
+    response["database"] = database;
+
+    // 缓存大小与命中率
+    Json::Value caches;
+    caches["thumbnail"] = ThumbnailCache::getInstance().getStats();
+    Json::Value followGraph = FollowGraphCache::getInstance().getStats();
+    uint64_t graphHits = followGraph["hits"].asUInt64();
+    uint64_t graphLookups = graphHits + followGraph["misses"].asUInt64();
+    followGraph["hit_rate"] = graphLookups > 0 ? static_cast<double>(graphHits) / static_cast<double>(graphLookups) : 0.0;
+    caches["follow_graph"] = followGraph;
+    caches["hot_ranking"] = HotRankingEngine::getInstance().getStats();
+    caches["counts"] = CountService::getInstance().getStats();
+    response["caches"] = caches;
+
+    response["timestamp"] = static_cast<Json::Int64>(std::time(nullptr));
+    response["generation_us"] = static_cast<Json::Int64>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started).count());
+
+    Json::StreamWriterBuilder writer;
+    res.set_content(Json::writeString(writer, response), "application/json");
+    res.status = 200;
+}
@@ -20,6 +20,14 @@ class FavoriteHandler;
 class FollowHandler;
 class CommentHandler;
 class ShareHandler;
+class StaticFileHandler;
+class Router;
+class CpuLane;
+class AdmissionController;
+class EpollServer;
+class TlsServer;
+struct WorkerPoolStats;
+class ConnectionStats;
 
 /**
  * @brief HTTP 服务器封装类
@@ -69,10 +77,26 @@ private:
     std::unique_ptr<FollowHandler> followHandler_;
     std::unique_ptr<CommentHandler> commentHandler_;
     std::unique_ptr<ShareHandler> shareHandler_;
+    std::unique_ptr<StaticFileHandler> staticFileHandler_;
+    std::unique_ptr<Router> router_;
+    std::shared_ptr<WorkerPoolStats> workerStats_;
+    std::shared_ptr<ConnectionStats> connectionStats_;
+    std::unique_ptr<CpuLane> cpuLane_;
+    std::unique_ptr<AdmissionController> admission_;
+    EpollServer* epollServer_;      // backend=epoll 时指向 server_，否则为nullptr
+    TlsServer* tlsServer_;          // server.tls.enabled 时指向 server_，否则为nullptr
+    int ioThreads_;                 // epoll 后端的 I/O 线程数
+    bool allocationHeaders_;        // 输出 X-Alloc-Count / X-Alloc-Bytes（仅分配剖析构建）
+    std::string adminToken_;        // 调试端点的 X-Admin-Token（debug.admin_token，空则禁用）
     std::string host_;
     int port_;
     bool running_;
     
+    /**
+     * @brief 设置工作线程池、准入控制、CPU密集请求通道、超时、keep-alive与流水线参数
+     */
+    void setupWorkerPool();
+
     /**
      * @brief 设置中间件
      */
@@ -97,6 +121,11 @@ private:
      * @brief 设置静态文件服务
      */
     void setupStaticFiles();
+
+    /**
+     * @brief 把各模块已有的统计（缓存命中、线程池、连接池）注册为 Prometheus 指标
+     */
+    void setupMetrics();
     
     /**
      * @brief 健康检查端点处理器
@@ -104,7 +133,20 @@ private:
     void handleHealthCheck(const httplib::Request& req, httplib::Response& res);
     
     /**
-     * @brief 指标端点处理器
+     * @brief 指标端点处理器（默认 Prometheus 文本格式，?format=json 返回 JSON 汇总）
      */
     void handleMetrics(const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 校验调试端点（/debug/...）的 X-Admin-Token，失败时写好 401/403 响应
+     * @return 校验通过返回 true
+     */
+    bool checkAdminToken(const httplib::Request& req, httplib::Response& res) const;
+
+    /**
+     * @brief 运行时快照端点处理器：工作线程利用率、连接池借用者、图片处理队列、缓存、RSS
+     *
+     * 只读取各模块的原子计数和短临界区内的容器大小，不访问数据库，可每隔几秒调用一次
+     */
+    void handleDebugRuntime(const httplib::Request& req, httplib::Response& res);
 };
@@ -0,0 +1,269 @@
+/**
+ * @file request_framing.cpp
+ * @brief HTTP/1.1 请求切分实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/request_framing.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <strings.h>
+
+namespace {
+
+// 不区分大小写比较请求头名称
+bool headerNameEquals(const char* line, size_t nameLen, const char* name) {
+    size_t expected = strlen(name);
+    if (nameLen != expected) {
+        return false;
+    }
+    return strncasecmp(line, name, expected) == 0;
+}
+
+// 不区分大小写查找子串（value 不以 '\0' 结尾）
+bool containsIgnoreCase(const char* value, size_t length, const char* needle) {
+    size_t needleLen = strlen(needle);
+    for (size_t i = 0; i + needleLen <= length; ++i) {
+        if (strncasecmp(value + i, needle, needleLen) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief 解析十进制 Content-Length（不接受符号、空白以外的字符）
+ * @return 0 成功；kMalformed / kTooLarge
+ */
+long parseContentLength(const char* value, size_t length, size_t limit, size_t& out) {
+    while (length > 0 && (value[length - 1] == ' ' || value[length - 1] == '\t')) {
+        --length;
+    }
+    if (length == 0) {
+        return RequestFraming::kMalformed;
+    }
+    out = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char c = value[i];
+        if (c < '0' || c > '9') {
+            return RequestFraming::kMalformed;
+        }
+        size_t digit = static_cast<size_t>(c - '0');
+        if (digit > limit || out > (limit - digit) / 10) {
+            return RequestFraming::kTooLarge;
+        }
+        out = out * 10 + digit;
+    }
+    return 0;
+}
+
+/**
+ * @brief 解析 [pos, lineEnd) 中的 chunk 大小：十六进制数字，后面可跟空白和 ";扩展"
+ * @return 0 成功；kMalformed / kTooLarge
+ */
+long parseChunkSize(const std::string& buffer, size_t pos, size_t lineEnd, size_t limit, size_t& out) {
+    out = 0;
+    size_t i = pos;
+    for (; i < lineEnd; ++i) {
+        int digit = hexValue(buffer[i]);
+        if (digit < 0) {
+            break;
+        }
+        if (static_cast<size_t>(digit) > limit || out > (limit - static_cast<size_t>(digit)) / 16) {
+            return RequestFraming::kTooLarge;
+        }
+        out = out * 16 + static_cast<size_t>(digit);
+    }
+    if (i == pos) {
+        return RequestFraming::kMalformed;
+    }
+    while (i < lineEnd && (buffer[i] == ' ' || buffer[i] == '\t')) {
+        ++i;
+    }
+    if (i < lineEnd && buffer[i] != ';') {
+        return RequestFraming::kMalformed;
+    }
+    return 0;
+}
+
+}  // namespace
+
+long RequestFraming::completeLength(const std::string& buffer, size_t maxPayload) {
+    RequestFraming framing;
+    return framing.scan(buffer, maxPayload);
+}
+
+void RequestFraming::reset() {
+    phase_ = Phase::Header;
+    searchFrom_ = 0;
+    limit_ = 0;
+    bodyStart_ = 0;
+    contentLength_ = 0;
+    pos_ = 0;
+    dataEnd_ = 0;
+    bodySize_ = 0;
+    expectContinue_ = false;
+    result_ = kIncomplete;
+}
+
+long RequestFraming::finish(long result) {
+    phase_ = Phase::Done;
+    result_ = result;
+    return result;
+}
+
+long RequestFraming::scan(const std::string& buffer, size_t maxPayload) {
+    if (phase_ == Phase::Done) {
+        return result_;
+    }
+
+    if (phase_ == Phase::Header) {
+        size_t headerEnd = buffer.find("\r\n\r\n", searchFrom_);
+        if (headerEnd == std::string::npos) {
+            // 分隔符可能跨越两次读取，保留末尾3个字节下次重新查找
+            searchFrom_ = buffer.size() > 3 ? buffer.size() - 3 : 0;
+            return buffer.size() > kMaxHeaderBytes ? finish(kMalformed) : kIncomplete;
+        }
+        if (headerEnd > kMaxHeaderBytes) {
+            return finish(kMalformed);
+        }
+
+        bodyStart_ = headerEnd + 4;
+        // 返回值是 long，请求总长度不能超过 LONG_MAX
+        limit_ = std::min(maxPayload, static_cast<size_t>(LONG_MAX) - bodyStart_);
+
+        long status = parseHeaders(buffer, buffer.find("\r\n") + 2, headerEnd);
+        if (status != 0) {
+            return finish(status);
+        }
+    }
+
+    if (phase_ == Phase::FixedBody) {
+        // contentLength_ <= limit_，加法不会溢出
+        size_t total = bodyStart_ + contentLength_;
+        return buffer.size() >= total ? finish(static_cast<long>(total)) : kIncomplete;
+    }
+
+    return scanChunks(buffer);
+}
+
+long RequestFraming::parseHeaders(const std::string& buffer, size_t lineStart, size_t headerEnd) {
+    // 解析 Content-Length / Transfer-Encoding / Expect（直接在缓冲区上比较，不复制行）
+    bool hasContentLength = false;
+    bool chunked = false;
+    while (lineStart < headerEnd) {
+        size_t lineEnd = buffer.find("\r\n", lineStart);
+        const char* line = buffer.data() + lineStart;
+        size_t lineLen = lineEnd - lineStart;
+        const char* colonPtr = static_cast<const char*>(memchr(line, ':', lineLen));
+        if (colonPtr != nullptr) {
+            size_t colon = static_cast<size_t>(colonPtr - line);
+            size_t valueStart = colon + 1;
+            while (valueStart < lineLen && (line[valueStart] == ' ' || line[valueStart] == '\t')) {
+                ++valueStart;
+            }
+            const char* value = line + valueStart;
+            size_t valueLen = lineLen - valueStart;
+            if (headerNameEquals(line, colon, "Content-Length")) {
+                size_t parsed = 0;
+                long status = parseContentLength(value, valueLen, limit_, parsed);
+                if (status != 0) {
+                    return status;
+                }
+                // 取值不一致的重复 Content-Length 会让前后端对请求边界理解不同
+                if (hasContentLength && parsed != contentLength_) {
+                    return kMalformed;
+                }
+                contentLength_ = parsed;
+                hasContentLength = true;
+            } else if (headerNameEquals(line, colon, "Transfer-Encoding")) {
+                chunked = containsIgnoreCase(value, valueLen, "chunked");
+            } else if (headerNameEquals(line, colon, "Expect")) {
+                expectContinue_ = containsIgnoreCase(value, valueLen, "100-continue");
+            }
+        }
+        lineStart = lineEnd + 2;
+    }
+
+    if (chunked) {
+        phase_ = Phase::ChunkSize;
+        pos_ = bodyStart_;
+    } else {
+        phase_ = Phase::FixedBody;
+    }
+    return 0;
+}
+
+long RequestFraming::scanChunks(const std::string& buffer) {
+    // chunked：逐块推进，直到遇到大小为0的块和结尾空行；已确认的块不再重新扫描
+    while (true) {
+        if (phase_ == Phase::ChunkSize) {
+            size_t lineEnd = buffer.find("\r\n", pos_);
+            if (lineEnd == std::string::npos) {
+                return buffer.size() - pos_ > kMaxChunkLineBytes ? finish(kMalformed) : kIncomplete;
+            }
+            if (lineEnd - pos_ > kMaxChunkLineBytes) {
+                return finish(kMalformed);
+            }
+
+            size_t chunkSize = 0;
+            long status = parseChunkSize(buffer, pos_, lineEnd, limit_ - bodySize_, chunkSize);
+            if (status != 0) {
+                return finish(status);
+            }
+
+            size_t dataStart = lineEnd + 2;
+            if (chunkSize == 0) {
+                // 最后一块之后是可选的 trailer，以空行结束
+                phase_ = Phase::Trailer;
+                pos_ = dataStart;
+                searchFrom_ = dataStart;
+                continue;
+            }
+
+            // chunkSize <= limit_ - bodySize_ <= LONG_MAX，累加和数据结束位置都不会溢出
+            bodySize_ += chunkSize;
+            dataEnd_ = dataStart + chunkSize;
+            phase_ = Phase::ChunkData;
+        }
+
+        if (phase_ == Phase::ChunkData) {
+            // 数据和结尾 CRLF 是否已全部到达
+            if (buffer.size() < dataEnd_ || buffer.size() - dataEnd_ < 2) {
+                return kIncomplete;
+            }
+            if (buffer.compare(dataEnd_, 2, "\r\n") != 0) {
+                return finish(kMalformed);
+            }
+            pos_ = dataEnd_ + 2;
+            phase_ = Phase::ChunkSize;
+            continue;
+        }
+
+        // Phase::Trailer
+        if (buffer.compare(pos_, 2, "\r\n") == 0) {
+            return finish(static_cast<long>(pos_ + 2));
+        }
+        size_t trailerEnd = buffer.find("\r\n\r\n", searchFrom_);
+        if (trailerEnd == std::string::npos) {
+            searchFrom_ = std::max(pos_, buffer.size() > 3 ? buffer.size() - 3 : 0);
+            return buffer.size() - pos_ > kMaxHeaderBytes ? finish(kMalformed) : kIncomplete;
+        }
+        return finish(static_cast<long>(trailerEnd + 4));
+    }
+}
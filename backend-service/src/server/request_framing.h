@@ -0,0 +1,114 @@
+/**
+ * @file request_framing.h
+ * @brief HTTP/1.1 请求切分：从连接缓冲区中找出第一个完整请求的边界
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief 请求切分（epoll 后端的 I/O 线程在交给 httplib 解析之前调用）
+ *
+ * 只识别请求头结束位置、Content-Length、chunked 请求体和 Expect: 100-continue，不解析其他内容。
+ * 输入来自未认证的客户端，所有长度先与上限比较再参与加法：
+ * - Content-Length 只接受十进制数字；多个取值不一致的 Content-Length 视为非法
+ * - chunk 大小只接受十六进制数字（可带 ";扩展"），长度超过上限直接拒绝
+ * - 每个 chunk 的数据后必须紧跟 CRLF
+ *
+ * 增量切分：对象保存在连接上，缓冲区在两次 scan 之间只会在末尾追加数据。
+ * 请求头只在找到结束位置时解析一次，chunked 请求体记录当前块的位置，
+ * 每次 scan 只处理新到达的字节；取走一个完整请求后调用 reset()。
+ */
+class RequestFraming {
+public:
+    /// 请求头总长度上限
+    static constexpr size_t kMaxHeaderBytes = 64 * 1024;
+
+    /// chunk 大小行（含扩展）长度上限
+    static constexpr size_t kMaxChunkLineBytes = 1024;
+
+    /// 返回值：请求尚不完整
+    static constexpr long kIncomplete = 0;
+    /// 返回值：请求头或分块格式非法（400）
+    static constexpr long kMalformed = -1;
+    /// 返回值：请求体超过上限（413）
+    static constexpr long kTooLarge = -2;
+
+    RequestFraming() { reset(); }
+
+    /**
+     * @brief 计算缓冲区中第一个完整请求的长度（一次性切分）
+     * @param buffer 连接缓冲区（可能包含多个流水线请求）
+     * @param maxPayload 请求体字节数上限
+     * @return 完整请求字节数；kIncomplete / kMalformed / kTooLarge
+     */
+    static long completeLength(const std::string& buffer, size_t maxPayload);
+
+    /**
+     * @brief 从上次停下的位置继续切分
+     *
+     * 得出结果（完整长度或错误）后结果被缓存，再次调用直接返回，直到 reset()
+     *
+     * @param buffer 连接缓冲区（自上次 reset 以来只在末尾追加过数据）
+     * @param maxPayload 请求体字节数上限
+     * @return 完整请求字节数；kIncomplete / kMalformed / kTooLarge
+     */
+    long scan(const std::string& buffer, size_t maxPayload);
+
+    /**
+     * @brief 开始切分下一个请求（缓冲区已移除上一个请求）
+     */
+    void reset();
+
+    /**
+     * @brief 请求头是否已完整
+     */
+    bool headerComplete() const { return phase_ != Phase::Header; }
+
+    /**
+     * @brief 请求头中是否带有 Expect: 100-continue
+     */
+    bool expectsContinue() const { return expectContinue_; }
+
+private:
+    enum class Phase {
+        Header,         // 等待请求头结束
+        FixedBody,      // Content-Length 请求体
+        ChunkSize,      // 等待 chunk 大小行
+        ChunkData,      // 等待当前 chunk 的数据和结尾 CRLF
+        Trailer,        // 最后一块之后，等待 trailer 结束
+        Done            // 已得出结果
+    };
+
+    /**
+     * @brief 解析 [lineStart, headerEnd) 中的请求头
+     * @return 0 成功；kMalformed / kTooLarge
+     */
+    long parseHeaders(const std::string& buffer, size_t lineStart, size_t headerEnd);
+
+    /**
+     * @brief 推进 chunked 请求体
+     * @return 完整请求字节数；kIncomplete / kMalformed / kTooLarge
+     */
+    long scanChunks(const std::string& buffer);
+
+    /**
+     * @brief 记录最终结果
+     */
+    long finish(long result);
+
+    Phase phase_;
+    size_t searchFrom_;         // 下一次查找分隔符的起点（已扫描过的字节不再查找）
+    size_t limit_;              // 请求体字节数上限（已考虑 long 返回值范围）
+    size_t bodyStart_;
+    size_t contentLength_;
+    size_t pos_;                // chunked：当前 chunk 大小行的起点 / trailer 起点
+    size_t dataEnd_;            // chunked：当前 chunk 数据结束位置（不含 CRLF）
+    size_t bodySize_;           // chunked：已累计的数据字节数
+    bool expectContinue_;
+    long result_;
+};
@@ -0,0 +1,367 @@
+/**
+ * @file router.cpp
+ * @brief 基于路径段前缀树的路由表实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/router.h"
+#include "utils/alloc_profiler.h"
+#include "utils/logger.h"
+#include "utils/metrics_registry.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr const char* kMethodNames[] = {"GET", "POST", "PUT", "DELETE", "PATCH"};
+constexpr std::string_view kIntSuffix = "<int>";
+
+/**
+ * @brief 按 '/' 切分路径（忽略开头的 '/'，保留末尾的空段）
+ * @return 段数；路径不以 '/' 开头或超过 maxSegments 时返回-1
+ */
+template <size_t N>
+int splitPath(std::string_view path, std::array<std::string_view, N>& segments) {
+    if (path.empty() || path[0] != '/') {
+        return -1;
+    }
+    if (path.size() == 1) {
+        return 0;
+    }
+
+    size_t count = 0;
+    size_t start = 1;
+    while (true) {
+        if (count == N) {
+            return -1;
+        }
+        size_t slash = path.find('/', start);
+        if (slash == std::string_view::npos) {
+            segments[count++] = path.substr(start);
+            break;
+        }
+        segments[count++] = path.substr(start, slash - start);
+        start = slash + 1;
+    }
+    return static_cast<int>(count);
+}
+
+bool isDigits(std::string_view segment) {
+    if (segment.empty()) {
+        return false;
+    }
+    return std::all_of(segment.begin(), segment.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+}  // namespace
+
+thread_local const Router::Route* Router::matchedRoute_ = nullptr;
+
+// 构造函数
+Router::Router()
+    : routeCount_(0)
+    , invoker_(nullptr)
+    , dispatched_(0)
+    , fastPath_(0)
+    , notFound_(0)
+    , methodNotAllowed_(0)
+    , unmatchedMetrics_(createMetrics("any", "unmatched")) {
+    hasMethod_.fill(false);
+}
+
+// 析构函数
+Router::~Router() = default;
+
+Router& Router::Get(const std::string& pattern, Handler handler) {
+    return add(kGet, pattern, std::move(handler));
+}
+
+Router& Router::Post(const std::string& pattern, Handler handler) {
+    return add(kPost, pattern, std::move(handler));
+}
+
+Router& Router::Put(const std::string& pattern, Handler handler) {
+    return add(kPut, pattern, std::move(handler));
+}
+
+Router& Router::Delete(const std::string& pattern, Handler handler) {
+    return add(kDelete, pattern, std::move(handler));
+}
+
+Router& Router::Patch(const std::string& pattern, Handler handler) {
+    return add(kPatch, pattern, std::move(handler));
+}
+
+// 注册路由：逐段插入前缀树
+Router& Router::add(Method method, const std::string& pattern, Handler handler) {
+    std::array<std::string_view, kMaxSegments> segments;
+    int count = splitPath(pattern, segments);
+    if (count < 0) {
+        throw std::invalid_argument("Invalid route pattern '" + pattern + "'");
+    }
+
+    auto route = std::make_unique<Route>();
+    route->pattern = pattern;
+    route->handler = std::move(handler);
+    route->metrics = createMetrics(kMethodNames[method], pattern);
+
+    Node* node = &root_;
+    for (int i = 0; i < count; ++i) {
+        std::string_view segment = segments[static_cast<size_t>(i)];
+
+        if (!segment.empty() && segment[0] == ':') {
+            bool typed = segment.size() > kIntSuffix.size() &&
+                         segment.substr(segment.size() - kIntSuffix.size()) == kIntSuffix;
+            std::string name(segment.substr(1, segment.size() - 1 - (typed ? kIntSuffix.size() : 0)));
+            if (name.empty() ||
+                std::find(route->paramNames.begin(), route->paramNames.end(), name) != route->paramNames.end()) {
+                throw std::invalid_argument("Invalid or duplicate path parameter in route pattern '" + pattern + "'");
+            }
+            route->paramNames.push_back(std::move(name));
+
+            std::unique_ptr<Node>& child = typed ? node->intParam : node->stringParam;
+            if (!child) {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+            continue;
+        }
+
+        auto it = std::lower_bound(node->children.begin(), node->children.end(), segment,
+            [](const std::pair<std::string, std::unique_ptr<Node>>& entry, std::string_view key) {
+                return std::string_view(entry.first) < key;
+            });
+        if (it == node->children.end() || it->first != segment) {
+            it = node->children.emplace(it, std::string(segment), std::make_unique<Node>());
+        }
+        node = it->second.get();
+    }
+
+    if (node->routes[method]) {
+        throw std::invalid_argument(std::string("Duplicate route ") + kMethodNames[method] + " '" + pattern +
+                                    "' (conflicts with '" + node->routes[method]->pattern + "')");
+    }
+    node->routes[method] = std::move(route);
+    hasMethod_[method] = true;
+    routeCount_++;
+    return *this;
+}
+
+// 深度优先匹配
+bool Router::matchNode(const Node& node, const std::array<std::string_view, kMaxSegments>& segments,
+                       size_t count, size_t index, int method, Match& match) {
+    if (index == count) {
+        bool found = method >= 0
+            ? node.routes[static_cast<size_t>(method)] != nullptr
+            : std::any_of(node.routes.begin(), node.routes.end(), [](const std::unique_ptr<Route>& r) { return r != nullptr; });
+        if (found) {
+            match.node = &node;
+        }
+        return found;
+    }
+
+    std::string_view segment = segments[index];
+
+    auto it = std::lower_bound(node.children.begin(), node.children.end(), segment,
+        [](const std::pair<std::string, std::unique_ptr<Node>>& entry, std::string_view key) {
+            return std::string_view(entry.first) < key;
+        });
+    if (it != node.children.end() && it->first == segment &&
+        matchNode(*it->second, segments, count, index + 1, method, match)) {
+        return true;
+    }
+
+    if (segment.empty()) {
+        return false;
+    }
+
+    size_t paramIndex = match.paramCount;
+    match.params[paramIndex] = segment;
+    match.paramCount = paramIndex + 1;
+
+    if (node.intParam && isDigits(segment) &&
+        matchNode(*node.intParam, segments, count, index + 1, method, match)) {
+        return true;
+    }
+    if (node.stringParam &&
+        matchNode(*node.stringParam, segments, count, index + 1, method, match)) {
+        return true;
+    }
+
+    match.paramCount = paramIndex;
+    return false;
+}
+
+// 请求方法对应的下标
+int Router::methodIndex(const std::string& method) {
+    if (method == "GET" || method == "HEAD") {
+        return kGet;
+    }
+    for (int i = kPost; i < kMethodCount; ++i) {
+        if (method == kMethodNames[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 判断请求是否带请求体
+bool Router::hasBody(const httplib::Request& req) {
+    if (httplib::detail::is_chunked_transfer_encoding(req.headers)) {
+        return true;
+    }
+    if (req.has_header("Content-Length")) {
+        return req.get_header_value_u64("Content-Length") > 0;
+    }
+    // 没有 Content-Length 时 httplib 会读取 POST/PUT/PATCH 的请求体直到连接关闭
+    return req.method != "GET" && req.method != "HEAD" && req.method != "DELETE";
+}
+
+// 分发请求
+bool Router::dispatch(const httplib::Request& req, httplib::Response& res) {
+    int method = methodIndex(req.method);
+    if (method < 0 || !hasMethod_[static_cast<size_t>(method)]) {
+        return false;
+    }
+
+    std::array<std::string_view, kMaxSegments> segments;
+    int count = splitPath(req.path, segments);
+
+    Match match;
+    if (count < 0 || !matchNode(root_, segments, static_cast<size_t>(count), 0, method, match)) {
+        // 路径存在但方法不匹配时返回405并列出允许的方法
+        Match any;
+        if (count >= 0 && matchNode(root_, segments, static_cast<size_t>(count), 0, -1, any)) {
+            std::string allow;
+            for (int i = 0; i < kMethodCount; ++i) {
+                if (any.node->routes[static_cast<size_t>(i)]) {
+                    allow += allow.empty() ? "" : ", ";
+                    allow += i == kGet ? "GET, HEAD" : kMethodNames[i];
+                }
+            }
+            res.set_header("Allow", allow);
+            res.status = 405;
+            methodNotAllowed_++;
+        } else {
+            res.status = 404;
+            notFound_++;
+        }
+        return true;
+    }
+
+    const Route& route = *match.node->routes[static_cast<size_t>(method)];
+
+    // httplib 的处理器签名为 const Request&，但 Request 本身由 process_request 持有且可修改；
+    // 与 httplib 的 matcher 一样，在调用处理器之前写入路径参数
+    auto& mutableReq = const_cast<httplib::Request&>(req);
+    mutableReq.path_params.clear();
+    for (size_t i = 0; i < match.paramCount; ++i) {
+        mutableReq.path_params.emplace(route.paramNames[i], std::string(match.params[i]));
+    }
+    mutableReq.matched_route = route.pattern;
+
+    dispatched_++;
+    matchedRoute_ = &route;
+    if (invoker_) {
+        invoker_(route.handler, req, res);
+    } else {
+        route.handler(req, res);
+    }
+    return true;
+}
+
+// 在 pre_routing 中分发不带请求体的请求
+bool Router::dispatchWithoutBody(const httplib::Request& req, httplib::Response& res) {
+    if (hasBody(req)) {
+        return false;
+    }
+    if (!dispatch(req, res)) {
+        return false;
+    }
+    fastPath_++;
+    return true;
+}
+
+// 为每个方法注册兜底路由
+void Router::install(httplib::Server& server) {
+    auto fallback = [this](const httplib::Request& req, httplib::Response& res) {
+        dispatch(req, res);
+    };
+
+    // 请求体已由 httplib 读取，这里只剩一次全路径匹配
+    const std::string anyPath = ".*";
+    if (hasMethod_[kGet]) {
+        server.Get(anyPath, fallback);
+    }
+    if (hasMethod_[kPost]) {
+        server.Post(anyPath, fallback);
+    }
+    if (hasMethod_[kPut]) {
+        server.Put(anyPath, fallback);
+    }
+    if (hasMethod_[kDelete]) {
+        server.Delete(anyPath, fallback);
+    }
+    if (hasMethod_[kPatch]) {
+        server.Patch(anyPath, fallback);
+    }
+
+    Logger::info("Router installed with " + std::to_string(routeCount_) + " routes");
+}
+
+// 创建路由指标
+Router::RouteMetrics Router::createMetrics(const std::string& method, const std::string& route) {
+    static const char* const kStatusClasses[] = {"1xx", "2xx", "3xx", "4xx", "5xx"};
+
+    auto& registry = MetricsRegistry::getInstance();
+    RouteMetrics metrics;
+    for (size_t i = 0; i < metrics.responses.size(); ++i) {
+        metrics.responses[i] = &registry.counter("http_requests_total", "HTTP requests by route and status class",
+                                                 {{"method", method}, {"route", route}, {"status", kStatusClasses[i]}});
+    }
+    metrics.latency = &registry.histogram("http_request_duration_seconds",
+                                          "HTTP request latency from header parse to response write",
+                                          {{"method", method}, {"route", route}});
+    if (AllocProfiler::enabled()) {
+        metrics.allocations = &registry.counter("http_request_allocations_total",
+                                                "Heap allocations (operator new) made while handling requests",
+                                                {{"method", method}, {"route", route}});
+        metrics.allocatedBytes = &registry.counter("http_request_allocated_bytes_total",
+                                                   "Bytes requested from operator new while handling requests",
+                                                   {{"method", method}, {"route", route}});
+    }
+    return metrics;
+}
+
+// 记录请求结果
+void Router::recordResponse(int status, std::chrono::steady_clock::duration latency,
+                            const AllocationCounters& allocations) {
+    const RouteMetrics& metrics = matchedRoute_ ? matchedRoute_->metrics : unmatchedMetrics_;
+    matchedRoute_ = nullptr;
+
+    int statusClass = std::min(std::max(status / 100, 1), 5);
+    metrics.responses[static_cast<size_t>(statusClass - 1)]->inc();
+    metrics.latency->recordDuration(latency);
+    if (metrics.allocations) {
+        metrics.allocations->inc(allocations.allocations);
+        metrics.allocatedBytes->inc(allocations.bytes);
+    }
+}
+
+// 当前请求匹配的路由模板
+const std::string& Router::matchedPattern() {
+    static const std::string empty;
+    return matchedRoute_ ? matchedRoute_->pattern : empty;
+}
+
+// 获取统计信息
+Json::Value Router::getStats() const {
+    Json::Value stats;
+    stats["routes"] = static_cast<Json::UInt64>(routeCount_);
+    stats["dispatched"] = static_cast<Json::UInt64>(dispatched_.load());
+    stats["fast_path"] = static_cast<Json::UInt64>(fastPath_.load());
+    stats["not_found"] = static_cast<Json::UInt64>(notFound_.load());
+    stats["method_not_allowed"] = static_cast<Json::UInt64>(methodNotAllowed_.load());
+    return stats;
+}
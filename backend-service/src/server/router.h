@@ -0,0 +1,214 @@
+/**
+ * @file router.h
+ * @brief 基于路径段前缀树（radix tree）的路由表
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "httplib.h"
+#include <json/json.h>
+
+class Counter;
+class Histogram;
+struct AllocationCounters;
+
+/**
+ * @brief 路由器
+ *
+ * 替代 httplib 按注册顺序逐条匹配（部分为正则）的路由表：
+ * - 路由按路径段组织成前缀树，分发耗时只与路径段数有关，与路由数量和注册顺序无关
+ * - 同一位置上静态段优先于参数段，类型化参数优先于普通参数，
+ *   例如 /api/v1/users/profile 总是优先于 /api/v1/users/:user_id
+ * - 路径参数写入 req.path_params，处理器的读取方式与 httplib 的 :param 语法一致
+ *
+ * 路由模式语法：
+ * - 静态段：/api/v1/posts
+ * - 参数段：/:post_id（匹配任意非空路径段）
+ * - 类型化参数段：/:id<int>（只匹配十进制数字）
+ *
+ * 分发时机：
+ * - 不带请求体的请求（GET/HEAD、无请求体的 DELETE、Content-Length: 0）由 pre_routing_handler
+ *   调用 dispatchWithoutBody 直接分发，不经过 httplib 的路由表
+ * - 带请求体的请求需要 httplib 先读取请求体，由 install 为每个方法注册的兜底路由分发
+ *
+ * 每个路由在注册时创建自己的指标（http_requests_total、http_request_duration_seconds，
+ * 标签为 method 和路由模式；开启分配剖析时另有 http_request_allocations_total、
+ * http_request_allocated_bytes_total），记录时无需查表。
+ */
+class Router {
+public:
+    using Handler = httplib::Server::Handler;
+
+    /**
+     * @brief 处理器调用方式（路径参数已写入请求）
+     *
+     * HttpServer 用它在处理器外创建请求级的 DbOperationScope，路由器本身不依赖数据库层
+     */
+    using Invoker = void (*)(const Handler& handler, const httplib::Request& req, httplib::Response& res);
+
+    Router();
+    ~Router();
+
+    /**
+     * @brief 设置处理器调用方式（默认直接调用处理器）
+     */
+    void setInvoker(Invoker invoker) { invoker_ = invoker; }
+
+    /**
+     * @brief 注册路由（GET 路由同时处理 HEAD）
+     * @param pattern 路由模式
+     * @param handler 处理器
+     * @return Router引用
+     * @throws std::invalid_argument 模式非法或与已注册路由重复
+     */
+    Router& Get(const std::string& pattern, Handler handler);
+    Router& Post(const std::string& pattern, Handler handler);
+    Router& Put(const std::string& pattern, Handler handler);
+    Router& Delete(const std::string& pattern, Handler handler);
+    Router& Patch(const std::string& pattern, Handler handler);
+
+    /**
+     * @brief 在 pre_routing_handler 中分发不带请求体的请求
+     * @return 已处理（包括404/405）返回true；带请求体或方法不受路由器管理时返回false
+     */
+    bool dispatchWithoutBody(const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 为已注册的每个方法在 httplib 中注册一个兜底路由（带请求体的请求在读取请求体后进入）
+     * @param server HTTP服务器实例
+     */
+    void install(httplib::Server& server);
+
+    /**
+     * @brief 把请求结果记入所匹配路由的指标（在 post_routing_handler 中调用）
+     *
+     * 未经路由器分发到处理器的请求（404/405、被准入控制拒绝等）记入 route="unmatched"。
+     *
+     * @param status 响应状态码
+     * @param latency 请求耗时
+     * @param allocations 请求期间的堆分配（未开启分配剖析时忽略）
+     */
+    void recordResponse(int status, std::chrono::steady_clock::duration latency,
+                        const AllocationCounters& allocations);
+
+    /**
+     * @brief 当前请求所匹配的路由模板（如 /api/v1/posts/:id），未匹配返回空
+     *
+     * 需在 recordResponse 之前调用。
+     */
+    static const std::string& matchedPattern();
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+private:
+    enum Method { kGet = 0, kPost, kPut, kDelete, kPatch, kMethodCount };
+
+    static constexpr size_t kMaxSegments = 16;
+
+    /**
+     * @brief 单个路由的指标（按状态码类别 1xx~5xx 计数 + 耗时直方图）
+     */
+    struct RouteMetrics {
+        std::array<Counter*, 5> responses{};
+        Histogram* latency = nullptr;
+        Counter* allocations = nullptr;         // 仅在开启分配剖析时创建
+        Counter* allocatedBytes = nullptr;
+    };
+
+    /**
+     * @brief 已注册的路由
+     */
+    struct Route {
+        std::string pattern;
+        std::vector<std::string> paramNames;    // 按出现顺序
+        Handler handler;
+        RouteMetrics metrics;
+    };
+
+    /**
+     * @brief 前缀树节点（一个节点对应一个路径段）
+     */
+    struct Node {
+        std::vector<std::pair<std::string, std::unique_ptr<Node>>> children;   // 静态段，按字典序
+        std::unique_ptr<Node> intParam;
+        std::unique_ptr<Node> stringParam;
+        std::array<std::unique_ptr<Route>, kMethodCount> routes;
+    };
+
+    /**
+     * @brief 匹配结果
+     */
+    struct Match {
+        const Node* node = nullptr;
+        std::array<std::string_view, kMaxSegments> params;
+        size_t paramCount = 0;
+    };
+
+    /**
+     * @brief 注册路由
+     */
+    Router& add(Method method, const std::string& pattern, Handler handler);
+
+    /**
+     * @brief 分发请求（路由未命中时设置404/405）
+     * @return 方法不受路由器管理时返回false
+     */
+    bool dispatch(const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 深度优先匹配路径段，静态段优先、类型化参数其次、普通参数最后
+     * @param method 要求节点注册了该方法；-1表示任意方法
+     */
+    static bool matchNode(const Node& node, const std::array<std::string_view, kMaxSegments>& segments,
+                          size_t count, size_t index, int method, Match& match);
+
+    /**
+     * @brief 请求方法对应的下标（HEAD 按 GET 处理）
+     * @return 不受路由器管理的方法返回-1
+     */
+    static int methodIndex(const std::string& method);
+
+    /**
+     * @brief 判断请求是否带请求体（与 httplib 读取请求体的条件一致）
+     */
+    static bool hasBody(const httplib::Request& req);
+
+    /**
+     * @brief 在指标注册表中创建路由指标
+     */
+    static RouteMetrics createMetrics(const std::string& method, const std::string& route);
+
+    Node root_;
+    size_t routeCount_;
+    Invoker invoker_;
+    std::array<bool, kMethodCount> hasMethod_;   // 该方法是否注册过路由
+
+    std::atomic<uint64_t> dispatched_;
+    std::atomic<uint64_t> fastPath_;            // 在 pre_routing 中直接分发的请求数
+    std::atomic<uint64_t> notFound_;
+    std::atomic<uint64_t> methodNotAllowed_;
+
+    RouteMetrics unmatchedMetrics_;
+
+    // 当前线程正在处理的请求所匹配的路由（dispatch 写入，recordResponse 取出并清空）
+    static thread_local const Route* matchedRoute_;
+};
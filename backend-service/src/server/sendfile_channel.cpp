@@ -0,0 +1,129 @@
+/**
+ * @file sendfile_channel.cpp
+ * @brief sendfile 发送通道实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/sendfile_channel.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <openssl/err.h>
+
+namespace {
+
+struct ChannelState {
+    int socketFd = -1;
+    int writeTimeoutMs = 0;
+    SSL* ssl = nullptr;         // TLS 连接（kTLS 发送）
+    size_t pendingSkip = 0;     // 已发送但尚未被流写入扣除的字节数
+};
+
+thread_local ChannelState channelState;
+
+// 等待套接字可写
+bool waitWritable(int socketFd, int timeoutMs) {
+    pollfd pfd{socketFd, POLLOUT, 0};
+    return ::poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLOUT);
+}
+
+// 通过 kTLS 发送文件区间（TlsServer 的套接字为阻塞模式，发送期间临时切换为非阻塞以受写超时限制）
+bool sendKtls(SSL* ssl, int socketFd, int fileFd, off_t offset, size_t length, int timeoutMs) {
+    int flags = ::fcntl(socketFd, F_GETFL, 0);
+    ::fcntl(socketFd, F_SETFL, flags | O_NONBLOCK);
+
+    bool ok = true;
+    size_t remaining = length;
+    while (remaining > 0) {
+        ossl_ssize_t n = SSL_sendfile(ssl, fileFd, offset, remaining, 0);
+        if (n > 0) {
+            offset += n;
+            remaining -= static_cast<size_t>(n);
+            continue;
+        }
+        int error = errno;
+        ERR_clear_error();
+        if (n < 0 && error == EINTR) {
+            continue;
+        }
+        if (n < 0 && (error == EAGAIN || error == EWOULDBLOCK || error == EBUSY) &&
+            waitWritable(socketFd, timeoutMs)) {
+            continue;
+        }
+        ok = false;
+        break;
+    }
+
+    ::fcntl(socketFd, F_SETFL, flags);
+    return ok;
+}
+
+}  // namespace
+
+// 登记套接字
+SendfileChannel::Scope::Scope(int socketFd, int writeTimeoutMs, SSL* ssl) {
+    channelState.socketFd = socketFd;
+    channelState.writeTimeoutMs = writeTimeoutMs;
+    channelState.ssl = ssl;
+    channelState.pendingSkip = 0;
+}
+
+// 注销套接字
+SendfileChannel::Scope::~Scope() {
+    channelState.socketFd = -1;
+    channelState.ssl = nullptr;
+    channelState.pendingSkip = 0;
+}
+
+// 当前线程是否可以使用 sendfile
+bool SendfileChannel::available() {
+    if (channelState.socketFd < 0) {
+        return false;
+    }
+    return channelState.ssl == nullptr || BIO_get_ktls_send(SSL_get_wbio(channelState.ssl));
+}
+
+// 发送文件区间（明文套接字为非阻塞模式，发送缓冲区满时等待可写）
+bool SendfileChannel::send(int fileFd, off_t offset, size_t length) {
+    if (!available()) {
+        return false;
+    }
+
+    if (channelState.ssl) {
+        if (!sendKtls(channelState.ssl, channelState.socketFd, fileFd, offset, length, channelState.writeTimeoutMs)) {
+            return false;
+        }
+        channelState.pendingSkip += length;
+        return true;
+    }
+
+    size_t remaining = length;
+    while (remaining > 0) {
+        ssize_t n = ::sendfile(channelState.socketFd, fileFd, &offset, remaining);
+        if (n > 0) {
+            remaining -= static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!waitWritable(channelState.socketFd, channelState.writeTimeoutMs)) {
+                return false;
+            }
+        } else {
+            // n == 0 表示文件被截断
+            return false;
+        }
+    }
+
+    channelState.pendingSkip += length;
+    return true;
+}
+
+// 扣除已发送的字节
+size_t SendfileChannel::consumeSent(size_t size) {
+    size_t skipped = std::min(size, channelState.pendingSkip);
+    channelState.pendingSkip -= skipped;
+    return skipped;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file sendfile_channel.h
+ * @brief 当前连接的 sendfile 零拷贝发送通道
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <sys/types.h>
+#include <openssl/ssl.h>
+
+/**
+ * @brief sendfile 发送通道（线程局部）
+ *
+ * httplib 的处理器和 content provider 无法直接拿到连接套接字，只能通过 DataSink 写入，
+ * 数据必须先进入用户态缓冲区。EpollServer / TlsServer 自己持有连接，在调用 process_request 期间
+ * 用 Scope 把套接字登记到当前线程：
+ * - content provider 先调用 send() 用 sendfile 把文件区间直接写到套接字
+ * - 再用同样的长度调用 sink.write 推进 httplib 的偏移量
+ * - EpollServer / TlsServer 的流在 write() 中通过 consumeSent() 丢弃这部分已发送的数据
+ *
+ * TLS 连接只有在 kTLS 发送方向生效时才可用（SSL_sendfile 由内核加密）。
+ * 未登记套接字的线程（threaded 后端）或未启用 kTLS 的 TLS 连接 available() 返回false，调用方走普通写入。
+ */
+class SendfileChannel {
+public:
+    /**
+     * @brief 登记当前线程正在处理的连接套接字（RAII，析构时注销）
+     */
+    class Scope {
+    public:
+        /**
+         * @brief 构造函数
+         * @param socketFd 连接套接字
+         * @param writeTimeoutMs 发送缓冲区满时的等待超时（毫秒）
+         * @param ssl TLS 连接（明文连接为nullptr）
+         */
+        Scope(int socketFd, int writeTimeoutMs, SSL* ssl = nullptr);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @brief 当前线程是否可以使用 sendfile
+     * @return 已登记明文套接字，或已登记且启用 kTLS 发送的 TLS 连接返回true
+     */
+    static bool available();
+
+    /**
+     * @brief 把文件区间直接发送到当前连接
+     * @param fileFd 文件描述符
+     * @param offset 文件偏移
+     * @param length 发送长度
+     * @return 全部发送成功返回true；随后必须以相同长度调用一次 sink.write
+     */
+    static bool send(int fileFd, off_t offset, size_t length);
+
+    /**
+     * @brief 流写入时扣除已由 sendfile 发送的字节
+     * @param size 本次写入长度
+     * @return 其中已发送（应丢弃）的字节数
+     */
+    static size_t consumeSent(size_t size);
+};
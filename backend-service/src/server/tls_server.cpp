@@ -0,0 +1,349 @@
+/**
+ * @file tls_server.cpp
+ * @brief 进程内 TLS 终止的 HTTP 服务器实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/tls_server.h"
+#include "server/sendfile_channel.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <openssl/core_names.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+namespace {
+
+constexpr unsigned char kSessionIdContext[] = "knot";
+constexpr int kTicketIvLength = 16;    // AES-256-CBC
+
+// 设置票据 HMAC-SHA256 密钥
+bool setHmacKey(EVP_MAC_CTX* macCtx, const unsigned char* key, size_t length) {
+    OSSL_PARAM params[3];
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, const_cast<unsigned char*>(key), length);
+    params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("sha256"), 0);
+    params[2] = OSSL_PARAM_construct_end();
+    return EVP_MAC_CTX_set_params(macCtx, params) == 1;
+}
+
+// 取出 OpenSSL 错误队列中最早的错误描述
+std::string lastSslError() {
+    unsigned long code = ERR_get_error();
+    ERR_clear_error();
+    if (code == 0) {
+        return "unknown error";
+    }
+    char buffer[256];
+    ERR_error_string_n(code, buffer, sizeof(buffer));
+    return buffer;
+}
+
+}  // namespace
+
+// ==================== TlsStream ====================
+
+/**
+ * @brief TLS 连接流：在 httplib 的 SSLSocketStream 基础上扣除已由 SSL_sendfile 发送的字节
+ */
+class TlsServer::TlsStream : public httplib::Stream {
+public:
+    TlsStream(socket_t sock, SSL* ssl, time_t readTimeoutSec, time_t readTimeoutUsec,
+              time_t writeTimeoutSec, time_t writeTimeoutUsec)
+        : inner_(sock, ssl, readTimeoutSec, readTimeoutUsec, writeTimeoutSec, writeTimeoutUsec) {
+    }
+
+    bool is_readable() const override { return inner_.is_readable(); }
+
+    bool wait_readable() const override { return inner_.wait_readable(); }
+
+    bool wait_writable() const override { return inner_.wait_writable(); }
+
+    ssize_t read(char* ptr, size_t size) override { return inner_.read(ptr, size); }
+
+    ssize_t write(const char* ptr, size_t size) override {
+        // 文件数据已由 content provider 通过 SSL_sendfile 发送，这里只推进偏移
+        size_t skipped = SendfileChannel::consumeSent(size);
+        if (skipped > 0) {
+            return static_cast<ssize_t>(skipped);
+        }
+        return inner_.write(ptr, size);
+    }
+
+    void get_remote_ip_and_port(std::string& ip, int& port) const override {
+        inner_.get_remote_ip_and_port(ip, port);
+    }
+
+    void get_local_ip_and_port(std::string& ip, int& port) const override {
+        inner_.get_local_ip_and_port(ip, port);
+    }
+
+    socket_t socket() const override { return inner_.socket(); }
+
+    time_t duration() const override { return inner_.duration(); }
+
+private:
+    httplib::detail::SSLSocketStream inner_;
+};
+
+// ==================== TlsServer ====================
+
+// 构造函数：读取 server.tls.* 配置并创建 SSL_CTX
+TlsServer::TlsServer()
+    : ctx_(nullptr)
+    , handshakes_(0)
+    , resumed_(0)
+    , handshakeFailures_(0)
+    , ktlsConnections_(0)
+    , ticketRotations_(0) {
+    auto& config = ConfigManager::getInstance();
+    certFile_ = config.get<std::string>("server.tls.cert_file", "");
+    keyFile_ = config.get<std::string>("server.tls.key_file", "");
+    sessionCacheSize_ = std::max(0, config.get<int>("server.tls.session_cache_size", 20480));
+    sessionTimeout_ = std::max(60, config.get<int>("server.tls.session_timeout", 7200));
+    sessionTickets_ = config.get<bool>("server.tls.session_tickets", true);
+    ticketKeyRotation_ = std::max(60, config.get<int>("server.tls.ticket_key_rotation", 3600));
+    ktls_ = config.get<bool>("server.tls.ktls", true);
+
+    if (!createContext()) {
+        if (ctx_) {
+            SSL_CTX_free(ctx_);
+            ctx_ = nullptr;
+        }
+        return;
+    }
+
+    Logger::info("TLS enabled (cert=" + certFile_ +
+                ", session_cache_size=" + std::to_string(sessionCacheSize_) +
+                ", session_timeout=" + std::to_string(sessionTimeout_) +
+                "s, session_tickets=" + std::string(sessionTickets_ ? "true" : "false") +
+                ", ticket_key_rotation=" + std::to_string(ticketKeyRotation_) +
+                "s, ktls=" + std::string(ktls_ ? "true" : "false") + ")");
+}
+
+// 析构函数
+TlsServer::~TlsServer() {
+    if (ctx_) {
+        SSL_CTX_free(ctx_);
+    }
+}
+
+// SSL_CTX 是否可用
+bool TlsServer::is_valid() const {
+    return ctx_ != nullptr;
+}
+
+// 创建并配置 SSL_CTX
+bool TlsServer::createContext() {
+    if (certFile_.empty() || keyFile_.empty()) {
+        Logger::error("server.tls.cert_file and server.tls.key_file are required");
+        return false;
+    }
+
+    ctx_ = SSL_CTX_new(TLS_server_method());
+    if (!ctx_) {
+        Logger::error("Failed to create SSL_CTX: " + lastSslError());
+        return false;
+    }
+
+    uint64_t options = SSL_OP_NO_COMPRESSION | SSL_OP_NO_SESSION_RESUMPTION_ON_RENEGOTIATION |
+                       SSL_OP_NO_RENEGOTIATION | SSL_OP_CIPHER_SERVER_PREFERENCE;
+    if (!sessionTickets_) {
+        options |= SSL_OP_NO_TICKET;
+    }
+#ifdef SSL_OP_ENABLE_KTLS
+    if (ktls_) {
+        options |= SSL_OP_ENABLE_KTLS;
+    }
+#else
+    ktls_ = false;
+#endif
+    SSL_CTX_set_options(ctx_, options);
+    SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+
+    if (SSL_CTX_use_certificate_chain_file(ctx_, certFile_.c_str()) != 1) {
+        Logger::error("Failed to load TLS certificate " + certFile_ + ": " + lastSslError());
+        return false;
+    }
+    if (SSL_CTX_use_PrivateKey_file(ctx_, keyFile_.c_str(), SSL_FILETYPE_PEM) != 1 ||
+        SSL_CTX_check_private_key(ctx_) != 1) {
+        Logger::error("Failed to load TLS private key " + keyFile_ + ": " + lastSslError());
+        return false;
+    }
+
+    // 服务端会话缓存：客户端带 session ID 重连时跳过完整握手
+    SSL_CTX_set_session_id_context(ctx_, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+    SSL_CTX_set_session_cache_mode(ctx_, sessionCacheSize_ > 0 ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_OFF);
+    SSL_CTX_sess_set_cache_size(ctx_, sessionCacheSize_);
+    SSL_CTX_set_timeout(ctx_, sessionTimeout_);
+
+    // 会话票据：使用自管理的轮换密钥替代 OpenSSL 进程内固定密钥
+    if (sessionTickets_) {
+        SSL_CTX_set_app_data(ctx_, this);
+        if (SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx_, &TlsServer::ticketKeyCallback) != 1) {
+            Logger::error("Failed to install TLS session ticket callback: " + lastSslError());
+            return false;
+        }
+    }
+    return true;
+}
+
+// 生成新的票据密钥；超过轮换间隔加会话有效期的旧密钥不再用于解密
+bool TlsServer::rotateTicketKeyLocked(std::time_t now) {
+    TicketKey key;
+    if (RAND_bytes(key.name, sizeof(key.name)) != 1 ||
+        RAND_bytes(key.aesKey, sizeof(key.aesKey)) != 1 ||
+        RAND_bytes(key.hmacKey, sizeof(key.hmacKey)) != 1) {
+        Logger::error("Failed to generate TLS session ticket key: " + lastSslError());
+        return false;
+    }
+    key.createdAt = now;
+    ticketKeys_.push_front(key);
+    while (ticketKeys_.size() > 1 &&
+           now - ticketKeys_.back().createdAt > ticketKeyRotation_ + sessionTimeout_) {
+        ticketKeys_.pop_back();
+    }
+    ticketRotations_++;
+    return true;
+}
+
+// 会话票据加解密回调
+int TlsServer::ticketKeyCallback(SSL* ssl, unsigned char* keyName, unsigned char* iv,
+                                 EVP_CIPHER_CTX* cipherCtx, EVP_MAC_CTX* macCtx, int enc) {
+    auto* server = static_cast<TlsServer*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    if (!server) {
+        return -1;
+    }
+
+    std::time_t now = std::time(nullptr);
+    std::lock_guard<std::mutex> lock(server->ticketMutex_);
+
+    if (enc) {
+        if (server->ticketKeys_.empty() ||
+            now - server->ticketKeys_.front().createdAt >= server->ticketKeyRotation_) {
+            if (!server->rotateTicketKeyLocked(now)) {
+                return -1;
+            }
+        }
+        const TicketKey& key = server->ticketKeys_.front();
+        if (RAND_bytes(iv, kTicketIvLength) != 1) {
+            return -1;
+        }
+        memcpy(keyName, key.name, sizeof(key.name));
+        if (EVP_EncryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr, key.aesKey, iv) != 1 ||
+            !setHmacKey(macCtx, key.hmacKey, sizeof(key.hmacKey))) {
+            return -1;
+        }
+        return 1;
+    }
+
+    for (size_t i = 0; i < server->ticketKeys_.size(); ++i) {
+        const TicketKey& key = server->ticketKeys_[i];
+        if (memcmp(keyName, key.name, sizeof(key.name)) != 0) {
+            continue;
+        }
+        if (now - key.createdAt > server->ticketKeyRotation_ + server->sessionTimeout_) {
+            return 0;
+        }
+        if (EVP_DecryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr, key.aesKey, iv) != 1 ||
+            !setHmacKey(macCtx, key.hmacKey, sizeof(key.hmacKey))) {
+            return -1;
+        }
+        // 旧密钥解密成功：会话可以复用，但重新签发当前密钥的票据
+        return i == 0 ? 1 : 2;
+    }
+    return 0;
+}
+
+// TLS 握手后在同一连接上处理 keep-alive 请求
+bool TlsServer::process_and_close_socket(socket_t sock) {
+    SSL* ssl = httplib::detail::ssl_new(
+        sock, ctx_, ctxMutex_,
+        [&](SSL* handshakeSsl) {
+            return httplib::detail::ssl_connect_or_accept_nonblocking(
+                sock, handshakeSsl, SSL_accept, read_timeout_sec_, read_timeout_usec_, nullptr);
+        },
+        [](SSL*) { return true; });
+
+    bool ret = false;
+    if (ssl) {
+        handshakes_++;
+        if (SSL_session_reused(ssl)) {
+            resumed_++;
+        }
+        if (BIO_get_ktls_send(SSL_get_wbio(ssl))) {
+            ktlsConnections_++;
+        }
+
+        std::string remoteAddr;
+        int remotePort = 0;
+        httplib::detail::get_remote_ip_and_port(sock, remoteAddr, remotePort);
+        std::string localAddr;
+        int localPort = 0;
+        httplib::detail::get_local_ip_and_port(sock, localAddr, localPort);
+
+        // kTLS 发送方向生效时，静态文件可以通过 SSL_sendfile 发送
+        SendfileChannel::Scope channel(sock, static_cast<int>(write_timeout_sec_ * 1000 + write_timeout_usec_ / 1000), ssl);
+
+        ret = httplib::detail::process_server_socket_core(
+            svr_sock_, sock, keep_alive_max_count_, keep_alive_timeout_sec_,
+            [&](bool closeConnection, bool& connectionClosed) {
+                TlsStream strm(sock, ssl, read_timeout_sec_, read_timeout_usec_,
+                               write_timeout_sec_, write_timeout_usec_);
+                return process_request(strm, remoteAddr, remotePort, localAddr, localPort,
+                                       closeConnection, connectionClosed,
+                                       [&](httplib::Request& req) { req.ssl = ssl; });
+            });
+
+        // 对端未发送 close_notify 就断开（移动端切网、杀进程很常见）时静默关闭，
+        // 否则 OpenSSL 会把会话从缓存中移除，下次重连只能完整握手
+        if (!ret) {
+            SSL_set_quiet_shutdown(ssl, 1);
+        }
+        httplib::detail::ssl_delete(ctxMutex_, ssl, sock, true);
+    } else {
+        handshakeFailures_++;
+        ERR_clear_error();
+    }
+
+    httplib::detail::shutdown_socket(sock);
+    httplib::detail::close_socket(sock);
+    return ret;
+}
+
+// 获取统计信息
+Json::Value TlsServer::getStats() const {
+    Json::Value stats;
+    stats["handshakes"] = static_cast<Json::UInt64>(handshakes_.load());
+    stats["resumed"] = static_cast<Json::UInt64>(resumed_.load());
+    stats["handshake_failures"] = static_cast<Json::UInt64>(handshakeFailures_.load());
+    uint64_t handshakes = handshakes_.load();
+    stats["resumption_rate"] = handshakes > 0
+        ? static_cast<double>(resumed_.load()) / static_cast<double>(handshakes) : 0.0;
+    stats["ktls"] = ktls_;
+    stats["ktls_connections"] = static_cast<Json::UInt64>(ktlsConnections_.load());
+
+    if (ctx_) {
+        Json::Value cache;
+        cache["size"] = static_cast<Json::Int64>(SSL_CTX_sess_number(ctx_));
+        cache["max_size"] = static_cast<Json::Int64>(SSL_CTX_sess_get_cache_size(ctx_));
+        cache["hits"] = static_cast<Json::Int64>(SSL_CTX_sess_hits(ctx_));
+        cache["misses"] = static_cast<Json::Int64>(SSL_CTX_sess_misses(ctx_));
+        cache["timeouts"] = static_cast<Json::Int64>(SSL_CTX_sess_timeouts(ctx_));
+        cache["cache_full"] = static_cast<Json::Int64>(SSL_CTX_sess_cache_full(ctx_));
+        stats["session_cache"] = cache;
+    }
+
+    Json::Value tickets;
+    tickets["enabled"] = sessionTickets_;
+    tickets["rotations"] = static_cast<Json::UInt64>(ticketRotations_.load());
+    {
+        std::lock_guard<std::mutex> lock(ticketMutex_);
+        tickets["active_keys"] = static_cast<Json::UInt64>(ticketKeys_.size());
+    }
+    stats["session_tickets"] = tickets;
+    return stats;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file tls_server.h
+ * @brief 进程内 TLS 终止的 HTTP 服务器（会话复用 + kTLS）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include "httplib.h"
+#include <json/json.h>
+
+/**
+ * @brief TLS HTTP 服务器
+ *
+ * 继承 httplib::Server（与 EpollServer 相同的方式），路由、中间件和工作线程池全部沿用，
+ * 只替换每个连接的处理：完成 TLS 握手后用 httplib 的 process_request 处理请求。
+ * 与 httplib::SSLServer 相比：
+ * - 服务端会话缓存（session ID）和会话票据（session ticket）均可配置，
+ *   票据密钥按 ticket_key_rotation 定期轮换，旧密钥在会话有效期内仍可解密
+ * - 启用 kTLS（SSL_OP_ENABLE_KTLS）时把连接登记到 SendfileChannel，
+ *   静态图片通过 SSL_sendfile 由内核加密发送，保持零拷贝
+ *
+ * 配置项 server.tls.*，由构造函数读取；证书或私钥加载失败时 is_valid() 返回false。
+ * 连接仍然是每连接一个工作线程（threaded 模型）。
+ */
+class TlsServer : public httplib::Server {
+public:
+    TlsServer();
+    ~TlsServer() override;
+
+    /**
+     * @brief SSL_CTX 是否创建成功（证书、私钥均已加载）
+     */
+    bool is_valid() const override;
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    TlsServer(const TlsServer&) = delete;
+    TlsServer& operator=(const TlsServer&) = delete;
+
+private:
+    /**
+     * @brief 会话票据密钥
+     */
+    struct TicketKey {
+        unsigned char name[16];
+        unsigned char aesKey[32];
+        unsigned char hmacKey[32];
+        std::time_t createdAt;
+    };
+
+    class TlsStream;
+
+    /**
+     * @brief 创建并配置 SSL_CTX
+     * @return 成功返回true
+     */
+    bool createContext();
+
+    /**
+     * @brief TLS 握手并在同一连接上循环处理请求（覆盖 httplib::Server 的连接处理）
+     */
+    bool process_and_close_socket(socket_t sock) override;
+
+    /**
+     * @brief 会话票据加解密回调（SSL_CTX_set_tlsext_ticket_key_evp_cb）
+     * @return 加密：1成功；解密：0未知密钥，1成功，2成功但需用新密钥重新签发
+     */
+    static int ticketKeyCallback(SSL* ssl, unsigned char* keyName, unsigned char* iv,
+                                 EVP_CIPHER_CTX* cipherCtx, EVP_MAC_CTX* macCtx, int enc);
+
+    /**
+     * @brief 生成新的票据密钥并淘汰过期密钥（调用方持有 ticketMutex_）
+     * @return 成功返回true
+     */
+    bool rotateTicketKeyLocked(std::time_t now);
+
+    SSL_CTX* ctx_;
+    std::mutex ctxMutex_;
+
+    std::string certFile_;
+    std::string keyFile_;
+    int sessionCacheSize_;
+    int sessionTimeout_;            // 会话有效期（秒）
+    bool sessionTickets_;
+    int ticketKeyRotation_;         // 票据密钥轮换间隔（秒）
+    bool ktls_;
+
+    mutable std::mutex ticketMutex_;
+    std::deque<TicketKey> ticketKeys_;  // 头部为当前加密密钥
+
+    std::atomic<uint64_t> handshakes_;
+    std::atomic<uint64_t> resumed_;
+    std::atomic<uint64_t> handshakeFailures_;
+    std::atomic<uint64_t> ktlsConnections_;
+    std::atomic<uint64_t> ticketRotations_;
+};
@@ -0,0 +1,203 @@
+/**
+ * @file worker_pool.cpp
+ * @brief HTTP 工作线程池与 CPU 密集请求通道实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "server/worker_pool.h"
+#include "server/connection_stats.h"
+#include "utils/logger.h"
+#include <chrono>
+#include <exception>
+
+// ==================== WorkerPool ====================
+
+// 构造函数：启动工作线程
+WorkerPool::WorkerPool(size_t threadCount, size_t maxQueued, std::shared_ptr<WorkerPoolStats> stats,
+                       std::shared_ptr<ConnectionStats> connectionStats)
+    : shutdown_(false)
+    , maxQueued_(maxQueued)
+    , stats_(std::move(stats))
+    , connectionStats_(std::move(connectionStats)) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&WorkerPool::workerLoop, this);
+    }
+    stats_->threads = threadCount;
+}
+
+// 析构函数
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+// 提交连接处理任务
+bool WorkerPool::enqueue(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shutdown_) {
+            return false;
+        }
+        if (maxQueued_ > 0 && tasks_.size() >= maxQueued_) {
+            stats_->rejected++;
+            return false;
+        }
+        tasks_.push_back(Task{std::move(fn), std::chrono::steady_clock::now()});
+        stats_->queued = tasks_.size();
+    }
+    if (connectionStats_) {
+        connectionStats_->onOpened();
+    }
+    condition_.notify_one();
+    return true;
+}
+
+// 停止并等待线程退出
+void WorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shutdown_ && threads_.empty()) {
+            return;
+        }
+        shutdown_ = true;
+    }
+    condition_.notify_all();
+
+    for (auto& t : threads_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    threads_.clear();
+    stats_->threads = 0;
+}
+
+// 工作线程主循环（关闭时先处理完已排队的连接）
+void WorkerPool::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return shutdown_ || !tasks_.empty(); });
+            if (shutdown_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            stats_->queued = tasks_.size();
+        }
+
+        // 记录排队时间
+        auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - task.enqueuedAt).count();
+        uint64_t waitedMicros = waited > 0 ? static_cast<uint64_t>(waited) : 0;
+        stats_->dequeued++;
+        stats_->queueWaitMicrosTotal += waitedMicros;
+        uint64_t prevMax = stats_->queueWaitMicrosMax.load();
+        while (waitedMicros > prevMax && !stats_->queueWaitMicrosMax.compare_exchange_weak(prevMax, waitedMicros)) {
+        }
+
+        stats_->active++;
+        ConnectionStats::takeRequestCount();
+        try {
+            task.fn();
+        } catch (const std::exception& e) {
+            Logger::error("Exception in worker thread: " + std::string(e.what()));
+        }
+        uint64_t requests = ConnectionStats::takeRequestCount();
+        if (connectionStats_) {
+            connectionStats_->onClosed(requests);
+        }
+        stats_->active--;
+        stats_->completed++;
+    }
+}
+
+// ==================== CpuLane ====================
+
+// 构造函数
+CpuLane::CpuLane(int slots, int maxWaiting, int waitTimeoutMs)
+    : slots_(slots > 0 ? slots : 1)
+    , maxWaiting_(maxWaiting > 0 ? maxWaiting : 0)
+    , waitTimeoutMs_(waitTimeoutMs > 0 ? waitTimeoutMs : 0)
+    , inUse_(0)
+    , waiting_(0)
+    , admitted_(0)
+    , rejected_(0) {
+}
+
+// 判断是否为上传/图片处理请求
+bool CpuLane::isCpuHeavy(const httplib::Request& req) {
+    if (req.method != "POST") {
+        return false;
+    }
+
+    const std::string& path = req.path;
+    if (path == "/api/v1/images" || path == "/api/v1/posts" || path == "/api/v1/users/avatar") {
+        return true;
+    }
+
+    // POST /api/v1/posts/:post_id/images
+    const std::string prefix = "/api/v1/posts/";
+    const std::string suffix = "/images";
+    return path.size() > prefix.size() + suffix.size() &&
+           path.compare(0, prefix.size(), prefix) == 0 &&
+           path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// 获取名额
+std::unique_ptr<CpuLane::Slot> CpuLane::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (inUse_ >= slots_) {
+        if (waiting_ >= maxWaiting_ || waitTimeoutMs_ == 0) {
+            rejected_++;
+            return nullptr;
+        }
+
+        waiting_++;
+        bool ready = condition_.wait_for(lock, std::chrono::milliseconds(waitTimeoutMs_),
+                                         [this] { return inUse_ < slots_; });
+        waiting_--;
+        if (!ready) {
+            rejected_++;
+            return nullptr;
+        }
+    }
+
+    inUse_++;
+    admitted_++;
+    return std::make_unique<Slot>(*this);
+}
+
+// 归还名额
+void CpuLane::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (inUse_ > 0) {
+            inUse_--;
+        }
+    }
+    condition_.notify_one();
+}
+
+// 获取统计信息
+Json::Value CpuLane::getStats() const {
+    Json::Value stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats["in_use"] = inUse_;
+        stats["waiting"] = waiting_;
+    }
+    stats["slots"] = slots_;
+    stats["max_waiting"] = maxWaiting_;
+    stats["wait_timeout_ms"] = waitTimeoutMs_;
+    stats["admitted"] = static_cast<Json::UInt64>(admitted_.load());
+    stats["rejected"] = static_cast<Json::UInt64>(rejected_.load());
+    return stats;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file worker_pool.h
+ * @brief HTTP 工作线程池（可配置线程数）与 CPU 密集请求通道
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "httplib.h"
+#include <json/json.h>
+
+class ConnectionStats;
+
+/**
+ * @brief 工作线程池运行统计（由 HttpServer 持有，线程池销毁后仍可读取）
+ */
+struct WorkerPoolStats {
+    std::atomic<size_t> threads{0};             // 线程数
+    std::atomic<size_t> active{0};              // 正在处理连接的线程数
+    std::atomic<size_t> queued{0};              // 排队中的连接数
+    std::atomic<uint64_t> completed{0};         // 已处理的连接数
+    std::atomic<uint64_t> rejected{0};          // 队列已满被拒绝的连接数
+    std::atomic<uint64_t> dequeued{0};          // 已出队的任务数
+    std::atomic<uint64_t> queueWaitMicrosTotal{0};  // 任务排队时间累计（微秒）
+    std::atomic<uint64_t> queueWaitMicrosMax{0};    // 任务排队时间最大值（微秒）
+};
+
+/**
+ * @brief HTTP 连接工作线程池
+ *
+ * 通过 httplib::Server::new_task_queue 安装，替代编译期固定的
+ * CPPHTTPLIB_THREAD_POOL_COUNT，线程数由 server.thread_pool_size 决定。
+ * 每个任务对应一个连接（包括其上的 keep-alive 请求）。
+ */
+class WorkerPool : public httplib::TaskQueue {
+public:
+    /**
+     * @brief 构造函数：启动工作线程
+     * @param threadCount 线程数
+     * @param maxQueued 最大排队连接数（0表示不限制）
+     * @param stats 统计对象
+     * @param connectionStats 连接复用统计（每个任务对应一个连接时传入，否则为nullptr）
+     */
+    WorkerPool(size_t threadCount, size_t maxQueued, std::shared_ptr<WorkerPoolStats> stats,
+               std::shared_ptr<ConnectionStats> connectionStats = nullptr);
+
+    ~WorkerPool() override;
+
+    /**
+     * @brief 提交连接处理任务
+     * @return 队列已满返回false（httplib 会直接关闭该连接）
+     */
+    bool enqueue(std::function<void()> fn) override;
+
+    /**
+     * @brief 停止接收任务并等待所有线程退出
+     */
+    void shutdown() override;
+
+    // 禁止拷贝
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+private:
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop();
+
+    /**
+     * @brief 排队中的任务
+     */
+    struct Task {
+        std::function<void()> fn;
+        std::chrono::steady_clock::time_point enqueuedAt;
+    };
+
+    std::vector<std::thread> threads_;
+    std::deque<Task> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool shutdown_;
+    size_t maxQueued_;
+    std::shared_ptr<WorkerPoolStats> stats_;
+    std::shared_ptr<ConnectionStats> connectionStats_;
+};
+
+/**
+ * @brief CPU 密集请求通道（上传、图片处理）
+ *
+ * 在 pre_request_handler 中按请求行分类：httplib 读完请求体、匹配到路由后才调用它，
+ * 上传类请求获得一个通道名额后才执行处理器（压缩、缩略图），网络传输期间不占名额。
+ * 名额用完时最多允许 maxWaiting 个请求等待 waitTimeoutMs，其余直接返回503。
+ * 这样同时处理图片的请求最多占用 slots + maxWaiting 个工作线程；
+ * 读取请求体的线程数由准入控制（上传为 Low 优先级）限制。
+ */
+class CpuLane {
+public:
+    /**
+     * @brief 通道名额（RAII，析构时归还）
+     */
+    class Slot {
+    public:
+        explicit Slot(CpuLane& lane) : lane_(lane) {}
+        ~Slot() { lane_.release(); }
+
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+    private:
+        CpuLane& lane_;
+    };
+
+    /**
+     * @brief 构造函数
+     * @param slots 同时执行的上传/图片请求数
+     * @param maxWaiting 最大等待请求数
+     * @param waitTimeoutMs 等待超时（毫秒）
+     */
+    CpuLane(int slots, int maxWaiting, int waitTimeoutMs);
+
+    /**
+     * @brief 判断请求是否属于 CPU 密集通道
+     * @param req HTTP请求（仅使用方法和路径）
+     * @return 上传/图片处理请求返回true
+     */
+    static bool isCpuHeavy(const httplib::Request& req);
+
+    /**
+     * @brief 获取通道名额
+     * @return 成功返回名额对象；通道饱和或等待超时返回nullptr
+     */
+    std::unique_ptr<Slot> acquire();
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+private:
+    /**
+     * @brief 归还名额
+     */
+    void release();
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    int slots_;
+    int maxWaiting_;
+    int waitTimeoutMs_;
+    int inUse_;
+    int waiting_;
+
+    std::atomic<uint64_t> admitted_;
+    std::atomic<uint64_t> rejected_;
+};
@@ -0,0 +1,173 @@
+/**
+ * @file alloc_profiler.cpp
+ * @brief 堆分配剖析实现（全局 operator new/delete 替换）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "utils/alloc_profiler.h"
+#include "utils/config_manager.h"
+
+#ifdef KNOT_ALLOC_PROFILING
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#endif
+
+#ifndef KNOT_MALLOC_NAME
+#define KNOT_MALLOC_NAME "system"
+#endif
+
+namespace {
+
+// 常量初始化的 thread_local 不需要动态初始化，在 operator new 中访问不会递归分配
+thread_local AllocationCounters threadAllocations;
+
+}  // namespace
+
+AllocationCounters AllocProfiler::threadCounters() {
+    return threadAllocations;
+}
+
+Json::Value AllocProfiler::getStats() {
+    Json::Value stats;
+    stats["enabled"] = enabled();
+    stats["allocator"] = KNOT_MALLOC_NAME;
+    stats["headers"] = enabled() && ConfigManager::getInstance().get<bool>("profiling.allocation_headers", false);
+    return stats;
+}
+
+#ifdef KNOT_ALLOC_PROFILING
+
+namespace {
+
+void* allocate(std::size_t size, std::size_t alignment, bool nothrow) {
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        void* ptr = nullptr;
+        if (alignment > alignof(std::max_align_t)) {
+            if (posix_memalign(&ptr, alignment, size) != 0) {
+                ptr = nullptr;
+            }
+        } else {
+            ptr = std::malloc(size);
+        }
+        if (ptr) {
+            threadAllocations.allocations++;
+            threadAllocations.bytes += size;
+            return ptr;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            if (nothrow) {
+                return nullptr;
+            }
+            throw std::bad_alloc();
+        }
+        if (nothrow) {
+            try {
+                handler();
+            } catch (...) {
+                return nullptr;
+            }
+        } else {
+            handler();
+        }
+    }
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr) {
+        threadAllocations.deallocations++;
+        std::free(ptr);
+    }
+}
+
+constexpr std::size_t kDefaultAlignment = alignof(std::max_align_t);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return allocate(size, kDefaultAlignment, false);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size, kDefaultAlignment, false);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, kDefaultAlignment, true);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, kDefaultAlignment, true);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment), false);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment), false);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment), true);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment), true);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+#endif  // KNOT_ALLOC_PROFILING
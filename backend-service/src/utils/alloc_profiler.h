@@ -0,0 +1,58 @@
+/**
+ * @file alloc_profiler.h
+ * @brief 堆分配剖析：替换全局 operator new，线程局部计数，按请求统计分配次数与字节数
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <json/json.h>
+
+/**
+ * @brief 分配计数（operator new 次数、请求的字节数、operator delete 次数）
+ */
+struct AllocationCounters {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t deallocations = 0;
+
+    AllocationCounters operator-(const AllocationCounters& other) const {
+        return {allocations - other.allocations, bytes - other.bytes, deallocations - other.deallocations};
+    }
+};
+
+/**
+ * @brief 分配剖析器
+ *
+ * 以 -DKNOT_ALLOC_PROFILING=ON 构建时，alloc_profiler.cpp 替换全部全局 operator new/delete，
+ * 每次分配只累加当前线程的计数（无原子操作、无锁）。一个请求在一个工作线程上同步处理，
+ * 因此 pre_routing 与 post_routing 之间的差值就是该请求在处理器内的分配量：
+ * - 按路由累加到 http_request_allocations_total / http_request_allocated_bytes_total
+ * - profiling.allocation_headers 为 true 时写入 X-Alloc-Count / X-Alloc-Bytes 响应头
+ *
+ * 只统计 operator new（C++ 对象、std::string、容器），不含第三方库直接调用的 malloc。
+ * 未开启时不替换 operator new，threadCounters() 恒为0。
+ */
+class AllocProfiler {
+public:
+    static constexpr bool enabled() {
+#ifdef KNOT_ALLOC_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 当前线程自启动以来的累计计数
+     */
+    static AllocationCounters threadCounters();
+
+    /**
+     * @brief 获取配置信息（是否开启、链接的分配器）
+     * @return JSON对象
+     */
+    static Json::Value getStats();
+};
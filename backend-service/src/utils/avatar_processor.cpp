@@ -7,6 +7,7 @@
 
 #include "avatar_processor.h"
 #include "logger.h"
+#include "metrics_registry.h"
 
 // 不定义IMPLEMENTATION宏，因为image_processor.cpp已经定义了
 #include "stb_image.h"
@@ -25,6 +26,10 @@ AvatarProcessResult AvatarProcessor::processAvatar(
     const std::string& userId,
     const std::string& outputDir
 ) {
+    static Histogram& processTime = MetricsRegistry::getInstance().histogram(
+        "image_processing_seconds", "Image decode, thumbnail and encode time", {{"operation", "avatar"}});
+    ScopedTimer timer(processTime);
+
     AvatarProcessResult result;
 
     try {
@@ -7,6 +7,7 @@
 
 #include "utils/image_processor.h"
 #include "utils/logger.h"
+#include "utils/metrics_registry.h"
 #include <sys/stat.h>
 #include <algorithm>
 #include <cstring>
@@ -26,6 +27,10 @@ ProcessResult ImageProcessor::processImage(const std::string& inputPath,
                                           const std::string& outputDir,
                                           const std::string& thumbnailDir,
                                           const std::string& filename) {
+    static Histogram& processTime = MetricsRegistry::getInstance().histogram(
+        "image_processing_seconds", "Image decode, thumbnail and encode time", {{"operation", "upload"}});
+    ScopedTimer timer(processTime);
+
     ProcessResult result;
     
     try {
@@ -78,14 +78,8 @@ public:
      */
     static std::string getMimeType(const std::string& filePath);
 
-private:
-    // 常量定义
-    static constexpr int THUMBNAIL_SIZE = 300;      // 缩略图尺寸（300x300）
-    static constexpr int JPEG_QUALITY = 80;         // JPEG压缩质量（80%）
-    static constexpr long long MAX_FILE_SIZE = 5 * 1024 * 1024;  // 最大文件大小（5MB）
-    
     /**
-     * @brief 生成缩略图
+     * @brief 生成缩略图（processImage 内部使用，公开以便基准测试单独计时）
      * 
      * @param inputData 输入图片数据
      * @param width 原图宽度
@@ -99,5 +93,11 @@ private:
                                   int height,
                                   int channels,
                                   const std::string& outputPath);
+
+private:
+    // 常量定义
+    static constexpr int THUMBNAIL_SIZE = 300;      // 缩略图尺寸（300x300）
+    static constexpr int JPEG_QUALITY = 80;         // JPEG压缩质量（80%）
+    static constexpr long long MAX_FILE_SIZE = 5 * 1024 * 1024;  // 最大文件大小（5MB）
 };
 
@@ -7,11 +7,14 @@
 
 #include "utils/logger.h"
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <memory>
 #include <vector>
+#include <chrono>
+#include <thread>
 #include <sstream>
 #include <iomanip>
 #include <sys/stat.h>
@@ -24,15 +27,71 @@ std::mutex Logger::logMutex_;
 LogLevel Logger::currentLevel_ = LogLevel::INFO;
 std::unique_ptr<std::ofstream> Logger::logFile_;
 bool Logger::consoleOutput_ = true;
-bool Logger::initialized_ = false;
+std::atomic<bool> Logger::initialized_{false};
+bool Logger::async_ = false;
+size_t Logger::asyncQueueSize_ = 0;
+AsyncOverflowPolicy Logger::overflowPolicy_ = AsyncOverflowPolicy::BLOCK;
+
+namespace {
+
+// How long shutdown() waits for the async queue to drain
+constexpr auto kShutdownDrainTimeout = std::chrono::seconds(1);
+
+// Access logger (null until initializeAccessLog; access lines then go to the default logger)
+std::shared_ptr<spdlog::logger> accessLogger;
+
+/**
+ * @brief Create a logger that is async or sync depending on the current mode
+ */
+template <typename It>
+std::shared_ptr<spdlog::logger> makeLogger(const std::string& name, It begin, It end,
+                                           bool async, AsyncOverflowPolicy policy) {
+    if (!async) {
+        return std::make_shared<spdlog::logger>(name, begin, end);
+    }
+    return std::make_shared<spdlog::async_logger>(
+        name, begin, end, spdlog::thread_pool(),
+        policy == AsyncOverflowPolicy::DROP_OLDEST ? spdlog::async_overflow_policy::overrun_oldest
+                                                   : spdlog::async_overflow_policy::block);
+}
+
+/**
+ * @brief Create the parent directory of a log file
+ */
+bool ensureLogDirectory(const std::string& logFile) {
+    std::string logFileCopy = logFile;
+    char* logFilePathCopy = strdup(logFileCopy.c_str());
+    char* logDir = dirname(logFilePathCopy);
+
+    // Create directory recursively
+    struct stat st;
+    if (stat(logDir, &st) != 0) {
+        // Directory doesn't exist, create it
+        std::string mkdirCmd = "mkdir -p " + std::string(logDir);
+        if (system(mkdirCmd.c_str()) != 0) {
+            free(logFilePathCopy);
+            return false;
+        }
+    }
+    free(logFilePathCopy);
+    return true;
+}
+
+}  // namespace
 
 // Initialize logger with configuration
 bool Logger::initialize(const std::string& logFile,
                        LogLevel level,
-                       bool consoleOutput) {
+                       bool consoleOutput,
+                       const AsyncLogOptions& asyncOptions) {
     std::lock_guard<std::mutex> lock(logMutex_);
 
     try {
+        // One background thread keeps messages in order; the queue is bounded
+        if (asyncOptions.enabled) {
+            spdlog::init_thread_pool(asyncOptions.queueSize, 1);
+        }
+
         std::vector<spdlog::sink_ptr> sinks;
 
         // Console sink
@@ -45,21 +104,9 @@ bool Logger::initialize(const std::string& logFile,
         // File sink
         if (!logFile.empty()) {
             // Create log directory if it doesn't exist
-            std::string logFileCopy = logFile;
-            char* logFilePathCopy = strdup(logFileCopy.c_str());
-            char* logDir = dirname(logFilePathCopy);
-
-            // Create directory recursively
-            struct stat st;
-            if (stat(logDir, &st) != 0) {
-                // Directory doesn't exist, create it
-                std::string mkdirCmd = "mkdir -p " + std::string(logDir);
-                if (system(mkdirCmd.c_str()) != 0) {
-                    free(logFilePathCopy);
-                    return false;
-                }
+            if (!ensureLogDirectory(logFile)) {
+                return false;
             }
-            free(logFilePathCopy);
 
             // Create rotating file sink (10MB max size, 5 rotated files)
             auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
@@ -69,9 +116,8 @@ bool Logger::initialize(const std::string& logFile,
         }
         
         // Create logger
-        auto logger = std::make_shared<spdlog::logger>("shared_parking", 
-                                                       sinks.begin(), 
-                                                       sinks.end());
+        auto logger = makeLogger("shared_parking", sinks.begin(), sinks.end(),
+                                 asyncOptions.enabled, asyncOptions.overflowPolicy);
         
         // Set log level
         switch (level) {
@@ -106,6 +152,9 @@ bool Logger::initialize(const std::string& logFile,
         
         currentLevel_ = level;
         consoleOutput_ = consoleOutput;
+        async_ = asyncOptions.enabled;
+        asyncQueueSize_ = asyncOptions.enabled ? asyncOptions.queueSize : 0;
+        overflowPolicy_ = asyncOptions.overflowPolicy;
         initialized_ = true;
         
         return true;
@@ -114,6 +163,99 @@ bool Logger::initialize(const std::string& logFile,
     }
 }
 
+// Initialize the access log
+bool Logger::initializeAccessLog(const std::string& logFile) {
+    std::lock_guard<std::mutex> lock(logMutex_);
+
+    if (!initialized_) {
+        return false;
+    }
+    if (logFile.empty()) {
+        accessLogger.reset();
+        return true;
+    }
+
+    try {
+        if (!ensureLogDirectory(logFile)) {
+            return false;
+        }
+
+        // Same rotation as the main log file (10MB max size, 5 rotated files)
+        std::vector<spdlog::sink_ptr> sinks;
+        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+            logFile, 1024 * 1024 * 10, 5));
+
+        auto logger = makeLogger("access", sinks.begin(), sinks.end(), async_, overflowPolicy_);
+        logger->set_level(spdlog::level::info);
+        logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] %v");
+        logger->flush_on(spdlog::level::err);
+        spdlog::register_logger(logger);
+        accessLogger = logger;
+        return true;
+    } catch (const std::exception& e) {
+        return false;
+    }
+}
+
+// Log one access line
+void Logger::access(const std::string& method, const std::string& path, int status,
+                    double latencyMs, size_t bytes, const std::string& remoteAddr,
+                    const std::string& traceId) {
+    if (!initialized_) {
+        return;
+    }
+
+    // Formatting happens on the caller thread; only the finished line is queued
+    constexpr const char* fmt = "method={} path={} status={} latency_ms={:.3f} bytes={} remote={} trace_id={}";
+    const std::string& trace = traceId.empty() ? std::string("-") : traceId;
+    if (accessLogger) {
+        accessLogger->info(fmt, method, path, status, latencyMs, bytes, remoteAddr, trace);
+    } else if (currentLevel_ <= LogLevel::INFO) {
+        spdlog::info(fmt, method, path, status, latencyMs, bytes, remoteAddr, trace);
+    }
+}
+
+// Stop logging and flush what is already queued
+void Logger::shutdown() {
+    std::lock_guard<std::mutex> lock(logMutex_);
+    if (!initialized_.exchange(false)) {
+        return;
+    }
+
+    // Threads that already passed the initialized_ check still find a valid logger,
+    // so the registry is not dropped here
+    if (accessLogger) {
+        accessLogger->flush();
+    }
+    spdlog::default_logger()->flush();
+
+    // Async flush requests go through the queue as well; wait for it to drain
+    if (async_) {
+        auto pool = spdlog::thread_pool();
+        auto deadline = std::chrono::steady_clock::now() + kShutdownDrainTimeout;
+        while (pool && pool->queue_size() > 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+// Get async queue statistics
+Json::Value Logger::getStats() {
+    Json::Value stats;
+    stats["async"] = async_;
+    stats["access_log"] = accessLogger != nullptr;
+    if (async_) {
+        auto pool = spdlog::thread_pool();
+        stats["queue_capacity"] = static_cast<Json::UInt64>(asyncQueueSize_);
+        stats["overflow_policy"] = overflowPolicy_ == AsyncOverflowPolicy::DROP_OLDEST ? "drop_oldest" : "block";
+        if (pool) {
+            stats["queued"] = static_cast<Json::UInt64>(pool->queue_size());
+            stats["dropped"] = static_cast<Json::UInt64>(pool->overrun_counter());
+        }
+    }
+    return stats;
+}
+
 // Log debug message
 void Logger::debug(const std::string& message) {
     if (initialized_ && currentLevel_ <= LogLevel::DEBUG) {
@@ -146,7 +288,7 @@ void Logger::error(const std::string& message) {
 void Logger::fatal(const std::string& message) {
     if (initialized_) {
         spdlog::critical(message);
-        spdlog::shutdown();
+        spdlog::default_logger()->flush();
     }
 }
 
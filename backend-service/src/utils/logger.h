@@ -8,9 +8,12 @@
 #pragma once
 
 #include <string>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <fstream>
+#include <cstddef>
+#include <json/json.h>
 
 /**
  * @brief Log levels enumeration
@@ -23,6 +26,26 @@ enum class LogLevel {
     FATAL = 4
 };
 
+/**
+ * @brief What an async logger does when its queue is full
+ */
+enum class AsyncOverflowPolicy {
+    BLOCK = 0,          // Caller waits for a free slot (no message is lost)
+    DROP_OLDEST = 1     // Oldest queued message is overwritten (caller never waits)
+};
+
+/**
+ * @brief Async logging options
+ *
+ * When enabled, log calls only format the message and push it onto a bounded
+ * queue; a single background thread writes it to the sinks.
+ */
+struct AsyncLogOptions {
+    bool enabled = false;
+    size_t queueSize = 8192;
+    AsyncOverflowPolicy overflowPolicy = AsyncOverflowPolicy::BLOCK;
+};
+
 /**
  * @brief Static logger class for application-wide logging
  */
@@ -37,7 +60,32 @@ public:
      */
     static bool initialize(const std::string& logFile = "", 
                           LogLevel level = LogLevel::INFO,
-                          bool consoleOutput = true);
+                          bool consoleOutput = true,
+                          const AsyncLogOptions& asyncOptions = AsyncLogOptions());
+
+    /**
+     * @brief Initialize the access log (call after initialize)
+     * @param logFile Path to access log file (empty to write access lines to the main log)
+     * @return true if successful, false otherwise
+     */
+    static bool initializeAccessLog(const std::string& logFile);
+
+    /**
+     * @brief Log one access line per request
+     *
+     * Format: method=GET path=/api/v1/posts status=200 latency_ms=1.234 bytes=512 remote=1.2.3.4 trace_id=-
+     *
+     * @param method HTTP method
+     * @param path Request path
+     * @param status Response status code
+     * @param latencyMs Handling latency in milliseconds
+     * @param bytes Response body size
+     * @param remoteAddr Client address
+     * @param traceId Trace id of the request ("-" when not traced)
+     */
+    static void access(const std::string& method, const std::string& path, int status,
+                       double latencyMs, size_t bytes, const std::string& remoteAddr,
+                       const std::string& traceId = "");
     
     /**
      * @brief Log debug message
@@ -81,12 +129,30 @@ public:
      */
     static LogLevel getLevel();
 
+    /**
+     * @brief Stop logging and flush queued messages (call before exit)
+     *
+     * Other threads may still be running, so the spdlog registry is kept:
+     * later log calls are ignored, and the async thread is joined when exit()
+     * destroys the registry.
+     */
+    static void shutdown();
+
+    /**
+     * @brief Get async queue statistics
+     * @return JSON object
+     */
+    static Json::Value getStats();
+
 private:
     static std::mutex logMutex_;
     static LogLevel currentLevel_;
     static std::unique_ptr<std::ofstream> logFile_;
     static bool consoleOutput_;
-    static bool initialized_;
+    static std::atomic<bool> initialized_;
+    static bool async_;
+    static size_t asyncQueueSize_;
+    static AsyncOverflowPolicy overflowPolicy_;
     
     /**
      * @brief Internal log function
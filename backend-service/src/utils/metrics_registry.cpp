@@ -0,0 +1,238 @@
+/**
+ * @file metrics_registry.cpp
+ * @brief 指标注册表实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "utils/metrics_registry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+// 直方图导出的 le 边界（秒）及对应的微秒值
+constexpr std::pair<const char*, uint64_t> kLatencyBounds[] = {
+    {"0.0005", 500}, {"0.001", 1000}, {"0.0025", 2500}, {"0.005", 5000},
+    {"0.01", 10000}, {"0.025", 25000}, {"0.05", 50000}, {"0.1", 100000},
+    {"0.25", 250000}, {"0.5", 500000}, {"1", 1000000}, {"2.5", 2500000},
+    {"5", 5000000}, {"10", 10000000},
+};
+
+std::atomic<size_t> nextShard{0};
+
+std::string formatNumber(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+std::string escapeLabelValue(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '"':  escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default:   escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief 在已序列化的标签后追加一个标签
+ */
+std::string appendLabel(const std::string& labels, const std::string& name, const std::string& value) {
+    std::string pair = name + "=\"" + value + "\"";
+    if (labels.empty()) {
+        return "{" + pair + "}";
+    }
+    return labels.substr(0, labels.size() - 1) + "," + pair + "}";
+}
+
+}  // namespace
+
+namespace metrics_detail {
+
+size_t shardIndex() {
+    static thread_local size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+}
+
+}  // namespace metrics_detail
+
+// ========== Counter ==========
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// ========== Histogram ==========
+
+size_t Histogram::bucketIndex(uint64_t micros) {
+    if (micros < kSubBuckets) {
+        return static_cast<size_t>(micros);
+    }
+    size_t msb = 63 - static_cast<size_t>(__builtin_clzll(micros));
+    if (msb > kMaxBit) {
+        return kBuckets - 1;
+    }
+    size_t shift = msb - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + static_cast<size_t>((micros >> shift) & (kSubBuckets - 1));
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index + 1;
+    }
+    size_t shift = index / kSubBuckets - 1;
+    size_t sub = index % kSubBuckets;
+    return static_cast<uint64_t>(kSubBuckets + sub + 1) << shift;
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snap;
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < kBuckets; ++i) {
+            uint64_t n = shard.counts[i].load(std::memory_order_relaxed);
+            snap.counts[i] += n;
+            snap.count += n;
+        }
+        snap.sumMicros += shard.sum.load(std::memory_order_relaxed);
+    }
+    return snap;
+}
+
+uint64_t Histogram::Snapshot::quantile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(kBuckets - 1);
+}
+
+uint64_t Histogram::Snapshot::countAtOrBelow(uint64_t upperMicros) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBuckets && bucketUpperBound(i) - 1 <= upperMicros; ++i) {
+        total += counts[i];
+    }
+    return total;
+}
+
+// ========== MetricsRegistry ==========
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::Family& MetricsRegistry::familyLocked(const std::string& name, const std::string& help, Kind kind) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        Family family;
+        family.help = help;
+        family.kind = kind;
+        it = families_.emplace(name, std::move(family)).first;
+    } else if (it->second.kind != kind) {
+        throw std::invalid_argument("Metric '" + name + "' registered with a different type");
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Family& family = familyLocked(name, help, Kind::COUNTER);
+    auto& slot = family.counters[formatLabels(labels)];
+    if (!slot) {
+        slot = std::make_unique<Counter>();
+    }
+    return *slot;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Family& family = familyLocked(name, help, Kind::HISTOGRAM);
+    auto& slot = family.histograms[formatLabels(labels)];
+    if (!slot) {
+        slot = std::make_unique<Histogram>();
+    }
+    return *slot;
+}
+
+void MetricsRegistry::addCallback(const std::string& name, const std::string& help, Type type,
+                                  const MetricLabels& labels, std::function<double()> read) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Family& family = familyLocked(name, help, type == Type::COUNTER ? Kind::CALLBACK_COUNTER : Kind::CALLBACK_GAUGE);
+    family.callbacks[formatLabels(labels)] = std::move(read);
+}
+
+std::string MetricsRegistry::formatLabels(const MetricLabels& labels) {
+    if (labels.empty()) {
+        return "";
+    }
+    std::string out = "{";
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) {
+            out += ",";
+        }
+        out += labels[i].first + "=\"" + escapeLabelValue(labels[i].second) + "\"";
+    }
+    out += "}";
+    return out;
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string out;
+    out.reserve(64 * 1024);
+    for (const auto& [name, family] : families_) {
+        const char* type = "counter";
+        if (family.kind == Kind::HISTOGRAM) {
+            type = "histogram";
+        } else if (family.kind == Kind::CALLBACK_GAUGE) {
+            type = "gauge";
+        }
+        out += "# HELP " + name + " " + family.help + "\n";
+        out += "# TYPE " + name + " " + type + "\n";
+
+        for (const auto& [labels, counter] : family.counters) {
+            out += name + labels + " " + std::to_string(counter->value()) + "\n";
+        }
+
+        for (const auto& [labels, read] : family.callbacks) {
+            out += name + labels + " " + formatNumber(read()) + "\n";
+        }
+
+        for (const auto& [labels, histogram] : family.histograms) {
+            Histogram::Snapshot snap = histogram->snapshot();
+            for (const auto& [le, micros] : kLatencyBounds) {
+                out += name + "_bucket" + appendLabel(labels, "le", le) + " " +
+                       std::to_string(snap.countAtOrBelow(micros)) + "\n";
+            }
+            out += name + "_bucket" + appendLabel(labels, "le", "+Inf") + " " + std::to_string(snap.count) + "\n";
+            out += name + "_sum" + labels + " " + formatNumber(static_cast<double>(snap.sumMicros) / 1e6) + "\n";
+            out += name + "_count" + labels + " " + std::to_string(snap.count) + "\n";
+        }
+    }
+    return out;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file metrics_registry.h
+ * @brief 指标注册表（分片计数器、HDR 风格直方图、Prometheus 文本格式导出）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 指标标签（按给定顺序输出）
+ */
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+namespace metrics_detail {
+
+// 分片数：每个线程固定写一个分片，避免多核同时写同一缓存行
+constexpr size_t kShards = 8;
+
+/**
+ * @brief 当前线程使用的分片下标（线程首次使用时轮流分配）
+ */
+size_t shardIndex();
+
+}  // namespace metrics_detail
+
+/**
+ * @brief 单调递增计数器
+ *
+ * 写入只做一次 relaxed fetch_add（按线程分片），读取时汇总所有分片。
+ */
+class Counter {
+public:
+    Counter() = default;
+
+    void inc(uint64_t n = 1) {
+        shards_[metrics_detail::shardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const;
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, metrics_detail::kShards> shards_;
+};
+
+/**
+ * @brief HDR 风格的对数-线性直方图（单位：微秒）
+ *
+ * 每个 2 的幂区间再等分为 8 个子桶，相对误差不超过 12.5%，
+ * 覆盖 1µs ~ 约19小时，超出范围的值计入最后一个桶。
+ * 写入是两次 relaxed fetch_add（桶计数 + 总和），按线程分片，不加锁。
+ */
+class Histogram {
+public:
+    static constexpr size_t kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kMaxBit = 36;
+    static constexpr size_t kBuckets = (kMaxBit - kSubBucketBits + 2) * kSubBuckets;
+
+    /**
+     * @brief 汇总后的快照
+     */
+    struct Snapshot {
+        std::array<uint64_t, kBuckets> counts{};
+        uint64_t count = 0;
+        uint64_t sumMicros = 0;
+
+        /**
+         * @brief 计算分位数
+         * @param q 0~1
+         * @return 分位数所在桶的上界（微秒），无数据时返回0
+         */
+        uint64_t quantile(double q) const;
+
+        /**
+         * @brief 不超过 upperMicros 的样本数（只统计上界不超过它的完整桶）
+         */
+        uint64_t countAtOrBelow(uint64_t upperMicros) const;
+    };
+
+    Histogram() = default;
+
+    /**
+     * @brief 记录一个样本
+     * @param micros 微秒
+     */
+    void record(uint64_t micros) {
+        Shard& shard = shards_[metrics_detail::shardIndex()];
+        shard.counts[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(micros, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 记录一段耗时
+     */
+    void recordDuration(std::chrono::steady_clock::duration duration) {
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        record(micros > 0 ? static_cast<uint64_t>(micros) : 0);
+    }
+
+    Snapshot snapshot() const;
+
+    /**
+     * @brief 样本值所在的桶
+     */
+    static size_t bucketIndex(uint64_t micros);
+
+    /**
+     * @brief 桶的上界（不含，微秒）
+     */
+    static uint64_t bucketUpperBound(size_t index);
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kBuckets> counts{};
+        std::atomic<uint64_t> sum{0};
+    };
+    std::array<Shard, metrics_detail::kShards> shards_;
+};
+
+/**
+ * @brief 作用域计时器：析构时把耗时记入直方图
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        histogram_.recordDuration(std::chrono::steady_clock::now() - start_);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief 指标注册表（单例）
+ *
+ * - counter/histogram 按名称+标签返回同一个实例，地址在进程生命周期内不变；
+ *   查找需要加锁，调用方应在初始化时取得引用并缓存，热路径上只做原子写入
+ * - addCallback 注册在导出时才读取的指标（已有模块的 getStats 计数，如缓存命中数）
+ * - renderPrometheus 输出 Prometheus 文本格式（0.0.4），直方图以秒为单位
+ */
+class MetricsRegistry {
+public:
+    enum class Type { COUNTER, GAUGE };
+
+    static MetricsRegistry& getInstance();
+
+    /**
+     * @brief 获取或创建计数器
+     * @param name 指标名（如 http_requests_total）
+     * @param help 说明
+     * @param labels 标签
+     */
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * @brief 获取或创建直方图（导出为 <name>_bucket/_sum/_count）
+     * @param name 指标名（如 http_request_duration_seconds）
+     * @param help 说明
+     * @param labels 标签
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * @brief 注册导出时读取的指标
+     * @param name 指标名
+     * @param help 说明
+     * @param type 类型
+     * @param labels 标签
+     * @param read 读取当前值（导出时在注册表锁内调用，不能再访问注册表）
+     */
+    void addCallback(const std::string& name, const std::string& help, Type type,
+                     const MetricLabels& labels, std::function<double()> read);
+
+    /**
+     * @brief 以 Prometheus 文本格式导出所有指标
+     * @return 文本
+     */
+    std::string renderPrometheus() const;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+private:
+    MetricsRegistry() = default;
+    ~MetricsRegistry() = default;
+
+    enum class Kind { COUNTER, HISTOGRAM, CALLBACK_COUNTER, CALLBACK_GAUGE };
+
+    /**
+     * @brief 同名指标族
+     */
+    struct Family {
+        std::string help;
+        Kind kind;
+        std::map<std::string, std::unique_ptr<Counter>> counters;          // 键为序列化后的标签
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+        std::map<std::string, std::function<double()>> callbacks;
+    };
+
+    /**
+     * @brief 获取或创建指标族（调用方持有 mutex_）
+     * @throws std::invalid_argument 同名指标的类型不一致
+     */
+    Family& familyLocked(const std::string& name, const std::string& help, Kind kind);
+
+    /**
+     * @brief 序列化标签：{a="x",b="y"}，无标签时为空串
+     */
+    static std::string formatLabels(const MetricLabels& labels);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+};
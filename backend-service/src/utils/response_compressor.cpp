@@ -0,0 +1,275 @@
+/**
+ * @file response_compressor.cpp
+ * @brief HTTP 响应压缩实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "utils/response_compressor.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <zlib.h>
+
+#ifdef KNOT_BROTLI_SUPPORT
+#include <brotli/encode.h>
+#endif
+
+namespace {
+
+/**
+ * @brief 每个线程复用的 zlib 压缩上下文
+ *
+ * deflateInit2 会分配约256KB的内部状态，复用后每次压缩只需 deflateReset
+ */
+class ZlibContext {
+public:
+    ZlibContext(bool gzip, int level) : ready_(false) {
+        stream_.zalloc = Z_NULL;
+        stream_.zfree = Z_NULL;
+        stream_.opaque = Z_NULL;
+        // windowBits 15 为 zlib 格式（HTTP deflate），+16 为 gzip 格式
+        int windowBits = gzip ? 15 + 16 : 15;
+        ready_ = deflateInit2(&stream_, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    }
+
+    ~ZlibContext() {
+        if (ready_) {
+            deflateEnd(&stream_);
+        }
+    }
+
+    ZlibContext(const ZlibContext&) = delete;
+    ZlibContext& operator=(const ZlibContext&) = delete;
+
+    bool compress(const std::string& input, std::string& output) {
+        if (!ready_ || deflateReset(&stream_) != Z_OK) {
+            return false;
+        }
+
+        output.resize(deflateBound(&stream_, static_cast<uLong>(input.size())));
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream_.avail_in = static_cast<uInt>(input.size());
+        stream_.next_out = reinterpret_cast<Bytef*>(&output[0]);
+        stream_.avail_out = static_cast<uInt>(output.size());
+
+        if (deflate(&stream_, Z_FINISH) != Z_STREAM_END) {
+            return false;
+        }
+        output.resize(stream_.total_out);
+        return true;
+    }
+
+private:
+    z_stream stream_;
+    bool ready_;
+};
+
+// 去除首尾空白
+std::string trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = s.find_last_not_of(" \t");
+    return s.substr(begin, end - begin + 1);
+}
+
+// 只压缩 JSON / 文本类响应（图片等已压缩格式不处理）
+bool isCompressibleType(const std::string& contentType) {
+    return contentType.find("application/json") != std::string::npos ||
+           contentType.compare(0, 5, "text/") == 0;
+}
+
+const char* encodingName(ResponseCompressor::Encoding encoding) {
+    switch (encoding) {
+        case ResponseCompressor::Encoding::Brotli:  return "br";
+        case ResponseCompressor::Encoding::Gzip:    return "gzip";
+        case ResponseCompressor::Encoding::Deflate: return "deflate";
+        default:                                    return "identity";
+    }
+}
+
+}  // namespace
+
+// 获取单例实例
+ResponseCompressor& ResponseCompressor::getInstance() {
+    static ResponseCompressor instance;
+    return instance;
+}
+
+// 构造函数：读取压缩配置
+ResponseCompressor::ResponseCompressor()
+    : compressed_(0)
+    , skipped_(0)
+    , bytesIn_(0)
+    , bytesOut_(0) {
+    auto& config = ConfigManager::getInstance();
+    enabled_ = config.get<bool>("compression.enabled", true);
+    minSize_ = static_cast<size_t>(std::max(0, config.get<int>("compression.min_size", 1024)));
+    level_ = std::min(9, std::max(1, config.get<int>("compression.level", 6)));
+    brotliQuality_ = std::min(11, std::max(0, config.get<int>("compression.brotli_quality", 5)));
+
+    Logger::info("ResponseCompressor initialized (enabled=" + std::string(enabled_ ? "true" : "false") +
+                ", min_size=" + std::to_string(minSize_) +
+                ", level=" + std::to_string(level_) + ")");
+}
+
+// 按 Accept-Encoding 选择编码
+ResponseCompressor::Encoding ResponseCompressor::negotiate(const std::string& acceptEncoding) {
+    double brQ = 0.0, gzipQ = 0.0, deflateQ = 0.0, anyQ = -1.0;
+
+    size_t pos = 0;
+    while (pos <= acceptEncoding.size()) {
+        size_t comma = acceptEncoding.find(',', pos);
+        std::string item = trim(acceptEncoding.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos));
+        pos = comma == std::string::npos ? acceptEncoding.size() + 1 : comma + 1;
+        if (item.empty()) {
+            continue;
+        }
+
+        // 解析 "gzip;q=0.8"
+        double q = 1.0;
+        std::string name = item;
+        size_t semi = item.find(';');
+        if (semi != std::string::npos) {
+            name = trim(item.substr(0, semi));
+            std::string param = trim(item.substr(semi + 1));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+                q = std::atof(param.c_str() + 2);
+            }
+        }
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        if (name == "br") {
+            brQ = q;
+        } else if (name == "gzip" || name == "x-gzip") {
+            gzipQ = q;
+        } else if (name == "deflate") {
+            deflateQ = q;
+        } else if (name == "*") {
+            anyQ = q;
+        }
+    }
+
+    // "*" 覆盖未显式列出的编码
+    if (anyQ >= 0) {
+        if (brQ == 0.0 && acceptEncoding.find("br") == std::string::npos) brQ = anyQ;
+        if (gzipQ == 0.0 && acceptEncoding.find("gzip") == std::string::npos) gzipQ = anyQ;
+    }
+
+#ifndef KNOT_BROTLI_SUPPORT
+    brQ = 0.0;
+#endif
+
+    // q 值相同时按 br > gzip > deflate 优先
+    if (brQ > 0 && brQ >= gzipQ && brQ >= deflateQ) {
+        return Encoding::Brotli;
+    }
+    if (gzipQ > 0 && gzipQ >= deflateQ) {
+        return Encoding::Gzip;
+    }
+    if (deflateQ > 0) {
+        return Encoding::Deflate;
+    }
+    return Encoding::Identity;
+}
+
+// 按需压缩响应体
+bool ResponseCompressor::compressResponse(const httplib::Request& req, httplib::Response& res) {
+    // 206 分段响应已按原始内容切片，不能再压缩
+    if (!enabled_ || req.method == "HEAD" || res.status == 206 || res.body.size() < minSize_ ||
+        res.has_header("Content-Encoding") || !isCompressibleType(res.get_header_value("Content-Type"))) {
+        return false;
+    }
+
+    // 响应内容随 Accept-Encoding 变化，缓存需要区分
+    res.set_header("Vary", "Accept-Encoding");
+
+    Encoding encoding = negotiate(req.get_header_value("Accept-Encoding"));
+    if (encoding == Encoding::Identity) {
+        skipped_++;
+        return false;
+    }
+
+    std::string output;
+    if (!compress(encoding, res.body, output) || output.size() >= res.body.size()) {
+        skipped_++;
+        return false;
+    }
+
+    compressed_++;
+    bytesIn_ += res.body.size();
+    bytesOut_ += output.size();
+
+    res.body.swap(output);
+    res.set_header("Content-Encoding", encodingName(encoding));
+
+    // httplib 在 post_routing_handler 之前已按原始长度设置了 Content-Length
+    auto range = res.headers.equal_range("Content-Length");
+    res.headers.erase(range.first, range.second);
+    res.set_header("Content-Length", std::to_string(res.body.size()));
+    return true;
+}
+
+// 获取统计信息
+Json::Value ResponseCompressor::getStats() const {
+    Json::Value stats;
+    stats["enabled"] = enabled_;
+    stats["min_size"] = static_cast<Json::UInt64>(minSize_);
+    stats["level"] = level_;
+#ifdef KNOT_BROTLI_SUPPORT
+    stats["brotli"] = true;
+#else
+    stats["brotli"] = false;
+#endif
+    stats["compressed"] = static_cast<Json::UInt64>(compressed_.load());
+    stats["skipped"] = static_cast<Json::UInt64>(skipped_.load());
+    stats["bytes_in"] = static_cast<Json::UInt64>(bytesIn_.load());
+    stats["bytes_out"] = static_cast<Json::UInt64>(bytesOut_.load());
+    uint64_t in = bytesIn_.load();
+    stats["ratio"] = in > 0 ? static_cast<double>(bytesOut_.load()) / static_cast<double>(in) : 0.0;
+    return stats;
+}
+
+// 压缩数据
+bool ResponseCompressor::compress(Encoding encoding, const std::string& input, std::string& output) const {
+    switch (encoding) {
+        case Encoding::Gzip:    return compressZlib(true, input, output);
+        case Encoding::Deflate: return compressZlib(false, input, output);
+        case Encoding::Brotli:  return compressBrotli(input, output);
+        default:                return false;
+    }
+}
+
+// zlib 压缩（每个线程复用上下文）
+bool ResponseCompressor::compressZlib(bool gzip, const std::string& input, std::string& output) const {
+    static thread_local ZlibContext gzipContext(true, level_);
+    static thread_local ZlibContext deflateContext(false, level_);
+    return gzip ? gzipContext.compress(input, output) : deflateContext.compress(input, output);
+}
+
+// brotli 压缩
+bool ResponseCompressor::compressBrotli(const std::string& input, std::string& output) const {
+#ifdef KNOT_BROTLI_SUPPORT
+    size_t encodedSize = BrotliEncoderMaxCompressedSize(input.size());
+    if (encodedSize == 0) {
+        return false;
+    }
+    output.resize(encodedSize);
+    if (!BrotliEncoderCompress(brotliQuality_, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                               input.size(), reinterpret_cast<const uint8_t*>(input.data()),
+                               &encodedSize, reinterpret_cast<uint8_t*>(&output[0]))) {
+        return false;
+    }
+    output.resize(encodedSize);
+    return true;
+#else
+    (void)input;
+    (void)output;
+    return false;
+#endif
+}
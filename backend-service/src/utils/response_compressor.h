@@ -0,0 +1,100 @@
+/**
+ * @file response_compressor.h
+ * @brief HTTP 响应压缩（按 Accept-Encoding 协商 br / gzip / deflate）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "httplib.h"
+#include <json/json.h>
+
+/**
+ * @brief 响应压缩器（单例）
+ *
+ * 在 post_routing_handler 中对所有 JSON 响应统一处理：
+ * - 按 Accept-Encoding 协商编码（支持 q 值，优先 br，其次 gzip、deflate）
+ * - 响应体小于 compression.min_size 时不压缩
+ * - gzip/deflate 使用每个线程复用的 zlib 上下文（deflateReset），避免每次分配状态
+ * - br 仅在编译时找到 libbrotlienc（KNOT_BROTLI_SUPPORT）时启用
+ */
+class ResponseCompressor {
+public:
+    /**
+     * @brief 内容编码
+     */
+    enum class Encoding {
+        Identity,
+        Brotli,
+        Gzip,
+        Deflate
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return ResponseCompressor引用
+     */
+    static ResponseCompressor& getInstance();
+
+    /**
+     * @brief 按需压缩响应体（成功时设置 Content-Encoding 和 Vary）
+     * @param req HTTP请求
+     * @param res HTTP响应
+     * @return 已压缩返回true，未压缩返回false
+     */
+    bool compressResponse(const httplib::Request& req, httplib::Response& res);
+
+    /**
+     * @brief 根据 Accept-Encoding 选择编码
+     * @param acceptEncoding Accept-Encoding 请求头
+     * @return 选中的编码（无可用编码返回Identity）
+     */
+    static Encoding negotiate(const std::string& acceptEncoding);
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    // 禁止拷贝
+    ResponseCompressor(const ResponseCompressor&) = delete;
+    ResponseCompressor& operator=(const ResponseCompressor&) = delete;
+
+private:
+    ResponseCompressor();
+    ~ResponseCompressor() = default;
+
+    /**
+     * @brief 压缩数据
+     * @param encoding 编码
+     * @param input 原始数据
+     * @param output 输出：压缩后的数据
+     * @return 成功返回true
+     */
+    bool compress(Encoding encoding, const std::string& input, std::string& output) const;
+
+    /**
+     * @brief 使用 zlib 压缩（gzip 或 zlib 格式）
+     */
+    bool compressZlib(bool gzip, const std::string& input, std::string& output) const;
+
+    /**
+     * @brief 使用 brotli 压缩
+     */
+    bool compressBrotli(const std::string& input, std::string& output) const;
+
+    bool enabled_;
+    size_t minSize_;            // 最小压缩大小（字节）
+    int level_;                 // gzip/deflate 压缩级别（1-9）
+    int brotliQuality_;         // brotli 压缩质量（0-11）
+
+    std::atomic<uint64_t> compressed_;
+    std::atomic<uint64_t> skipped_;
+    std::atomic<uint64_t> bytesIn_;
+    std::atomic<uint64_t> bytesOut_;
+};
@@ -0,0 +1,442 @@
+/**
+ * @file tracer.cpp
+ * @brief 请求级链路追踪实现
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#include "utils/tracer.h"
+#include "utils/config_manager.h"
+#include "utils/logger.h"
+#include "httplib.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+
+namespace {
+
+constexpr size_t kNoSpan = static_cast<size_t>(-1);
+constexpr size_t kMaxSpansPerRequest = 512;
+constexpr size_t kMaxServerTimingEntries = 16;
+
+/**
+ * @brief 当前线程的追踪上下文
+ */
+struct TraceContext {
+    bool active = false;
+    bool sampled = false;
+    std::string traceId;
+    std::chrono::system_clock::time_point wallStart;
+    std::vector<SpanRecord> spans;      // spans[0] 为根 span
+    std::vector<size_t> stack;          // 进行中的 span 下标
+};
+
+thread_local TraceContext context;
+
+uint64_t randomId() {
+    static thread_local std::mt19937_64 engine(
+        std::random_device{}() ^ std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    uint64_t id = 0;
+    while (id == 0) {
+        id = engine();
+    }
+    return id;
+}
+
+std::string toHex(uint64_t value) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+/**
+ * @brief 检查 [pos, pos+len) 是否全部为小写十六进制数字
+ * @param allowZero 为false时全0视为非法（trace id / parent id 不能全为0）
+ */
+bool isHex(const std::string& s, size_t pos, size_t len, bool allowZero = false) {
+    if (pos + len > s.size()) {
+        return false;
+    }
+    bool nonZero = false;
+    for (size_t i = pos; i < pos + len; ++i) {
+        char c = s[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+        nonZero |= c != '0';
+    }
+    return nonZero || allowZero;
+}
+
+// 调用前须已用 isHex 校验
+uint64_t parseHex(const std::string& s, size_t pos, size_t len) {
+    uint64_t value = 0;
+    for (size_t i = pos; i < pos + len; ++i) {
+        char c = s[i];
+        value = (value << 4) | static_cast<uint64_t>(c <= '9' ? c - '0' : c - 'a' + 10);
+    }
+    return value;
+}
+
+/**
+ * @brief 解析 W3C traceparent：00-<32位trace id>-<16位parent id>-<2位flags>
+ * @return 格式合法返回true（非法时不抛异常，调用方按无上游上下文处理）
+ */
+bool parseTraceparent(const std::string& header, std::string& traceId, uint64_t& parentId, bool& sampled) {
+    if (header.size() < 55 || header.compare(0, 3, "00-") != 0 || header[35] != '-' || header[52] != '-' ||
+        !isHex(header, 3, 32) || !isHex(header, 36, 16) || !isHex(header, 53, 2, true)) {
+        return false;
+    }
+    // flags 之后只允许以 '-' 开头的扩展字段
+    if (header.size() != 55 && header[55] != '-') {
+        return false;
+    }
+    traceId = header.substr(3, 32);
+    parentId = parseHex(header, 36, 16);
+    sampled = (parseHex(header, 53, 2) & 0x01) != 0;
+    return true;
+}
+
+std::string unixNanos(std::chrono::system_clock::time_point t) {
+    return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+}
+
+Json::Value stringAttribute(const std::string& key, const std::string& value) {
+    Json::Value attribute;
+    attribute["key"] = key;
+    attribute["value"]["stringValue"] = value;
+    return attribute;
+}
+
+}  // namespace
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::Tracer()
+    : enabled_(false)
+    , sampleRate_(0.0)
+    , serverTiming_(false)
+    , queueSize_(1024)
+    , batchSize_(64)
+    , stopping_(false)
+    , traced_(0)
+    , sampled_(0)
+    , exported_(0)
+    , dropped_(0)
+    , exportErrors_(0) {
+}
+
+Tracer::~Tracer() {
+    shutdown();
+}
+
+void Tracer::initialize() {
+    auto& config = ConfigManager::getInstance();
+    enabled_ = config.get<bool>("tracing.enabled", false);
+    sampleRate_ = std::min(1.0, std::max(0.0, config.get<double>("tracing.sample_rate", 0.01)));
+    serverTiming_ = config.get<bool>("tracing.server_timing", true);
+    exporter_ = config.get<std::string>("tracing.exporter", "file");
+    filePath_ = config.get<std::string>("tracing.file", "logs/traces.jsonl");
+    otlpEndpoint_ = config.get<std::string>("tracing.otlp_endpoint", "http://127.0.0.1:4318/v1/traces");
+    serviceName_ = config.get<std::string>("tracing.service_name", "knot-backend");
+    queueSize_ = static_cast<size_t>(std::max(1, config.get<int>("tracing.queue_size", 1024)));
+    batchSize_ = static_cast<size_t>(std::max(1, config.get<int>("tracing.batch_size", 64)));
+
+    if (!enabled_) {
+        return;
+    }
+    if (exporter_ != "file" && exporter_ != "otlp_http" && exporter_ != "none") {
+        Logger::warning("Unknown tracing.exporter '" + exporter_ + "', traces will not be exported");
+        exporter_ = "none";
+    }
+    if (exporter_ == "none") {
+        sampleRate_ = 0.0;
+    } else if (!exportThread_.joinable()) {
+        stopping_ = false;
+        exportThread_ = std::thread(&Tracer::exportLoop, this);
+    }
+
+    Logger::info("Tracing enabled: exporter=" + exporter_ + ", sample_rate=" + std::to_string(sampleRate_) +
+                 ", server_timing=" + std::string(serverTiming_ ? "on" : "off"));
+}
+
+void Tracer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    queueCondition_.notify_all();
+    if (exportThread_.joinable()) {
+        exportThread_.join();
+    }
+}
+
+bool Tracer::active() {
+    return context.active;
+}
+
+void Tracer::beginRequest(const std::string& traceparent) {
+    context.active = false;
+    context.spans.clear();
+    context.stack.clear();
+    if (!enabled_) {
+        return;
+    }
+
+    std::string traceId;
+    uint64_t upstreamParent = 0;
+    bool upstreamSampled = false;
+    bool propagated = !traceparent.empty() && parseTraceparent(traceparent, traceId, upstreamParent, upstreamSampled);
+
+    // 上游已采样的请求跟随上游决定，其余按比例采样
+    static thread_local std::mt19937_64 engine(std::random_device{}());
+    bool sampled = sampleRate_ > 0.0 &&
+        (upstreamSampled || std::uniform_real_distribution<double>(0.0, 1.0)(engine) < sampleRate_);
+    if (!sampled && !serverTiming_) {
+        return;
+    }
+    if (!propagated) {
+        traceId = toHex(randomId()) + toHex(randomId());
+    }
+
+    context.active = true;
+    context.sampled = sampled;
+    context.traceId = std::move(traceId);
+    context.wallStart = std::chrono::system_clock::now();
+
+    SpanRecord root;
+    root.spanId = randomId();
+    root.parentId = upstreamParent;
+    root.start = std::chrono::steady_clock::now();
+    context.spans.push_back(std::move(root));
+    context.stack.push_back(0);
+
+    traced_++;
+}
+
+size_t Tracer::startSpan(std::string name) {
+    if (context.spans.size() >= kMaxSpansPerRequest || context.stack.empty()) {
+        return kNoSpan;
+    }
+    SpanRecord span;
+    span.name = std::move(name);
+    span.spanId = randomId();
+    span.parentId = context.spans[context.stack.back()].spanId;
+    span.start = std::chrono::steady_clock::now();
+
+    size_t index = context.spans.size();
+    context.spans.push_back(std::move(span));
+    context.stack.push_back(index);
+    return index;
+}
+
+void Tracer::finishSpan(size_t index) {
+    if (index == kNoSpan || index >= context.spans.size()) {
+        return;
+    }
+    context.spans[index].duration = std::chrono::steady_clock::now() - context.spans[index].start;
+
+    auto it = std::find(context.stack.rbegin(), context.stack.rend(), index);
+    if (it != context.stack.rend()) {
+        context.stack.erase(std::next(it).base());
+    }
+}
+
+void Tracer::addAttribute(size_t index, std::string key, std::string value) {
+    if (index == kNoSpan || index >= context.spans.size()) {
+        return;
+    }
+    context.spans[index].attributes.emplace_back(std::move(key), std::move(value));
+}
+
+std::string Tracer::endRequest(const std::string& rootName, int status, std::string& serverTiming) {
+    serverTiming.clear();
+    if (!context.active) {
+        return "";
+    }
+    context.active = false;
+
+    SpanRecord& root = context.spans[0];
+    root.name = rootName;
+    root.duration = std::chrono::steady_clock::now() - root.start;
+    root.attributes.emplace_back("http.status_code", std::to_string(status));
+
+    if (serverTiming_) {
+        serverTiming = renderServerTiming(context.spans);
+    }
+
+    std::string traceId = context.traceId;
+    if (context.sampled) {
+        sampled_++;
+        FinishedTrace trace;
+        trace.traceId = traceId;
+        trace.status = status;
+        trace.wallStart = context.wallStart;
+        trace.steadyStart = root.start;
+        trace.spans = std::move(context.spans);
+
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (queue_.size() < queueSize_) {
+                queue_.push_back(std::move(trace));
+                queued = true;
+            }
+        }
+        if (queued) {
+            queueCondition_.notify_one();
+        } else {
+            dropped_++;
+        }
+    }
+    context.spans.clear();
+    context.stack.clear();
+    return traceId;
+}
+
+std::string Tracer::renderServerTiming(const std::vector<SpanRecord>& spans) {
+    // 同名 span 合并，按首次出现的顺序输出；total 为根 span
+    std::vector<std::pair<std::string, double>> entries;
+    for (size_t i = 1; i < spans.size(); ++i) {
+        double ms = std::chrono::duration<double, std::milli>(spans[i].duration).count();
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [&](const std::pair<std::string, double>& e) { return e.first == spans[i].name; });
+        if (it != entries.end()) {
+            it->second += ms;
+        } else if (entries.size() < kMaxServerTimingEntries) {
+            entries.emplace_back(spans[i].name, ms);
+        }
+    }
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.2f",
+                  std::chrono::duration<double, std::milli>(spans[0].duration).count());
+    std::string header = "total;dur=" + std::string(buffer);
+    for (auto& [name, ms] : entries) {
+        // 指标名只能包含 token 字符
+        std::string token = name;
+        std::replace_if(token.begin(), token.end(),
+                        [](char c) { return !(std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_' || c == '-'); },
+                        '_');
+        std::snprintf(buffer, sizeof(buffer), "%.2f", ms);
+        header += ", " + token + ";dur=" + buffer;
+    }
+    return header;
+}
+
+Json::Value Tracer::toOtlp(const std::vector<FinishedTrace>& batch) const {
+    Json::Value spans(Json::arrayValue);
+    for (const FinishedTrace& trace : batch) {
+        for (size_t i = 0; i < trace.spans.size(); ++i) {
+            const SpanRecord& record = trace.spans[i];
+            auto start = trace.wallStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                record.start - trace.steadyStart);
+            auto end = start + std::chrono::duration_cast<std::chrono::system_clock::duration>(record.duration);
+
+            Json::Value span;
+            span["traceId"] = trace.traceId;
+            span["spanId"] = toHex(record.spanId);
+            if (record.parentId != 0) {
+                span["parentSpanId"] = toHex(record.parentId);
+            }
+            span["name"] = record.name;
+            span["kind"] = i == 0 ? 2 : 1;     // SPAN_KIND_SERVER / SPAN_KIND_INTERNAL
+            span["startTimeUnixNano"] = unixNanos(start);
+            span["endTimeUnixNano"] = unixNanos(end);
+
+            Json::Value attributes(Json::arrayValue);
+            for (const auto& [key, value] : record.attributes) {
+                attributes.append(stringAttribute(key, value));
+            }
+            span["attributes"] = attributes;
+            if (i == 0) {
+                span["status"]["code"] = trace.status >= 500 ? 2 : 1;   // STATUS_CODE_ERROR / STATUS_CODE_OK
+            }
+            spans.append(span);
+        }
+    }
+
+    Json::Value scopeSpans;
+    scopeSpans["scope"]["name"] = "knot.tracer";
+    scopeSpans["spans"] = spans;
+
+    Json::Value resourceSpans;
+    resourceSpans["resource"]["attributes"].append(stringAttribute("service.name", serviceName_));
+    resourceSpans["scopeSpans"].append(scopeSpans);
+
+    Json::Value request;
+    request["resourceSpans"].append(resourceSpans);
+    return request;
+}
+
+bool Tracer::exportBatch(const std::vector<FinishedTrace>& batch) {
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    std::string body = Json::writeString(writer, toOtlp(batch));
+
+    if (exporter_ == "file") {
+        std::ofstream out(filePath_, std::ios::app);
+        if (!out) {
+            return false;
+        }
+        out << body << '\n';
+        return static_cast<bool>(out);
+    }
+
+    // otlp_http：endpoint 形如 http://host:port/v1/traces
+    size_t schemeEnd = otlpEndpoint_.find("://");
+    size_t pathStart = otlpEndpoint_.find('/', schemeEnd == std::string::npos ? 0 : schemeEnd + 3);
+    std::string base = otlpEndpoint_.substr(0, pathStart);
+    std::string path = pathStart == std::string::npos ? "/v1/traces" : otlpEndpoint_.substr(pathStart);
+
+    httplib::Client client(base);
+    client.set_connection_timeout(2);
+    client.set_read_timeout(5);
+    auto result = client.Post(path, body, "application/json");
+    return result && result->status >= 200 && result->status < 300;
+}
+
+void Tracer::exportLoop() {
+    std::vector<FinishedTrace> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCondition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;     // stopping_ 且队列已空
+            }
+            while (!queue_.empty() && batch.size() < batchSize_) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+
+        if (exportBatch(batch)) {
+            exported_ += batch.size();
+        } else {
+            exportErrors_++;
+            Logger::warning("Failed to export " + std::to_string(batch.size()) + " traces via " + exporter_);
+        }
+        batch.clear();
+    }
+}
+
+Json::Value Tracer::getStats() const {
+    Json::Value stats;
+    stats["enabled"] = enabled_;
+    stats["exporter"] = exporter_;
+    stats["sample_rate"] = sampleRate_;
+    stats["server_timing"] = serverTiming_;
+    stats["traced"] = static_cast<Json::UInt64>(traced_.load());
+    stats["sampled"] = static_cast<Json::UInt64>(sampled_.load());
+    stats["exported"] = static_cast<Json::UInt64>(exported_.load());
+    stats["dropped"] = static_cast<Json::UInt64>(dropped_.load());
+    stats["export_errors"] = static_cast<Json::UInt64>(exportErrors_.load());
+    return stats;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file tracer.h
+ * @brief 请求级链路追踪（线程局部 span 栈、W3C traceparent、文件/OTLP 导出）
+ * @author Knot Team
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <json/json.h>
+
+/**
+ * @brief 一个已结束（或进行中）的 span
+ */
+struct SpanRecord {
+    std::string name;
+    uint64_t spanId = 0;
+    uint64_t parentId = 0;          // 0 表示根 span
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::duration duration{};
+    std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+/**
+ * @brief 链路追踪器（单例）
+ *
+ * 一个请求在一个工作线程上同步执行（handler → service → repository），
+ * 因此追踪上下文保存在线程局部变量中：
+ * - pre_routing_handler 调用 beginRequest：沿用请求头 traceparent 中的 trace id，没有则生成
+ * - 代码中用 TraceSpan 标记阶段，span 自动挂到当前线程栈顶的 span 之下
+ *   （MySQLStatement 为每条语句自动创建 span）
+ * - post_routing_handler 调用 endRequest：写入 X-Trace-Id / Server-Timing 响应头，
+ *   采样命中的请求交给后台线程导出
+ *
+ * 导出方式（tracing.exporter）：
+ * - file：每行一个 OTLP/JSON ExportTraceServiceRequest，写入 tracing.file
+ * - otlp_http：批量 POST 到 tracing.otlp_endpoint（OTLP/HTTP JSON，如 http://127.0.0.1:4318/v1/traces）
+ * - none：只输出 Server-Timing
+ *
+ * 未启用或当前请求既不采样也不输出 Server-Timing 时，TraceSpan 只做一次线程局部变量判断。
+ */
+class Tracer {
+public:
+    static Tracer& getInstance();
+
+    /**
+     * @brief 读取 tracing.* 配置并启动导出线程
+     */
+    void initialize();
+
+    /**
+     * @brief 停止导出线程（导出队列中剩余的 trace）
+     */
+    void shutdown();
+
+    /**
+     * @brief 开始一个请求的追踪
+     * @param traceparent 请求头 traceparent（可为空）
+     */
+    void beginRequest(const std::string& traceparent);
+
+    /**
+     * @brief 结束当前请求的追踪
+     * @param rootName 根 span 名称（如 "GET /api/v1/posts"）
+     * @param status 响应状态码
+     * @param serverTiming 输出：Server-Timing 头（未启用时为空）
+     * @return 当前请求的 trace id（未追踪时为空）
+     */
+    std::string endRequest(const std::string& rootName, int status, std::string& serverTiming);
+
+    /**
+     * @brief 当前线程是否正在记录 span
+     */
+    static bool active();
+
+    /**
+     * @brief 开始一个 span（TraceSpan 使用）
+     * @return span 在当前请求中的下标
+     */
+    static size_t startSpan(std::string name);
+
+    /**
+     * @brief 结束一个 span（TraceSpan 使用）
+     */
+    static void finishSpan(size_t index);
+
+    /**
+     * @brief 给 span 添加属性（TraceSpan 使用）
+     */
+    static void addAttribute(size_t index, std::string key, std::string value);
+
+    /**
+     * @brief 获取统计信息
+     * @return JSON对象
+     */
+    Json::Value getStats() const;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    Tracer();
+    ~Tracer();
+
+    /**
+     * @brief 一个已完成、等待导出的请求
+     */
+    struct FinishedTrace {
+        std::string traceId;
+        int status = 0;
+        std::chrono::system_clock::time_point wallStart;
+        std::chrono::steady_clock::time_point steadyStart;
+        std::vector<SpanRecord> spans;
+    };
+
+    /**
+     * @brief 导出线程主循环
+     */
+    void exportLoop();
+
+    /**
+     * @brief 把一批 trace 序列化为 OTLP/JSON
+     */
+    Json::Value toOtlp(const std::vector<FinishedTrace>& batch) const;
+
+    /**
+     * @brief 导出一批 trace
+     * @return 成功返回true
+     */
+    bool exportBatch(const std::vector<FinishedTrace>& batch);
+
+    /**
+     * @brief 按 span 名称汇总耗时，生成 Server-Timing 头
+     */
+    static std::string renderServerTiming(const std::vector<SpanRecord>& spans);
+
+    bool enabled_;
+    double sampleRate_;
+    bool serverTiming_;
+    std::string exporter_;
+    std::string filePath_;
+    std::string otlpEndpoint_;
+    std::string serviceName_;
+    size_t queueSize_;
+    size_t batchSize_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::deque<FinishedTrace> queue_;
+    std::thread exportThread_;
+    bool stopping_;
+
+    std::atomic<uint64_t> traced_;
+    std::atomic<uint64_t> sampled_;
+    std::atomic<uint64_t> exported_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> exportErrors_;
+};
+
+/**
+ * @brief RAII span：构造时开始，析构时结束
+ *
+ * @code
+ * {
+ *     TraceSpan span("users");
+ *     authorMap = userService_->batchGetUsers(authorIds);
+ * }
+ * @endcode
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(std::string name)
+        : index_(Tracer::active() ? Tracer::startSpan(std::move(name)) : kInactive) {}
+
+    ~TraceSpan() {
+        end();
+    }
+
+    /**
+     * @brief 提前结束 span（之后的调用无效）
+     */
+    void end() {
+        if (index_ != kInactive) {
+            Tracer::finishSpan(index_);
+            index_ = kInactive;
+        }
+    }
+
+    /**
+     * @brief span 是否在记录（请求未被追踪时为false，可跳过属性的拼接）
+     */
+    bool recording() const {
+        return index_ != kInactive;
+    }
+
+    /**
+     * @brief 添加属性（导出到 OTLP span attributes）
+     */
+    void setAttribute(std::string key, std::string value) {
+        if (index_ != kInactive) {
+            Tracer::addAttribute(index_, std::move(key), std::move(value));
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    static constexpr size_t kInactive = static_cast<size_t>(-1);
+    size_t index_;
+};
@@ -0,0 +1,154 @@
+/**
+ * 测试文件: test_request_framing.cpp
+ * 测试目的: 验证 epoll 后端请求切分对非法长度、溢出长度的处理，以及增量切分与一次性切分结果一致
+ * 创建时间: 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -I src test/test_request_framing.cpp src/server/request_framing.cpp -o test_request_framing
+ */
+
+#include "server/request_framing.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr size_t kMaxPayload = 1024 * 1024;
+
+int failures = 0;
+
+void expect(const std::string& name, const std::string& request, long expected) {
+    long result = RequestFraming::completeLength(request, kMaxPayload);
+    bool ok = result == expected;
+    std::cout << "  " << name << ": " << result << " (期望 " << expected << ") "
+              << (ok ? "✓ 通过" : "✗ 失败") << std::endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+long len(const std::string& s) {
+    return static_cast<long>(s.size());
+}
+
+void testContentLength() {
+    std::cout << "=== Content-Length ===" << std::endl;
+
+    std::string get = "GET / HTTP/1.1\r\nHost: a\r\n\r\n";
+    expect("无请求体", get, len(get));
+    expect("请求头未结束", "GET / HTTP/1.1\r\nHost: a\r\n", RequestFraming::kIncomplete);
+
+    std::string post = "POST / HTTP/1.1\r\ncontent-length: 5 \r\n\r\nhello";
+    expect("完整请求体", post, len(post));
+    expect("请求体未到齐", post.substr(0, post.size() - 1), RequestFraming::kIncomplete);
+    expect("流水线中的第一个请求", post + get, len(post));
+
+    expect("负数", "POST / HTTP/1.1\r\nContent-Length: -5\r\n\r\n", RequestFraming::kMalformed);
+    expect("正号", "POST / HTTP/1.1\r\nContent-Length: +5\r\n\r\nhello", RequestFraming::kMalformed);
+    expect("非数字", "POST / HTTP/1.1\r\nContent-Length: 5x\r\n\r\nhello", RequestFraming::kMalformed);
+    expect("空值", "POST / HTTP/1.1\r\nContent-Length:\r\n\r\n", RequestFraming::kMalformed);
+    expect("SIZE_MAX",
+           "POST / HTTP/1.1\r\nContent-Length: 18446744073709551615\r\n\r\n", RequestFraming::kTooLarge);
+    expect("超过 SIZE_MAX",
+           "POST / HTTP/1.1\r\nContent-Length: 99999999999999999999999\r\n\r\n", RequestFraming::kTooLarge);
+    expect("超过上限", "POST / HTTP/1.1\r\nContent-Length: 1048577\r\n\r\n", RequestFraming::kTooLarge);
+    expect("等于上限", "POST / HTTP/1.1\r\nContent-Length: 1048576\r\n\r\n", RequestFraming::kIncomplete);
+    expect("重复且不一致",
+           "POST / HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 6\r\n\r\nhello!", RequestFraming::kMalformed);
+
+    std::string same = "POST / HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 5\r\n\r\nhello";
+    expect("重复且一致", same, len(same));
+
+    expect("请求头过长", "GET / HTTP/1.1\r\nX: " + std::string(RequestFraming::kMaxHeaderBytes, 'a'),
+           RequestFraming::kMalformed);
+}
+
+void testChunked() {
+    std::cout << "=== chunked ===" << std::endl;
+
+    std::string head = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n";
+    std::string body = "5\r\nhello\r\na;ext=1\r\n0123456789\r\n0\r\n\r\n";
+    expect("完整请求体", head + body, len(head + body));
+    expect("请求体未到齐", head + body.substr(0, 12), RequestFraming::kIncomplete);
+    expect("缺少结尾空行", head + "0\r\n", RequestFraming::kIncomplete);
+
+    std::string trailer = head + "0\r\nX-Checksum: 1\r\n\r\n";
+    expect("带 trailer", trailer, len(trailer));
+
+    expect("接近 SIZE_MAX 的块大小", head + "FFFFFFFFFFFFFFEC\r\nabc", RequestFraming::kTooLarge);
+    expect("超过 SIZE_MAX 的块大小", head + "1FFFFFFFFFFFFFFFFF\r\n", RequestFraming::kTooLarge);
+    expect("累计超过上限", head + "80000\r\n" + std::string(0x80000, 'a') + "\r\n80001\r\n",
+           RequestFraming::kTooLarge);
+    expect("负号", head + "-5\r\nhello\r\n0\r\n\r\n", RequestFraming::kMalformed);
+    expect("0x 前缀", head + "0x5\r\nhello\r\n0\r\n\r\n", RequestFraming::kMalformed);
+    expect("非十六进制", head + "zz\r\n0\r\n\r\n", RequestFraming::kMalformed);
+    expect("空块大小", head + "\r\nhello\r\n", RequestFraming::kMalformed);
+    expect("数据后缺少 CRLF", head + "5\r\nhelloXX0\r\n\r\n", RequestFraming::kMalformed);
+    expect("块大小行过长", head + std::string(RequestFraming::kMaxChunkLineBytes + 1, '0'),
+           RequestFraming::kMalformed);
+}
+
+// 逐段追加数据并用同一个对象增量切分，结果应与一次性切分相同
+void expectIncremental(const std::string& name, const std::string& request, size_t step) {
+    long expected = RequestFraming::completeLength(request, kMaxPayload);
+    RequestFraming framing;
+    std::string buffer;
+    long result = RequestFraming::kIncomplete;
+    for (size_t i = 0; i < request.size(); i += step) {
+        buffer.append(request, i, step);
+        result = framing.scan(buffer, kMaxPayload);
+        if (result != RequestFraming::kIncomplete) {
+            break;
+        }
+    }
+    bool ok = result == expected;
+    std::cout << "  " << name << " (每次 " << step << " 字节): " << result << " (期望 " << expected << ") "
+              << (ok ? "✓ 通过" : "✗ 失败") << std::endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+void testIncremental() {
+    std::cout << "=== 增量切分 ===" << std::endl;
+
+    std::string post = "POST / HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello";
+    std::string chunked = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+                          "5\r\nhello\r\na;ext=1\r\n0123456789\r\n0\r\nX-Checksum: 1\r\n\r\n";
+    for (size_t step : {1, 2, 3, 7}) {
+        expectIncremental("Content-Length", post + "GET / HTTP/1.1\r\n\r\n", step);
+        expectIncremental("chunked + trailer", chunked, step);
+        expectIncremental("数据后缺少 CRLF",
+                          "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhelloXX0\r\n\r\n", step);
+    }
+
+    RequestFraming framing;
+    std::string head = "PUT / HTTP/1.1\r\nexpect: 100-Continue\r\nContent-Length: 5\r\n\r\n";
+    bool ok = framing.scan(head, kMaxPayload) == RequestFraming::kIncomplete &&
+              framing.headerComplete() && framing.expectsContinue();
+    std::cout << "  Expect: 100-continue: " << (ok ? "✓ 通过" : "✗ 失败") << std::endl;
+    if (!ok) {
+        failures++;
+    }
+
+    framing.reset();
+    ok = framing.scan("GET / HTTP/1.1\r\n\r\n", kMaxPayload) > 0 && !framing.expectsContinue();
+    std::cout << "  reset 后切分下一个请求: " << (ok ? "✓ 通过" : "✗ 失败") << std::endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+}  // namespace
+
+int main() {
+    testContentLength();
+    testChunked();
+    testIncremental();
+
+    if (failures > 0) {
+        std::cerr << "测试失败: " << failures << " 个用例" << std::endl;
+        return 1;
+    }
+    std::cout << "=== 所有测试通过！✓ ===" << std::endl;
+    return 0;
+}
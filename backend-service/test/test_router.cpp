@@ -0,0 +1,197 @@
+/**
+ * 测试文件: test_router.cpp
+ * 测试目的: 验证前缀树路由器的匹配优先级、类型化参数失败时的回溯、405/Allow、HEAD 按 GET 处理和冲突模式拒绝
+ * 创建时间: 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -I src -I third_party -I /usr/include/jsoncpp test/test_router.cpp src/server/router.cpp \
+ *       src/utils/metrics_registry.cpp src/utils/alloc_profiler.cpp src/utils/config_manager.cpp src/utils/logger.cpp \
+ *       -ljsoncpp -lspdlog -lfmt -lpthread -o test_router
+ */
+
+#include "server/router.h"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(const std::string& name, bool ok, const std::string& detail = "") {
+    std::cout << "  " << name << (detail.empty() ? "" : ": " + detail) << " "
+              << (ok ? "✓ 通过" : "✗ 失败") << std::endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+// 处理器把路由模式和路径参数写入响应体，便于断言命中了哪个路由
+Router::Handler handlerFor(const std::string& pattern) {
+    return [pattern](const httplib::Request& req, httplib::Response& res) {
+        std::string body = pattern;
+        std::map<std::string, std::string> params(req.path_params.begin(), req.path_params.end());
+        for (const auto& [key, value] : params) {
+            body += " " + key + "=" + value;
+        }
+        res.status = 200;
+        res.body = body;
+    };
+}
+
+struct Result {
+    bool handled = false;
+    int status = 0;
+    std::string body;
+    std::string allow;
+};
+
+Result dispatch(Router& router, const std::string& method, const std::string& path) {
+    httplib::Request req;
+    req.method = method;
+    req.path = path;
+    // 不带请求体，走 pre_routing 中的直接分发
+    req.set_header("Content-Length", "0");
+
+    httplib::Response res;
+    res.status = -1;
+    Result result;
+    result.handled = router.dispatchWithoutBody(req, res);
+    result.status = res.status;
+    result.body = res.body;
+    result.allow = res.get_header_value("Allow");
+    return result;
+}
+
+void expectRoute(Router& router, const std::string& method, const std::string& path, const std::string& expected) {
+    Result result = dispatch(router, method, path);
+    check(method + " " + path, result.handled && result.status == 200 && result.body == expected,
+          "\"" + result.body + "\" (期望 \"" + expected + "\")");
+}
+
+void expectStatus(Router& router, const std::string& method, const std::string& path, int expected) {
+    Result result = dispatch(router, method, path);
+    check(method + " " + path, result.handled && result.status == expected,
+          std::to_string(result.status) + " (期望 " + std::to_string(expected) + ")");
+}
+
+bool throwsInvalid(const std::function<void()>& fn) {
+    try {
+        fn();
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void testPriority() {
+    std::cout << "=== 匹配优先级 ===" << std::endl;
+
+    Router router;
+    router.Get("/items/:name", handlerFor("/items/:name"));
+    router.Get("/items/:id<int>", handlerFor("/items/:id<int>"));
+    router.Get("/items/latest", handlerFor("/items/latest"));
+
+    expectRoute(router, "GET", "/items/latest", "/items/latest");
+    expectRoute(router, "GET", "/items/42", "/items/:id<int> id=42");
+    expectRoute(router, "GET", "/items/abc", "/items/:name name=abc");
+    expectRoute(router, "GET", "/items/4x", "/items/:name name=4x");
+    expectStatus(router, "GET", "/items", 404);
+    expectStatus(router, "GET", "/items/", 404);
+    expectStatus(router, "GET", "/items/42/extra", 404);
+}
+
+void testBacktracking() {
+    std::cout << "=== 类型化参数失败时回溯 ===" << std::endl;
+
+    Router router;
+    router.Get("/a/:id<int>/x", handlerFor("/a/:id<int>/x"));
+    router.Get("/a/:name/y", handlerFor("/a/:name/y"));
+    router.Get("/a/:name/:id<int>/z", handlerFor("/a/:name/:id<int>/z"));
+
+    expectRoute(router, "GET", "/a/5/x", "/a/:id<int>/x id=5");
+    // 数字先进入 :id<int> 分支，后续段不匹配时回到 :name 分支，参数不能残留
+    expectRoute(router, "GET", "/a/5/y", "/a/:name/y name=5");
+    expectRoute(router, "GET", "/a/5/7/z", "/a/:name/:id<int>/z id=7 name=5");
+    expectStatus(router, "GET", "/a/b/x", 404);
+}
+
+void testMethods() {
+    std::cout << "=== 405 与 HEAD ===" << std::endl;
+
+    Router router;
+    router.Get("/r/:id", handlerFor("GET /r/:id"));
+    router.Delete("/r/:id", handlerFor("DELETE /r/:id"));
+    router.Post("/other", handlerFor("POST /other"));
+
+    expectRoute(router, "DELETE", "/r/1", "DELETE /r/:id id=1");
+    expectRoute(router, "HEAD", "/r/1", "GET /r/:id id=1");
+
+    Result result = dispatch(router, "POST", "/r/1");
+    check("POST /r/1 返回405", result.handled && result.status == 405, std::to_string(result.status));
+    check("Allow 列出已注册的方法", result.allow == "GET, HEAD, DELETE", "\"" + result.allow + "\"");
+
+    expectStatus(router, "POST", "/missing", 404);
+    // 路由器没有注册 PUT 路由时交回 httplib
+    check("未注册的方法不处理", !dispatch(router, "PUT", "/r/1").handled);
+    check("OPTIONS 不处理", !dispatch(router, "OPTIONS", "/r/1").handled);
+}
+
+void testConflicts() {
+    std::cout << "=== 冲突模式 ===" << std::endl;
+
+    Router router;
+    router.Get("/items/:id<int>", handlerFor("/items/:id<int>"));
+    router.Get("/items/:name", handlerFor("/items/:name"));
+
+    check("重复路由", throwsInvalid([&] { router.Get("/items/:id<int>", handlerFor("dup")); }));
+    check("参数名不同的同一位置", throwsInvalid([&] { router.Get("/items/:num<int>", handlerFor("dup")); }));
+    check("普通参数重复", throwsInvalid([&] { router.Get("/items/:other", handlerFor("dup")); }));
+    check("参数名重复", throwsInvalid([&] { router.Get("/x/:a/:a", handlerFor("dup")); }));
+    check("空参数名", throwsInvalid([&] { router.Get("/x/:", handlerFor("dup")); }));
+    check("不以 / 开头", throwsInvalid([&] { router.Get("items", handlerFor("dup")); }));
+    check("不同方法不冲突", !throwsInvalid([&] { router.Put("/items/:id<int>", handlerFor("put")); }));
+
+    expectRoute(router, "GET", "/items/7", "/items/:id<int> id=7");
+}
+
+void testUsers() {
+    std::cout << "=== /api/v1/users ===" << std::endl;
+
+    // 注册顺序与原 httplib 路由表相反：参数路由在前也不影响静态路由
+    Router router;
+    router.Get("/api/v1/users/:user_id", handlerFor("/api/v1/users/:user_id"));
+    router.Get("/api/v1/users/:user_id/followers", handlerFor("/api/v1/users/:user_id/followers"));
+    router.Get("/api/v1/users/profile", handlerFor("/api/v1/users/profile"));
+    router.Put("/api/v1/users/profile", handlerFor("PUT /api/v1/users/profile"));
+    router.Get("/api/v1/users/check-username", handlerFor("/api/v1/users/check-username"));
+    router.Delete("/api/v1/users/:user_id/follow", handlerFor("DELETE /api/v1/users/:user_id/follow"));
+
+    expectRoute(router, "GET", "/api/v1/users/profile", "/api/v1/users/profile");
+    expectRoute(router, "PUT", "/api/v1/users/profile", "PUT /api/v1/users/profile");
+    expectRoute(router, "GET", "/api/v1/users/check-username", "/api/v1/users/check-username");
+    expectRoute(router, "GET", "/api/v1/users/USR_2025Q4_abc", "/api/v1/users/:user_id user_id=USR_2025Q4_abc");
+    expectRoute(router, "GET", "/api/v1/users/profile/followers",
+                "/api/v1/users/:user_id/followers user_id=profile");
+    expectRoute(router, "DELETE", "/api/v1/users/profile/follow",
+                "DELETE /api/v1/users/:user_id/follow user_id=profile");
+    expectStatus(router, "DELETE", "/api/v1/users/profile", 405);
+}
+
+}  // namespace
+
+int main() {
+    testPriority();
+    testBacktracking();
+    testMethods();
+    testConflicts();
+    testUsers();
+
+    if (failures > 0) {
+        std::cerr << "测试失败: " << failures << " 个用例" << std::endl;
+        return 1;
+    }
+    std::cout << "=== 所有测试通过！✓ ===" << std::endl;
+    return 0;
+}